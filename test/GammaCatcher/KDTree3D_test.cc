@@ -0,0 +1,105 @@
+// Checks gammacatcher::KDTree3D, which gammacorrelation uses to find the
+// track start nearest to each space point, against the linear scan it
+// replaced: same nearest index (lowest index among equally distant points)
+// and bit-identical distance. Includes an empty tree, duplicated points,
+// lattice points with many exact ties, and points with non-finite
+// coordinates, which the scan can never select.
+
+#include "ubreco/GammaCatcher/Base/KDTree3D.h"
+#include "test/TestCheck.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+  ubtest::Checker check;
+
+  // the gammacorrelation loop: strictly closer wins, so ties keep the
+  // first point; non-finite distances never compare as closer
+  bool Scan(const std::vector<gammacatcher::XYZ_t>& pt_v, const gammacatcher::XYZ_t& pos,
+	    double& dist, size_t& idx)
+  {
+    bool found = false;
+    dist = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < pt_v.size(); i++) {
+      double d = std::sqrt((std::pow(pt_v[i].x - pos.x, 2)) + (std::pow(pt_v[i].y - pos.y, 2)) + (std::pow(pt_v[i].z - pos.z, 2)));
+      if (d < dist) {
+	dist = d;
+	idx = i;
+	found = true;
+      }
+    }
+    return found;
+  }
+
+  void Check(const gammacatcher::KDTree3D& tree, const std::vector<gammacatcher::XYZ_t>& pt_v,
+	     const gammacatcher::XYZ_t& pos, const char* what)
+  {
+    double d_tree = -1., d_scan = -1.;
+    size_t i_tree = 0, i_scan = 0;
+    bool f_tree = tree.Nearest(pos, d_tree, i_tree);
+    bool f_scan = Scan(pt_v, pos, d_scan, i_scan);
+    bool ok = (f_tree == f_scan) && (!f_scan || (i_tree == i_scan && d_tree == d_scan));
+    if (check.Failed(ok))
+      std::cerr << "FAIL (" << what << "): tree " << f_tree << " " << i_tree << " " << d_tree
+		<< ", scan " << f_scan << " " << i_scan << " " << d_scan << std::endl;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(32452843);
+  std::uniform_real_distribution<double> coord(-300., 300.);
+  std::uniform_int_distribution<int> lattice(-3, 3);
+
+  // empty tree
+  {
+    gammacatcher::KDTree3D tree;
+    std::vector<gammacatcher::XYZ_t> pt_v;
+    tree.Build(pt_v);
+    Check(tree, pt_v, {0., 0., 0.}, "empty");
+  }
+
+  // only non-finite points
+  {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<gammacatcher::XYZ_t> pt_v = { {nan, 0., 0.}, {0., std::numeric_limits<double>::infinity(), 0.} };
+    gammacatcher::KDTree3D tree;
+    tree.Build(pt_v);
+    Check(tree, pt_v, {0., 0., 0.}, "non-finite");
+  }
+
+  for (size_t trial = 0; trial < 1000; trial++) {
+    size_t n = std::uniform_int_distribution<size_t>(1, 200)(rng);
+    bool on_lattice = (trial % 3 == 0);
+
+    std::vector<gammacatcher::XYZ_t> pt_v(n);
+    for (size_t i = 0; i < n; i++) {
+      if (on_lattice) pt_v[i] = { (double)lattice(rng), (double)lattice(rng), (double)lattice(rng) };
+      else            pt_v[i] = { coord(rng), coord(rng), coord(rng) };
+      // some exact duplicates of earlier points
+      if (i > 0 && i % 5 == 0) pt_v[i] = pt_v[i / 2];
+    }
+    if (trial % 7 == 0) pt_v[n / 2].y = std::numeric_limits<double>::quiet_NaN();
+
+    gammacatcher::KDTree3D tree;
+    tree.Build(pt_v);
+
+    for (size_t q = 0; q < 50; q++) {
+      gammacatcher::XYZ_t pos;
+      if (on_lattice) pos = { (double)lattice(rng), (double)lattice(rng), (double)lattice(rng) };
+      else            pos = { coord(rng), coord(rng), coord(rng) };
+      Check(tree, pt_v, pos, on_lattice ? "lattice" : "random");
+      // queries on the points themselves
+      Check(tree, pt_v, pt_v[q % n], "on point");
+    }
+  }
+
+  return check.Report();
+}
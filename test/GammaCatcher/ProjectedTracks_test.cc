@@ -0,0 +1,188 @@
+// Checks gammacatcher::ProjectedTracks, which Gamma3D and ClusterTrackDistance
+// use to find the tracks near each cluster, against the loops over every
+// track, trajectory point and hit it replaced: Nearest must keep the same
+// (track, point, hit) with a bit-identical distance, and TracksWithin must
+// return the same tracks. Includes lattice points with many exact ties,
+// points and hits with non-finite coordinates, empty tracks, and hits
+// outside the grid, some of them very far.
+
+#include "ubreco/GammaCatcher/Base/ProjectedTracks.h"
+#include "test/TestCheck.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+  using gammacatcher::ProjectedPoint_t;
+  using gammacatcher::WireTime_t;
+  using Tracks_t = std::vector<std::vector<ProjectedPoint_t> >;
+
+  ubtest::Checker check;
+
+  // reference: the modules' brute-force loops
+  double RefDistance(const WireTime_t& pos, const ProjectedPoint_t& p, size_t plane)
+  { return std::sqrt((std::pow(pos.w - p.w[plane], 2)) + (std::pow(pos.t - p.x, 2))); }
+
+  gammacatcher::TrackMatch_t RefNearest(const Tracks_t& trk_vv, size_t plane,
+					const std::vector<WireTime_t>& pos_v)
+  {
+    gammacatcher::TrackMatch_t match;
+    double best_d = std::numeric_limits<double>::infinity();
+    for (size_t t = 0; t < trk_vv.size(); t++) {
+      for (size_t m = 0; m < trk_vv[t].size(); m++) {
+	for (size_t h = 0; h < pos_v.size(); h++) {
+	  double d = RefDistance(pos_v[h], trk_vv[t][m], plane);
+	  if (d < best_d) {
+	    best_d = d;
+	    match.found = true;
+	    match.dist  = d;
+	    match.track = t;
+	    match.point = m;
+	    match.hit   = h;
+	    match.x     = trk_vv[t][m].x;
+	    match.z     = trk_vv[t][m].z;
+	  }
+	}
+      }
+    }
+    return match;
+  }
+
+  std::vector<size_t> RefTracksWithin(const Tracks_t& trk_vv, size_t plane,
+				      const std::vector<WireTime_t>& pos_v, double radius)
+  {
+    std::vector<size_t> track_v;
+    for (size_t t = 0; t < trk_vv.size(); t++) {
+      bool near = false;
+      for (auto const& p : trk_vv[t])
+	for (auto const& pos : pos_v)
+	  if (RefDistance(pos, p, plane) <= radius) near = true;
+      if (near) track_v.push_back(t);
+    }
+    return track_v;
+  }
+
+  //-------------------------------------------------------------------
+
+  const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+  // random value in [lo,hi), snapped to pitch if pitch > 0
+  double Random(std::mt19937& rng, double lo, double hi, double pitch)
+  {
+    double v = std::uniform_real_distribution<double>(lo, hi)(rng);
+    return (pitch > 0) ? std::round(v / pitch) * pitch : v;
+  }
+
+  // tracks as short random walks; some empty, some with non-finite points
+  Tracks_t RandomTracks(std::mt19937& rng, size_t ntrk, double pitch)
+  {
+    std::uniform_int_distribution<size_t> npts(0, 40);
+    std::uniform_int_distribution<int> coin(0, 19);
+    Tracks_t trk_vv(ntrk);
+    for (auto& trk_v : trk_vv) {
+      size_t n = (coin(rng) < 3) ? 0 : npts(rng);
+      ProjectedPoint_t p;
+      for (size_t plane = 0; plane < 3; plane++) p.w[plane] = Random(rng, 0., 1000., pitch);
+      p.x = Random(rng, 0., 250., pitch);
+      p.z = p.w[2];
+      for (size_t m = 0; m < n; m++) {
+	for (size_t plane = 0; plane < 3; plane++) p.w[plane] += Random(rng, -3., 3., pitch);
+	p.x += Random(rng, -3., 3., pitch);
+	p.z = p.w[2];
+	ProjectedPoint_t q = p;
+	if (coin(rng) == 0) q.w[coin(rng) % 3] = kNaN;
+	if (coin(rng) == 0) q.x = (coin(rng) % 2) ? kNaN : std::numeric_limits<double>::infinity();
+	trk_v.push_back(q);
+      }
+    }
+    return trk_vv;
+  }
+
+  // hits around the tracks, outside the grid, very far away, or non-finite
+  std::vector<WireTime_t> RandomHits(std::mt19937& rng, size_t nhit, double pitch)
+  {
+    std::uniform_int_distribution<int> kind(0, 19);
+    std::vector<WireTime_t> pos_v(nhit);
+    for (auto& pos : pos_v) {
+      int k = kind(rng);
+      if (k == 0)      { pos.w = kNaN; pos.t = Random(rng, 0., 250., pitch); }
+      else if (k == 1) { pos.w = Random(rng, 0., 1000., pitch); pos.t = kNaN; }
+      else if (k == 2) { pos.w = (kind(rng) % 2) ? 1.e15 : -1.e15; pos.t = Random(rng, 0., 250., pitch); }
+      else if (k == 3) { pos.w = Random(rng, -1500., 2500., pitch); pos.t = -1.e13; }
+      else if (k <= 6) { pos.w = Random(rng, -500., 1500., pitch); pos.t = Random(rng, -300., 550., pitch); }
+      else             { pos.w = Random(rng, 0., 1000., pitch); pos.t = Random(rng, 0., 250., pitch); }
+    }
+    return pos_v;
+  }
+
+  void CheckEvent(const Tracks_t& trk_vv, const std::vector<WireTime_t>& pos_v, size_t trial)
+  {
+    std::vector<size_t> track_idx_v(trk_vv.size());
+    for (size_t i = 0; i < trk_vv.size(); i++) track_idx_v[i] = 2 * i + 1;
+
+    gammacatcher::ProjectedTracks proj;
+    proj.Build(trk_vv, track_idx_v);
+
+    size_t npts = 0;
+    for (auto const& trk_v : trk_vv) npts += trk_v.size();
+    check(proj.NTracks() == trk_vv.size(), "NTracks", trial);
+    check(proj.NPoints() == npts, "NPoints", trial);
+    for (size_t i = 0; i < trk_vv.size(); i++)
+      check(proj.TrackIndex(i) == track_idx_v[i], "TrackIndex", trial);
+
+    for (size_t plane = 0; plane < 3; plane++) {
+      auto ref = RefNearest(trk_vv, plane, pos_v);
+      auto got = proj.Nearest(plane, pos_v);
+      check(got.found == ref.found, "Nearest found", trial);
+      if (ref.found && got.found) {
+	if (check.Failed(got.dist == ref.dist && got.track == ref.track &&
+			 got.point == ref.point && got.hit == ref.hit &&
+			 got.x == ref.x && got.z == ref.z))
+	  std::cerr << "FAIL (" << trial << "): Nearest plane " << plane
+		    << " got (" << got.track << "," << got.point << "," << got.hit << ") " << got.dist
+		    << " expected (" << ref.track << "," << ref.point << "," << ref.hit << ") " << ref.dist
+		    << std::endl;
+      }
+
+      std::vector<size_t> within_v;
+      for (double radius : { 0., 0.5, 1., 3., 10., 40. }) {
+	proj.TracksWithin(plane, pos_v, radius, within_v);
+	check(within_v == RefTracksWithin(trk_vv, plane, pos_v, radius), "TracksWithin", trial);
+      }
+    }
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(49979687);
+  std::uniform_int_distribution<size_t> ntrk(0, 12), nhit(0, 30);
+
+  // continuous and lattice coordinates; on the lattice many distances tie
+  // exactly and many points sit on the TracksWithin radius
+  for (size_t trial = 0; trial < 3000; trial++) {
+    double pitch = (trial % 2) ? 0.5 : 0.;
+    auto trk_vv = RandomTracks(rng, ntrk(rng), pitch);
+    auto pos_v  = RandomHits(rng, nhit(rng), pitch);
+    CheckEvent(trk_vv, pos_v, trial);
+  }
+
+  // every point on one spot: a single-cell grid, all distances tied
+  Tracks_t same_vv(4, std::vector<ProjectedPoint_t>(5, ProjectedPoint_t{ { 10., 20., 30. }, 5., 30. }));
+  CheckEvent(same_vv, { { 12., 5. }, { 8., 5. }, { 10., 7. }, { -1.e15, 5. } }, 0);
+
+  // no tracks, only empty tracks, only non-finite points, and no hits
+  CheckEvent(Tracks_t(), { { 1., 1. } }, 0);
+  CheckEvent(Tracks_t(3), { { 1., 1. } }, 0);
+  CheckEvent(Tracks_t(2, std::vector<ProjectedPoint_t>(3, ProjectedPoint_t{ { kNaN, kNaN, kNaN }, kNaN, 0. })),
+	     { { 1., 1. } }, 0);
+  CheckEvent(RandomTracks(rng, 5, 0.), {}, 0);
+
+  return check.Report();
+}
@@ -0,0 +1,47 @@
+#! /bin/bash
+
+# Runs gammacorrelation twice on the same events, with ParallelSpacePoints
+# false and true, and checks that the two TFileService files hold the same
+# trees entry by entry.
+#
+# The input is a saved art file with the gaushit, gaushitproximity, gamma3d,
+# pandora and generator products, given in UBRECO_GAMMACORRELATION_INPUT
+# (UBRECO_GAMMACORRELATION_NEVENTS events are read, 5 by default). No such
+# file is part of the repository, so without one the test reports itself as
+# skipped.
+
+input=${UBRECO_GAMMACORRELATION_INPUT}
+nevents=${UBRECO_GAMMACORRELATION_NEVENTS:-5}
+
+if [ -z "$input" -o ! -r "$input" ]; then
+  echo "UBRECO_GAMMACORRELATION_INPUT is not a readable file, skipping."
+  exit 247
+fi
+
+for mode in serial parallel
+do
+  echo "Running gammacorrelation_${mode}.fcl on ${input}"
+
+  lar -c ./gammacorrelation_${mode}.fcl -s $input -n $nevents > ${mode}.lar.out 2> ${mode}.lar.err
+  stat=$?
+  if [ $stat -ne 0 ]; then
+    echo "lar failed for ${mode} with status ${stat}, see ${mode}.lar.err."
+    exit 1
+  fi
+
+  # Drop the line where root echoes the macro call, which names the file.
+  root -l -b -q "gammacorrelation_dump.C(\"gammacorrelation_${mode}_hist.root\")" \
+    | grep -v '^Processing' > ${mode}.dump
+  if ! grep -q '^tree ' ${mode}.dump; then
+    echo "No gammacorrelation trees found in gammacorrelation_${mode}_hist.root."
+    exit 1
+  fi
+done
+
+if ! diff -q serial.dump parallel.dump > /dev/null; then
+  echo "Trees differ between ParallelSpacePoints false and true:"
+  diff serial.dump parallel.dump | head -40
+  exit 1
+fi
+
+echo "Trees are identical."
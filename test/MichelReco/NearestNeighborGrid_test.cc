@@ -0,0 +1,95 @@
+// Checks michel::NearestNeighborGrid, which MichelReco's hit ordering,
+// HitIndex2D and HitCosmicTag's ClassicHitOrderer all use, against a scan
+// over every point: Near() must return each remaining point at most once, in
+// increasing order, and every remaining point within the requested distance.
+// Points are placed on both sides of the cell boundaries at 0, where negative
+// and positive cell indices meet.
+
+#include "ubreco/MichelReco/Fmwk/NearestNeighborGrid.h"
+#include "test/TestCheck.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+  ubtest::Checker check;
+
+  void check_query(const michel::NearestNeighborGrid& grid,
+		   const std::vector<double>& x, const std::vector<double>& y,
+		   const std::vector<bool>& alive,
+		   double x0, double y0, double r, size_t trial)
+  {
+    std::vector<size_t> cand;
+    bool all = grid.Near(x0,y0,r,cand);
+
+    for(size_t k=1; k<cand.size(); ++k)
+      check(cand[k-1] < cand[k], "candidates not strictly increasing (duplicate point)", trial);
+
+    std::vector<bool> found(x.size(),false);
+    for(auto const& i : cand) {
+      check(i < x.size() && alive[i], "removed or unknown point returned", trial);
+      if(i < x.size()) found[i] = true;
+    }
+
+    size_t n_alive = 0;
+    for(size_t i=0; i<x.size(); ++i) {
+      if(!alive[i]) continue;
+      ++n_alive;
+      if(std::abs(x[i]-x0) <= r && std::abs(y[i]-y0) <= r)
+	check(found[i], "point within distance missing", trial);
+    }
+    if(all) check(cand.size() == n_alive, "'all' returned without every remaining point", trial);
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(7919);
+
+  // the four cells around the origin, one point in each corner
+  {
+    std::vector<double> x = { -0.5,  0.5, -0.5,  0.5 };
+    std::vector<double> y = { -0.5, -0.5,  0.5,  0.5 };
+    std::vector<bool> alive(x.size(),true);
+    michel::NearestNeighborGrid grid(x,y,1.);
+    check_query(grid,x,y,alive,0.,0.,0.25,0);
+    for(double x0 = -3.; x0 <= 3.; x0 += 0.5)
+      for(double y0 = -3.; y0 <= 3.; y0 += 0.5)
+	check_query(grid,x,y,alive,x0,y0,0.5,0);
+  }
+
+  // random clusters straddling the origin, queried as points are removed
+  for(size_t trial=1; trial<=500; ++trial) {
+    double cell = std::uniform_real_distribution<double>(0.1,5.)(rng);
+    double half = std::uniform_real_distribution<double>(0.5,20.)(rng) * cell;
+    std::uniform_real_distribution<double> coord(-half,half);
+    size_t n = std::uniform_int_distribution<size_t>(1,200)(rng);
+
+    std::vector<double> x(n), y(n);
+    for(size_t i=0; i<n; ++i) {
+      x[i] = coord(rng);
+      y[i] = coord(rng);
+      // some points exactly on cell boundaries, including 0 and -cell
+      if(i%7==0) x[i] = std::round(x[i]/cell)*cell;
+      if(i%11==0) y[i] = std::round(y[i]/cell)*cell;
+    }
+
+    std::vector<bool> alive(n,true);
+    michel::NearestNeighborGrid grid(x,y,cell);
+    std::uniform_int_distribution<size_t> pick(0,n-1);
+    while(grid.NRemaining()) {
+      double r = std::uniform_real_distribution<double>(0.,2.)(rng) * cell;
+      check_query(grid,x,y,alive,coord(rng),coord(rng),r,trial);
+      size_t i = pick(rng);
+      check_query(grid,x,y,alive,x[i],y[i],r,trial);
+      grid.Remove(i);
+      alive[i] = false;
+    }
+  }
+
+  return check.Report();
+}
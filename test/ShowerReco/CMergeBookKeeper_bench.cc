@@ -0,0 +1,301 @@
+// Benchmark of clusmtool::CMergeBookKeeper against the bookkeeping it
+// replaced (an index vector plus a dense triangular prohibit matrix, both
+// rewritten on every merge). Both run the same fixed-seed sequence of
+// prohibits, MergeAllowed queries and merges on N clusters, the way
+// CMergeManager drives them; every MergeAllowed answer and the final
+// PassResult must agree. Timings are printed for each N.
+
+#include "ubreco/ShowerReco/ClusterMerging/CMToolBase/CMergeBookKeeper.h"
+#include "test/TestCheck.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace clusmtool {
+
+  // the pre-union-find CMergeBookKeeper, kept here as the reference
+  class LegacyBookKeeper : public std::vector<unsigned short> {
+  public:
+    LegacyBookKeeper(unsigned short nclusters=0) { Reset(nclusters); }
+    void Reset(unsigned short nclusters=0);
+    void ProhibitMerge(unsigned short index1, unsigned short index2);
+    bool MergeAllowed(unsigned short index1, unsigned short index2);
+    void Merge(unsigned short index1, unsigned short index2);
+    void PassResult(std::vector<std::vector<unsigned short> > &result) const;
+  protected:
+    std::vector<std::vector<bool> > _prohibit_merge;
+    size_t _out_cluster_count;
+  };
+
+  void LegacyBookKeeper::Reset(unsigned short nclusters)
+  {
+    _prohibit_merge.clear();
+    _prohibit_merge.reserve(nclusters);
+    std::vector<unsigned short>::clear();
+    std::vector<unsigned short>::reserve(nclusters);
+
+    for(size_t i=0; i<nclusters; ++i) {
+      this->push_back(i);
+      _prohibit_merge.push_back(std::vector<bool>(nclusters-i,false));
+    }
+    _out_cluster_count = nclusters;
+    
+  }
+
+  void LegacyBookKeeper::ProhibitMerge(unsigned short index1, unsigned short index2)
+  {
+    if(index1 == index2)
+
+      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
+
+    if( index1 >= this->size() || index2 >= this->size() )
+
+      throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
+
+    auto out_index1 = this->at(index1);
+    auto out_index2 = this->at(index2);
+
+    if(out_index1 == out_index2)
+      throw CMTException(Form("Cluster %d and %d already merged!",index1,index2));    
+
+    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
+
+    _prohibit_merge.at(out_index1).at(out_index2-out_index1) = true;
+
+  }
+
+  bool LegacyBookKeeper::MergeAllowed(unsigned short index1,
+				 unsigned short index2)
+  {
+
+    if(index1 == index2)
+
+      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
+
+    if( index1 >= this->size() || index2 >= this->size() )
+
+      throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
+
+    auto out_index1 = this->at(index1);
+    auto out_index2 = this->at(index2);
+
+    if(out_index1 == out_index2) return true;
+
+    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
+
+    return !(_prohibit_merge.at(out_index1).at(out_index2-out_index1));
+    
+  }
+
+  void LegacyBookKeeper::Merge(unsigned short index1, unsigned short index2)
+  {
+
+    if(index1 == index2)
+
+      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
+
+    if( index1 >= this->size() || index2 >= this->size() )
+
+      throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
+
+    auto out_index1 = this->at(index1);
+    auto out_index2 = this->at(index2);
+
+    if(out_index1 == out_index2) return;
+
+    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
+
+    if(_prohibit_merge.at(out_index1).at(out_index2-out_index1))
+      
+      throw CMTException(Form("Clusters (%d,%d) correspond to output (%d,%d) which is prohibited to merge",
+				   index1,index2,
+				   out_index1,out_index2));
+
+    //
+    // Merge cluster indexes
+    //
+    for(auto &v : (*this)) {
+
+      if( v == out_index1 || v == out_index2 )
+	v = out_index1;
+      else if( v > out_index2 )
+	v -= 1;
+    }
+
+    //
+    // Merge prohibit rule
+    //
+    // (1) handle index < out_index1
+    for(size_t index=0; index < out_index1; ++index) {
+      
+      size_t tmp_out_index1 = out_index1 - index;
+      size_t tmp_out_index2 = out_index2 - index;
+
+      _prohibit_merge.at(index).at(tmp_out_index1) = ( _prohibit_merge.at(index).at(tmp_out_index1)
+						       ||
+						       _prohibit_merge.at(index).at(tmp_out_index2)
+						       );
+      
+      for(size_t in_index=tmp_out_index2; 
+	  in_index < (_out_cluster_count - index - 1);
+	  ++in_index) {
+
+	_prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index).at(in_index+1);
+      }
+
+      _prohibit_merge.at(index).at(_out_cluster_count - index - 1) = false;
+
+    }
+
+    // (2) handle index == out_index1
+    for(size_t in_index = 1; 
+	in_index < (_out_cluster_count - out_index1 - 1);
+	++in_index) {
+      if( (in_index + out_index1) < out_index2 ) {
+	_prohibit_merge.at(out_index1).at(in_index) = ( _prohibit_merge.at(out_index1).at(in_index)
+							||
+							_prohibit_merge.at(in_index + out_index1).at(out_index2 - (in_index+out_index1))
+							);
+      }
+      else {
+	_prohibit_merge.at(out_index1).at(in_index) = ( _prohibit_merge.at(out_index1).at(in_index+1)
+							||
+							_prohibit_merge.at(out_index2).at(in_index+1+out_index1-out_index2)
+							);
+	
+      }
+    }
+    _prohibit_merge.at(out_index1).at(_out_cluster_count - out_index1 - 1) = false;
+
+    // (3) handle out_index1 < index < out_index2
+    for(size_t index = out_index1+1; 
+	index < out_index2;
+	++index){
+      for(size_t in_index = (out_index2 - index);
+	  in_index < (_out_cluster_count - index - 1);
+	  ++in_index)
+
+	_prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index).at(in_index+1);
+      
+      _prohibit_merge.at(index).at(_out_cluster_count - index - 1) = false;
+    }
+    // (4) handle out_index2 <= index
+    for(size_t index = out_index2;
+	index < (_out_cluster_count - 1);
+	++index) {
+      
+      for(size_t in_index = 0;
+	  in_index < _prohibit_merge.at(index).size();
+	  ++in_index)
+
+	if(in_index < _prohibit_merge.at(index+1).size())
+	  _prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index+1).at(in_index);
+
+	else
+	  _prohibit_merge.at(index).at(in_index) = false;
+
+    }
+
+    _out_cluster_count -=1;
+
+  }
+
+  void LegacyBookKeeper::PassResult(std::vector<std::vector<unsigned short> > &result) const
+  {
+
+    result.clear();
+    result.resize(_out_cluster_count, std::vector<unsigned short>());
+
+    for(size_t i=0; i<this->size(); ++i)
+      result.at(this->at(i)).push_back(i);
+  }
+
+}
+
+namespace {
+
+  struct Op_t {
+    enum Kind_t { kProhibit, kMerge } kind;
+    unsigned int a, b;
+  };
+
+  // random prohibits first, then random pairs merged when allowed
+  std::vector<Op_t> MakeOps(unsigned int n, std::mt19937& rng)
+  {
+    std::vector<Op_t> ops;
+    std::uniform_int_distribution<unsigned int> pick(0,n-1);
+    for(size_t k=0; k<2*(size_t)n; ++k) {
+      unsigned int a = pick(rng), b = pick(rng);
+      if(a!=b) ops.push_back({Op_t::kProhibit,a,b});
+    }
+    for(size_t k=0; k<20*(size_t)n; ++k) {
+      unsigned int a = pick(rng), b = pick(rng);
+      if(a!=b) ops.push_back({Op_t::kMerge,a,b});
+    }
+    return ops;
+  }
+
+  bool IsMerged(clusmtool::CMergeBookKeeper& bk, unsigned int a, unsigned int b)
+  { return bk.IsMerged(a,b); }
+
+  bool IsMerged(clusmtool::LegacyBookKeeper& bk, unsigned int a, unsigned int b)
+  { return bk.at(a) == bk.at(b); }
+
+  // replays ops, skipping prohibits between already merged clusters and
+  // merges that are not allowed; returns the MergeAllowed answers
+  template <class BookKeeper>
+  std::vector<bool> Run(BookKeeper& bk, const std::vector<Op_t>& ops, double& seconds)
+  {
+    std::vector<bool> allowed;
+    allowed.reserve(ops.size());
+    auto start = std::chrono::steady_clock::now();
+    for(auto const& op : ops) {
+      bool ok = bk.MergeAllowed(op.a,op.b);
+      allowed.push_back(ok);
+      if(op.kind == Op_t::kProhibit) {
+	if(ok && !IsMerged(bk,op.a,op.b)) bk.ProhibitMerge(op.a,op.b);
+      }
+      else if(ok) bk.Merge(op.a,op.b);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return allowed;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(104729);
+  ubtest::Checker check;
+
+  std::cout << "      N      legacy [s]   union-find [s]" << std::endl;
+  for(unsigned int n : {100u, 300u, 1000u, 2000u}) {
+    auto ops = MakeOps(n,rng);
+
+    double t_old = 0., t_new = 0.;
+    clusmtool::LegacyBookKeeper old_bk(n);
+    clusmtool::CMergeBookKeeper new_bk(n);
+    auto old_allowed = Run(old_bk,ops,t_old);
+    auto new_allowed = Run(new_bk,ops,t_new);
+
+    std::vector<std::vector<unsigned short> > old_res;
+    std::vector<std::vector<unsigned int> > new_res;
+    old_bk.PassResult(old_res);
+    new_bk.PassResult(new_res);
+
+    bool same = (old_allowed == new_allowed) && (old_res.size() == new_res.size());
+    for(size_t i=0; same && i<old_res.size(); ++i)
+      same = std::vector<unsigned int>(old_res[i].begin(),old_res[i].end()) == new_res[i];
+    check(same, "results differ from the legacy bookkeeper (case = N)", n);
+
+    std::cout << "  " << std::setw(5) << n
+	      << "  " << std::setw(14) << t_old
+	      << "  " << std::setw(15) << t_new << std::endl;
+  }
+
+  return check.Report();
+}
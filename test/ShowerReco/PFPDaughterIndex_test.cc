@@ -0,0 +1,80 @@
+// Checks gammacatcher::PFPDaughterIndex, which CosmicFilter uses to collect
+// the delta-ray daughters of each muon PFParticle, against the scan over
+// every (PFParticle, daughter ID) pair it replaced. Events have
+// non-contiguous and repeated Self() IDs, daughter IDs that match nothing
+// or several PFParticles, and repeated daughter IDs.
+
+#include "ubreco/ShowerReco/ProximityClustering/Algorithms/PFPDaughterIndex.h"
+#include "test/TestCheck.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // the CosmicFilter loop before the Self() lookup
+  std::vector<size_t> ScanDaughters(const std::vector<recob::PFParticle>& pfp_v,
+				    const recob::PFParticle& pfp, int pdg)
+  {
+    std::vector<size_t> idx_v;
+    for (size_t pp=0; pp < pfp_v.size(); pp++)
+      for (auto const& daughterID : pfp.Daughters())
+	if ( (pfp_v[pp].Self() == daughterID) && (pfp_v[pp].PdgCode() == pdg) )
+	  idx_v.push_back(pp);
+    return idx_v;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(15485863);
+  ubtest::Checker check;
+
+  // fixed case: IDs 100, 7, 42, 7 (repeated), 3000 in that order
+  {
+    std::vector<recob::PFParticle> pfp_v;
+    pfp_v.emplace_back(13, 100, recob::PFParticle::kPFParticlePrimary, std::vector<size_t>{42, 7, 5, 42});
+    pfp_v.emplace_back(11,   7, 100, std::vector<size_t>{});
+    pfp_v.emplace_back(11,  42, 100, std::vector<size_t>{});
+    pfp_v.emplace_back(11,   7, 100, std::vector<size_t>{});
+    pfp_v.emplace_back(13,3000, recob::PFParticle::kPFParticlePrimary, std::vector<size_t>{});
+
+    gammacatcher::PFPDaughterIndex index;
+    index.Build(pfp_v);
+    std::vector<size_t> idx_v;
+    index.Daughters(pfp_v[0], 11, idx_v);
+    const std::vector<size_t> expected{1, 2, 2, 3};
+    check(idx_v == expected && idx_v == ScanDaughters(pfp_v, pfp_v[0], 11), "fixed event", 0);
+  }
+
+  for (size_t trial=0; trial < 2000; trial++) {
+    size_t n = std::uniform_int_distribution<size_t>(0, 60)(rng);
+    // sparse IDs, with some repeats
+    std::uniform_int_distribution<size_t> id(0, 3*n + 5);
+    std::uniform_int_distribution<int> pdg_pick(0, 2);
+    std::uniform_int_distribution<size_t> ndaughters(0, 6);
+    const int pdgs[3] = {11, 13, 22};
+
+    std::vector<recob::PFParticle> pfp_v;
+    for (size_t p=0; p < n; p++) {
+      std::vector<size_t> daughters(ndaughters(rng));
+      for (auto& d : daughters) d = id(rng);
+      pfp_v.emplace_back(pdgs[pdg_pick(rng)], id(rng), recob::PFParticle::kPFParticlePrimary, daughters);
+    }
+
+    gammacatcher::PFPDaughterIndex index;
+    index.Build(pfp_v);
+    std::vector<size_t> idx_v;
+    for (auto const& pfp : pfp_v) {
+      for (int pdg : pdgs) {
+	index.Daughters(pfp, pdg, idx_v);
+	check(idx_v == ScanDaughters(pfp_v, pfp, pdg), "daughters differ from the scan", trial);
+      }
+    }
+  }
+
+  return check.Report();
+}
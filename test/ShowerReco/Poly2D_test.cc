@@ -0,0 +1,183 @@
+// Checks twodimtools::Poly2D overlap and containment tests, which reject
+// pairs by bounding box before the edge loops, against the plain all-pairs
+// crossing tests they replaced, on fixed-seed random polygons. Results must
+// agree exactly. The intersection polygon of each pair must have the
+// bounding box of its own vertices, and its point tests must agree too.
+// Also times both on shower-cone / hit-hull pairs like the ones PhotonMerge
+// compares.
+
+#include "ubreco/ShowerReco/TwoDimTools/Poly2D.h"
+#include "test/TestCheck.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using Point_t = std::pair<float,float>;
+  using Vertices_t = std::vector<Point_t>;
+
+  //-------------------------------------------------------------------
+  // reference: the tests as they were before the bounding-box rejection
+
+  bool RefClockwise(double Ax, double Ay, double Bx, double By, double Cx, double Cy)
+  { return (Cy - Ay) * (Bx - Ax) > (By - Ay) * (Cx - Ax); }
+
+  bool RefSegmentOverlap(double Ax, double Ay, double Bx, double By,
+			 double Cx, double Cy, double Dx, double Dy)
+  {
+    return ( (RefClockwise(Ax, Ay, Cx, Cy, Dx, Dy) != RefClockwise(Bx, By, Cx, Cy, Dx, Dy))
+	     and (RefClockwise(Ax, Ay, Bx, By, Cx, Cy) != RefClockwise(Ax, Ay, Bx, By, Dx, Dy)) );
+  }
+
+  // vertex p, with p == size() wrapping to the first one, as Poly2D::Point
+  const Point_t& RefPoint(const Vertices_t& v, size_t p)
+  { return (p < v.size()) ? v[p] : v[0]; }
+
+  bool RefPointInside(const Vertices_t& v, const Point_t& point)
+  {
+    int intersections = 0;
+    for (size_t i = 0; i < v.size(); i++) {
+      if ( RefSegmentOverlap( RefPoint(v,i).first, RefPoint(v,i).second,
+			      RefPoint(v,i+1).first, RefPoint(v,i+1).second,
+			      10000.0, 10000.0,
+			      point.first, point.second) )
+	intersections += 1;
+    }
+    return (intersections % 2) != 0;
+  }
+
+  bool RefOverlap(const Vertices_t& v1, const Vertices_t& v2)
+  {
+    for (auto const& p : v2)
+      if (RefPointInside(v1,p)) return true;
+    return false;
+  }
+
+  bool RefContained(const Vertices_t& v1, const Vertices_t& v2)
+  {
+    for (auto const& p : v2)
+      if (!RefPointInside(v1,p)) return false;
+    return true;
+  }
+
+  //-------------------------------------------------------------------
+
+  ubtest::Checker check;
+
+  // random polygon of n vertices around (cx,cy), optionally snapped to a
+  // wire/tick-like pitch so that vertices and edges line up exactly
+  Vertices_t RandomPolygon(std::mt19937& rng, size_t n, float cx, float cy, float size, float pitch)
+  {
+    std::uniform_real_distribution<float> d(-size, size);
+    Vertices_t v(n);
+    for (auto& p : v) {
+      p.first  = cx + d(rng);
+      p.second = cy + d(rng);
+      if (pitch > 0) {
+	p.first  = std::round(p.first  / pitch) * pitch;
+	p.second = std::round(p.second / pitch) * pitch;
+      }
+    }
+    return v;
+  }
+
+  void CheckPair(const Vertices_t& v1, const Vertices_t& v2, std::mt19937& rng, size_t trial)
+  {
+    twodimtools::Poly2D p1(v1), p2(v2);
+
+    check(p1.Overlap(p2)   == RefOverlap(v1,v2),   "Overlap(1,2)",   trial);
+    check(p2.Overlap(p1)   == RefOverlap(v2,v1),   "Overlap(2,1)",   trial);
+    check(p1.Contained(p2) == RefContained(v1,v2), "Contained(1,2)", trial);
+    check(p2.Contained(p1) == RefContained(v2,v1), "Contained(2,1)", trial);
+
+    // vertices of either polygon, and random points around them
+    std::uniform_real_distribution<float> d(-30., 30.);
+    for (auto const& p : v2)
+      check(p1.PointInside(p) == RefPointInside(v1,p), "PointInside(vertex)", trial);
+    for (size_t k = 0; k < 10; k++) {
+      Point_t p(v1[0].first + d(rng), v1[0].second + d(rng));
+      check(p1.PointInside(p) == RefPointInside(v1,p), "PointInside(random)", trial);
+    }
+
+    // intersection polygon: its box comes from the vertices it collected
+    // (inverted when it has none), and its point tests rely on that box
+    twodimtools::Poly2D pi(p1,p2);
+    Vertices_t vi;
+    for (unsigned int i = 0; i < pi.Size(); i++) vi.push_back(pi.Point(i));
+    float xmin, xmax, ymin, ymax;
+    pi.Bounds(xmin, xmax, ymin, ymax);
+    if (vi.empty())
+      check(xmin > xmax && ymin > ymax, "intersection Bounds (empty)", trial);
+    else {
+      auto x = std::minmax_element(vi.begin(), vi.end(),
+				   [](const Point_t& a, const Point_t& b) { return a.first < b.first; });
+      auto y = std::minmax_element(vi.begin(), vi.end(),
+				   [](const Point_t& a, const Point_t& b) { return a.second < b.second; });
+      check(xmin == x.first->first  && xmax == x.second->first &&
+	    ymin == y.first->second && ymax == y.second->second, "intersection Bounds", trial);
+      for (auto const& p : vi)
+	check(pi.PointInside(p) == RefPointInside(vi,p), "intersection PointInside(vertex)", trial);
+      for (size_t k = 0; k < 10; k++) {
+	Point_t p(vi[0].first + d(rng), vi[0].second + d(rng));
+	check(pi.PointInside(p) == RefPointInside(vi,p), "intersection PointInside(random)", trial);
+      }
+      check(p1.Overlap(pi) == RefOverlap(v1,vi), "Overlap(1,intersection)", trial);
+    }
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng(1299709);
+  std::uniform_int_distribution<size_t> nvtx(3, 8);
+  std::uniform_real_distribution<float> offset(-40., 40.);
+
+  // agreement, with continuous and with pitch-snapped coordinates
+  for (size_t trial = 0; trial < 40000; trial++) {
+    float pitch = (trial % 2) ? 0.3f : 0.f;
+    auto v1 = RandomPolygon(rng, nvtx(rng), 0., 0., 20., pitch);
+    auto v2 = RandomPolygon(rng, nvtx(rng), offset(rng), offset(rng), 20., pitch);
+    CheckPair(v1, v2, rng, trial);
+    // a polygon against a shrunken copy of itself, to exercise containment
+    Vertices_t v3(v1);
+    for (auto& p : v3) { p.first *= 0.5f; p.second *= 0.5f; }
+    CheckPair(v1, v3, rng, trial);
+  }
+
+  // timing: 3-vertex shower cones against 3-8 vertex hit hulls spread over
+  // a plane, most of them far from any given cone
+  const size_t ncones = 200, nhulls = 500;
+  std::uniform_real_distribution<float> pos(0., 1000.);
+  std::vector<Vertices_t> cones, hulls;
+  for (size_t i = 0; i < ncones; i++) cones.push_back(RandomPolygon(rng, 3, pos(rng), pos(rng), 60., 0.));
+  for (size_t i = 0; i < nhulls; i++) hulls.push_back(RandomPolygon(rng, nvtx(rng), pos(rng), pos(rng), 10., 0.));
+  std::vector<twodimtools::Poly2D> cone_p(cones.begin(), cones.end()), hull_p(hulls.begin(), hulls.end());
+
+  size_t n_ref = 0, n_new = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto const& c : cones)
+    for (auto const& h : hulls)
+      n_ref += RefOverlap(c,h) + RefContained(c,h);
+  auto t1 = std::chrono::steady_clock::now();
+  for (auto const& c : cone_p)
+    for (auto const& h : hull_p)
+      n_new += c.Overlap(h) + c.Contained(h);
+  auto t2 = std::chrono::steady_clock::now();
+
+  check(n_ref == n_new, "timing sample counts", 0);
+  const double npairs = ncones * nhulls;
+  std::cout << "Overlap+Contained per pair: all-pairs "
+	    << std::chrono::duration<double, std::nano>(t1 - t0).count() / npairs << " ns, "
+	    << "bounding box "
+	    << std::chrono::duration<double, std::nano>(t2 - t1).count() / npairs << " ns" << std::endl;
+
+  return check.Report();
+}
@@ -0,0 +1,53 @@
+// Failure bookkeeping shared by the plain-main cet_tests under test/: each
+// check that fails is counted, the first few are printed, and Report() gives
+// the exit code for main.
+
+#ifndef UBRECO_TEST_TESTCHECK_H
+#define UBRECO_TEST_TESTCHECK_H
+
+#include <cstddef>
+#include <iostream>
+
+namespace ubtest {
+
+  class Checker {
+
+  public:
+
+    explicit Checker(size_t max_print = 20) : _max_print(max_print) {}
+
+    /// Counts a failure if ok is false. Returns true if that failure should
+    /// be printed, so that callers can print their own details
+    bool Failed(bool ok)
+    {
+      if (ok) return false;
+      return ++_nfail <= _max_print;
+    }
+
+    /// Counts a failure if ok is false, printing what failed in which case
+    void operator()(bool ok, const char* what, size_t which)
+    {
+      if (Failed(ok))
+	std::cerr << "FAIL (" << which << "): " << what << std::endl;
+    }
+
+    size_t Failures() const { return _nfail; }
+
+    /// 0 if every check passed; otherwise prints the failure count, returns 1
+    int Report() const
+    {
+      if (!_nfail) return 0;
+      std::cerr << _nfail << " failures" << std::endl;
+      return 1;
+    }
+
+  private:
+
+    size_t _max_print;
+    size_t _nfail = 0;
+
+  };
+
+}
+
+#endif
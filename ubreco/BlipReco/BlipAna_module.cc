@@ -23,6 +23,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib_except/exception.h"
 
 // LArSoft includes
 #include "lardataobj/RecoBase/Track.h"
@@ -47,6 +48,8 @@
 #include <algorithm>
 #include <typeinfo>
 #include <cmath>
+#include <functional>
+#include <memory>
 
 // ROOT includes
 #include "TFile.h"
@@ -54,6 +57,18 @@
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TF1.h"
+#include "RVersion.h"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,32,0)
+#define BLIPANA_HAS_RNTUPLE
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleWriter.hxx"
+// RNTupleModel/RNTupleWriter left ROOT::Experimental in 6.36
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+namespace rntuple = ROOT;
+#else
+namespace rntuple = ROOT::Experimental;
+#endif
+#endif
 
 // Helper templates for initializing arrays
 namespace{  
@@ -66,6 +81,13 @@ namespace{
   template <typename CONT, typename V>
     inline void FillWith(CONT& data, const V& value)
     { FillWith(std::begin(data), std::end(data), value); }
+
+  // ROOT leaflist type codes
+  template <typename T> const char* LeafType();
+  template <> const char* LeafType<int>()           { return "I"; }
+  template <> const char* LeafType<unsigned int>()  { return "i"; }
+  template <> const char* LeafType<float>()         { return "F"; }
+  template <> const char* LeafType<bool>()          { return "O"; }
 }
 
 
@@ -88,10 +110,22 @@ class BlipAnaTreeDataStruct
   public:
 
   // --- TTrees
-  TTree* evtTree;
+  TTree* evtTree            = nullptr;
+
+  // --- Columnar output ---
+  bool  columnar            = false;
+  std::vector<std::function<void()>>  colFillers;
+  std::vector<std::shared_ptr<void>>  colStore;
+#ifdef BLIPANA_HAS_RNTUPLE
+  std::unique_ptr<rntuple::RNTupleModel>   ntModel;
+  std::unique_ptr<rntuple::RNTupleWriter>  ntWriter;
+#endif
 
   // --- Configurations and switches ---
   std::string treeName      = "anatree";
+  std::string outputFormat  = "TTree";    // "TTree" or "RNTuple" (columnar)
+  std::vector<std::string> outputColumns; // array columns to write (empty = all)
+  std::vector<std::string> knownColumns;  // array columns offered by MakeTree
   bool  saveTruthInfo       = true;
   bool  saveTrkInfo         = true;
   bool  saveHitInfo         = true;
@@ -420,164 +454,270 @@ class BlipAnaTreeDataStruct
     if(nparticles) part_process.assign(nparticles,"");
   }
       
+  // === Output booking helpers ===
+  // Array columns are tied to the counter that sets their per-event length.
+  // In the TTree format they become fixed-size C-array branches; in the
+  // columnar format they become variable-length collections. Only the array
+  // columns listed in 'outputColumns' are booked (all if the list is empty),
+  // while event-level scalars and counters are always written.
+  struct Counter {
+    const char* name;
+    int*        n;
+    int         max;
+  };
+
+  bool KeepColumn(const std::string& name) {
+    knownColumns.push_back(name);
+    if( outputColumns.empty() ) return true;
+    return std::find(outputColumns.begin(),outputColumns.end(),name) != outputColumns.end();
+  }
+
+  template<typename T> std::shared_ptr<T> MakeColumn(const std::string& name){
+#ifdef BLIPANA_HAS_RNTUPLE
+    return ntModel->MakeField<T>(name);
+#else
+    // no RNTuple in this ROOT build: fall back to std::vector branches
+    auto col = std::make_shared<T>();
+    colStore.push_back(col);
+    evtTree->Branch(name.c_str(), col.get());
+    return col;
+#endif
+  }
+
+  template<typename T> void AddScalar(const std::string& name, T* val){
+    if( columnar ) {
+      auto col = MakeColumn<T>(name);
+      colFillers.push_back([col,val]{ *col = *val; });
+    } else {
+      evtTree->Branch(name.c_str(), val, (name+"/"+LeafType<T>()).c_str());
+    }
+  }
+
+  template<typename T> void AddArray(const std::string& name, T* arr, const Counter& c){
+    if( !KeepColumn(name) ) return;
+    if( columnar ) {
+      auto col = MakeColumn<std::vector<T>>(name);
+      int* n = c.n; int max = c.max;
+      colFillers.push_back([col,arr,n,max]{ col->assign(arr, arr + std::min(std::max(*n,0),max)); });
+    } else {
+      evtTree->Branch(name.c_str(), arr, Form("%s[%s]/%s",name.c_str(),c.name,LeafType<T>()));
+    }
+  }
+
+  template<typename T> void AddObject(const std::string& name, T* obj){
+    if( !KeepColumn(name) ) return;
+    if( columnar ) {
+      auto col = MakeColumn<T>(name);
+      colFillers.push_back([col,obj]{ *col = *obj; });
+    } else {
+      evtTree->Branch(name.c_str(), obj);
+    }
+  }
+
   // === Function for initializing tree branches ===
   void MakeTree(){
     
     art::ServiceHandle<art::TFileService> tfs;
    
+    columnar = (outputFormat == "RNTuple");
+#ifdef BLIPANA_HAS_RNTUPLE
+    if( columnar )  ntModel = rntuple::RNTupleModel::Create();
+    else            evtTree = tfs->make<TTree>(treeName.c_str(),"analysis tree");
+#else
     evtTree = tfs->make<TTree>(treeName.c_str(),"analysis tree");
-    evtTree->Branch("event",&event,"event/I");
-    evtTree->Branch("run",&run,"run/I");
-    evtTree->Branch("subrun",&subrun,"subrun/I");
-    evtTree->Branch("timestamp",&timestamp,"timestamp/i");
-    //evtTree->Branch("timestamp_hr",&timestamp_hr,"timestamp_hr/F");
-    evtTree->Branch("lifetime",&lifetime,"lifetime/F");
-    evtTree->Branch("badchans",&badchans,"badchans/I");
-    evtTree->Branch("longtrks",&longtrks,"longtrks/I");
+#endif
+
+    const Counter cHits   {"nhits",       &nhits,       kMaxHits};
+    const Counter cTrks   {"ntrks",       &ntrks,       kMaxTrks};
+    const Counter cClusts {"nclusts",     &nclusts,     kMaxClusts};
+    const Counter cBlips  {"nblips",      &nblips,      kMaxBlips};
+    const Counter cParts  {"nparticles",  &nparticles,  kMaxG4};
+    const Counter cEdeps  {"nedeps",      &nedeps,      kMaxEDeps};
+
+    AddScalar("event", &event);
+    AddScalar("run", &run);
+    AddScalar("subrun", &subrun);
+    AddScalar("timestamp", &timestamp);
+    //AddScalar("timestamp_hr", &timestamp_hr);
+    AddScalar("lifetime", &lifetime);
+    AddScalar("badchans", &badchans);
+    AddScalar("longtrks", &longtrks);
       
     if( saveHitInfo ) {
-      evtTree->Branch("nhits",&nhits,"nhits/I");
-      //evtTree->Branch("hit_tpc",hit_tpc,"hit_tpc[nhits]/I"); 
-      evtTree->Branch("hit_plane",hit_plane,"hit_plane[nhits]/I"); 
-      evtTree->Branch("hit_wire",hit_wire,"hit_wire[nhits]/I"); 
-      evtTree->Branch("hit_peakT",hit_peakT,"hit_peakT[nhits]/F"); 
-      evtTree->Branch("hit_time",hit_time,"hit_time[nhits]/F"); 
-      evtTree->Branch("hit_rms",hit_rms,"hit_rms[nhits]/F"); 
-      evtTree->Branch("hit_amp",hit_amp,"hit_amp[nhits]/F"); 
-      evtTree->Branch("hit_area",hit_area,"hit_area[nhits]/F"); 
-      evtTree->Branch("hit_sumadc",hit_sumadc,"hit_sumadc[nhits]/F"); 
-      evtTree->Branch("hit_mult",hit_mult,"hit_mult[nhits]/I"); 
-      evtTree->Branch("hit_charge",hit_charge,"hit_charge[nhits]/F");
-      evtTree->Branch("hit_ismatch",hit_ismatch,"hit_ismatch[nhits]/I");
-      evtTree->Branch("hit_trkid",hit_trkid,"hit_trkid[nhits]/I"); 
+      AddScalar("nhits", &nhits);
+      //AddArray("hit_tpc", hit_tpc, cHits); 
+      AddArray("hit_plane", hit_plane, cHits); 
+      AddArray("hit_wire", hit_wire, cHits); 
+      AddArray("hit_peakT", hit_peakT, cHits); 
+      AddArray("hit_time", hit_time, cHits); 
+      AddArray("hit_rms", hit_rms, cHits); 
+      AddArray("hit_amp", hit_amp, cHits); 
+      AddArray("hit_area", hit_area, cHits); 
+      AddArray("hit_sumadc", hit_sumadc, cHits); 
+      AddArray("hit_mult", hit_mult, cHits); 
+      AddArray("hit_charge", hit_charge, cHits);
+      AddArray("hit_ismatch", hit_ismatch, cHits);
+      AddArray("hit_trkid", hit_trkid, cHits); 
       if( saveTruthInfo ) {
-      evtTree->Branch("hit_g4trkid",hit_g4trkid,"hit_g4trkid[nhits]/I");
-      evtTree->Branch("hit_g4frac",hit_g4frac,"hit_g4frac[nhits]/F"); 
-      evtTree->Branch("hit_g4energy",hit_g4energy,"hit_g4energy[nhits]/F"); 
-      evtTree->Branch("hit_g4charge",hit_g4charge,"hit_g4charge[nhits]/F"); 
+      AddArray("hit_g4trkid", hit_g4trkid, cHits);
+      AddArray("hit_g4frac", hit_g4frac, cHits); 
+      AddArray("hit_g4energy", hit_g4energy, cHits); 
+      AddArray("hit_g4charge", hit_g4charge, cHits); 
       }
-      evtTree->Branch("hit_clustid",hit_clustid,"hit_clustid[nhits]/I"); 
-      evtTree->Branch("hit_blipid",hit_blipid,"hit_blipid[nhits]/I");
-      evtTree->Branch("hit_gof",hit_gof,"hit_gof[nhits]/F");
+      AddArray("hit_clustid", hit_clustid, cHits); 
+      AddArray("hit_blipid", hit_blipid, cHits);
+      AddArray("hit_gof", hit_gof, cHits);
     }
  
     if( saveTrkInfo ) {
-      evtTree->Branch("ntrks",&ntrks,"ntrks/I");
-      evtTree->Branch("trk_id",trk_id,"trk_id[ntrks]/I");       
-      evtTree->Branch("trk_length",trk_length,"trk_length[ntrks]/F");
-      evtTree->Branch("trk_startx",trk_startx,"trk_startx[ntrks]/F");
-      evtTree->Branch("trk_starty",trk_starty,"trk_starty[ntrks]/F");
-      evtTree->Branch("trk_startz",trk_startz,"trk_startz[ntrks]/F");
-      evtTree->Branch("trk_endx",trk_endx,"trk_endx[ntrks]/F");
-      evtTree->Branch("trk_endy",trk_endy,"trk_endy[ntrks]/F");
-      evtTree->Branch("trk_endz",trk_endz,"trk_endz[ntrks]/F");
+      AddScalar("ntrks", &ntrks);
+      AddArray("trk_id", trk_id, cTrks);       
+      AddArray("trk_length", trk_length, cTrks);
+      AddArray("trk_startx", trk_startx, cTrks);
+      AddArray("trk_starty", trk_starty, cTrks);
+      AddArray("trk_startz", trk_startz, cTrks);
+      AddArray("trk_endx", trk_endx, cTrks);
+      AddArray("trk_endy", trk_endy, cTrks);
+      AddArray("trk_endz", trk_endz, cTrks);
     }
 
     if( saveClustInfo ) {
-      evtTree->Branch("nclusts",        &nclusts,       "nclusts/I");
-      //evtTree->Branch("clust_id",       clust_id,       "clust_id[nclusts]/I");
-      evtTree->Branch("clust_plane",    clust_plane,    "clust_plane[nclusts]/I");
-      //evtTree->Branch("clust_wire",     clust_wire,     "clust_wire[nclusts]/I");
-      evtTree->Branch("clust_nhits",    clust_nhits,    "clust_nhits[nclusts]/I");
-      evtTree->Branch("clust_nwires",   clust_nwires,   "clust_nwires[nclusts]/I");
-      //evtTree->Branch("clust_nticks",   clust_nticks,   "clust_nticks[nclusts]/I");
-      evtTree->Branch("clust_startwire",clust_startwire,"clust_startwire[nclusts]/I");
-      evtTree->Branch("clust_endwire",  clust_endwire,  "clust_endwire[nclusts]/I");
-      evtTree->Branch("clust_bydeadwire",   clust_bydeadwire,   "clust_bydeadwire[nclusts]/O");
-      evtTree->Branch("clust_time",     clust_time,     "clust_time[nclusts]/F");
-      evtTree->Branch("clust_timespan", clust_timespan, "clust_timespan[nclusts]/F");
-      //evtTree->Branch("clust_deadwiresep",   clust_deadwiresep,   "clust_deadwiresep[nclusts]/I");
-      //evtTree->Branch("clust_nnfhits",  clust_nnfhits,  "clust_nnfhits[nclusts]/I");
-      //evtTree->Branch("clust_pulsetrain",  clust_pulsetrain,  "clust_pulsetrain[nclusts]/O");
-      //evtTree->Branch("clust_starttime",clust_starttime,"clust_starttime[nclusts]/F");
-      //evtTree->Branch("clust_endtime",  clust_endtime,"clust_endtime[nclusts]/F");
-      evtTree->Branch("clust_charge",   clust_charge,   "clust_charge[nclusts]/I");
-      evtTree->Branch("clust_chargeErr",   clust_chargeErr,   "clust_chargeErr[nclusts]/I");
-      evtTree->Branch("clust_amp",      clust_amp,      "clust_amp[nclusts]/F");
-      //evtTree->Branch("clust_gof",      clust_gof,      "clust_gof[nclusts]/F");
-      //evtTree->Branch("clust_ratio",      clust_ratio,  "clust_ratio[nclusts]/F");
-      evtTree->Branch("clust_ismatch",  clust_ismatch,  "clust_ismatch[nclusts]/O");
-      evtTree->Branch("clust_touchtrk",  clust_touchtrk,  "clust_touchtrk[nclusts]/O");
-      if( saveTrkInfo ) evtTree->Branch("clust_touchtrkid",  clust_touchtrkid,  "clust_touchtrkid[nclusts]/I");
-      evtTree->Branch("clust_blipid",   clust_blipid,   "clust_blipid[nclusts]/I");
-      if( saveTruthInfo ) evtTree->Branch("clust_edepid",   clust_edepid,   "clust_edepid[nclusts]/I");
+      AddScalar("nclusts", &nclusts);
+      //AddArray("clust_id", clust_id, cClusts);
+      AddArray("clust_plane", clust_plane, cClusts);
+      //AddArray("clust_wire", clust_wire, cClusts);
+      AddArray("clust_nhits", clust_nhits, cClusts);
+      AddArray("clust_nwires", clust_nwires, cClusts);
+      //AddArray("clust_nticks", clust_nticks, cClusts);
+      AddArray("clust_startwire", clust_startwire, cClusts);
+      AddArray("clust_endwire", clust_endwire, cClusts);
+      AddArray("clust_bydeadwire", clust_bydeadwire, cClusts);
+      AddArray("clust_time", clust_time, cClusts);
+      AddArray("clust_timespan", clust_timespan, cClusts);
+      //AddArray("clust_deadwiresep", clust_deadwiresep, cClusts);
+      //AddArray("clust_nnfhits", clust_nnfhits, cClusts);
+      //AddArray("clust_pulsetrain", clust_pulsetrain, cClusts);
+      //AddArray("clust_starttime", clust_starttime, cClusts);
+      //AddArray("clust_endtime", clust_endtime, cClusts);
+      AddArray("clust_charge", clust_charge, cClusts);
+      AddArray("clust_chargeErr", clust_chargeErr, cClusts);
+      AddArray("clust_amp", clust_amp, cClusts);
+      //AddArray("clust_gof", clust_gof, cClusts);
+      //AddArray("clust_ratio", clust_ratio, cClusts);
+      AddArray("clust_ismatch", clust_ismatch, cClusts);
+      AddArray("clust_touchtrk", clust_touchtrk, cClusts);
+      if( saveTrkInfo ) AddArray("clust_touchtrkid", clust_touchtrkid, cClusts);
+      AddArray("clust_blipid", clust_blipid, cClusts);
+      if( saveTruthInfo ) AddArray("clust_edepid", clust_edepid, cClusts);
     }
 
-    evtTree->Branch("nblips",&nblips,"nblips/I");
-    evtTree->Branch("blip_nplanes",blip_nplanes,"blip_nplanes[nblips]/I");
-    evtTree->Branch("blip_x",blip_x,"blip_x[nblips]/F");
-    evtTree->Branch("blip_y",blip_y,"blip_y[nblips]/F");
-    evtTree->Branch("blip_z",blip_z,"blip_z[nblips]/F");
-    //evtTree->Branch("blip_sigmayz",blip_sigmayz,"blip_sigmayz[nblips]/F");
-    evtTree->Branch("blip_dx",blip_dx,"blip_dx[nblips]/F");
-    evtTree->Branch("blip_dyz",blip_dyz,"blip_dyz[nblips]/F");
-    evtTree->Branch("blip_size",blip_size,"blip_size[nblips]/F");
-    evtTree->Branch("blip_charge",blip_charge,"blip_charge[nblips]/I");
-    evtTree->Branch("blip_energy",blip_energy,"blip_energy[nblips]/F");
-    evtTree->Branch("blip_yzcorr",blip_yzcorr,"blip_yzcorr[nblips]/F");
-    //evtTree->Branch("blip_energyTrue",blip_energyTrue,"blip_energyTrue[nblips]/F");
-    evtTree->Branch("blip_incylinder",blip_incylinder,"blip_incylinder[nblips]/O");
-    evtTree->Branch("blip_proxtrkdist",blip_proxtrkdist,"blip_proxtrkdist[nblips]/F");
-    evtTree->Branch("blip_touchtrk",blip_touchtrk,"blip_touchtrk[nblips]/O");
+    AddScalar("nblips", &nblips);
+    AddArray("blip_nplanes", blip_nplanes, cBlips);
+    AddArray("blip_x", blip_x, cBlips);
+    AddArray("blip_y", blip_y, cBlips);
+    AddArray("blip_z", blip_z, cBlips);
+    //AddArray("blip_sigmayz", blip_sigmayz, cBlips);
+    AddArray("blip_dx", blip_dx, cBlips);
+    AddArray("blip_dyz", blip_dyz, cBlips);
+    AddArray("blip_size", blip_size, cBlips);
+    AddArray("blip_charge", blip_charge, cBlips);
+    AddArray("blip_energy", blip_energy, cBlips);
+    AddArray("blip_yzcorr", blip_yzcorr, cBlips);
+    //AddArray("blip_energyTrue", blip_energyTrue, cBlips);
+    AddArray("blip_incylinder", blip_incylinder, cBlips);
+    AddArray("blip_proxtrkdist", blip_proxtrkdist, cBlips);
+    AddArray("blip_touchtrk", blip_touchtrk, cBlips);
     if( saveTrkInfo ) {
-      evtTree->Branch("blip_proxtrkid",blip_proxtrkid,"blip_proxtrkid[nblips]/I");
-      evtTree->Branch("blip_touchtrkid",blip_touchtrkid,"blip_touchtrkid[nblips]/I");
+      AddArray("blip_proxtrkid", blip_proxtrkid, cBlips);
+      AddArray("blip_touchtrkid", blip_touchtrkid, cBlips);
     }
-    if( saveTruthInfo ) evtTree->Branch("blip_edepid",blip_edepid,"blip_edepid[nblips]/I");
-    for(int i=0;i<kNplanes;i++) evtTree->Branch(Form("blip_pl%i_clustid",i),blip_clustid[i],Form("blip_pl%i_clustid[nblips]/I",i));
+    if( saveTruthInfo ) AddArray("blip_edepid", blip_edepid, cBlips);
+    for(int i=0;i<kNplanes;i++) AddArray(Form("blip_pl%i_clustid",i), blip_clustid[i], cBlips);
     
     
     if( saveTruthInfo ) {
-      evtTree->Branch("nparticles",&nparticles,"nparticles/I");
-      evtTree->Branch("part_isPrimary",part_isPrimary,"part_isPrimary[nparticles]/O");
-      //evtTree->Branch("part_madeHitCol",part_madeHitCol,"part_madeHitCol[nparticles]/O");
-      //evtTree->Branch("part_madeClustCol",part_madeClustCol,"part_madeClustCol[nparticles]/O");
-      //evtTree->Branch("part_trackID",part_trackID,"part_trackID[nparticles]/I");
-      evtTree->Branch("part_pdg",part_pdg,"part_pdg[nparticles]/I");
-      evtTree->Branch("part_nDaughters",part_nDaughters,"part_nDaughters[nparticles]/I");
-      evtTree->Branch("part_mother",part_mother,"part_mother[nparticles]/I");
-      evtTree->Branch("part_KE",part_KE,"part_KE[nparticles]/F");
-      //evtTree->Branch("part_endKE",part_endKE,"part_endKE[nparticles]/F");
-      //evtTree->Branch("part_mass",part_mass,"part_mass[nparticles]/F");
-      //evtTree->Branch("part_P",part_P,"part_P[nparticles]/F");
-      //evtTree->Branch("part_Px",part_Px,"part_Px[nparticles]/F");
-      //evtTree->Branch("part_Py",part_Py,"part_Py[nparticles]/F");
-      //evtTree->Branch("part_Pz",part_Pz,"part_Pz[nparticles]/F");
-      //evtTree->Branch("part_startPointx",part_startPointx,"part_startPointx[nparticles]/F");
-      //evtTree->Branch("part_startPointy",part_startPointy,"part_startPointy[nparticles]/F");
-      //evtTree->Branch("part_startPointz",part_startPointz,"part_startPointz[nparticles]/F");
-      //evtTree->Branch("part_endPointx",part_endPointx,"part_endPointx[nparticles]/F");
-      //evtTree->Branch("part_endPointy",part_endPointy,"part_endPointy[nparticles]/F");
-      //evtTree->Branch("part_endPointz",part_endPointz,"part_endPointz[nparticles]/F");
-      evtTree->Branch("part_startT",part_startT,"part_startT[nparticles]/F");
-      //evtTree->Branch("part_endT",part_endT,"part_endT[nparticles]/F");
-      evtTree->Branch("part_pathlen",part_pathlen,"part_pathlen[nparticles]/F");
-      evtTree->Branch("part_depEnergy",part_depEnergy,"part_depEnergy[nparticles]/F");
-      //evtTree->Branch("part_depElectrons",part_depElectrons,"part_depElectrons[nparticles]/I");
-      //evtTree->Branch("part_numElectrons",part_numElectrons,"part_numElectrons[nparticles]/F");
-      evtTree->Branch("part_process",&part_process);
+      AddScalar("nparticles", &nparticles);
+      AddArray("part_isPrimary", part_isPrimary, cParts);
+      //AddArray("part_madeHitCol", part_madeHitCol, cParts);
+      //AddArray("part_madeClustCol", part_madeClustCol, cParts);
+      //AddArray("part_trackID", part_trackID, cParts);
+      AddArray("part_pdg", part_pdg, cParts);
+      AddArray("part_nDaughters", part_nDaughters, cParts);
+      AddArray("part_mother", part_mother, cParts);
+      AddArray("part_KE", part_KE, cParts);
+      //AddArray("part_endKE", part_endKE, cParts);
+      //AddArray("part_mass", part_mass, cParts);
+      //AddArray("part_P", part_P, cParts);
+      //AddArray("part_Px", part_Px, cParts);
+      //AddArray("part_Py", part_Py, cParts);
+      //AddArray("part_Pz", part_Pz, cParts);
+      //AddArray("part_startPointx", part_startPointx, cParts);
+      //AddArray("part_startPointy", part_startPointy, cParts);
+      //AddArray("part_startPointz", part_startPointz, cParts);
+      //AddArray("part_endPointx", part_endPointx, cParts);
+      //AddArray("part_endPointy", part_endPointy, cParts);
+      //AddArray("part_endPointz", part_endPointz, cParts);
+      AddArray("part_startT", part_startT, cParts);
+      //AddArray("part_endT", part_endT, cParts);
+      AddArray("part_pathlen", part_pathlen, cParts);
+      AddArray("part_depEnergy", part_depEnergy, cParts);
+      //AddArray("part_depElectrons", part_depElectrons, cParts);
+      //AddArray("part_numElectrons", part_numElectrons, cParts);
+      AddObject("part_process", &part_process);
       
-      evtTree->Branch("nedeps",&nedeps,"nedeps/I");
-      evtTree->Branch("edep_g4id",edep_g4id,"edep_g4id[nedeps]/I"); 
-      evtTree->Branch("edep_g4trkid",edep_g4trkid,"edep_g4trkid[nedeps]/I"); 
-      evtTree->Branch("edep_g4qfrac",edep_g4qfrac,"edep_g4qfrac[nedeps]/F"); 
-      evtTree->Branch("edep_isPrimary",edep_isPrimary,"edep_isPrimary[nedeps]/O"); 
-      //evtTree->Branch("edep_madeHitCol",edep_madeHitCol,"edep_madeHitCol[nedeps]/O"); 
-      evtTree->Branch("edep_madeClustCol",edep_madeClustCol,"edep_madeClustCol[nedeps]/O"); 
-      evtTree->Branch("edep_pdg",edep_pdg,"edep_pdg[nedeps]/I"); 
-      evtTree->Branch("edep_proc",edep_proc,"edep_proc[nedeps]/I"); 
-      evtTree->Branch("edep_blipid",edep_blipid,"edep_blipid[nedeps]/I"); 
-      //evtTree->Branch("edep_clustid",edep_clustid,"edep_clustid[nedeps]/I"); 
-      evtTree->Branch("edep_energy",edep_energy,"edep_energy[nedeps]/F"); 
-      evtTree->Branch("edep_electrons",edep_electrons,"edep_electrons[nedeps]/I"); 
-      evtTree->Branch("edep_charge",edep_charge,"edep_charge[nedeps]/I"); 
-      evtTree->Branch("edep_tdrift",edep_tdrift,"edep_tdrift[nedeps]/I"); 
-      evtTree->Branch("edep_x",edep_x,"edep_x[nedeps]/F"); 
-      evtTree->Branch("edep_y",edep_y,"edep_y[nedeps]/F"); 
-      evtTree->Branch("edep_z",edep_z,"edep_z[nedeps]/F"); 
-      evtTree->Branch("edep_dx",edep_dx,"edep_dx[nedeps]/F"); 
-      evtTree->Branch("edep_dz",edep_dz,"edep_dz[nedeps]/F"); 
+      AddScalar("nedeps", &nedeps);
+      AddArray("edep_g4id", edep_g4id, cEdeps); 
+      AddArray("edep_g4trkid", edep_g4trkid, cEdeps); 
+      AddArray("edep_g4qfrac", edep_g4qfrac, cEdeps); 
+      AddArray("edep_isPrimary", edep_isPrimary, cEdeps); 
+      //AddArray("edep_madeHitCol", edep_madeHitCol, cEdeps); 
+      AddArray("edep_madeClustCol", edep_madeClustCol, cEdeps); 
+      AddArray("edep_pdg", edep_pdg, cEdeps); 
+      AddArray("edep_proc", edep_proc, cEdeps); 
+      AddArray("edep_blipid", edep_blipid, cEdeps); 
+      //AddArray("edep_clustid", edep_clustid, cEdeps); 
+      AddArray("edep_energy", edep_energy, cEdeps); 
+      AddArray("edep_electrons", edep_electrons, cEdeps); 
+      AddArray("edep_charge", edep_charge, cEdeps); 
+      AddArray("edep_tdrift", edep_tdrift, cEdeps); 
+      AddArray("edep_x", edep_x, cEdeps); 
+      AddArray("edep_y", edep_y, cEdeps); 
+      AddArray("edep_z", edep_z, cEdeps); 
+      AddArray("edep_dx", edep_dx, cEdeps); 
+      AddArray("edep_dz", edep_dz, cEdeps); 
+    }
+
+    // a misspelled column would otherwise just be missing from the output
+    for(auto const& name : outputColumns ) {
+      if( std::find(knownColumns.begin(),knownColumns.end(),name) == knownColumns.end() ) 
+        throw cet::exception("BlipAna") << "OutputColumns entry '" << name << "' is not an array column of " 
+          << treeName << " (check the spelling and the Save*Info switches)\n";
+    }
+
+#ifdef BLIPANA_HAS_RNTUPLE
+    if( columnar ) ntWriter = rntuple::RNTupleWriter::Append(std::move(ntModel), treeName, tfs->file());
+#endif
+  }
+
+  // === Function for writing out the current event ===
+  void Fill(){
+    if( !columnar ) { 
+      evtTree->Fill(); 
+      return;
     }
+    for(auto& fillColumn : colFillers ) fillColumn();
+#ifdef BLIPANA_HAS_RNTUPLE
+    ntWriter->Fill();
+#else
+    evtTree->Fill();
+#endif
+  }
+
+  // === Function for flushing columnar output (call before file closes) ===
+  void Close(){
+#ifdef BLIPANA_HAS_RNTUPLE
+    ntWriter.reset();
+#endif
   }
 
   void MakeCalibTree(){
@@ -961,6 +1101,10 @@ BlipAna::BlipAna(fhicl::ParameterSet const& pset) :
   fData ->saveTrkInfo     = pset.get<bool>        ("SaveTrkInfo",   true);
   fData ->saveHitInfo     = pset.get<bool>        ("SaveHitInfo",   true);
   fData ->saveClustInfo   = pset.get<bool>        ("SaveClustInfo", true);
+  fData ->outputFormat    = pset.get<std::string> ("OutputFormat",  "TTree");
+  fData ->outputColumns   = pset.get<std::vector<std::string>>("OutputColumns", {});
+  if( fData->outputFormat != "TTree" && fData->outputFormat != "RNTuple" ) 
+    throw cet::exception("BlipAna") << "Unknown OutputFormat '" << fData->outputFormat << "' (use \"TTree\" or \"RNTuple\")\n";
   fData ->Clear();
   fData ->MakeTree();
   if( fDoACPTrkCalib ) fData->MakeCalibTree();
@@ -1875,7 +2019,7 @@ void BlipAna::analyze(const art::Event& evt)
   //====================================
   // Fill TTree
   //====================================
-  fData->evtTree->Fill();
+  fData->Fill();
 
 }
 
@@ -1885,6 +2029,8 @@ void BlipAna::analyze(const art::Event& evt)
 //###################################################
 void BlipAna::endJob(){
   
+  fData->Close();
+
   fBlipAlg->h_recoWireEff_num->Divide(fBlipAlg->h_recoWireEff_denom);
   fBlipAlg->h_recoWireEff_num->SetOption("hist");
   fBlipAlg->h_recoWireEff_num->SetBit(TH1::kIsAverage);
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////
+// File:        ScaleLookupTables.h
+//
+// Regular-grid stand-ins for the TSpline3 / TGraph2D response maps used
+// by WireModifier. Each table is sampled once per job from its ROOT
+// object and then evaluated with linear (1D) or bilinear (2D)
+// interpolation. Points outside the sampled range, 2D cells touching the
+// outside of the graph's convex hull, and tables that were never built (or
+// failed their accuracy check) fall back to the ROOT object, so results
+// there are unchanged. Eval/Interpolate may
+// be called concurrently; the TGraph2D fallback is serialized since
+// TGraph2D::Interpolate updates its cached Delaunay state.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef SYS_SCALELOOKUPTABLES_H
+#define SYS_SCALELOOKUPTABLES_H
+
+#include "TSpline.h"
+#include "TGraph2D.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <mutex>
+
+namespace sys {
+
+  class SplineTable {
+  public:
+    SplineTable() = default;
+    explicit SplineTable(TSpline3* spline) : fSpline(spline) {}
+
+    // sample the spline on nbins equal cells between its first and last
+    // knot; returns the largest deviation from TSpline3::Eval found at the
+    // cell midpoints (negative if no table could be built)
+    double Build(size_t nbins)
+    {
+      fTable.clear();
+      if(!fSpline || nbins==0) return -1.;
+
+      fXmin = fSpline->GetXmin();
+      double xmax = fSpline->GetXmax();
+      if(!(xmax>fXmin)) return -1.;
+
+      fNbins  = nbins;
+      fDx     = (xmax-fXmin)/nbins;
+      fInvDx  = 1./fDx;
+      fTable.resize(nbins+1);
+      for(size_t i=0; i<=nbins; ++i)
+        fTable[i] = fSpline->Eval(fXmin+i*fDx);
+
+      double max_dev = 0.;
+      for(size_t i=0; i<nbins; ++i){
+        double x = fXmin+(i+0.5)*fDx;
+        max_dev = std::max(max_dev, std::abs(Eval(x)-fSpline->Eval(x)));
+      }
+      return max_dev;
+    }
+
+    void Clear() { fTable.clear(); }
+    bool IsBuilt() const { return !fTable.empty(); }
+
+    double Eval(double x) const
+    {
+      if(!fTable.empty()){
+        double u = (x-fXmin)*fInvDx;
+        if(u>=0. && u<fNbins){
+          size_t i = (size_t)u;
+          double f = u-i;
+          return fTable[i] + f*(fTable[i+1]-fTable[i]);
+        }
+      }
+      return fSpline->Eval(x);
+    }
+
+  private:
+    TSpline3*           fSpline = nullptr;
+    std::vector<double> fTable;
+    double              fXmin   = 0.;
+    double              fDx     = 1.;
+    double              fInvDx  = 1.;
+    double              fNbins  = 0.;
+  };
+
+
+  class Graph2DTable {
+  public:
+    Graph2DTable() = default;
+    explicit Graph2DTable(TGraph2D* graph) : fGraph(graph) {}
+
+    // sample the graph on an nx-by-ny grid spanning the range of its points.
+    // TGraph2D::Interpolate returns 0 outside the convex hull of the points,
+    // so cells with a corner at 0 are left to the graph. Returns the largest
+    // deviation from TGraph2D::Interpolate over the centers of all other
+    // cells (negative if no table was built)
+    double Build(size_t nx, size_t ny)
+    {
+      fTable.clear();
+      fUseGraph.clear();
+      if(!fGraph || nx==0 || ny==0 || fGraph->GetN()==0) return -1.;
+
+      fXmin = fGraph->GetXmin();
+      fYmin = fGraph->GetYmin();
+      double xmax = fGraph->GetXmax();
+      double ymax = fGraph->GetYmax();
+      if(!(xmax>fXmin) || !(ymax>fYmin)) return -1.;
+
+      fNx = nx; fNy = ny;
+      fDx = (xmax-fXmin)/nx; fInvDx = 1./fDx;
+      fDy = (ymax-fYmin)/ny; fInvDy = 1./fDy;
+      fTable.resize((nx+1)*(ny+1));
+      for(size_t ix=0; ix<=nx; ++ix)
+        for(size_t iy=0; iy<=ny; ++iy)
+          fTable[ix*(ny+1)+iy] = fGraph->Interpolate(fXmin+ix*fDx,fYmin+iy*fDy);
+
+      fUseGraph.assign(nx*ny,0);
+      double max_dev = 0.;
+      for(size_t ix=0; ix<nx; ++ix){
+        for(size_t iy=0; iy<ny; ++iy){
+          const double* c0 = &fTable[ix*(ny+1)+iy];
+          const double* c1 = c0+(ny+1);
+          if(c0[0]==0. || c0[1]==0. || c1[0]==0. || c1[1]==0.){
+            fUseGraph[ix*ny+iy] = 1;
+            continue;
+          }
+          double x = fXmin+(ix+0.5)*fDx;
+          double y = fYmin+(iy+0.5)*fDy;
+          max_dev = std::max(max_dev, std::abs(Interpolate(x,y)-fGraph->Interpolate(x,y)));
+        }
+      }
+      return max_dev;
+    }
+
+    void Clear() { fTable.clear(); fUseGraph.clear(); }
+    bool IsBuilt() const { return !fTable.empty(); }
+
+    double Interpolate(double x, double y) const
+    {
+      if(!fTable.empty()){
+        double u = (x-fXmin)*fInvDx;
+        double v = (y-fYmin)*fInvDy;
+        if(u>=0. && u<fNx && v>=0. && v<fNy){
+          size_t ix = (size_t)u;
+          size_t iy = (size_t)v;
+          if(!fUseGraph[ix*(size_t)fNy+iy]){
+            double fx = u-ix;
+            double fy = v-iy;
+            const double* c0 = &fTable[ix*((size_t)fNy+1)+iy];
+            const double* c1 = c0+((size_t)fNy+1);
+            double z0 = c0[0] + fy*(c0[1]-c0[0]);
+            double z1 = c1[0] + fy*(c1[1]-c1[0]);
+            return z0 + fx*(z1-z0);
+          }
+        }
+      }
+      static std::mutex fallback_mutex;
+      std::lock_guard<std::mutex> lock(fallback_mutex);
+      return fGraph->Interpolate(x,y);
+    }
+
+  private:
+    TGraph2D*           fGraph = nullptr;
+    std::vector<double> fTable;
+    std::vector<char>   fUseGraph;
+    double              fXmin  = 0.;
+    double              fYmin  = 0.;
+    double              fDx    = 1.;
+    double              fDy    = 1.;
+    double              fInvDx = 1.;
+    double              fInvDy = 1.;
+    double              fNx    = 0.;
+    double              fNy    = 0.;
+  };
+
+}
+
+#endif
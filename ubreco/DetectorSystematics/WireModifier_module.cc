@@ -18,6 +18,11 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <memory>
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
 
 #include "lardataobj/RawData/RawDigit.h"
 #include "lardataobj/RecoBase/Wire.h"
@@ -31,6 +36,8 @@
 #include "TSpline.h"
 #include "TGraph2DErrors.h"
 
+#include "ubreco/DetectorSystematics/ScaleLookupTables.h"
+
 // Use include statements for the truth products.
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
@@ -111,12 +118,42 @@ private:
   bool fApplyAdditionalTickOffset;
   bool fApplyAngleYZSigmaSpline;
 
+  //regular-grid tables baked from the splines/graphs above (these are what
+  //GetScaleValues evaluates; they fall back to the ROOT objects when disabled)
+  bool                fUseLookupTables;
+  size_t              fLookupTableBins;
+  std::vector<size_t> fLookupTableBins2D;
+  double              fLookupTableTolerance;
+
+  //spread the wires over art's TBB pool; the output is identical to the
+  //serial loop (forced serial when filling the scale check tree)
+  bool                fParallelWires;
+  size_t              fWireGrainSize;
+
+  std::vector<SplineTable>  fLUT_Charge_X;
+  std::vector<SplineTable>  fLUT_Sigma_X;
+  std::vector<Graph2DTable> fLUT_Charge_YZ;
+  std::vector<Graph2DTable> fLUT_Sigma_YZ;
+  std::vector<SplineTable>  fLUT_Charge_XZAngle;
+  std::vector<SplineTable>  fLUT_Sigma_XZAngle;
+  std::vector<SplineTable>  fLUT_Charge_YZAngle;
+  std::vector<SplineTable>  fLUT_Sigma_YZAngle;
+  std::vector<SplineTable>  fLUT_Charge_dEdX;
+  std::vector<SplineTable>  fLUT_Sigma_dEdX;
+
+  void MakeSplineTables(std::vector<TSpline3*> const&, std::vector<std::string> const&, std::vector<SplineTable>&);
+  void MakeGraph2DTables(std::vector<TGraph2DErrors*> const&, std::vector<std::string> const&, std::vector<Graph2DTable>&);
+
   //useful math things
   //static constexpr double ONE_OVER_SQRT_2PI = 1./std::sqrt(2*util::pi());
   double GAUSSIAN(double t, double mean,double sigma,double a=1.0){
     return ( (a/sigma /std::sqrt(2*util::pi()) * std::exp( -1.*(t-mean)*(t-mean)*0.5/sigma/sigma) ));
   }
 
+  // exp(-x) underflows to exactly zero in double precision for x > ~745.2,
+  // i.e. beyond ~38.6 sigma, so gaussians are only evaluated within this
+  static constexpr double GAUS_SUPPORT_SIGMAS = 39.;
+
   static constexpr double A_w = 3.33328;
   static constexpr double C_U = 338.140;
   static constexpr double C_V = 2732.53;
@@ -127,8 +164,19 @@ private:
   static constexpr double PI_OVER_TWO = util::pi()/2.;
 
   typedef std::pair<unsigned int,unsigned int> ROI_Key_t;
-  std::map< ROI_Key_t,std::vector<size_t> > fROIMatchedEdepMap;
-  std::map< ROI_Key_t,std::vector<size_t> > fROIMatchedHitMap;
+
+  //ROI interval index, rebuilt once per event: the ROIs of every wire laid out
+  //by (channel, begin) with per-channel offsets, so an ROI is found by channel
+  //lookup plus binary search on begin tick. Matched edeps/hits per indexed ROI.
+  std::vector<size_t>       fROIChanOffset;
+  std::vector<unsigned int> fROIBegin;
+  std::vector<unsigned int> fROIEnd;
+  std::vector< std::vector<size_t> > fROIMatchedEdeps;
+  std::vector< std::vector<size_t> > fROIMatchedHits;
+
+  void BuildROIIndex(std::vector<recob::Wire> const&);
+  long FindROI(unsigned int channel, unsigned int tick) const;
+  long GetROIIndex(unsigned int channel, size_t range_number) const;
   
   typedef struct ROIProperties{
     ROI_Key_t key;
@@ -155,6 +203,14 @@ private:
     double r_sigma;
   } ScaleValues_t;
 
+  //per-worker buffers, reused across the ROIs that worker processes
+  typedef struct ROIScratch{
+    std::vector<float>  modified_data;
+    std::vector<double> q_orig;
+    std::vector<double> q_mod;
+    std::vector<double> gaus_buf;
+  } ROIScratch_t;
+
   typedef struct TruthProperties{
     float x;
     float x_rms;
@@ -224,7 +280,6 @@ private:
 
   ROIProperties_t CalcROIProperties(recob::Wire::RegionsOfInterest_t::datarange_t const&);
 
-  std::vector< std::pair<unsigned int, unsigned int> > GetTargetROIs(sim::SimEnergyDeposit const&, double offset);
   std::vector< std::pair<unsigned int, unsigned int> > GetHitTargetROIs(recob::Hit const&);
   
   void FillROIMatchedEdepMap(std::vector<sim::SimEnergyDeposit> const&, std::vector<recob::Wire> const&, double offset);
@@ -242,7 +297,23 @@ private:
   void ModifyROI(std::vector<float> &,
 		 ROIProperties_t const &, 
 		 std::vector<SubROIProperties_t> const&,
-		 std::map<SubROI_Key_t, ScaleValues_t> const&);
+		 std::map<SubROI_Key_t, ScaleValues_t> const&,
+		 ROIScratch_t &);
+
+  // builds the modified ROI list of one wire; shared state is only read, and
+  // the (edep_e, subroi_q) pairs meant for fNt are handed back in nt_vals
+  void ModifyWire(recob::Wire const&,
+		  std::vector<sim::SimEnergyDeposit> const&,
+		  std::vector<sim::SimEnergyDeposit> const&,
+		  std::vector<recob::Hit> const&,
+		  double offset,
+		  recob::Wire::RegionsOfInterest_t & new_rois,
+		  std::vector< std::pair<float,float> > & nt_vals,
+		  ROIScratch_t &);
+
+  // adds a*GAUSSIAN(t,mean,sigma) to q[t-roi_begin] over the gaussian's support
+  void AccumulateGaussian(std::vector<double> &, std::vector<double> &,
+			  float, double, double, double);
 
 };
 
@@ -278,33 +349,6 @@ sys::WireModifier::CalcROIProperties(recob::Wire::RegionsOfInterest_t::datarange
   return roi_vals;
 }
 
-std::vector< std::pair<unsigned int, unsigned int> > 
-sys::WireModifier::GetTargetROIs(sim::SimEnergyDeposit const& shifted_edep, double offset)
-{
-
-  //channel number, time tick
-  std::vector< std::pair<unsigned int,unsigned int> > target_roi_vec;
-
-  int edep_U_wire = std::round( A_w*(-std::sqrt(0.75)*shifted_edep.Y() + COS_SIXTY*shifted_edep.Z()) + C_U );
-  int edep_V_wire = std::round( A_w*( std::sqrt(0.75)*shifted_edep.Y() + COS_SIXTY*shifted_edep.Z()) + C_V );
-  int edep_Y_wire = std::round( A_w*shifted_edep.Z() + C_Y );
-  int edep_tick   = std::round( A_t*shifted_edep.X() + ( C_t + offset ) + fTickOffset);
-
-  if (edep_tick<fTickOffset || edep_tick>=6400+fTickOffset)
-    return target_roi_vec;
-
-  if(edep_U_wire>=0 && edep_U_wire<2400)
-    target_roi_vec.emplace_back((unsigned int)edep_U_wire,(unsigned int)edep_tick);
-
-  if(edep_V_wire>=2400 && edep_V_wire<4800)
-    target_roi_vec.emplace_back((unsigned int)edep_V_wire,(unsigned int)edep_tick);
-
-  if(edep_Y_wire>=4800 && edep_Y_wire<8256)
-    target_roi_vec.emplace_back((unsigned int)edep_Y_wire,(unsigned int)edep_tick);
-
-  return target_roi_vec;
-}
-
 std::vector< std::pair<unsigned int, unsigned int> > 
 sys::WireModifier::GetHitTargetROIs(recob::Hit const& hit)
 {
@@ -322,56 +366,104 @@ sys::WireModifier::GetHitTargetROIs(recob::Hit const& hit)
   return target_roi_vec;
 }
 
-void sys::WireModifier::FillROIMatchedEdepMap(std::vector<sim::SimEnergyDeposit> const& edepVec,
-					      std::vector<recob::Wire> const& wireVec, double offset)
+void sys::WireModifier::BuildROIIndex(std::vector<recob::Wire> const& wireVec)
 {
-  fROIMatchedEdepMap.clear();
+  //if a channel appears on more than one wire, the last one wins
+  unsigned int max_channel = 0;
+  for(auto const& wire : wireVec)
+    max_channel = std::max(max_channel,(unsigned int)wire.Channel());
 
-  std::unordered_map<unsigned int,unsigned int> wireChannelMap;
+  std::vector<long> chanWire(wireVec.empty() ? 0 : max_channel+1, -1);
   for(size_t i_w=0; i_w<wireVec.size(); ++i_w)
-    wireChannelMap[wireVec[i_w].Channel()] = i_w;
+    chanWire[wireVec[i_w].Channel()] = i_w;
 
-  for(size_t i_e=0; i_e<edepVec.size(); ++i_e){
+  fROIChanOffset.assign(chanWire.size()+1,0);
+  for(size_t ch=0; ch<chanWire.size(); ++ch){
+    size_t n_ranges = chanWire[ch]<0 ? 0 : wireVec[chanWire[ch]].SignalROI().n_ranges();
+    fROIChanOffset[ch+1] = fROIChanOffset[ch] + n_ranges;
+  }
 
-    std::vector< std::pair<unsigned int, unsigned int> > target_rois = GetTargetROIs(edepVec[i_e], offset); 
+  fROIBegin.resize(fROIChanOffset.back());
+  fROIEnd.resize(fROIChanOffset.back());
+  for(size_t ch=0; ch<chanWire.size(); ++ch){
+    if(chanWire[ch]<0) continue;
+    auto const& ranges = wireVec[chanWire[ch]].SignalROI().get_ranges();
+    for(size_t i_r=0; i_r<ranges.size(); ++i_r){
+      fROIBegin[fROIChanOffset[ch]+i_r] = ranges[i_r].begin_index();
+      fROIEnd[fROIChanOffset[ch]+i_r]   = ranges[i_r].end_index();
+    }
+  }
+}
 
-    for( auto const& target_roi : target_rois){
+long sys::WireModifier::FindROI(unsigned int channel, unsigned int tick) const
+{
+  if(channel+1>=fROIChanOffset.size()) return -1;
 
-      //std::cout << "Matched edeps to channel " << target_roi.first << " time tick " << target_roi.second << std::endl;
+  auto first = fROIBegin.begin()+fROIChanOffset[channel];
+  auto last  = fROIBegin.begin()+fROIChanOffset[channel+1];
+  auto it = std::upper_bound(first,last,tick);
+  if(it==first) return -1;
 
-      if(wireChannelMap.find(target_roi.first)==wireChannelMap.end())
-	continue;
-      
-      auto const& target_wire = wireVec.at(wireChannelMap[target_roi.first]);
+  long idx = (it-fROIBegin.begin())-1;
+  if(tick>=fROIEnd[idx]) return -1;
+  return idx;
+}
 
-      //if(target_roi.first!=target_wire.Channel())
-      //throw std::runtime_error("ERROR! Channel ordering doesn't match wire ordering.");
+long sys::WireModifier::GetROIIndex(unsigned int channel, size_t range_number) const
+{
+  if(channel+1>=fROIChanOffset.size()) return -1;
+  if(fROIChanOffset[channel]+range_number>=fROIChanOffset[channel+1]) return -1;
+  return fROIChanOffset[channel]+range_number;
+}
 
-      //std::cout << "\tGot wire " << target_wire.Channel() << std::endl;
+void sys::WireModifier::FillROIMatchedEdepMap(std::vector<sim::SimEnergyDeposit> const& edepVec,
+					      std::vector<recob::Wire> const&, double offset)
+{
+  fROIMatchedEdeps.assign(fROIBegin.size(),std::vector<size_t>());
+
+  //project all edeps to (channel, tick) in one pass
+  const size_t n_edeps = edepVec.size();
+  std::vector<double> edep_x(n_edeps), edep_y(n_edeps), edep_z(n_edeps);
+  for(size_t i_e=0; i_e<n_edeps; ++i_e){
+    edep_x[i_e] = edepVec[i_e].X();
+    edep_y[i_e] = edepVec[i_e].Y();
+    edep_z[i_e] = edepVec[i_e].Z();
+  }
+
+  std::vector<int> edep_tick(n_edeps);
+  std::vector<int> edep_wire[3];
+  for(auto& w : edep_wire) w.resize(n_edeps);
+  for(size_t i_e=0; i_e<n_edeps; ++i_e){
+    edep_wire[0][i_e] = std::round( A_w*(-std::sqrt(0.75)*edep_y[i_e] + COS_SIXTY*edep_z[i_e]) + C_U );
+    edep_wire[1][i_e] = std::round( A_w*( std::sqrt(0.75)*edep_y[i_e] + COS_SIXTY*edep_z[i_e]) + C_V );
+    edep_wire[2][i_e] = std::round( A_w*edep_z[i_e] + C_Y );
+    edep_tick[i_e]    = std::round( A_t*edep_x[i_e] + ( C_t + offset ) + fTickOffset);
+  }
 
-      //std::cout << "\tWire has " << target_wire.SignalROI().n_ranges() << std::endl;
+  //channel range of each plane
+  static constexpr int plane_channels[4] = {0,2400,4800,8256};
 
-      if(target_wire.SignalROI().n_ranges()==0) continue;
-      if(target_wire.SignalROI().is_void(target_roi.second)) continue;
+  //then match them to ROIs by binary search (edeps stay in index order per ROI)
+  for(size_t i_p=0; i_p<3; ++i_p){
+    for(size_t i_e=0; i_e<n_edeps; ++i_e){
 
-      auto range_number = target_wire.SignalROI().find_range_iterator(target_roi.second) - target_wire.SignalROI().begin_range();
+      if (edep_tick[i_e]<fTickOffset || edep_tick[i_e]>=6400+fTickOffset) continue;
+      if (edep_wire[i_p][i_e]<plane_channels[i_p] || edep_wire[i_p][i_e]>=plane_channels[i_p+1]) continue;
 
-      fROIMatchedEdepMap[std::make_pair(target_wire.Channel(),range_number)].push_back(i_e);
+      long roi_idx = FindROI((unsigned int)edep_wire[i_p][i_e],(unsigned int)edep_tick[i_e]);
+      if(roi_idx<0) continue;
 
-    }//end loop over target rois
+      fROIMatchedEdeps[roi_idx].push_back(i_e);
 
-  }//end loop over all edeps
+    }//end loop over all edeps
+  }//end loop over planes
 
 }
 
 void sys::WireModifier::FillROIMatchedHitMap(std::vector<recob::Hit> const& hitVec,
-					     std::vector<recob::Wire> const& wireVec)
+					     std::vector<recob::Wire> const&)
 {
-  fROIMatchedHitMap.clear();
-  
-  std::unordered_map<unsigned int,unsigned int> wireChannelMap;
-  for(size_t i_w=0; i_w<wireVec.size(); ++i_w)
-    wireChannelMap[wireVec[i_w].Channel()] = i_w;
+  fROIMatchedHits.assign(fROIBegin.size(),std::vector<size_t>());
   
   for(size_t i_h=0; i_h<hitVec.size(); ++i_h){
     
@@ -379,17 +471,10 @@ void sys::WireModifier::FillROIMatchedHitMap(std::vector<recob::Hit> const& hitV
     
     for( auto const& target_roi : target_rois){
       
-      if(wireChannelMap.find(target_roi.first)==wireChannelMap.end())
-	continue;
-
-      auto const& target_wire = wireVec.at(wireChannelMap[target_roi.first]);
+      long roi_idx = FindROI(target_roi.first,target_roi.second);
+      if(roi_idx<0) continue;
       
-      if(target_wire.SignalROI().n_ranges()==0) continue;
-      if(target_wire.SignalROI().is_void(target_roi.second)) continue;
-
-      auto range_number = target_wire.SignalROI().find_range_iterator(target_roi.second) - target_wire.SignalROI().begin_range();
-      
-      fROIMatchedHitMap[std::make_pair(target_wire.Channel(),range_number)].push_back(i_h);
+      fROIMatchedHits[roi_idx].push_back(i_h);
       
     }//end loop over target rois
     
@@ -749,32 +834,32 @@ sys::WireModifier::GetScaleValues(sys::WireModifier::TruthProperties_t const& tr
   //get scales here
   if(plane==0){
     if(fApplyXScale){
-      scales.r_Q *= fTSplines_Charge_X[plane]->Eval(truth_props.x);
-      scales.r_sigma *= fTSplines_Sigma_X[plane]->Eval(truth_props.x);
+      scales.r_Q *= fLUT_Charge_X[plane].Eval(truth_props.x);
+      scales.r_sigma *= fLUT_Sigma_X[plane].Eval(truth_props.x);
     }
     if(fApplyYScale){    
     }
     if(fApplyZScale){    
     }
     if(fApplyYZScale){    
-      temp_scale = fTGraph2Ds_Charge_YZ[plane]->Interpolate(truth_props.z,truth_props.y); //confirmed order is (z,y) by Aruturo, 1/24/20
+      temp_scale = fLUT_Charge_YZ[plane].Interpolate(truth_props.z,truth_props.y); //confirmed order is (z,y) by Aruturo, 1/24/20
       if(temp_scale>0.001) scales.r_Q *= temp_scale;
 
-      temp_scale = fTGraph2Ds_Sigma_YZ[plane]->Interpolate(truth_props.z,truth_props.y);
+      temp_scale = fLUT_Sigma_YZ[plane].Interpolate(truth_props.z,truth_props.y);
       if(temp_scale>0.001) scales.r_sigma *= temp_scale;
     }
     if(fApplyXZAngleScale){    
-      scales.r_Q     *= fTSplines_Charge_XZAngle[plane]->Eval(ThetaXZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
-      scales.r_sigma *= fTSplines_Sigma_XZAngle[plane]->Eval(ThetaXZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q     *= fLUT_Charge_XZAngle[plane].Eval(ThetaXZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_sigma *= fLUT_Sigma_XZAngle[plane].Eval(ThetaXZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplyYZAngleScale){    
-      scales.r_Q *= fTSplines_Charge_YZAngle[plane]->Eval(ThetaYZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q *= fLUT_Charge_YZAngle[plane].Eval(ThetaYZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
       if ( fApplyAngleYZSigmaSpline )
-	scales.r_sigma *= fTSplines_Sigma_YZAngle[plane]->Eval(ThetaYZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+	scales.r_sigma *= fLUT_Sigma_YZAngle[plane].Eval(ThetaYZ_U(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplydEdXScale){
-      scales.r_Q *= fTSplines_Charge_dEdX[plane]->Eval(truth_props.dedr);
-      scales.r_sigma *= fTSplines_Sigma_dEdX[plane]->Eval(truth_props.dedr);
+      scales.r_Q *= fLUT_Charge_dEdX[plane].Eval(truth_props.dedr);
+      scales.r_sigma *= fLUT_Sigma_dEdX[plane].Eval(truth_props.dedr);
     }
 
     //if(fApplyOverallScale){
@@ -783,32 +868,32 @@ sys::WireModifier::GetScaleValues(sys::WireModifier::TruthProperties_t const& tr
   }
   else if(plane==1){
     if(fApplyXScale){
-      scales.r_Q *= fTSplines_Charge_X[plane]->Eval(truth_props.x);
-      scales.r_sigma *= fTSplines_Sigma_X[plane]->Eval(truth_props.x);
+      scales.r_Q *= fLUT_Charge_X[plane].Eval(truth_props.x);
+      scales.r_sigma *= fLUT_Sigma_X[plane].Eval(truth_props.x);
     }
     if(fApplyYScale){    
     }
     if(fApplyZScale){    
     }
     if(fApplyYZScale){    
-      temp_scale = fTGraph2Ds_Charge_YZ[plane]->Interpolate(truth_props.z,truth_props.y);
+      temp_scale = fLUT_Charge_YZ[plane].Interpolate(truth_props.z,truth_props.y);
       if(temp_scale>0.001) scales.r_Q *= temp_scale;
 
-      temp_scale = fTGraph2Ds_Sigma_YZ[plane]->Interpolate(truth_props.z,truth_props.y);
+      temp_scale = fLUT_Sigma_YZ[plane].Interpolate(truth_props.z,truth_props.y);
       if(temp_scale>0.001) scales.r_sigma *= temp_scale;
     }
     if(fApplyXZAngleScale){    
-      scales.r_Q     *= fTSplines_Charge_XZAngle[plane]->Eval(ThetaXZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
-      scales.r_sigma *= fTSplines_Sigma_XZAngle[plane]->Eval(ThetaXZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q     *= fLUT_Charge_XZAngle[plane].Eval(ThetaXZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_sigma *= fLUT_Sigma_XZAngle[plane].Eval(ThetaXZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplyYZAngleScale){    
-      scales.r_Q *= fTSplines_Charge_YZAngle[plane]->Eval(ThetaYZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q *= fLUT_Charge_YZAngle[plane].Eval(ThetaYZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
       if ( fApplyAngleYZSigmaSpline )
-	scales.r_sigma *= fTSplines_Sigma_YZAngle[plane]->Eval(ThetaYZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+	scales.r_sigma *= fLUT_Sigma_YZAngle[plane].Eval(ThetaYZ_V(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplydEdXScale){    
-      scales.r_Q *= fTSplines_Charge_dEdX[plane]->Eval(truth_props.dedr);
-      scales.r_sigma *= fTSplines_Sigma_dEdX[plane]->Eval(truth_props.dedr);
+      scales.r_Q *= fLUT_Charge_dEdX[plane].Eval(truth_props.dedr);
+      scales.r_sigma *= fLUT_Sigma_dEdX[plane].Eval(truth_props.dedr);
     }
     //if(fApplyOverallScale){
     //scales.r_Q *= fOverallScale[1];
@@ -816,32 +901,32 @@ sys::WireModifier::GetScaleValues(sys::WireModifier::TruthProperties_t const& tr
   }
   else if(plane==2){
     if(fApplyXScale){
-      scales.r_Q *= fTSplines_Charge_X[plane]->Eval(truth_props.x);
-      scales.r_sigma *= fTSplines_Sigma_X[plane]->Eval(truth_props.x);
+      scales.r_Q *= fLUT_Charge_X[plane].Eval(truth_props.x);
+      scales.r_sigma *= fLUT_Sigma_X[plane].Eval(truth_props.x);
     }
     if(fApplyYScale){    
     }
     if(fApplyZScale){    
     }
     if(fApplyYZScale){    
-      temp_scale = fTGraph2Ds_Charge_YZ[plane]->Interpolate(truth_props.z,truth_props.y);
+      temp_scale = fLUT_Charge_YZ[plane].Interpolate(truth_props.z,truth_props.y);
       if(temp_scale>0.001) scales.r_Q *= temp_scale;
 
-      temp_scale = fTGraph2Ds_Sigma_YZ[plane]->Interpolate(truth_props.z,truth_props.y);
+      temp_scale = fLUT_Sigma_YZ[plane].Interpolate(truth_props.z,truth_props.y);
       if(temp_scale>0.001) scales.r_sigma *= temp_scale;
     }
     if(fApplyXZAngleScale){    
-      scales.r_Q     *= fTSplines_Charge_XZAngle[plane]->Eval(ThetaXZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
-      scales.r_sigma *= fTSplines_Sigma_XZAngle[plane]->Eval(ThetaXZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q     *= fLUT_Charge_XZAngle[plane].Eval(ThetaXZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_sigma *= fLUT_Sigma_XZAngle[plane].Eval(ThetaXZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplyYZAngleScale){    
-      scales.r_Q *= fTSplines_Charge_YZAngle[plane]->Eval(ThetaYZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+      scales.r_Q *= fLUT_Charge_YZAngle[plane].Eval(ThetaYZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
       if ( fApplyAngleYZSigmaSpline )
-	scales.r_sigma *= fTSplines_Sigma_YZAngle[plane]->Eval(ThetaYZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
+	scales.r_sigma *= fLUT_Sigma_YZAngle[plane].Eval(ThetaYZ_Y(truth_props.dxdr,truth_props.dydr,truth_props.dzdr));
     }
     if(fApplydEdXScale){    
-      scales.r_Q *= fTSplines_Charge_dEdX[plane]->Eval(truth_props.dedr);
-      scales.r_sigma *= fTSplines_Sigma_dEdX[plane]->Eval(truth_props.dedr);
+      scales.r_Q *= fLUT_Charge_dEdX[plane].Eval(truth_props.dedr);
+      scales.r_sigma *= fLUT_Sigma_dEdX[plane].Eval(truth_props.dedr);
     }
     //if(fApplyOverallScale){
     //scales.r_Q *= fOverallScale[2];
@@ -857,73 +942,57 @@ sys::WireModifier::GetScaleValues(sys::WireModifier::TruthProperties_t const& tr
 void sys::WireModifier::ModifyROI(std::vector<float> & roi_data,
 				  sys::WireModifier::ROIProperties_t const& roi_prop,
 				  std::vector<sys::WireModifier::SubROIProperties_t> const& subROIPropVec, 
-				  std::map<sys::WireModifier::SubROI_Key_t, sys::WireModifier::ScaleValues_t> const& subROIScaleMap)
+				  std::map<sys::WireModifier::SubROI_Key_t, sys::WireModifier::ScaleValues_t> const& subROIScaleMap,
+				  sys::WireModifier::ROIScratch_t & scratch)
 {
   
-  bool verbose=false;
-  //if(roi_data.size()>100) verbose=true;
-  //if(roi_data.size()==1) verbose=true;
-  
-  double q_orig = 0.;
-  double q_mod = 0.;
+  const size_t n_ticks = roi_data.size();
+
+  // q_orig/q_mod summed over subROIs, per tick
+  std::vector<double> & q_orig   = scratch.q_orig;
+  std::vector<double> & q_mod    = scratch.q_mod;
+  std::vector<double> & gaus_buf = scratch.gaus_buf;
+  q_orig.assign(n_ticks,0.);
+  q_mod.assign(n_ticks,0.);
+  gaus_buf.resize(n_ticks);
+
+  // each gaussian only contributes within its support; accumulating subROI by
+  // subROI keeps the per-tick summation order of the tick-by-tick loop
+  for ( auto const& subroi_prop : subROIPropVec ) {
+    auto const& scale_vals = subROIScaleMap.find(subroi_prop.key)->second;
+
+    AccumulateGaussian(q_orig, gaus_buf, roi_prop.begin,
+		       subroi_prop.center,
+		       subroi_prop.sigma,
+		       subroi_prop.total_q );
+
+    AccumulateGaussian(q_mod, gaus_buf, roi_prop.begin,
+		       subroi_prop.center,
+		       scale_vals.r_sigma * subroi_prop.sigma, 
+		       scale_vals.r_Q     * subroi_prop.total_q );
+  }
+
   double scale_ratio = 1.;
   
-  for(size_t i_t=0; i_t < roi_data.size(); i_t++) {
-    
-    // reset q_orig, q_mod, scale_ratio
-    q_orig = 0.;
-    q_mod = 0.;
-    scale_ratio = 1.;
+  for(size_t i_t=0; i_t < n_ticks; i_t++) {
     
-    // calculate q_orig, q_mod for this tick
-    for ( auto const& subroi_prop : subROIPropVec ) {
-      auto scale_vals = subROIScaleMap.find(subroi_prop.key)->second;
-
-      q_orig += GAUSSIAN( i_t+roi_prop.begin,
-			  subroi_prop.center,
-			  subroi_prop.sigma,
-			  subroi_prop.total_q );
-
-      if ( verbose ) std::cout << "    Incrementing q_orig by GAUSSIAN( " << i_t+roi_prop.begin << ", " << subroi_prop.center << ", " << subroi_prop.sigma 
-			       << ", " << subroi_prop.total_q << ") = " 
-			       << GAUSSIAN( i_t+roi_prop.begin,
-					    subroi_prop.center,
-					    subroi_prop.sigma,
-					    subroi_prop.total_q )
-			       << std::endl;
-
-      q_mod  += GAUSSIAN( i_t+roi_prop.begin,
-			  subroi_prop.center,
-			  scale_vals.r_sigma * subroi_prop.sigma, 
-			  scale_vals.r_Q     * subroi_prop.total_q );
-
-      if (verbose ) std::cout << "    Incrementing q_mod by GAUSSIAN( " << i_t+roi_prop.begin << ", " << subroi_prop.center << ", " << scale_vals.r_sigma 
-			      << " * " << subroi_prop.sigma << ", " << scale_vals.r_Q << " * " << subroi_prop.total_q << ") = " 
-			      << GAUSSIAN( i_t+roi_prop.begin,
-					   subroi_prop.center,
-					   scale_vals.r_sigma * subroi_prop.sigma,
-					   scale_vals.r_Q     * subroi_prop.total_q )
-			      << std::endl;
-      
-    }
-    
-    if(isnan(q_orig)) {
+    if(isnan(q_orig[i_t])) {
       std::cout << "WARNING: obtained q_orig = NaN... setting to zero" << std::endl;
-      q_orig = 0.;
+      q_orig[i_t] = 0.;
     }
-    if(isnan(q_mod)) {
+    if(isnan(q_mod[i_t])) {
       std::cout << "WARNING: obtained q_mod = NaN... setting to zero" << std::endl;
-      q_mod = 0.;
+      q_mod[i_t] = 0.;
     }
     
-    scale_ratio = q_mod / q_orig;
+    scale_ratio = q_mod[i_t] / q_orig[i_t];
     
     if(isnan(scale_ratio)) {
-      std::cout << "WARNING: obtained scale_ratio = " << q_mod << " / " << q_orig << " = NaN... setting to 1" << std::endl;
+      std::cout << "WARNING: obtained scale_ratio = " << q_mod[i_t] << " / " << q_orig[i_t] << " = NaN... setting to 1" << std::endl;
       scale_ratio = 1.;
     }
     if(isinf(scale_ratio)) {
-      std::cout << "WARNING: obtained scale_ratio = " << q_mod << " / " << q_orig << " = inf... setting to 1" << std::endl;
+      std::cout << "WARNING: obtained scale_ratio = " << q_mod[i_t] << " / " << q_orig[i_t] << " = inf... setting to 1" << std::endl;
       scale_ratio = 1.0;
     }
  
@@ -933,20 +1002,81 @@ void sys::WireModifier::ModifyROI(std::vector<float> & roi_data,
     */
 
     roi_data[i_t] = scale_ratio * roi_data[i_t];
-    
-    if(verbose)
-      std::cout << "\t tick " << i_t << ":"
-		<< " data=" << roi_data[i_t]
-		<< ", q_orig=" << q_orig
-		<< ", q_mod=" << q_mod
-		<< ", ratio=" << scale_ratio
-		<< std::endl;
   }
   
   return;
   
 }
 
+void sys::WireModifier::AccumulateGaussian(std::vector<double> & q, std::vector<double> & buf,
+					   float roi_begin, double mean, double sigma, double a)
+{
+  const size_t n_ticks = q.size();
+
+  // restrict to the ticks where exp() can be non-zero. A degenerate width,
+  // or a non-finite mean or amplitude (NaN/inf total_q or r_Q), gets the
+  // whole ROI: there exp()==0 ticks still pick up NaN (0*inf, NaN*0), as
+  // they did in the tick-by-tick loop
+  size_t lo = 0, hi = n_ticks;
+  if ( sigma > 0. && !isinf(sigma) && std::isfinite(mean) && std::isfinite(a) ) {
+    double t_lo = std::floor(mean - GAUS_SUPPORT_SIGMAS*sigma - roi_begin);
+    double t_hi = std::ceil (mean + GAUS_SUPPORT_SIGMAS*sigma - roi_begin) + 1.;
+    lo = t_lo > 0. ? std::min((size_t)t_lo, n_ticks) : 0;
+    hi = t_hi > 0. ? std::min((size_t)t_hi, n_ticks) : 0;
+  }
+  if ( lo >= hi ) return;
+
+  // same arithmetic as GAUSSIAN(), split so the exp() loop vectorizes
+  const double norm = a/sigma /std::sqrt(2*util::pi());
+  for ( size_t i_t = lo; i_t < hi; ++i_t ) {
+    double t = i_t+roi_begin;
+    buf[i_t] = -1.*(t-mean)*(t-mean)*0.5/sigma/sigma;
+  }
+  for ( size_t i_t = lo; i_t < hi; ++i_t )
+    buf[i_t] = std::exp(buf[i_t]);
+  for ( size_t i_t = lo; i_t < hi; ++i_t )
+    q[i_t] += norm * buf[i_t];
+}
+
+void sys::WireModifier::MakeSplineTables(std::vector<TSpline3*> const& splines,
+					  std::vector<std::string> const& names,
+					  std::vector<SplineTable>& tables)
+{
+  tables.clear();
+  for(size_t i_s=0; i_s<splines.size(); ++i_s){
+    tables.emplace_back(splines[i_s]);
+    if(!fUseLookupTables || !splines[i_s]) continue;
+
+    // keep the table only if it reproduces the spline to within tolerance
+    double max_dev = tables.back().Build(fLookupTableBins);
+    if(max_dev<0. || max_dev>fLookupTableTolerance){
+      std::cout << "WARNING: lookup table for " << names[i_s] << " deviates by " << max_dev
+		<< " (tolerance " << fLookupTableTolerance << ")... using TSpline3 directly" << std::endl;
+      tables.back().Clear();
+    }
+  }
+}
+
+void sys::WireModifier::MakeGraph2DTables(std::vector<TGraph2DErrors*> const& graphs,
+					   std::vector<std::string> const& names,
+					   std::vector<Graph2DTable>& tables)
+{
+  tables.clear();
+  for(size_t i_s=0; i_s<graphs.size(); ++i_s){
+    tables.emplace_back(graphs[i_s]);
+    if(!fUseLookupTables || !graphs[i_s]) continue;
+
+    size_t nx = fLookupTableBins2D.size()>0 ? fLookupTableBins2D[0] : 0;
+    size_t ny = fLookupTableBins2D.size()>1 ? fLookupTableBins2D[1] : nx;
+    double max_dev = tables.back().Build(nx,ny);
+    if(max_dev<0. || max_dev>fLookupTableTolerance){
+      std::cout << "WARNING: lookup table for " << names[i_s] << " deviates by " << max_dev
+		<< " (tolerance " << fLookupTableTolerance << ")... using TGraph2D directly" << std::endl;
+      tables.back().Clear();
+    }
+  }
+}
+
 sys::WireModifier::WireModifier(fhicl::ParameterSet const& p)
   : EDProducer{p},
   fWireInputTag(p.get<art::InputTag>("WireInputTag")),
@@ -979,7 +1109,13 @@ sys::WireModifier::WireModifier(fhicl::ParameterSet const& p)
   fOverallScale(p.get< std::vector<double> >("OverallScale",std::vector<double>(3,1.))),
   fFillScaleCheckTree(p.get<bool>("FillScaleCheckTree",false)),
   fApplyAdditionalTickOffset(p.get<bool>("ApplyAdditionalTickOffset", false)),
-  fApplyAngleYZSigmaSpline(p.get<bool>("ApplyAngleYZSigmaSpline", false))
+  fApplyAngleYZSigmaSpline(p.get<bool>("ApplyAngleYZSigmaSpline", false)),
+  fUseLookupTables(p.get<bool>("UseLookupTables",true)),
+  fLookupTableBins(p.get<size_t>("LookupTableBins",2000)),
+  fLookupTableBins2D(p.get< std::vector<size_t> >("LookupTableBins2D",{520,240})),
+  fLookupTableTolerance(p.get<double>("LookupTableTolerance",1e-3)),
+  fParallelWires(p.get<bool>("ParallelWires",false)),
+  fWireGrainSize(p.get<size_t>("WireGrainSize",16))
 {
   produces< std::vector< recob::Wire > >();
     
@@ -1042,12 +1178,154 @@ sys::WireModifier::WireModifier(fhicl::ParameterSet const& p)
       f_splines.GetObject(fSplineNames_Sigma_dEdX[i_s].c_str(),fTSplines_Sigma_dEdX[i_s]);
   }
 
+  MakeSplineTables(fTSplines_Charge_X,fSplineNames_Charge_X,fLUT_Charge_X);
+  MakeSplineTables(fTSplines_Sigma_X,fSplineNames_Sigma_X,fLUT_Sigma_X);
+  MakeGraph2DTables(fTGraph2Ds_Charge_YZ,fGraph2DNames_Charge_YZ,fLUT_Charge_YZ);
+  MakeGraph2DTables(fTGraph2Ds_Sigma_YZ,fGraph2DNames_Sigma_YZ,fLUT_Sigma_YZ);
+  MakeSplineTables(fTSplines_Charge_XZAngle,fSplineNames_Charge_XZAngle,fLUT_Charge_XZAngle);
+  MakeSplineTables(fTSplines_Sigma_XZAngle,fSplineNames_Sigma_XZAngle,fLUT_Sigma_XZAngle);
+  MakeSplineTables(fTSplines_Charge_YZAngle,fSplineNames_Charge_YZAngle,fLUT_Charge_YZAngle);
+  MakeSplineTables(fTSplines_Sigma_YZAngle,fSplineNames_Sigma_YZAngle,fLUT_Sigma_YZAngle);
+  MakeSplineTables(fTSplines_Charge_dEdX,fSplineNames_Charge_dEdX,fLUT_Charge_dEdX);
+  MakeSplineTables(fTSplines_Sigma_dEdX,fSplineNames_Sigma_dEdX,fLUT_Sigma_dEdX);
+
   art::ServiceHandle<art::TFileService> tfs;
   fNt = tfs->make<TNtuple>("nt","Ana Ntuple","edep_e:subroi_q");
   fNtScaleCheck = tfs->make<TNtuple>("nt_scales","Scale Check ntuple",
 				     "plane:e:x:y:z:dxdr:dydr:dzdr:thetaXZ:thetaYZ:dedr:r_Q:r_sigma");
 }
 
+void sys::WireModifier::ModifyWire(recob::Wire const& wire,
+				   std::vector<sim::SimEnergyDeposit> const& edepShiftedVec,
+				   std::vector<sim::SimEnergyDeposit> const& edepOrigVec,
+				   std::vector<recob::Hit> const& hitVec,
+				   double offset_ADC,
+				   recob::Wire::RegionsOfInterest_t & new_rois,
+				   std::vector< std::pair<float,float> > & nt_vals,
+				   sys::WireModifier::ROIScratch_t & scratch)
+{
+
+  //make a new roi list
+  new_rois.resize(wire.SignalROI().size());
+
+  unsigned int my_plane=wire.View();
+
+  for(size_t i_r=0; i_r<wire.SignalROI().get_ranges().size(); ++i_r){
+
+    auto const& range = wire.SignalROI().get_ranges()[i_r];
+    ROI_Key_t roi_key(wire.Channel(),i_r);
+
+
+    std::vector<float> & modified_data = scratch.modified_data;
+    modified_data.assign(range.data().begin(),range.data().end());
+
+    if(fApplyOverallScale)
+	for(size_t i_t=0; i_t<modified_data.size(); ++i_t)
+	  modified_data[i_t] = modified_data[i_t]*fOverallScale[my_plane];
+    
+    //get the matching edeps
+    long roi_idx = GetROIIndex(wire.Channel(),i_r);
+    if(roi_idx<0){	
+	new_rois.add_range(range.begin_index(),modified_data);
+	continue;
+    }
+    std::vector<size_t> const& matchedEdepIdxVec = fROIMatchedEdeps[roi_idx];
+    if(matchedEdepIdxVec.size()==0){
+	new_rois.add_range(range.begin_index(),modified_data);
+	continue;
+    }
+    std::vector<const sim::SimEnergyDeposit*> matchedShiftedEdepPtrVec;
+    matchedShiftedEdepPtrVec.reserve(matchedEdepIdxVec.size());
+    for(auto i_e : matchedEdepIdxVec)
+	matchedShiftedEdepPtrVec.push_back(&edepShiftedVec[i_e]);
+
+
+    // get the matching hits
+    std::vector<const recob::Hit*> matchedHitPtrVec;
+    for( auto i_h : fROIMatchedHits[roi_idx] ) {
+	matchedHitPtrVec.push_back(&hitVec[i_h]);
+    }
+
+    //calc roi properties
+    auto roi_properties = CalcROIProperties(range);
+    roi_properties.key   = roi_key;
+    roi_properties.plane = my_plane;
+
+    /*
+    std::cout << "DOING WIRE ROI (wire=" << wire.Channel() << ", roi_idx=" << i_r
+		<< ", roi_begin=" << roi_properties.begin << ", roi_size=" << roi_properties.end-roi_properties.begin << ")" << std::endl;
+    std::cout << "  Have " << matchedEdepPtrVec.size() << " matching Edeps" << std::endl;
+    std::cout << "  Have " << matchedHitPtrVec.size() << " matching hits" << std::endl;
+    */
+
+    // get the subROIs
+    auto subROIPropVec = CalcSubROIProperties(roi_properties, matchedHitPtrVec);
+    //std::cout << "  Have " << subROIPropVec.size() << " subROIs" << std::endl;
+
+    // get the edeps per subROI
+    auto SubROIMatchedShiftedEdepMap = MatchEdepsToSubROIs(subROIPropVec, matchedShiftedEdepPtrVec, offset_ADC);
+    // convert from shifted edep pointers to original edep pointers (same index in both collections)
+    std::map<SubROI_Key_t, std::vector<const sim::SimEnergyDeposit*>> SubROIMatchedEdepMap;
+    for ( auto const& key_edepPtrVec_pair : SubROIMatchedShiftedEdepMap ) {
+	auto& orig_edep_ptrs = SubROIMatchedEdepMap[key_edepPtrVec_pair.first];
+	for ( auto const& shifted_edep_ptr : key_edepPtrVec_pair.second )
+	  orig_edep_ptrs.push_back(&edepOrigVec[shifted_edep_ptr - edepShiftedVec.data()]);
+    } // end conversion
+    //for ( auto const& pair : SubROIMatchedEdepMap ) std::cout << "  For subROI #" << pair.first.second << ", have " 
+    //<< pair.second.size() << " matching Edeps" << std::endl;
+
+    //get the scaling values
+    std::map<SubROI_Key_t, ScaleValues_t> SubROIMatchedScalesMap;
+    for ( auto const& subroi_prop : subROIPropVec ) {
+	ScaleValues_t scale_vals;
+	auto key = subroi_prop.key;
+	auto key_it =  SubROIMatchedEdepMap.find(key);
+	
+	// if subROI has matched EDeps, use them to get the scale values
+	if ( key_it != SubROIMatchedEdepMap.end() && key_it->second.size() > 0 ) {
+	  auto truth_vals = CalcPropertiesFromEdeps(key_it->second, offset_ADC);
+	  
+	  // fill ntuple with total subROI total energy and total Q information
+	  nt_vals.emplace_back(truth_vals.total_energy,subroi_prop.total_q);
+
+	  // if we have a large it with little energy, default to r_Q = r_sigma = 
+	  if ( truth_vals.total_energy < 0.3 && subroi_prop.total_q > 80 ) {
+	    scale_vals.r_Q     = 1.;
+	    scale_vals.r_sigma = 1.;
+	  }
+	  // otherwise, use scale factors based on EDep properties
+	  else {
+	    if(fUseCollectiveEdepsForScales) //use bulk properties of edeps to determine scale
+	      scale_vals = GetScaleValues(truth_vals, roi_properties);
+	    else //use the energy-weighted average scale values per edep
+	      scale_vals = truth_vals.scales_avg[roi_properties.plane];
+	  }
+	}
+	// otherwise, set scale values to 1
+	else {
+	  scale_vals.r_Q     = 1.;
+	  scale_vals.r_sigma = 1.;
+	}
+	SubROIMatchedScalesMap[key] = scale_vals;
+    }
+    /*
+    for ( auto const& key_scale_pair : SubROIMatchedScalesMap ) {
+      std::cout << "  For subROI #" << key_scale_pair.first.second << ", have "
+                  << "scale factors r_Q = " << key_scale_pair.second.r_Q << " and r_sigma = " << key_scale_pair.second.r_sigma << std::endl;
+
+    }
+    */
+
+    //get modified ROI given scales
+    //std::vector<float> modified_data(range.data());
+    ModifyROI(modified_data, roi_properties, subROIPropVec, SubROIMatchedScalesMap, scratch);
+
+    new_rois.add_range(roi_properties.begin,modified_data);
+    
+  }//end loop over rois
+
+}
+
 void sys::WireModifier::produce(art::Event& e)
 {
 
@@ -1110,149 +1388,46 @@ void sys::WireModifier::produce(art::Event& e)
   std::unique_ptr< std::vector<recob::Wire> > new_wires(new std::vector<recob::Wire>());
   std::unique_ptr< art::Assns<raw::RawDigit,recob::Wire> > new_digit_assn(new art::Assns<raw::RawDigit,recob::Wire>());
 
-  //first fill our roi to edep map
+  //index the rois, then fill our roi to edep map
+  BuildROIIndex(wireVec);
   FillROIMatchedEdepMap(edepShiftedVec,wireVec,offset_ADC);
   // and fill our roi to hit map
   FillROIMatchedHitMap(hitVec,wireVec);
 
-  //loop through the wires and rois per wire...
-  for(size_t i_w=0; i_w<wireVec.size(); ++i_w){
-
-    auto const& wire = wireVec[i_w];
-
-    //make a new roi list
-    recob::Wire::RegionsOfInterest_t new_rois;
-    new_rois.resize(wire.SignalROI().size());
-
-    unsigned int my_plane=wire.View();
-
-    for(size_t i_r=0; i_r<wire.SignalROI().get_ranges().size(); ++i_r){
-
-      auto const& range = wire.SignalROI().get_ranges()[i_r];
-      ROI_Key_t roi_key(wire.Channel(),i_r);
-
-
-      std::vector<float> modified_data(range.data());
-
-      if(fApplyOverallScale)
-	for(size_t i_t=0; i_t<modified_data.size(); ++i_t)
-	  modified_data[i_t] = modified_data[i_t]*fOverallScale[my_plane];
-      
-      //get the matching edeps
-      auto it_map = fROIMatchedEdepMap.find(roi_key);
-      if(it_map==fROIMatchedEdepMap.end()){	
-	new_rois.add_range(range.begin_index(),modified_data);
-	continue;
-      }
-      std::vector<size_t> matchedEdepIdxVec = it_map->second;      
-      if(matchedEdepIdxVec.size()==0){
-	new_rois.add_range(range.begin_index(),modified_data);
-	continue;
-      }
-      std::vector<const sim::SimEnergyDeposit*> matchedEdepPtrVec;
-      std::vector<const sim::SimEnergyDeposit*> matchedShiftedEdepPtrVec;
-      for(auto i_e : matchedEdepIdxVec) {
-	matchedEdepPtrVec.push_back(&edepOrigVec[i_e]);
-	matchedShiftedEdepPtrVec.push_back(&edepShiftedVec[i_e]);
-      }
-
-
-      // get the matching hits
-      std::vector<const recob::Hit*> matchedHitPtrVec;
-      auto it_hit_map = fROIMatchedHitMap.find(roi_key);
-      if( it_hit_map != fROIMatchedHitMap.end() ) {
-	for( auto i_h : it_hit_map->second ) {
-	  matchedHitPtrVec.push_back(&hitVec[i_h]);
-	}
-      }
-
-      //calc roi properties
-      auto roi_properties = CalcROIProperties(range);
-      roi_properties.key   = roi_key;
-      roi_properties.plane = my_plane;
-
-      /*
-      std::cout << "DOING WIRE ROI (wire=" << wire.Channel() << ", roi_idx=" << i_r
-		<< ", roi_begin=" << roi_properties.begin << ", roi_size=" << roi_properties.end-roi_properties.begin << ")" << std::endl;
-      std::cout << "  Have " << matchedEdepPtrVec.size() << " matching Edeps" << std::endl;
-      std::cout << "  Have " << matchedHitPtrVec.size() << " matching hits" << std::endl;
-      */
-
-      // get the subROIs
-      auto subROIPropVec = CalcSubROIProperties(roi_properties, matchedHitPtrVec);
-      //std::cout << "  Have " << subROIPropVec.size() << " subROIs" << std::endl;
-
-      // get the edeps per subROI
-      auto SubROIMatchedShiftedEdepMap = MatchEdepsToSubROIs(subROIPropVec, matchedShiftedEdepPtrVec, offset_ADC);
-      // convert from shifted edep pointers to original edep pointers
-      std::map<SubROI_Key_t, std::vector<const sim::SimEnergyDeposit*>> SubROIMatchedEdepMap;
-      for ( auto const& key_edepPtrVec_pair : SubROIMatchedShiftedEdepMap ) {
-	auto key = key_edepPtrVec_pair.first;
-	for ( auto const& shifted_edep_ptr : key_edepPtrVec_pair.second ) {
-	  for ( unsigned int i_e=0; i_e < matchedShiftedEdepPtrVec.size(); i_e++ ) {
-	    if ( shifted_edep_ptr == matchedShiftedEdepPtrVec[i_e] ) {
-	      SubROIMatchedEdepMap[key].push_back(matchedEdepPtrVec[i_e]);
-	      break;
-	    }
-	  }
-	}
-      } // end conversion
-      //for ( auto const& pair : SubROIMatchedEdepMap ) std::cout << "  For subROI #" << pair.first.second << ", have " 
-      //<< pair.second.size() << " matching Edeps" << std::endl;
-
-      //get the scaling values
-      std::map<SubROI_Key_t, ScaleValues_t> SubROIMatchedScalesMap;
-      for ( auto const& subroi_prop : subROIPropVec ) {
-	ScaleValues_t scale_vals;
-	auto key = subroi_prop.key;
-	auto key_it =  SubROIMatchedEdepMap.find(key);
-	
-	// if subROI has matched EDeps, use them to get the scale values
-	if ( key_it != SubROIMatchedEdepMap.end() && key_it->second.size() > 0 ) {
-	  auto truth_vals = CalcPropertiesFromEdeps(key_it->second, offset_ADC);
-	  
-	  // fill ntuple with total subROI total energy and total Q information
-	  fNt->Fill(truth_vals.total_energy,subroi_prop.total_q);
+  //one output slot per wire, so the wires can be done in any order
+  const size_t n_wires = wireVec.size();
+  std::vector<recob::Wire::RegionsOfInterest_t> new_rois_vec(n_wires);
+  std::vector< std::vector< std::pair<float,float> > > nt_vals_vec(n_wires);
+
+  //the scale check tree is filled from inside the wire processing
+  if(fParallelWires && !fFillScaleCheckTree){
+    tbb::enumerable_thread_specific<ROIScratch_t> scratch_pool;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0,n_wires,std::max(fWireGrainSize,(size_t)1)),
+		      [&](tbb::blocked_range<size_t> const& r){
+			ROIScratch_t & scratch = scratch_pool.local();
+			for(size_t i_w=r.begin(); i_w<r.end(); ++i_w)
+			  ModifyWire(wireVec[i_w],edepShiftedVec,edepOrigVec,hitVec,offset_ADC,
+				     new_rois_vec[i_w],nt_vals_vec[i_w],scratch);
+		      });
+  }
+  else{
+    ROIScratch_t scratch;
+    for(size_t i_w=0; i_w<n_wires; ++i_w)
+      ModifyWire(wireVec[i_w],edepShiftedVec,edepOrigVec,hitVec,offset_ADC,
+		 new_rois_vec[i_w],nt_vals_vec[i_w],scratch);
+  }
 
-	  // if we have a large it with little energy, default to r_Q = r_sigma = 
-	  if ( truth_vals.total_energy < 0.3 && subroi_prop.total_q > 80 ) {
-	    scale_vals.r_Q     = 1.;
-	    scale_vals.r_sigma = 1.;
-	  }
-	  // otherwise, use scale factors based on EDep properties
-	  else {
-	    if(fUseCollectiveEdepsForScales) //use bulk properties of edeps to determine scale
-	      scale_vals = GetScaleValues(truth_vals, roi_properties);
-	    else //use the energy-weighted average scale values per edep
-	      scale_vals = truth_vals.scales_avg[roi_properties.plane];
-	  }
-	}
-	// otherwise, set scale values to 1
-	else {
-	  scale_vals.r_Q     = 1.;
-	  scale_vals.r_sigma = 1.;
-	}
-	SubROIMatchedScalesMap[key] = scale_vals;
-      }
-      /*
-      for ( auto const& key_scale_pair : SubROIMatchedScalesMap ) {
-        std::cout << "  For subROI #" << key_scale_pair.first.second << ", have "
-                    << "scale factors r_Q = " << key_scale_pair.second.r_Q << " and r_sigma = " << key_scale_pair.second.r_sigma << std::endl;
+  //now fill the ntuple and make the outputs in wire order
+  new_wires->reserve(n_wires);
+  for(size_t i_w=0; i_w<n_wires; ++i_w){
 
-      }
-      */
+    auto const& wire = wireVec[i_w];
 
-      //get modified ROI given scales
-      //std::vector<float> modified_data(range.data());
-      ModifyROI(modified_data, roi_properties, subROIPropVec, SubROIMatchedScalesMap);
+    for(auto const& nt_val : nt_vals_vec[i_w])
+      fNt->Fill(nt_val.first,nt_val.second);
 
-      new_rois.add_range(roi_properties.begin,modified_data);
-      
-    }//end loop over rois
-    
     //make our new wire object
-    //std::cout << "adding channel " << wire.Channel() << std::endl; 
-    new_wires->emplace_back(new_rois,wire.Channel(),wire.View());
+    new_wires->emplace_back(std::move(new_rois_vec[i_w]),wire.Channel(),wire.View());
 
     
     //get the associated rawdigit
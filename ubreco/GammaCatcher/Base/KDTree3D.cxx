@@ -0,0 +1,107 @@
+#ifndef GAMMACATCHER_KDTREE3D_CXX
+#define GAMMACATCHER_KDTREE3D_CXX
+
+#include "KDTree3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gammacatcher {
+
+  void KDTree3D::Build(const std::vector<XYZ_t>& pt_v)
+  {
+    Clear();
+    _pt_v = pt_v;
+    // points at no finite distance from anything are left out
+    for (size_t i = 0; i < _pt_v.size(); i++) {
+      if (std::isfinite(_pt_v[i].x) && std::isfinite(_pt_v[i].y) && std::isfinite(_pt_v[i].z))
+	_node_v.push_back(i);
+    }
+    _axis_v.assign(_node_v.size(), 0);
+    BuildNode(0, _node_v.size());
+  }
+
+  void KDTree3D::Clear()
+  {
+    _pt_v.clear();
+    _node_v.clear();
+    _axis_v.clear();
+  }
+
+  void KDTree3D::BuildNode(size_t lo, size_t hi)
+  {
+    if (hi - lo < 2) return;
+
+    // split along the widest extent
+    double lo_v[3], hi_v[3];
+    for (int a = 0; a < 3; a++) {
+      lo_v[a] =  std::numeric_limits<double>::max();
+      hi_v[a] = -std::numeric_limits<double>::max();
+    }
+    for (size_t n = lo; n < hi; n++) {
+      for (int a = 0; a < 3; a++) {
+	double v = Coord(_pt_v[_node_v[n]], a);
+	lo_v[a] = std::min(lo_v[a], v);
+	hi_v[a] = std::max(hi_v[a], v);
+      }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++)
+      if (hi_v[a] - lo_v[a] > hi_v[axis] - lo_v[axis]) axis = a;
+
+    size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(_node_v.begin() + lo, _node_v.begin() + mid, _node_v.begin() + hi,
+		     [&](size_t i, size_t j) { return Coord(_pt_v[i], axis) < Coord(_pt_v[j], axis); });
+    _axis_v[mid] = axis;
+    BuildNode(lo, mid);
+    BuildNode(mid + 1, hi);
+  }
+
+  double KDTree3D::Distance(const XYZ_t& pos, size_t i) const
+  {
+    auto const& pt = _pt_v[i];
+    return std::sqrt((std::pow(pt.x - pos.x, 2)) + (std::pow(pt.y - pos.y, 2)) + (std::pow(pt.z - pos.z, 2)));
+  }
+
+  bool KDTree3D::Nearest(const XYZ_t& pos, double& dist, size_t& idx) const
+  {
+    double best_d = std::numeric_limits<double>::infinity();
+    size_t best_i = std::numeric_limits<size_t>::max();
+    if (std::isfinite(pos.x) && std::isfinite(pos.y) && std::isfinite(pos.z))
+      Search(0, _node_v.size(), pos, best_d, best_i);
+    if (best_i == std::numeric_limits<size_t>::max()) return false;
+    dist = best_d;
+    idx  = best_i;
+    return true;
+  }
+
+  void KDTree3D::Search(size_t lo, size_t hi, const XYZ_t& pos,
+			double& best_d, size_t& best_i) const
+  {
+    if (lo >= hi) return;
+    size_t mid = lo + (hi - lo) / 2;
+    size_t i = _node_v[mid];
+
+    double d = Distance(pos, i);
+    if (d < best_d || (d == best_d && i < best_i)) {
+      best_d = d;
+      best_i = i;
+    }
+    if (hi - lo == 1) return;
+
+    // near side first; the far side can only hold a point at least as close
+    // as the best one if the splitting plane is no further away than that
+    int axis = _axis_v[mid];
+    double diff = Coord(pos, axis) - Coord(_pt_v[i], axis);
+    bool left_first = diff < 0;
+    if (left_first) Search(lo, mid, pos, best_d, best_i);
+    else            Search(mid + 1, hi, pos, best_d, best_i);
+    if (std::abs(diff) > best_d * (1. + 1.e-12)) return;
+    if (left_first) Search(mid + 1, hi, pos, best_d, best_i);
+    else            Search(lo, mid, pos, best_d, best_i);
+  }
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * \file KDTree3D.h
+ *
+ * \ingroup GammaCatcher
+ *
+ * \brief k-d tree over a fixed set of 3D points, for nearest-point queries
+ *
+ */
+
+/** \addtogroup GammaCatcher
+
+    @{*/
+#ifndef GAMMACATCHER_KDTREE3D_H
+#define GAMMACATCHER_KDTREE3D_H
+
+#include <cstddef>
+#include <vector>
+
+namespace gammacatcher {
+
+  /// 3D position [cm]
+  struct XYZ_t {
+    double x;
+    double y;
+    double z;
+  };
+
+  /**
+     \class KDTree3D
+     Balanced k-d tree over a list of points, built once and then queried.
+     Nearest returns the distance sqrt(dx^2+dy^2+dz^2) computed exactly as
+     the analysis modules' brute-force loops do, and among equally distant
+     points the lowest index, so it is a drop-in replacement for such a
+     loop. Points with a non-finite coordinate are never returned.
+     Queries are const and may run concurrently.
+  */
+  class KDTree3D {
+
+  public:
+
+    KDTree3D() {}
+
+    /// Index a list of points (copied)
+    void Build(const std::vector<XYZ_t>& pt_v);
+
+    void Clear();
+
+    /// Number of indexed points
+    size_t Size() const { return _pt_v.size(); }
+
+    /// Distance from pos to the nearest point, whose index goes in idx.
+    /// Returns false if there is none at a finite distance.
+    bool Nearest(const XYZ_t& pos, double& dist, size_t& idx) const;
+
+  private:
+
+    /// Subtree over _node_v[lo,hi): the median element is the node, split
+    /// along _axis_v of that node
+    void BuildNode(size_t lo, size_t hi);
+
+    void Search(size_t lo, size_t hi, const XYZ_t& pos,
+		double& best_d, size_t& best_i) const;
+
+    double Distance(const XYZ_t& pos, size_t i) const;
+
+    static double Coord(const XYZ_t& p, int axis)
+    { return axis == 0 ? p.x : (axis == 1 ? p.y : p.z); }
+
+    std::vector<XYZ_t>  _pt_v;
+    std::vector<size_t> _node_v; ///< point indices in tree order
+    std::vector<int>    _axis_v; ///< split axis, per position in _node_v
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -0,0 +1,252 @@
+#ifndef GAMMACATCHER_PROJECTEDTRACKS_CXX
+#define GAMMACATCHER_PROJECTEDTRACKS_CXX
+
+#include "ProjectedTracks.h"
+
+#include "larcorealg/Geometry/PlaneGeo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace gammacatcher {
+
+  namespace {
+    const double kCellSize = 5.;    ///< starting grid cell size [cm]
+    const double kMinCells = 1024.; ///< grids this small are never coarsened
+    const double kMaxCell  = 1.e9;  ///< queries further out (in cells) scan every point
+    const double kMargin   = 1.e-6; ///< slack on ring distance bounds [cells]
+    const size_t kNone     = std::numeric_limits<size_t>::max();
+  }
+
+  void ProjectedTracks::Build(const std::vector<recob::Track>& track_v,
+			      const geo::PlaneGeo& planeU, const geo::PlaneGeo& planeV,
+			      double wire2cm)
+  {
+    std::vector<size_t> track_idx_v(track_v.size());
+    for (size_t i = 0; i < track_v.size(); i++) track_idx_v[i] = i;
+    Build(track_v, track_idx_v, planeU, planeV, wire2cm);
+  }
+
+  void ProjectedTracks::Build(const std::vector<recob::Track>& track_v,
+			      const std::vector<size_t>& track_idx_v,
+			      const geo::PlaneGeo& planeU, const geo::PlaneGeo& planeV,
+			      double wire2cm)
+  {
+    Clear();
+    _track_idx_v = track_idx_v;
+
+    for (size_t i = 0; i < _track_idx_v.size(); i++) {
+      auto const& track = track_v.at(_track_idx_v[i]);
+      for (size_t m = 0; m < track.NumberTrajectoryPoints(); m++) {
+	auto const& track_loc = track.LocationAtPoint(m);
+	ProjectedPoint_t p;
+	p.w[0] = planeU.WireCoordinate(track_loc) * wire2cm;
+	p.w[1] = planeV.WireCoordinate(track_loc) * wire2cm;
+	p.w[2] = track_loc.Z();
+	p.x    = track_loc.X();
+	p.z    = track_loc.Z();
+	AddPoint(i, m, p);
+      }
+    }
+    _n_points = _x_v.size();
+
+    for (size_t plane = 0; plane < 3; plane++) BuildGrid(plane);
+  }
+
+  void ProjectedTracks::Build(const std::vector<std::vector<ProjectedPoint_t> >& point_vv,
+			      const std::vector<size_t>& track_idx_v)
+  {
+    Clear();
+    _track_idx_v = track_idx_v;
+
+    for (size_t i = 0; i < _track_idx_v.size(); i++) {
+      auto const& point_v = point_vv.at(i);
+      for (size_t m = 0; m < point_v.size(); m++) AddPoint(i, m, point_v[m]);
+    }
+    _n_points = _x_v.size();
+
+    for (size_t plane = 0; plane < 3; plane++) BuildGrid(plane);
+  }
+
+  void ProjectedTracks::AddPoint(size_t track, size_t point, const ProjectedPoint_t& p)
+  {
+    _trk_v.push_back(track);
+    _pt_v.push_back(point);
+    _x_v.push_back(p.x);
+    _z_v.push_back(p.z);
+    for (size_t plane = 0; plane < 3; plane++) _w_v[plane].push_back(p.w[plane]);
+  }
+
+  void ProjectedTracks::Clear()
+  {
+    _track_idx_v.clear();
+    _n_points = 0;
+    _trk_v.clear();
+    _pt_v.clear();
+    _x_v.clear();
+    _z_v.clear();
+    for (size_t plane = 0; plane < 3; plane++) {
+      _w_v[plane].clear();
+      _grid[plane] = PlaneGrid_t();
+    }
+  }
+
+  void ProjectedTracks::BuildGrid(size_t plane)
+  {
+    auto& g = _grid[plane];
+    g = PlaneGrid_t();
+    auto const& w_v = _w_v[plane];
+
+    // points with a non-finite coordinate are at no finite distance from
+    // anything, so they are left out of the grid
+    double wmin =  std::numeric_limits<double>::max(), tmin = wmin;
+    double wmax = -std::numeric_limits<double>::max(), tmax = wmax;
+    size_t n = 0;
+    for (size_t i = 0; i < _n_points; i++) {
+      if (!std::isfinite(w_v[i]) || !std::isfinite(_x_v[i])) continue;
+      wmin = std::min(wmin, w_v[i]); wmax = std::max(wmax, w_v[i]);
+      tmin = std::min(tmin, _x_v[i]); tmax = std::max(tmax, _x_v[i]);
+      n++;
+    }
+    g.start_v.assign(1, 0);
+    if (!n) return;
+
+    // coarsen until there are a few points per cell at most
+    g.cell = kCellSize;
+    while ( ((wmax - wmin) / g.cell + 1.) * ((tmax - tmin) / g.cell + 1.) > 4. * n + kMinCells )
+      g.cell *= 2.;
+    g.w0 = wmin;
+    g.t0 = tmin;
+    g.nw = (int64_t)std::floor((wmax - wmin) / g.cell) + 1;
+    g.nt = (int64_t)std::floor((tmax - tmin) / g.cell) + 1;
+
+    // counting sort by cell, keeping point order within each cell
+    std::vector<size_t> cell_v(_n_points, kNone);
+    g.start_v.assign(g.nw * g.nt + 1, 0);
+    for (size_t i = 0; i < _n_points; i++) {
+      if (!std::isfinite(w_v[i]) || !std::isfinite(_x_v[i])) continue;
+      int64_t iw = std::min(g.nw - 1, std::max((int64_t)0, (int64_t)std::floor((w_v[i] - g.w0) / g.cell)));
+      int64_t it = std::min(g.nt - 1, std::max((int64_t)0, (int64_t)std::floor((_x_v[i] - g.t0) / g.cell)));
+      cell_v[i] = iw * g.nt + it;
+      g.start_v[cell_v[i] + 1] += 1;
+    }
+    for (size_t c = 1; c < g.start_v.size(); c++) g.start_v[c] += g.start_v[c - 1];
+    g.idx_v.resize(n);
+    std::vector<size_t> fill_v(g.start_v.begin(), g.start_v.end() - 1);
+    for (size_t i = 0; i < _n_points; i++)
+      if (cell_v[i] != kNone) g.idx_v[fill_v[cell_v[i]]++] = i;
+  }
+
+  double ProjectedTracks::Distance(size_t plane, const WireTime_t& pos, size_t i) const
+  {
+    // same expression as the modules' brute-force loops
+    return std::sqrt((std::pow(pos.w - _w_v[plane][i], 2)) + (std::pow(pos.t - _x_v[i], 2)));
+  }
+
+  TrackMatch_t ProjectedTracks::Nearest(size_t plane, const std::vector<WireTime_t>& pos_v) const
+  {
+    TrackMatch_t match;
+    if (plane > 2 || _grid[plane].idx_v.empty()) return match;
+    auto const& g = _grid[plane];
+
+    // points are stored track by track, so a lower point index is an earlier
+    // (track, point) pair; with hits scanned in order, a strictly smaller
+    // (distance, point) is what the brute-force loops would have kept
+    double best_d = std::numeric_limits<double>::infinity();
+    size_t best_i = kNone, best_h = 0;
+    auto consider = [&](size_t h, size_t i) {
+      double d = Distance(plane, pos_v[h], i);
+      if (d < best_d || (best_i != kNone && d == best_d && i < best_i)) {
+	best_d = d;
+	best_i = i;
+	best_h = h;
+      }
+    };
+    auto visit = [&](size_t h, int64_t iw, int64_t it) {
+      if (iw < 0 || iw >= g.nw || it < 0 || it >= g.nt) return;
+      size_t c = iw * g.nt + it;
+      for (size_t j = g.start_v[c]; j < g.start_v[c + 1]; j++) consider(h, g.idx_v[j]);
+    };
+
+    for (size_t h = 0; h < pos_v.size(); h++) {
+      double fw = (pos_v[h].w - g.w0) / g.cell;
+      double ft = (pos_v[h].t - g.t0) / g.cell;
+      if (!std::isfinite(fw) || !std::isfinite(ft)) continue;
+      if (std::abs(fw) > kMaxCell || std::abs(ft) > kMaxCell) {
+	for (auto const& i : g.idx_v) consider(h, i);
+	continue;
+      }
+      int64_t cw = (int64_t)std::floor(fw);
+      int64_t ct = (int64_t)std::floor(ft);
+
+      // square rings of cells around the hit, starting from the first one
+      // that reaches the grid; points beyond ring k are at least k cells away
+      int64_t k0 = std::max({(int64_t)0, -cw, cw - (g.nw - 1), -ct, ct - (g.nt - 1)});
+      for (int64_t k = k0; ; k++) {
+	if (k >= 1 && best_i != kNone && best_d < ((double)(k - 1) - kMargin) * g.cell) break;
+	if (k == 0)
+	  visit(h, cw, ct);
+	else {
+	  for (int64_t iw = std::max(cw - k, (int64_t)0); iw <= std::min(cw + k, g.nw - 1); iw++) {
+	    if (iw == cw - k || iw == cw + k) {
+	      for (int64_t it = std::max(ct - k, (int64_t)0); it <= std::min(ct + k, g.nt - 1); it++)
+		visit(h, iw, it);
+	    }
+	    else {
+	      visit(h, iw, ct - k);
+	      visit(h, iw, ct + k);
+	    }
+	  }
+	}
+	if (cw - k <= 0 && cw + k >= g.nw - 1 && ct - k <= 0 && ct + k >= g.nt - 1) break;
+      }
+    }
+
+    if (best_i == kNone) return match;
+    match.found = true;
+    match.dist  = best_d;
+    match.track = _trk_v[best_i];
+    match.point = _pt_v[best_i];
+    match.hit   = best_h;
+    match.x     = _x_v[best_i];
+    match.z     = _z_v[best_i];
+    return match;
+  }
+
+  void ProjectedTracks::TracksWithin(size_t plane, const std::vector<WireTime_t>& pos_v,
+				     double radius, std::vector<size_t>& track_v) const
+  {
+    track_v.clear();
+    if (plane > 2 || _grid[plane].idx_v.empty() || !(radius >= 0)) return;
+    auto const& g = _grid[plane];
+
+    std::vector<bool> near_v(NTracks(), false);
+    for (auto const& pos : pos_v) {
+      if (!std::isfinite(pos.w) || !std::isfinite(pos.t)) continue;
+      // cells overlapping the square around the hit, plus one ring
+      double iw_lo = std::max(std::floor((pos.w - radius - g.w0) / g.cell) - 1., 0.);
+      double iw_hi = std::min(std::floor((pos.w + radius - g.w0) / g.cell) + 1., (double)(g.nw - 1));
+      double it_lo = std::max(std::floor((pos.t - radius - g.t0) / g.cell) - 1., 0.);
+      double it_hi = std::min(std::floor((pos.t + radius - g.t0) / g.cell) + 1., (double)(g.nt - 1));
+      if (iw_lo > iw_hi || it_lo > it_hi) continue;
+      for (int64_t iw = (int64_t)iw_lo; iw <= (int64_t)iw_hi; iw++) {
+	for (int64_t it = (int64_t)it_lo; it <= (int64_t)it_hi; it++) {
+	  size_t c = iw * g.nt + it;
+	  for (size_t j = g.start_v[c]; j < g.start_v[c + 1]; j++) {
+	    size_t i = g.idx_v[j];
+	    if (!near_v[_trk_v[i]] && Distance(plane, pos, i) <= radius)
+	      near_v[_trk_v[i]] = true;
+	  }
+	}
+      }
+    }
+
+    for (size_t t = 0; t < near_v.size(); t++)
+      if (near_v[t]) track_v.push_back(t);
+  }
+
+}
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * \file ProjectedTracks.h
+ *
+ * \ingroup GammaCatcher
+ *
+ * \brief Event-level cache of reco track trajectories projected on the
+ *        three wire planes, with nearest-track and radius queries
+ *
+ */
+
+/** \addtogroup GammaCatcher
+
+    @{*/
+#ifndef GAMMACATCHER_PROJECTEDTRACKS_H
+#define GAMMACATCHER_PROJECTEDTRACKS_H
+
+#include "lardataobj/RecoBase/Track.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace geo {
+  class PlaneGeo;
+}
+
+namespace gammacatcher {
+
+  /// Position on a wire plane: wire coordinate and drift coordinate [cm]
+  struct WireTime_t {
+    double w;
+    double t;
+  };
+
+  /// Trajectory point projected on the three planes
+  struct ProjectedPoint_t {
+    double w[3]; ///< wire coordinate on planes 0, 1 and 2 [cm]
+    double x;    ///< 3D X, also the drift coordinate [cm]
+    double z;    ///< 3D Z [cm]
+  };
+
+  /// Closest (trajectory point, hit) pair found by ProjectedTracks::Nearest
+  struct TrackMatch_t {
+    bool   found = false;
+    double dist  = 0.;
+    size_t track = 0; ///< position of the track in the projected list
+    size_t point = 0; ///< trajectory point of that track
+    size_t hit   = 0; ///< position in the query list
+    double x     = 0.; ///< 3D X of the trajectory point [cm]
+    double z     = 0.; ///< 3D Z of the trajectory point [cm]
+  };
+
+  /**
+     \class ProjectedTracks
+     Projects every trajectory point of a list of tracks once per event on
+     planes 0, 1 and 2, keeping each track as a (wire, time) polyline, and
+     buckets the points of each plane in a uniform grid.
+     The drift coordinate is the point X. The wire coordinate is
+     WireCoordinate * wire2cm on the induction planes and the point Z on the
+     collection plane, as in the GammaCatcher modules. The caller passes the
+     two induction planes, so this class does not touch the geometry service.
+     Distances are hit-to-trajectory-point distances computed exactly as the
+     modules' brute-force loops do, and ties are resolved in the same order
+     (track, then point, then hit), so the queries give bit-identical answers
+     to a scan over every track. Queries are const.
+  */
+  class ProjectedTracks {
+
+  public:
+
+    ProjectedTracks() : _n_points(0) {}
+
+    /// Project all tracks; planeU and planeV are planes 0 and 1
+    void Build(const std::vector<recob::Track>& track_v,
+	       const geo::PlaneGeo& planeU, const geo::PlaneGeo& planeV,
+	       double wire2cm);
+
+    /// Project the tracks track_v[track_idx_v[i]], in that order
+    void Build(const std::vector<recob::Track>& track_v,
+	       const std::vector<size_t>& track_idx_v,
+	       const geo::PlaneGeo& planeU, const geo::PlaneGeo& planeV,
+	       double wire2cm);
+
+    /// Use tracks that are already projected: projected track i has the
+    /// points point_vv[i] and the event index track_idx_v[i]
+    void Build(const std::vector<std::vector<ProjectedPoint_t> >& point_vv,
+	       const std::vector<size_t>& track_idx_v);
+
+    void Clear();
+
+    /// Number of projected tracks
+    size_t NTracks() const { return _track_idx_v.size(); }
+
+    /// Event index of the i-th projected track
+    size_t TrackIndex(size_t i) const { return _track_idx_v[i]; }
+
+    /// Total number of trajectory points over the projected tracks
+    size_t NPoints() const { return _n_points; }
+
+    /// Trajectory point, hit and distance of the closest pair between the
+    /// given positions on a plane and the projected tracks
+    TrackMatch_t Nearest(size_t plane, const std::vector<WireTime_t>& pos_v) const;
+
+    /// Projected tracks, in increasing order, with at least one point at a
+    /// distance not larger than radius from one of the given positions
+    void TracksWithin(size_t plane, const std::vector<WireTime_t>& pos_v,
+		      double radius, std::vector<size_t>& track_v) const;
+
+  private:
+
+    /// Points of one plane bucketed by cell: point indices of cell c are
+    /// idx_v[start_v[c]] ... idx_v[start_v[c+1]-1], in increasing order
+    struct PlaneGrid_t {
+      double w0 = 0., t0 = 0., cell = 1.;
+      int64_t nw = 0, nt = 0;
+      std::vector<size_t> start_v;
+      std::vector<size_t> idx_v;
+    };
+
+    void AddPoint(size_t track, size_t point, const ProjectedPoint_t& p);
+
+    void BuildGrid(size_t plane);
+
+    double Distance(size_t plane, const WireTime_t& pos, size_t i) const;
+
+    std::vector<size_t> _track_idx_v;
+    size_t _n_points;
+
+    /// per point: projected track, trajectory point, 3D X and Z
+    std::vector<size_t> _trk_v;
+    std::vector<size_t> _pt_v;
+    std::vector<double> _x_v;
+    std::vector<double> _z_v;
+
+    /// per plane: wire coordinate of each point [cm]
+    std::vector<double> _w_v[3];
+
+    PlaneGrid_t _grid[3];
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -14,7 +14,6 @@
 #include <fstream>
 #include <memory>
 #include <map>
-#include <tuple>
 
 #include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/EDProducer.h"
@@ -58,6 +57,8 @@
 #include "TVector3.h"
 #include "TGraph.h"
 
+#include "ubreco/GammaCatcher/Base/ProjectedTracks.h"
+
 using namespace std;
 
 class ClusterTrackDistance : public art::EDAnalyzer {
@@ -95,9 +96,6 @@ private:
 
 
 
-  Double_t X_reco=0.0;
-  Double_t Y_reco=0.0;
-  Double_t Z_reco=0.0;
 
   Double_t X_reco3d=0.0;
   Double_t Y_reco3d=0.0;
@@ -132,7 +130,6 @@ private:
   // Double_t Y_reco_best3dU=0.0;
   // Double_t Z_reco_best3dU=0.0;
 
-  Double_t pointdistance=0;
   // Double_t pointdistance3dV=0;
   // Double_t pointdistance3dU=0;
   Double_t pointdistance3d=0;
@@ -147,8 +144,6 @@ private:
 
   Int_t plane;
 
-  Double_t X_reco_smallest=0;
-  Double_t Z_reco_smallest=0;
 
   //Double_t X_reco_smallest3dV=0;
   //Double_t Z_reco_smallest3dV=0;
@@ -162,7 +157,6 @@ private:
   Double_t Z_reco_smallest3d=0;
   Double_t Y_reco_smallest3d=0;
 
-  Double_t pointdistance_smallest;
   //Double_t pointdistance_smallestV;
   //Double_t pointdistance_smallestU;
 
@@ -191,6 +185,8 @@ private:
 
   Double_t wire2cm,time2cm;
 
+  gammacatcher::ProjectedTracks _trk_proj; // reco tracks projected on the wire planes
+
 
   std::vector<Double_t> Start_Cluster0;
   std::vector<Double_t> End_Cluster0;
@@ -285,6 +281,13 @@ void ClusterTrackDistance::analyze(art::Event const & e)//START EVENT LOOP
 
 
   auto const& channelMap = art::ServiceHandle<geo::WireReadout>()->Get();
+
+  // project the tracks once for all clusters
+  _trk_proj.Build(*recotrack_handle,
+		  channelMap.Plane(geo::PlaneID(0,0,0)), channelMap.Plane(geo::PlaneID(0,0,1)),
+		  wire2cm);
+
+  std::vector<gammacatcher::WireTime_t> hit_pos_v;
   for (size_t i_c = 0, size_cluster = cluster_handle->size(); i_c != size_cluster; ++i_c) { //START CLUSTER FOR LOOP
 
     //  if(cluster[i_c].View()==2){//Y CLUSTER IF LOOP
@@ -294,79 +297,25 @@ void ClusterTrackDistance::analyze(art::Event const & e)//START EVENT LOOP
     auto hits = clus_hit_assn_v.at(i_c);
     //  //cout<<"hits.size(): "<<hits.size()<<endl;
 
-    Int_t trackcounter=0;//Variable to keep track of cluster index
-    //Int_t trackcounter_smallest=0;
-
-    for (size_t i_t = 0, size_track = recotrack_handle->size(); i_t != size_track; ++i_t) {//START RECO TRACK FOR LOOP
-      trackcounter++;
-      ////cout<<"***************************************Track Counter: "<<trackcounter<<endl;
-
-
-      auto const& track = recotrack_handle->at(i_t);
-
-
-      pointdistance_smallest=1e10;////Variable for distance between a cluster hit and a reco track point, initialized to a large number for comparison
-      for(size_t m=0;m<(track.NumberTrajectoryPoints());m++){//START RECO POINT LOOP
-
-
-        auto const& track_loc = track.LocationAtPoint(m);
-        std::tie(X_reco, Y_reco, Z_reco) = std::make_tuple(track_loc.X(), track_loc.Y(), track_loc.Z());
-
-        //   //cout<<"X_reco: "<<X_reco<<endl;
-        auto V_wire_cm = channelMap.Plane(geo::PlaneID(0,0,1)).WireCoordinate(track_loc) * wire2cm;
-        auto V_time_cm = X_reco;
-
-        auto U_wire_cm = channelMap.Plane(geo::PlaneID(0,0,0)).WireCoordinate(track_loc) * wire2cm;
-        auto U_time_cm = X_reco;
-
-
-        for (auto const& hit : hits) {//START CLUSTER HIT LOOP
-
-          cluster_hit_z = hit->WireID().Wire * wire2cm;//Also equal to Cluster_hit_wire_cm
-          cluster_hit_x = (hit->PeakTime() * time2cm)-44.575 ;//Also equal to Cluster_hit_time_cm
-
-          if(cluster[i_c].View()==2){
-            plane=2;
-            pointdistance=sqrt((pow(cluster_hit_z-Z_reco,2))+(pow(cluster_hit_x-X_reco,2)));
-
-          }
-          if (cluster[i_c].View()==1){     //    //cout<<"pointdistance: "<<pointdistance<<endl;
-          plane=1;
-
-          pointdistance=sqrt((pow(cluster_hit_z-V_wire_cm,2))+(pow(cluster_hit_x-V_time_cm,2)));
-        }
-
-        if (cluster[i_c].View()==0){     //    //cout<<"pointdistance: "<<pointdistance<<endl;
-        plane=0;
-        pointdistance=sqrt((pow(cluster_hit_z-U_wire_cm,2))+(pow(cluster_hit_x-U_time_cm,2)));
-      }
-
-      if(pointdistance<pointdistance_smallest){//comparison IF loop
-
-        pointdistance_smallest=pointdistance;
-
-        X_reco_smallest=X_reco;
-        Z_reco_smallest=Z_reco;
-
-      }
-
+    hit_pos_v.clear();
+    for (auto const& hit : hits) {//START CLUSTER HIT LOOP
+      hit_pos_v.push_back({ hit->WireID().Wire * wire2cm,            //Also equal to Cluster_hit_wire_cm
+                            (hit->PeakTime() * time2cm)-44.575 });  //Also equal to Cluster_hit_time_cm
     }//END CLUSTER HIT LOOP
 
+    // tree variables hold the last hit looked at and the cluster plane
+    if (!hit_pos_v.empty() && _trk_proj.NPoints() > 0) {
+      cluster_hit_z = hit_pos_v.back().w;
+      cluster_hit_x = hit_pos_v.back().t;
+      if (cluster[i_c].View() <= 2) plane = cluster[i_c].View();
+    }
 
-    ////cout<<"Pointdistance_smallest1: "<<pointdistance_smallest<<endl;
-
-  }//END RECO POINT LOOP
-
-
-  if(pointdistance_smallest<distance_smallest){
-    distance_smallest=pointdistance_smallest;
-    //   trackcounter_smallest=trackcounter;
-    X_reco_best=X_reco_smallest;
-    Z_reco_best=Z_reco_smallest;
-  }
-  //      //cout<<"distance_smallest: "<<distance_smallest<<endl;
-
-}//END RECO TRACK FOR LOOP
+    auto match = _trk_proj.Nearest(cluster[i_c].View(), hit_pos_v);
+    if (match.found && match.dist < distance_smallest) {
+      distance_smallest=match.dist;
+      X_reco_best=match.x;
+      Z_reco_best=match.z;
+    }
 
 
 
@@ -36,8 +36,9 @@
 #include "TTree.h"
 #include "art_root_io/TFileService.h"
 
+#include "ubreco/GammaCatcher/Base/ProjectedTracks.h"
+
 #include <memory>
-#include <tuple>
 
 class Gamma3D : public art::EDProducer {
 public:
@@ -80,10 +81,6 @@ private:
 
 
 
-  Double_t X_reco=0.0;
-  Double_t Y_reco=0.0;
-  Double_t Z_reco=0.0;
-
   //Double_t X_reco_nu=0.0;
   //Double_t Y_reco_nu=0.0;
   //Double_t Z_reco_nu=0.0;
@@ -126,7 +123,6 @@ private:
 
 
 
-  Double_t pointdistance=0;
   //Double_t pointdistance_nu=0;
 
   //Double_t pointdistance3d=0;
@@ -141,9 +137,6 @@ private:
 
   Int_t plane;
 
-  Double_t X_reco_smallest=0;
-  Double_t Z_reco_smallest=0;
-
   //Double_t X_reco_smallest_nu=0;
   //Double_t Z_reco_smallest_nu=0;
 
@@ -159,7 +152,6 @@ private:
   //Double_t Z_reco_smallest3d=0;
   //Double_t Y_reco_smallest3d=0;
 
-  Double_t pointdistance_smallest;
   //Double_t pointdistance_smallest_nu;
 
   //Double_t pointdistance_smallestV;
@@ -190,6 +182,8 @@ private:
 
   Double_t wire2cm,time2cm;
 
+  gammacatcher::ProjectedTracks _trk_proj; // reco tracks projected on the wire planes
+
 
   Double_t start_tick_cluster2,start_tick_cluster1,start_tick_cluster0,end_tick_cluster2,end_tick_cluster1,end_tick_cluster0;
 
@@ -360,6 +354,25 @@ void Gamma3D::produce(art::Event & e)//START EVENT LOOP
   // std::cout<<"size_track: "<<recotrack_handle->size()<<std::endl;
 
   auto const& channelMap = art::ServiceHandle<geo::WireReadout>()->Get();
+
+  // project the tracks once for all clusters. Neutrino Correlated Tracks are
+  // skipped, so all activity close to a neutrino track will be reconstructed.
+  std::vector<size_t> trk_idx_v;
+  for (size_t i_t = 0, size_track = recotrack_handle->size(); i_t != size_track; ++i_t) {
+
+    auto const& track = recotrack_handle->at(i_t);
+
+    if ( (sqrt((pow(nuvtx.position().x()-track.Start().X(),2))+(pow(nuvtx.position().y()-track.Start().Y(),2))+ (pow(nuvtx.position().z()-track.Start().Z(),2))) <5.0) ||  (sqrt((pow(nuvtx.position().x()-track.End().X(),2))+(pow(nuvtx.position().y()-track.End().Y(),2))+ (pow(nuvtx.position().z()-track.End().Z(),2)))<5.0))
+    continue;
+
+    trk_idx_v.push_back(i_t);
+  }
+  _trk_proj.Build(*recotrack_handle, trk_idx_v,
+		  channelMap.Plane(geo::PlaneID(0,0,0)), channelMap.Plane(geo::PlaneID(0,0,1)),
+		  wire2cm);
+
+  std::vector<gammacatcher::WireTime_t> hit_pos_v;
+  std::vector<size_t> near_trk_v;
   for (size_t i_c = 0, size_cluster = cluster_handle->size(); i_c != size_cluster; ++i_c) { //start cluster FOR loop for calculating 2-D distance
 
     // std::cout<<"Cluster # "<<i_c<<std::endl;
@@ -440,127 +453,62 @@ void Gamma3D::produce(art::Event & e)//START EVENT LOOP
     distance_smallest=1e10; //Variable for 2D distance between a cluster and nearest reco track, initialized to a large number for comparison
     distance_smallest_nu=1e10;
 
+    auto hits = clus_hit_assn_v.at(i_c);
 
+    hit_pos_v.clear();
+    for (auto const& hit : hits) {//START CLUSTER HIT LOOP
+      hit_pos_v.push_back({ hit->WireID().Wire * wire2cm,            //Also equal to Cluster_hit_wire_cm
+                            (hit->PeakTime() * time2cm)-44.575 });  //Also equal to Cluster_hit_time_cm
+    }//END CLUSTER HIT LOOP
 
+    // tree variables hold the last hit looked at and the cluster plane
+    if (!hit_pos_v.empty() && _trk_proj.NPoints() > 0) {
+      cluster_hit_z = hit_pos_v.back().w;
+      cluster_hit_x = hit_pos_v.back().t;
+      if (cluster[i_c].View() <= 2) plane = cluster[i_c].View();
+    }
 
+    auto match = _trk_proj.Nearest(cluster[i_c].View(), hit_pos_v);
+    if (match.found && match.dist < distance_smallest) {
+      distance_smallest=match.dist;
+      X_reco_best=match.x; //variables for the coordinates of the nearest reco track
+      Z_reco_best=match.z; //variables for the coordinates of the nearest reco track
+    }
 
-    for (size_t i_t = 0, size_track = recotrack_handle->size(); i_t != size_track; ++i_t) {//START RECO TRACK FOR LOOP
-
-      auto hits = clus_hit_assn_v.at(i_c);
-      auto const& track = recotrack_handle->at(i_t);
-
-      //Neutrino Correlated Tracks are skipped. So all activity close to a neutrino track will be reconstructed.
-
-      if ( (sqrt((pow(nuvtx.position().x()-track.Start().X(),2))+(pow(nuvtx.position().y()-track.Start().Y(),2))+ (pow(nuvtx.position().z()-track.Start().Z(),2))) <5.0) ||  (sqrt((pow(nuvtx.position().x()-track.End().X(),2))+(pow(nuvtx.position().y()-track.End().Y(),2))+ (pow(nuvtx.position().z()-track.End().Z(),2)))<5.0))
-      continue;
-
-
-      pointdistance_smallest=1e10;////Variable for distance between a cluster hit and a reco track point, initialized to a large number for comparison
-
-      for(size_t m=0;m<(track.NumberTrajectoryPoints());m++){//START RECO POINT LOOP
-
-
-        auto const& track_loc = track.LocationAtPoint(m);
-        std::tie(X_reco, Y_reco, Z_reco) = std::make_tuple(track_loc.X(), track_loc.Y(), track_loc.Z());
-
-
-        auto V_wire_cm = channelMap.Plane(geo::PlaneID(0,0,1)).WireCoordinate(track_loc) * wire2cm;
-
-        auto V_time_cm = X_reco;
-
-        auto U_wire_cm = channelMap.Plane(geo::PlaneID(0,0,0)).WireCoordinate(track_loc) * wire2cm;
-
-        auto U_time_cm = X_reco;
-
-
-        for (auto const& hit : hits) {//START CLUSTER HIT LOOP
-
-          cluster_hit_z = hit->WireID().Wire * wire2cm;//Also equal to Cluster_hit_wire_cm
-          cluster_hit_x = (hit->PeakTime() * time2cm)-44.575 ;//Also equal to Cluster_hit_time_cm
-
-          if(cluster[i_c].View()==2){
-            plane=2;
-            pointdistance=sqrt((pow(cluster_hit_z-Z_reco,2))+(pow(cluster_hit_x-X_reco,2)));
-
-          }
-          if (cluster[i_c].View()==1){
-            plane=1;
-
-            pointdistance=sqrt((pow(cluster_hit_z-V_wire_cm,2))+(pow(cluster_hit_x-V_time_cm,2)));
-          }
-
-          if (cluster[i_c].View()==0){
-            plane=0;
-            pointdistance=sqrt((pow(cluster_hit_z-U_wire_cm,2))+(pow(cluster_hit_x-U_time_cm,2)));
-          }
-
-          if(pointdistance<pointdistance_smallest){//comparison IF loop
-
-            pointdistance_smallest=pointdistance;
-
-            X_reco_smallest=X_reco;
-            Z_reco_smallest=Z_reco;
-
-          }
-
-        }//END CLUSTER HIT LOOP
-
-
-
-      }//END RECO POINT LOOP
-
-      // std::cout<<"distance_nu_smallest: "<<distance_nu_smallest<<std::endl;
-      if(pointdistance_smallest<distance_smallest){
-        distance_smallest=pointdistance_smallest;
-        X_reco_best=X_reco_smallest; //variables for the coordinates of the nearest reco track
-        Z_reco_best=Z_reco_smallest; //variables for the coordinates of the nearest reco track
-      }
-
-
-      //}//END RECO TRACK FOR LOOP
-
-
-
-
-
-
+    // The cluster is recorded once for every track looked at while the
+    // nearest track so far was still beyond the cut, i.e. once per track up
+    // to the first one that comes within the cut
+    _trk_proj.TracksWithin(cluster[i_c].View(), hit_pos_v,
+                           (cluster[i_c].View()==2 ? f2DcutY : f2DcutUV), near_trk_v);
+    size_t n_far = near_trk_v.empty() ? _trk_proj.NTracks() : near_trk_v.front();
 
-      // if(cluster[i_c].View()==2 && (distance_smallest > f2DcutY || (distance_smallest_nu > 2.0 && track_point_length_smallest>4.0 ) || (distance_smallest_nu > (2.0*track_point_length_smallest/4.0) && track_point_length_smallest<4.0 )  )) {// IF LOOP TO CHECK WHAT PLANE A CLUSTER BELONGS TO
-      if(cluster[i_c].View()==2 && (distance_smallest > f2DcutY)){
+    for (size_t i_t = 0; i_t != n_far; ++i_t) {
 
+      if(cluster[i_c].View()==2){
 
         Start_Cluster2.push_back((cluster[i_c].StartTick ())-3.0);//added +- 3.0 time tick tolerances
         End_Cluster2.push_back((cluster[i_c].EndTick ())+3.0);
-        // Start_Cluster2.push_back((cluster[i_c].StartTick ()));//added +- 3.0 time tick tolerances
-        // End_Cluster2.push_back((cluster[i_c].EndTick ()));
         Y_clus_hitsize.push_back(clus_hit_assn_v.at(i_c).size());
         Y_index_vector.push_back(i_c); //Y Index vector to store the event index for a given cluster. Very important variable for getting cluster-hit associaton
       }
 
-      if(cluster[i_c].View()==1 && (distance_smallest > f2DcutUV )){//IF LOOP TO CHECK WHAT PLANE A CLUSTER BELONGS TO
-
+      if(cluster[i_c].View()==1){//IF LOOP TO CHECK WHAT PLANE A CLUSTER BELONGS TO
 
         Start_Cluster1.push_back((cluster[i_c].StartTick ())-3.0);
         End_Cluster1.push_back((cluster[i_c].EndTick ())+3.0);
         V_clus_hitsize.push_back(clus_hit_assn_v.at(i_c).size());
-        // Start_Cluster1.push_back((cluster[i_c].StartTick ()));
-        // End_Cluster1.push_back((cluster[i_c].EndTick ()));
         V_index_vector.push_back(i_c);//V Index vector to store the event index for a given cluster. Very important variable for getting cluster-hit associaton
       }
 
-      if(cluster[i_c].View()==0 && (distance_smallest > f2DcutUV )){//IF LOOP TO CHECK WHAT PLANE A CLUSTER BELONGS TO
+      if(cluster[i_c].View()==0){//IF LOOP TO CHECK WHAT PLANE A CLUSTER BELONGS TO
 
-        //
         Start_Cluster0.push_back((cluster[i_c].StartTick ())-3.0);
         End_Cluster0.push_back((cluster[i_c].EndTick ())+3.0);
         U_clus_hitsize.push_back(clus_hit_assn_v.at(i_c).size());
-        // Start_Cluster0.push_back((cluster[i_c].StartTick ()));
-        // End_Cluster0.push_back((cluster[i_c].EndTick ()));
         U_index_vector.push_back(i_c);//U Index vector to store the event index for a given cluster. Very important variable for getting cluster-hit associaton
       }
 
-
-    }//END RECO TRACK FOR LOOP (Thanks to Ivan Lepetic for pointing this out)
+    }
 
     Clustertree->Fill();
   }//end cluster FOR loop for calculating 2-D distance
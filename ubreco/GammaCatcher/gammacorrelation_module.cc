@@ -42,6 +42,12 @@
 #include "TTree.h"
 #include "TRandom3.h"
 #include "art_root_io/TFileService.h"
+
+#include "ubreco/GammaCatcher/Base/KDTree3D.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <memory>
 
 class gammacorrelation;
@@ -124,6 +130,9 @@ private:
 
   bool isData,fData;
 
+  bool fParallelSps; // look up nearest tracks for spacepoints in parallel
+  gammacatcher::KDTree3D _trk_start_tree; // track start points
+
   /** Setup root trees  */
   TTree *potTree;
   double sr_pot = 0;
@@ -159,6 +168,7 @@ gammacorrelation::gammacorrelation(fhicl::ParameterSet const& p)
   fcluster_tag=p.get<std::string>("cluster_tag");
   fData     = p.get< bool >("IsData");
   fReco_track_tag = p.get<std::string>("recotrack_tag"  );
+  fParallelSps = p.get<bool>("ParallelSpacePoints", false);
 }
 
 
@@ -350,6 +360,34 @@ void gammacorrelation::analyze(art::Event const& e)
   }
 
 
+  // Distance from each spacepoint to the nearest track, measured from the
+  // track start point. The start points go in a k-d tree, queried in
+  // parallel chunks of spacepoints if so configured.
+  std::vector<gammacatcher::XYZ_t> trk_start_v;
+  for (auto const& track : *recotrack_handle) {
+    if (track.NumberTrajectoryPoints()==0) continue;
+    trk_start_v.push_back({ track.Start().X(), track.Start().Y(), track.Start().Z() });
+  }
+  _trk_start_tree.Build(trk_start_v);
+
+  std::vector<Double_t> trk_dist_v(spacepoint_handle->size(), 1e10);
+  auto nearest_trk = [&](size_t s) {
+    auto const& xyz = spacepoint_handle->at(s).XYZ();
+    double dist = 0;
+    size_t idx = 0;
+    if (_trk_start_tree.Nearest({ xyz[0], xyz[1], xyz[2] }, dist, idx))
+      trk_dist_v[s] = dist;
+  };
+  if (fParallelSps && trk_dist_v.size() > 1) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, trk_dist_v.size()),
+                      [&](tbb::blocked_range<size_t> const& range) {
+                        for (size_t s = range.begin(); s != range.end(); ++s) nearest_trk(s);
+                      });
+  }
+  else {
+    for (size_t s = 0; s < trk_dist_v.size(); s++) nearest_trk(s);
+  }
+
   for(size_t s=0;s<spacepoint_handle->size();s++){ //START SPACEPOINT LOOP
     N_sps++;
     // std::cout<<"SpacePoint_Number: "<<s<<std::endl;
@@ -357,8 +395,8 @@ void gammacorrelation::analyze(art::Event const& e)
 
     // std::cout<<"SpacePoint_Number: "<<s<<std::endl;
 
-    auto sps = spacepoint_handle->at(s);
-    auto cluster_v = sps_clus_assn_v.at(s);
+    auto const& sps = spacepoint_handle->at(s);
+    auto const& cluster_v = sps_clus_assn_v.at(s);
 
 
     sps_x=sps.XYZ()[0];
@@ -373,94 +411,23 @@ void gammacorrelation::analyze(art::Event const& e)
     distance_smallest_nu=1e10;
 
 
-    for (size_t i_t = 0, size_track = recotrack_handle->size(); i_t != size_track; ++i_t) {//START RECO TRACK FOR LOOP
-
-
-
-
-      auto const& track = recotrack_handle->at(i_t);
-
-      /*
-
-
-      if ( (sqrt((pow(nuvtx.position().x()-track.Start().X(),2))+(pow(nuvtx.position().y()-track.Start().Y(),2))+ (pow(nuvtx.position().z()-track.Start().Z(),2))) <5.0) ||  (sqrt((pow(nuvtx.position().x()-track.End().X(),2))+(pow(nuvtx.position().y()-track.End().Y(),2))+ (pow(nuvtx.position().z()-track.End().Z(),2)))<5.0)){
-
-        // std::cout<<"************************Nu Track # "<<i_t<<" *************************"<<std::endl;
-        // std::cout<<"************************Tracklength # "<<track.Length()<<" *************************"<<std::endl;
-
-
-        pointdistance_smallest_nu=1e10;
-
-        track_point_length=0.0;
-        for(size_t m=0;m<(track.NumberTrajectoryPoints());m++){//START RECO POINT LOOP
-
-          X_reco_nu=track.LocationAtPoint(m).X();
-          Y_reco_nu=track.LocationAtPoint(m).Y();
-          Z_reco_nu=track.LocationAtPoint(m).Z();
-
-
-
-          pointdistance_nu=sqrt((pow(sps_x-X_reco_nu,2))+(pow(sps_y-Y_reco_nu,2))+(pow(sps_z-Z_reco_nu,2)));
-          // std::cout<<"pointdistance_nu: "<<pointdistance_nu<<std::endl;
-          // std::cout<<"trackpointlength: "<<sqrt((pow(X_reco_nu-nuvtx.position().x(),2))+(pow(Y_reco_nu-nuvtx.position().y(),2))+ (pow(Z_reco_nu-nuvtx.position().z(),2)))<<std::endl;
-
-          if(pointdistance_nu<pointdistance_smallest_nu){//comparison IF loop
-
-            pointdistance_smallest_nu=pointdistance_nu;
-
-            X_reco_smallest_nu=X_reco_nu;
-            Y_reco_smallest_nu=Y_reco_nu;
-            Z_reco_smallest_nu=Z_reco_nu;
-            track_point_length= sqrt((pow(X_reco_nu-nuvtx.position().x(),2))+(pow(Y_reco_nu-nuvtx.position().y(),2))+ (pow(Z_reco_nu-nuvtx.position().z(),2)));
-
-          }
-
-        }//END RECO POINT LOOP
-
-        // std::cout<<"pointdistance_smallest_nu: "<<pointdistance_smallest_nu<<std::endl;
-        // std::cout<<"track_point_length: "<<track_point_length<<std::endl;
-
-
-
-        if(pointdistance_smallest_nu<distance_smallest_nu){
-          distance_smallest_nu=pointdistance_smallest_nu;
-          track_point_length_smallest=track_point_length;
-          X_reco_best_nu=X_reco_smallest_nu; //variables for the coordinates of the nearest reco track
-          Z_reco_best_nu=Z_reco_smallest_nu; //variables for the coordinates of the nearest reco track
-        }
-
-        // std::cout<<"distance_smallest_nu: "<<distance_smallest_nu<<std::endl;
-        // std::cout<<"track_point_length_smallest: "<<track_point_length_smallest<<std::endl;
-
-
-
-
-
-      }//END IF LOOP
-
-      */
+    if (trk_dist_v[s]<distance_trk_smallest){
+      distance_trk_smallest=trk_dist_v[s];
+    }
 
-      // std::cout<<"Track Number: "<<i_t<<std::endl;
+    // the per-track branch holds the distance to the last track
+    if (!recotrack_handle->empty()){
+      auto const& track = recotrack_handle->back();
 
       pointdistance_trk_smallest=1e10;
 
-      for(size_t m=0;m<(track.NumberTrajectoryPoints());m++){//START RECO POINT LOOP
-
+      if (track.NumberTrajectoryPoints()>0){
         pointdistance_trk= sqrt((pow(track.Start().X()-sps_x,2))+(pow(track.Start().Y()-sps_y,2))+ (pow(track.Start().Z()-sps_z,2)));
 
         if (pointdistance_trk<pointdistance_trk_smallest){
           pointdistance_trk_smallest=pointdistance_trk;
         }
-
-      }
-
-      // std::cout<<"Distance to track: "<<pointdistance_trk_smallest<<std::endl;
-
-      if (pointdistance_trk_smallest<distance_trk_smallest){
-        distance_trk_smallest=pointdistance_trk_smallest;
-
       }
-
     }
 
     // std::cout<<"pointdistance_smallest_nu_here: "<<pointdistance_smallest_nu<<std::endl;
@@ -40,6 +40,9 @@ namespace michel {
     /// to calculate stuff based on the vecor of
     /// hits for a cluster
     ClusterVectorCalculator _clusterCalc;
+
+    // local stop-watch, totals go through AddTime
+    TStopwatch watch;
     
     std::vector<double> truncated_mean;
     std::vector<double> truncated_dqds;
@@ -52,13 +55,12 @@ namespace michel {
     slope.reserve         (cluster._ordered_pts.size());
     
     //do truncated mean
-    _watch.Start();
+    watch.Start();
     truncated_mean = _clusterCalc.calc_smooth_mean(cluster,
 						   _n_window_size,
 						   _window_cutoff,
 						   _p_above);
-    _t0 += _watch.RealTime();
-    _n0 += 1;
+    AddTime(_t0, _n0, watch.RealTime());
     
     if(truncated_mean.size() < _edgefix) {
       std::stringstream ss;
@@ -76,22 +78,19 @@ namespace michel {
     
     //Directionality considerations
     int dir_window = _covariance_window;
-    _watch.Start();
+    watch.Start();
     covariance     = _clusterCalc.calc_covariance(cluster._hits,dir_window);
-    _t1 += _watch.RealTime();
-    _n1 += 1;
-    _watch.Start();
+    AddTime(_t1, _n1, watch.RealTime());
+    watch.Start();
     slope          = _clusterCalc.calc_slope     (cluster._hits,dir_window);
-    _t2 += _watch.RealTime();
-    _n2 += 1;
+    AddTime(_t2, _n2, watch.RealTime());
     
     // must be odd, currently has no setter,
     // sorry that this method has no info on it, ask vic
     int s = 3; 
-    _watch.Start();
+    watch.Start();
     truncated_dqds = _clusterCalc.calc_smooth_derive(cluster._s_v,truncated_mean,s);
-    _t3 += _watch.RealTime();
-    _n3 += 1;
+    AddTime(_t3, _n3, watch.RealTime());
         
     //Lets play with truncated mean shaving...
     if(_verbosity <= msg::kINFO) {
@@ -112,6 +111,13 @@ namespace michel {
     return true;
   }
 
+  void CalcTruncated::AddTime(double& t, int& n, double dt)
+  {
+    std::lock_guard<std::mutex> lock(_time_mutex);
+    t += dt;
+    n += 1;
+  }
+
   void CalcTruncated::Report(){
 
     std::cout << "T0/clus = " << 1e6*_t0/(double)_n0 << std::endl
@@ -17,6 +17,7 @@
 #include "ubreco/MichelReco/Fmwk/BaseMichelAlgo.h"
 #include <algorithm>
 #include <TStopwatch.h>
+#include <mutex>
 
 namespace michel {
   /**
@@ -81,8 +82,12 @@ namespace michel {
     /// on both edges
     size_t _edgefix;
     
-    // stop-watch for time-profiling
-    TStopwatch _watch;
+    /// add one timed step to a time-profiling total
+    void AddTime(double& t, int& n, double dt);
+
+    // time-profiling totals, updated under _time_mutex as clusters may be
+    // processed concurrently
+    std::mutex _time_mutex;
     double _t0, _t1, _t2, _t3;
     int    _n0, _n1, _n2, _n3;
     
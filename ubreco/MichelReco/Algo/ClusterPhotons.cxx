@@ -20,8 +20,9 @@ namespace michel{
     // grab michel hits
     auto const& michel_hits = cluster._michel;
 
-    // clear the map that links hit index to cluster they have been saved to
-    _hit_cluster_map.clear();
+    // map that links hit index to cluster they have been saved to
+    // (local, so that clusters can be processed concurrently)
+    std::map<size_t,size_t> hit_cluster_map;
 
     // clear this michel's cluster of photons
     cluster._michel._photon_clus_v.clear();
@@ -57,17 +58,17 @@ namespace michel{
 
 	  // if both hits already recorded -> in separate clusters
 	  // merge their clusters
-	  if ( ( _hit_cluster_map.find( i ) != _hit_cluster_map.end() ) and
-	       ( _hit_cluster_map.find( j ) != _hit_cluster_map.end() ) ) {
+	  if ( ( hit_cluster_map.find( i ) != hit_cluster_map.end() ) and
+	       ( hit_cluster_map.find( j ) != hit_cluster_map.end() ) ) {
 
 	    //std::cout << "found hits " << i << " and " << j << " to belong to same cluster and already have different assigned clusters.." << std::endl;
 
 	    // make sure these are different clusters
-	    if ( _hit_cluster_map[i] != _hit_cluster_map[j] ) {
+	    if ( hit_cluster_map[i] != hit_cluster_map[j] ) {
 	      
 	      // which clusters need to be merged?
-	      auto idx1 = _hit_cluster_map[i];
-	      auto idx2 = _hit_cluster_map[j];
+	      auto idx1 = hit_cluster_map[i];
+	      auto idx2 = hit_cluster_map[j];
 
 	      //std::cout << "hits associated w/ clusters " << idx1 << " and " << idx2 << std::endl;
 
@@ -87,9 +88,9 @@ namespace michel{
 	      // to their cluster position in _michel._photon_clus_v
 	      // with what will become the next cluster
 	      for (auto const& idx : cl1)
-		_hit_cluster_map[idx] = cluster._michel._photon_clus_v.size();
+		hit_cluster_map[idx] = cluster._michel._photon_clus_v.size();
 	      for (auto const& idx : cl2)
-		_hit_cluster_map[idx] = cluster._michel._photon_clus_v.size();
+		hit_cluster_map[idx] = cluster._michel._photon_clus_v.size();
 
 	      //std::cout << "remove indices " << idx1 << " and " << idx2 << " from vec of size " << cluster._michel._photon_clus_v.size() << std::endl;
 
@@ -111,7 +112,7 @@ namespace michel{
 	      cluster._michel._photon_clus_v.push_back( clnew );
 	      // for all indices in clnew -> add them to map
 	      for (auto const& idx : clnew)
-		_hit_cluster_map[idx] = cluster._michel._photon_clus_v.size() - 1;
+		hit_cluster_map[idx] = cluster._michel._photon_clus_v.size() - 1;
 	      
 	    }// if both hits belong to different clusters
 	    else{
@@ -124,25 +125,25 @@ namespace michel{
 	  }// if both hits already assigned to a cluster
 
 	  // is hit i recorded in the map?
-	  else if ( _hit_cluster_map.find( i ) != _hit_cluster_map.end() ){
+	  else if ( hit_cluster_map.find( i ) != hit_cluster_map.end() ){
 	    //std::cout << " hit i already in a cluster" << std::endl;
-	    //std::cout << " hit i goes to cluster " << _hit_cluster_map[i] << std::endl;
+	    //std::cout << " hit i goes to cluster " << hit_cluster_map[i] << std::endl;
 	    //std::cout << " total # of clusters : " << cluster._michel._photon_clus_v.size() << std::endl;
-	    cluster._michel._photon_clus_v[ _hit_cluster_map[ i ] ].push_back( j );
-	    _hit_cluster_map[j] = _hit_cluster_map[i];
+	    cluster._michel._photon_clus_v[ hit_cluster_map[ i ] ].push_back( j );
+	    hit_cluster_map[j] = hit_cluster_map[i];
 	  }
 	  // is hit j recorded in the map?
-	  else if ( _hit_cluster_map.find( j ) != _hit_cluster_map.end() ){
+	  else if ( hit_cluster_map.find( j ) != hit_cluster_map.end() ){
 	    //std::cout << " hit j already in a cluster" << std::endl;
-	      cluster._michel._photon_clus_v[ _hit_cluster_map[ j ] ].push_back( i );
-	      _hit_cluster_map[i] = _hit_cluster_map[j];
+	      cluster._michel._photon_clus_v[ hit_cluster_map[ j ] ].push_back( i );
+	      hit_cluster_map[i] = hit_cluster_map[j];
 	  }
 	  else{
 	    //std::cout << " neither hit in a cluster" << std::endl;
 	    std::vector<size_t> new_clus = {i,j};
 	    cluster._michel._photon_clus_v.push_back( new_clus );
-	    _hit_cluster_map[i] = cluster._michel._photon_clus_v.size() - 1;
-	    _hit_cluster_map[j] = cluster._michel._photon_clus_v.size() - 1;
+	    hit_cluster_map[i] = cluster._michel._photon_clus_v.size() - 1;
+	    hit_cluster_map[j] = cluster._michel._photon_clus_v.size() - 1;
 	  }
 	  
 	}// if points are close
@@ -155,17 +156,17 @@ namespace michel{
     for (size_t i=0; i < michel_hits.size(); i++){
 
       // if hit in no cluster
-      if ( _hit_cluster_map.find( i ) == _hit_cluster_map.end() ){
+      if ( hit_cluster_map.find( i ) == hit_cluster_map.end() ){
 	// add to a new 1-hit cluster
 	std::vector<size_t> newclus = {i};
 	cluster._michel._photon_clus_v.push_back( newclus );
-	_hit_cluster_map[i] = cluster._michel._photon_clus_v.size() - 1 ;
+	hit_cluster_map[i] = cluster._michel._photon_clus_v.size() - 1 ;
 	
       }// if hit in no cluster
     }// for all hits
 
     // find the cluster associated with the electron index
-    auto clus_idx = _hit_cluster_map[electron_idx];
+    auto clus_idx = hit_cluster_map[electron_idx];
 
     //if there are only 1 or 2 hits in the Michel electron portion -> remove
     if ( cluster._michel._photon_clus_v.at( clus_idx ).size() <= 2)
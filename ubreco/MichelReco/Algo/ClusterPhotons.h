@@ -53,9 +53,6 @@ namespace michel {
 
     // max distance between hits for them to be in same cluster
     double _d_max;
-
-    // map hit index -> cluster index
-    std::map<size_t,size_t> _hit_cluster_map;
     
   };
 }
@@ -70,20 +70,19 @@ namespace michel {
       Print(msg::kINFO,this->Name(),ss.str());
     }
     
+    // hits already in the michel or the cluster
+    HitIDSet owned(hits.size());
+    owned.InsertHits(michel);
+    owned.InsertHits(cluster._hits);
+
     // get a list of hits that is less than dMax away from either the start or end point
+    std::vector<size_t> near_idx_v;
+    EventHitIndex().WithinEither(hits, start, end, dMax, near_idx_v);
     std::vector<michel::HitPt> nearbyHits;
-    for (auto& h : hits){
-
-      if (h._pl != 2) continue;
-
-      bool there = false;
-      for (auto& mh : michel) { if(mh._id == h._id) { there = true; break;} }
-      for (auto& ch : cluster._hits) { if(ch._id == h._id) { there = true; break;} }
-
-      if (there) continue;
-
-      if ( (start.SqDist(h) < dMax) or (end.SqDist(h) < dMax) )
-	nearbyHits.push_back(h);
+    for (auto const& idx : near_idx_v){
+      auto const& h = hits[idx];
+      if (h._pl != 2 or owned.Contains(h._id)) continue;
+      nearbyHits.push_back(h);
     }
 
     // get slope and intercept for linear fit to hits of michel cluster
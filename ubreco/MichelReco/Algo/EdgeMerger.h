@@ -38,6 +38,9 @@ namespace michel {
 
     /// Priority function assign a priority ordering for a merging function to be called
     double Priority(const MichelCluster& cluster);
+
+    /// Only clusters with touching start/end points are merged
+    double MergeReach() const { return _edge_dist; }
     
     /// setter function _edge_distance
     void SetEdgeDistance(double d) { _edge_dist = d; }
@@ -2,7 +2,6 @@
 #define STEPSUPERSONICCLUSTER_CXX
 
 #include "StepSuperSonicCluster.h"
-#include <algorithm>
 #include <sstream>
 #include <cmath>
 
@@ -33,8 +32,7 @@ namespace michel {
     auto michel_end  = michel[michel.size() - 1];
     auto max_step_sq = _max_step * _max_step;
     
-    std::vector<size_t> taken_hits;
-    taken_hits.reserve(hits.size());
+    HitIDSet taken_hits(hits.size());
 
     
     /// Step around on the end point a bit, jumping to the nearest
@@ -42,7 +40,10 @@ namespace michel {
 
 
     //temporary fix for SSS is add cluster hit ids to taken vector
-    for (auto& ch : cluster._hits) taken_hits.push_back(ch._id);
+    taken_hits.InsertHits(cluster._hits);
+
+    // hits within a step of the current end point
+    std::vector<size_t> step_idx_v;
 
     if (_verbosity == msg::kINFO)
       std::cout << "michel size before step: " << michel.size() << std::endl;
@@ -53,12 +54,13 @@ namespace michel {
       double dist = kINVALID_DOUBLE;
       HitPt  close;
       
-      for (const auto& thishit: hits) {
+      EventHitIndex().Within(hits, michel_end, max_step_sq, step_idx_v);
+      for (auto const& idx : step_idx_v) {
+
+	auto const& thishit = hits[idx];
 
-	/// if I already added this hit move on, std::find probably killer slow, oh well
-	if(std::find(taken_hits.begin(),
-		     taken_hits.end(),
-		     thishit._id) != taken_hits.end()) continue;
+	/// if I already added this hit move on
+	if(taken_hits.Contains(thishit._id)) continue;
 	
 	auto curr_dist = michel_end.SqDist(thishit);
 	if ( curr_dist < dist && curr_dist < max_step_sq) {
@@ -70,7 +72,7 @@ namespace michel {
 
       if(!done) {
 	michel    .push_back(close);
-	taken_hits.push_back(close._id);
+	taken_hits.Insert(close._id);
        
 	michel_end  = michel[michel.size() - 1];
       }
@@ -118,20 +120,19 @@ namespace michel {
       Print(msg::kINFO,this->Name(),ss.str());
     }
     
+    // hits already in the michel or the cluster
+    HitIDSet owned(hits.size());
+    owned.InsertHits(michel);
+    owned.InsertHits(cluster._hits);
+
     // get a list of hits that is less than dMax away from either the start or end point
+    std::vector<size_t> near_idx_v;
+    EventHitIndex().WithinEither(hits, start, end, dMax, near_idx_v);
     std::vector<michel::HitPt> nearbyHits;
-    for (auto& h : hits){
-
-      if (h._pl != 2) continue;
-
-      bool there = false;
-      for (auto& mh : michel) { if(mh._id == h._id) { there = true; break;} }
-      for (auto& ch : cluster._hits) { if(ch._id == h._id) { there = true; break;} }
-
-      if (there) continue;
-
-      if ( (start.SqDist(h) < dMax) or (end.SqDist(h) < dMax) )
-	nearbyHits.push_back(h);
+    for (auto const& idx : near_idx_v){
+      auto const& h = hits[idx];
+      if (h._pl != 2 or owned.Contains(h._id)) continue;
+      nearbyHits.push_back(h);
     }
 
     // merge?
@@ -148,16 +149,10 @@ namespace michel {
       
       // get a list of hits that is less than dMax away from either the start or end point
       std::vector<michel::HitPt> nearbyHits_cpy;
-      bool there;
       for (auto& h : nearbyHits) {
 	
 	if (h._pl != 2) continue;
-	
-	there = false;
-	
-	for (auto& mh : michel) { if(mh._id == h._id) { there = true; break;} }
-	for (auto& ch : cluster._hits) { if(ch._id == h._id) { there = true; break;} }
-	if(there) continue;
+	if (owned.Contains(h._id)) continue;
 	
 	if ( (start.SqDist(h) < dMax) or (end.SqDist(h) < dMax) )
 	  nearbyHits_cpy.push_back(h);
@@ -200,8 +195,10 @@ namespace michel {
       }
       
       // now that we found potential new hits, append them to the michel object
-      for (auto &h : newHits)
+      for (auto &h : newHits) {
 	michel.push_back(h);
+	owned.Insert(h._id);
+      }
       
       
       // recalculte the michel's charge taking into account the new hits
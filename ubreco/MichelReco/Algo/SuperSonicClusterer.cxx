@@ -71,20 +71,19 @@ namespace michel {
     }
 
 
+    // hits already in the michel or the cluster
+    HitIDSet owned(hits.size());
+    owned.InsertHits(michel);
+    owned.InsertHits(cluster._hits);
+
     // get a list of hits that is less than dMax away from either the start or end point
+    std::vector<size_t> near_idx_v;
+    EventHitIndex().WithinEither(hits, start, end, dMax, near_idx_v);
     std::vector<michel::HitPt> nearbyHits;
-    for (auto& h : hits){
-
-      if (h._pl != 2) continue;
-
-      bool there = false;
-      for (auto& mh : michel) { if(mh._id == h._id) { there = true; break;} }
-      for (auto& ch : cluster._hits) { if(ch._id == h._id) { there = true; break;} }
-
-      if (there) continue;
-
-      if ( (start.SqDist(h) < dMax) or (end.SqDist(h) < dMax) )
-	nearbyHits.push_back(h);
+    for (auto const& idx : near_idx_v){
+      auto const& h = hits[idx];
+      if (h._pl != 2 or owned.Contains(h._id)) continue;
+      nearbyHits.push_back(h);
     }
 
     // merge?
@@ -101,17 +100,10 @@ namespace michel {
       
       // get a list of hits that is less than dMax away from either the start or end point
       std::vector<michel::HitPt> nearbyHits_cpy;
-      bool there;
       for (auto& h : nearbyHits) {
 	
 	if (h._pl != 2) continue;
-	
-	there = false;
-	
-	for (auto& mh : michel) { if(mh._id == h._id) { there = true; break;} }
-	if(there) continue;
-	for (auto& ch : cluster._hits) { if(ch._id == h._id) { there = true; break;} }
-	if(there) continue;
+	if (owned.Contains(h._id)) continue;
 	
 	if ( (start.SqDist(h) < dMax) or (end.SqDist(h) < dMax) )
 	  nearbyHits_cpy.push_back(h);
@@ -156,8 +148,10 @@ namespace michel {
       }
       
       // now that we found potential new hits, append them to the michel object
-      for (auto &h : newHits)
+      for (auto &h : newHits) {
 	michel.push_back(h);
+	owned.Insert(h._id);
+      }
       
       
       // recalculte the michel's charge taking into account the new hits
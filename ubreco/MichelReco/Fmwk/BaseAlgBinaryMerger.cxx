@@ -2,11 +2,66 @@
 #define BASEALGBINARYMERGER_CXX
 
 #include "BaseAlgBinaryMerger.h"
-#include "CMergeBookKeeper.h"
-#include <map>
+#include "NearestNeighborGrid.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
 
 namespace michel {
 
+  namespace {
+
+    /// Disjoint sets of cluster indices (union-find)
+    class ClusterSets {
+    public:
+      ClusterSets(size_t n) : _parent(n), _nsets(n)
+      { std::iota(_parent.begin(), _parent.end(), 0); }
+
+      size_t Find(size_t i)
+      {
+	while(_parent[i] != i) {
+	  _parent[i] = _parent[_parent[i]];
+	  i = _parent[i];
+	}
+	return i;
+      }
+
+      void Union(size_t i, size_t j)
+      {
+	i = Find(i); j = Find(j);
+	if(i == j) return;
+	// the smaller index stays the root
+	if(j < i) std::swap(i,j);
+	_parent[j] = i;
+	--_nsets;
+      }
+
+      size_t NSets() const { return _nsets; }
+
+      /// Sets ordered by their smallest index, each in increasing order
+      std::vector<std::vector<size_t> > Result()
+      {
+	std::vector<std::vector<size_t> > result;
+	result.reserve(_nsets);
+	std::vector<size_t> set_of(_parent.size());
+	for(size_t i=0; i<_parent.size(); ++i) {
+	  auto root = Find(i);
+	  if(root == i) {
+	    set_of[i] = result.size();
+	    result.emplace_back();
+	  }
+	  result[set_of[root]].push_back(i);
+	}
+	return result;
+      }
+
+    private:
+      std::vector<size_t> _parent;
+      size_t _nsets;
+    };
+
+  }
+
   MichelClusterArray BaseAlgBinaryMerger::Merge(const MichelClusterArray& input_v)
   {
 
@@ -15,90 +70,110 @@ namespace michel {
     if(input_v.size()<2) return result_v;
     
     while(_recursive) {
-      // Instantiate a book keeper
-      CMergeBookKeeper bk(result_v.size());
 
-      // Compute the priority order & store in an ordered map
-      std::multimap<double,size_t> score_index_m;
-      for(size_t cluster_index=0; cluster_index<result_v.size(); ++cluster_index) {
+      ClusterSets sets(result_v.size());
 
-	auto const& cluster = result_v[cluster_index];
+      // Compute the priority order: highest priority first, ties in input order
+      std::vector<std::pair<double,size_t> > score_index_v;
+      score_index_v.reserve(result_v.size());
+      for(size_t cluster_index=0; cluster_index<result_v.size(); ++cluster_index) {
 
-	auto score = Priority(cluster);
+	auto score = Priority(result_v[cluster_index]);
 
 	if( score <= 0 ) continue;
 
-	score_index_m.emplace( 1./Priority(cluster), cluster_index );
+	score_index_v.emplace_back( 1./score, cluster_index );
       }
-
-      // Loop over possible combinations and try merging
-      for(size_t a_index=0; a_index<score_index_m.size(); ++a_index) {
-
-	// Find cluster a's index
-	auto score_iter_a = score_index_m.begin();
-	std::advance(score_iter_a,a_index);
-	// Obtain cluster a's reference
-	auto const& cluster_a = result_v[(*score_iter_a).second];
-
-	for(size_t b_index=(a_index+1); b_index<score_index_m.size(); ++b_index) {
-
-	  // Find cluster b's index
-	  auto score_iter_b = score_index_m.begin();
-	  std::advance(score_iter_b,b_index);
-	  // Obtain cluster b's reference
-	  auto const& cluster_b = result_v[(*score_iter_b).second];
-
-	  // Inspect to be merged or not
-	  if( Merge(cluster_a,cluster_b) )
-
-	    bk.Merge( (*score_iter_a).second, (*score_iter_b).second );
-		      
-	}	  
+      std::stable_sort(score_index_v.begin(), score_index_v.end(),
+		       [](const std::pair<double,size_t>& lhs,
+			  const std::pair<double,size_t>& rhs)
+		       { return lhs.first < rhs.first; });
+
+      // Inspect pair (a,b), a ahead of b in priority order. Pairs already in
+      // the same merged set need no inspection.
+      auto inspect = [&](size_t a_index, size_t b_index) {
+	auto const& index_a = score_index_v[a_index].second;
+	auto const& index_b = score_index_v[b_index].second;
+	if( sets.Find(index_a) == sets.Find(index_b) ) return;
+	if( Merge(result_v[index_a], result_v[index_b]) )
+	  sets.Union(index_a, index_b);
+      };
+
+      double reach = MergeReach();
+
+      if( !(reach >= 0) ) {
+	// Loop over all combinations and try merging
+	for(size_t a_index=0; a_index<score_index_v.size(); ++a_index)
+	  for(size_t b_index=(a_index+1); b_index<score_index_v.size(); ++b_index)
+	    inspect(a_index, b_index);
       }
-      
-      // If nothing merged, break
-      auto const& bk_result = bk.GetResult();
-
-      if(bk_result.size() == result_v.size()) break;
       else {
-	// Merge ... prepare a temporary vector container
-	MichelClusterArray tmp_result_v;
-	tmp_result_v.reserve(bk_result.size());
-
-	// Loop over merged cluster sets
-	for(auto const& index_set : bk_result) {
-
-	  // Construct a hit vector to be made for a cluster
-	  std::vector<HitPt> hits;
-	  double d_cutoff=0;
-	  size_t min_nhits=0;
-	  // prepare list of cluster indices that are being merged together
-	  std::vector<unsigned short> input_clus_idx_v;
-	  // Loop over index numbers of associated hits
-	  for(auto const& index : index_set) {
-	    auto const& cluster = result_v[index];
-	    if(!min_nhits) {
-	      min_nhits = cluster._min_nhits;
-	      d_cutoff  = cluster._d_cutoff;
-	    }
-	    hits.reserve(hits.size() + cluster._hits.size());
-	    for(auto const& h : cluster._hits)
-	      hits.push_back(h);
-	    // get input cluster index list from this MichelCluster
-	    auto clus_idx_v = result_v[index].getInputClusterIndex_v();
-	    for (auto& clus : clus_idx_v)
-	      input_clus_idx_v.push_back(clus);
+	// Only pairs with nearby start/end points: point 2*i is the start,
+	// 2*i+1 the end of the i-th cluster in priority order
+	std::vector<double> w_v, t_v;
+	w_v.reserve(2*score_index_v.size());
+	t_v.reserve(2*score_index_v.size());
+	for(auto const& score_index : score_index_v) {
+	  auto const& cluster = result_v[score_index.second];
+	  w_v.push_back(cluster._start._w); t_v.push_back(cluster._start._t);
+	  w_v.push_back(cluster._end._w);   t_v.push_back(cluster._end._t);
+	}
+	NearestNeighborGrid grid(w_v, t_v, reach);
+
+	std::vector<size_t> near_v, b_index_v;
+	for(size_t a_index=0; a_index<score_index_v.size(); ++a_index) {
+	  b_index_v.clear();
+	  for(size_t pt=2*a_index; pt<2*a_index+2; ++pt) {
+	    grid.Near(w_v[pt], t_v[pt], reach, near_v);
+	    for(auto const& near_pt : near_v)
+	      if(near_pt/2 > a_index) b_index_v.push_back(near_pt/2);
 	  }
-	  //MichelCluster merged(std::move(hits), min_nhits,d_cutoff);
-	  if (hits.size() >= 3){
-	    MichelCluster merged(std::move(hits), 3, d_cutoff);
-	    // save the index set as this MichelCluster's list of input clusters
-	    merged.setInputClusterIndex_v(input_clus_idx_v);
-	    tmp_result_v.emplace_back(merged);
+	  std::sort(b_index_v.begin(), b_index_v.end());
+	  b_index_v.erase(std::unique(b_index_v.begin(), b_index_v.end()), b_index_v.end());
+	  for(auto const& b_index : b_index_v)
+	    inspect(a_index, b_index);
+	}
+      }
+      
+      // If nothing merged, break
+      if(sets.NSets() == result_v.size()) break;
+
+      // Merge ... build each merged cluster once, in place
+      MichelClusterArray tmp_result_v;
+      tmp_result_v.reserve(sets.NSets());
+
+      // Loop over merged cluster sets
+      for(auto const& index_set : sets.Result()) {
+
+	// Construct a hit vector to be made for a cluster
+	std::vector<HitPt> hits;
+	double d_cutoff=0;
+	size_t min_nhits=0;
+	// prepare list of cluster indices that are being merged together
+	std::vector<unsigned short> input_clus_idx_v;
+	for(auto const& index : index_set)
+	  hits.reserve(hits.size() + result_v[index]._hits.size());
+	// Loop over index numbers of associated hits
+	for(auto const& index : index_set) {
+	  auto& cluster = result_v[index];
+	  if(!min_nhits) {
+	    min_nhits = cluster._min_nhits;
+	    d_cutoff  = cluster._d_cutoff;
 	  }
+	  // result_v is replaced below, so its hits can be moved
+	  std::move(cluster._hits.begin(), cluster._hits.end(), std::back_inserter(hits));
+	  // get input cluster index list from this MichelCluster
+	  auto const& clus_idx_v = cluster.getInputClusterIndex_v();
+	  input_clus_idx_v.insert(input_clus_idx_v.end(), clus_idx_v.begin(), clus_idx_v.end());
+	}
+	//MichelCluster merged(std::move(hits), min_nhits,d_cutoff);
+	if (hits.size() >= 3){
+	  tmp_result_v.emplace_back(std::move(hits), 3, d_cutoff);
+	  // save the index set as this MichelCluster's list of input clusters
+	  tmp_result_v.back().setInputClusterIndex_v(input_clus_idx_v);
 	}
-	result_v = tmp_result_v;
       }
+      std::swap(result_v, tmp_result_v);
     }
 
 
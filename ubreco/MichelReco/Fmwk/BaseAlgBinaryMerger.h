@@ -37,6 +37,13 @@ namespace michel {
     
     /// Priority function assign a priority ordering for a merging function to be called (TO BE IMPLEMENTED)
     virtual double Priority(const MichelCluster& cluster) = 0;
+
+    /**
+       Largest start/end point distance at which Merge can return true: pairs
+       whose start/end points are all further apart are never inspected.
+       Negative (default) means every pair is inspected.
+    */
+    virtual double MergeReach() const { return -1; }
     
     /// Recursive merge flag
     void Recursive(bool doit)
@@ -17,6 +17,7 @@
 #include "ubreco/MichelReco/Fmwk/MichelTypes.h"
 #include "ubreco/MichelReco/Fmwk/MichelCluster.h"
 #include "ubreco/MichelReco/Fmwk/ColorPrint.h"
+#include "ubreco/MichelReco/Fmwk/HitIndex2D.h"
 namespace michel {
   /**
      \class BaseMichelAlgo
@@ -27,7 +28,7 @@ namespace michel {
     
     /// Default constructor
     BaseMichelAlgo()
-      { _verbosity = msg::kNORMAL; _name = "BaseMichelAlgo"; }
+      { _verbosity = msg::kNORMAL; _name = "BaseMichelAlgo"; _hit_index = nullptr; }
     
     /// Default destructor
     virtual ~BaseMichelAlgo(){}
@@ -53,7 +54,21 @@ namespace michel {
 
     virtual void Report(){}
 
+    /// Event hit index, set by MichelRecoManager
+    void SetHitIndex(const HitIndex2D* index) { _hit_index = index; }
+
   protected:
+
+    /// Spatial index for the hit list given to ProcessCluster (an empty
+    /// index, i.e. plain scans over the hit list, if none was set)
+    const HitIndex2D& EventHitIndex() const
+    {
+      static const HitIndex2D no_index;
+      return _hit_index ? *_hit_index : no_index;
+    }
+
+    /// Event hit index (not owned)
+    const HitIndex2D* _hit_index;
     
     /// Name for algorithm
     std::string _name;
@@ -3,6 +3,7 @@
 
 #include "ClusterVectorCalculator.h"
 #include "ubreco/MichelReco/Fmwk/MichelException.h"
+#include "ubreco/MichelReco/Fmwk/NearestNeighborGrid.h"
 #include <cmath>
 #include <algorithm>
 #include <functional>
@@ -608,22 +609,31 @@ namespace michel {
     // Distance vector has the same length as the points vector
     s_v.push_back(0);
     
-    // Marker vector to mark already-used-index
-    std::vector<bool> used_v(hits.size(),false);
-    used_v[start_index]=true;
+    // Grid of the hits with cells of the cut-off distance: only hits in the
+    // cells around the last point can be the next one. Candidates come back
+    // in hit order, so the scan below (and its tie-breaking) is unchanged.
+    std::vector<double> w_v(hits.size()), t_v(hits.size());
+    for(size_t h_index=0; h_index<hits.size(); ++h_index) {
+      w_v[h_index] = hits[h_index]._w;
+      t_v[h_index] = hits[h_index]._t;
+    }
+    const double search_radius = sqrt(d_cutoff);
+    NearestNeighborGrid grid(w_v, t_v, search_radius);
+    grid.Remove(start_index);
+    std::vector<size_t> candidates;
+
     while(ordered_index_v.size() < hits.size()) {
 
       double min_dist  = kINVALID_DOUBLE;
       size_t min_index = kINVALID_SIZE;
-      // Linear search: slow but robust ... think of a better robust way to replace
-      for(size_t h_index=0; h_index<hits.size(); ++h_index) {
 
-	// If used skip
-	if(used_v[h_index]) continue;
+      auto const& last_step = hits[ordered_index_v.back()];
+      grid.Near(last_step._w, last_step._t, search_radius, candidates);
+
+      for(auto const& h_index : candidates) {
 
-	// Take a reference of this hit & last hit
+	// Take a reference of this hit
 	auto const& this_step = hits[h_index];
-	auto const& last_step = hits[ordered_index_v.back()];
 
 	if( (this_step._w - last_step._w) * (this_step._w - last_step._w) > min_dist ) continue;
 	if( (this_step._t - last_step._t) * (this_step._t - last_step._t) > min_dist ) continue;
@@ -644,7 +654,7 @@ namespace michel {
       ordered_index_v.push_back(min_index);
       ds_v.push_back ( sqrt(min_dist)           );
       s_v.push_back  ( s_v.back() + ds_v.back() );
-      used_v[min_index] = true;
+      grid.Remove(min_index);
     }
     // Verbosity report
     if( _verbosity <= msg::kINFO ) {
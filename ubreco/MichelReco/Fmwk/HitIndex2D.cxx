@@ -0,0 +1,74 @@
+#ifndef MICHELCLUSTER_HITINDEX2D_CXX
+#define MICHELCLUSTER_HITINDEX2D_CXX
+
+#include "HitIndex2D.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace michel {
+
+  void HitIndex2D::Build(const std::vector<HitPt>& hits, double cell_size)
+  {
+    _hits   = &hits;
+    _n_hits = hits.size();
+    _w_v.resize(_n_hits);
+    _t_v.resize(_n_hits);
+    for (size_t i = 0; i < _n_hits; ++i) {
+      _w_v[i] = hits[i]._w;
+      _t_v[i] = hits[i]._t;
+    }
+    _grid.reset(new NearestNeighborGrid(_w_v, _t_v, cell_size));
+  }
+
+  void HitIndex2D::Clear()
+  {
+    _grid.reset();
+    _hits   = nullptr;
+    _n_hits = 0;
+    _w_v.clear();
+    _t_v.clear();
+  }
+
+  void HitIndex2D::Candidates(const std::vector<HitPt>& hits,
+			      const HitPt& center, double sq_radius,
+			      std::vector<size_t>& idx_v) const
+  {
+    if (Indexes(hits)) {
+      // Near() returns a sorted list; each hit must appear once so that
+      // Within/WithinEither never count a hit twice
+      _grid->Near(center._w, center._t, std::sqrt(std::max(sq_radius, 0.)), idx_v);
+      idx_v.erase(std::unique(idx_v.begin(), idx_v.end()), idx_v.end());
+      return;
+    }
+    idx_v.resize(hits.size());
+    for (size_t i = 0; i < hits.size(); ++i) idx_v[i] = i;
+  }
+
+  void HitIndex2D::Within(const std::vector<HitPt>& hits,
+			  const HitPt& center, double sq_radius,
+			  std::vector<size_t>& idx_v) const
+  {
+    Candidates(hits, center, sq_radius, idx_v);
+    idx_v.erase(std::remove_if(idx_v.begin(), idx_v.end(),
+			       [&](size_t i) { return !(center.SqDist(hits[i]) < sq_radius); }),
+		idx_v.end());
+  }
+
+  void HitIndex2D::WithinEither(const std::vector<HitPt>& hits,
+				const HitPt& a, const HitPt& b, double sq_radius,
+				std::vector<size_t>& idx_v) const
+  {
+    std::vector<size_t> a_v, b_v;
+    Candidates(hits, a, sq_radius, a_v);
+    Candidates(hits, b, sq_radius, b_v);
+    idx_v.clear();
+    std::set_union(a_v.begin(), a_v.end(), b_v.begin(), b_v.end(), std::back_inserter(idx_v));
+    idx_v.erase(std::remove_if(idx_v.begin(), idx_v.end(),
+			       [&](size_t i) { return !( (a.SqDist(hits[i]) < sq_radius) or
+							 (b.SqDist(hits[i]) < sq_radius) ); }),
+		idx_v.end());
+  }
+
+}
+#endif
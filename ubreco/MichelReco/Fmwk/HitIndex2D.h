@@ -0,0 +1,114 @@
+/**
+ * \file HitIndex2D.h
+ *
+ * \ingroup MichelCluster
+ *
+ * \brief Event-level spatial index of the "ALL" hit list, and a hit-ID set
+ *
+ */
+
+/** \addtogroup MichelCluster
+
+    @{*/
+#ifndef MICHELCLUSTER_HITINDEX2D_H
+#define MICHELCLUSTER_HITINDEX2D_H
+
+#include "ubreco/MichelReco/Fmwk/HitPt.h"
+#include "ubreco/MichelReco/Fmwk/NearestNeighborGrid.h"
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace michel {
+  /**
+     \class HitIndex2D
+     Wire/time grid over the event hit list, built once per event by
+     MichelRecoManager. Radius queries return indices into the hit list in
+     increasing order, i.e. in the order a scan over the whole list would
+     find them, and select exactly the hits with HitPt::SqDist below the
+     given value. Queries on a hit list other than the indexed one fall back
+     to such a scan. Queries are const and may run concurrently.
+  */
+  class HitIndex2D {
+
+  public:
+
+    HitIndex2D() : _hits(nullptr), _n_hits(0) {}
+
+    HitIndex2D(const HitIndex2D&) = delete;
+    HitIndex2D& operator=(const HitIndex2D&) = delete;
+
+    /// Index a hit list, which must stay unchanged while the index is used
+    void Build(const std::vector<HitPt>& hits, double cell_size);
+
+    /// Forget the indexed hit list
+    void Clear();
+
+    /// Whether this index was built on the given hit list
+    bool Indexes(const std::vector<HitPt>& hits) const
+    { return _grid && _hits == &hits && _n_hits == hits.size(); }
+
+    /// Indices of hits h with center.SqDist(h) < sq_radius
+    void Within(const std::vector<HitPt>& hits,
+		const HitPt& center, double sq_radius,
+		std::vector<size_t>& idx_v) const;
+
+    /// Indices of hits h with a.SqDist(h) < sq_radius or b.SqDist(h) < sq_radius
+    void WithinEither(const std::vector<HitPt>& hits,
+		      const HitPt& a, const HitPt& b, double sq_radius,
+		      std::vector<size_t>& idx_v) const;
+
+  private:
+
+    /// Candidate indices near center, all hits if not indexed
+    void Candidates(const std::vector<HitPt>& hits,
+		    const HitPt& center, double sq_radius,
+		    std::vector<size_t>& idx_v) const;
+
+    const std::vector<HitPt>* _hits;
+    size_t _n_hits;
+    std::vector<double> _w_v;
+    std::vector<double> _t_v;
+    std::unique_ptr<NearestNeighborGrid> _grid;
+  };
+
+  /**
+     \class HitIDSet
+     Set of hit IDs with constant-time insert and lookup, for "is this hit
+     already in the cluster/michel" checks. IDs are hit indices in practice,
+     so they go in a bitmap; unusually large IDs go in a hash set.
+  */
+  class HitIDSet {
+
+  public:
+
+    explicit HitIDSet(size_t n_ids = 0) : _bits(n_ids, false) {}
+
+    void Insert(HitID_t id)
+    {
+      if (id < _bits.size()) { _bits[id] = true; return; }
+      if (id < kMaxBits) { _bits.resize(id + 1, false); _bits[id] = true; return; }
+      _others.insert(id);
+    }
+
+    template <class Hits>
+    void InsertHits(const Hits& hits)
+    { for (auto const& h : hits) Insert(h._id); }
+
+    bool Contains(HitID_t id) const
+    {
+      if (id < _bits.size()) return _bits[id];
+      return !_others.empty() && _others.count(id);
+    }
+
+  private:
+
+    static const size_t kMaxBits = 1 << 24;
+
+    std::vector<bool> _bits;
+    std::unordered_set<HitID_t> _others;
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
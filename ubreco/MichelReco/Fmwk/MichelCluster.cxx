@@ -110,6 +110,27 @@ namespace michel {
     , _d_cutoff  ( rhs._d_cutoff  )
   {}
   */
+  size_t MichelCluster::HeapBytes() const
+  {
+    size_t bytes = 0;
+    bytes += _hits.capacity()        * sizeof(HitPt);
+    bytes += _all_hits.capacity()    * sizeof(HitPt);
+    bytes += _ordered_pts.capacity() * sizeof(HitIdx_t);
+    bytes += _ds_v.capacity()        * sizeof(double);
+    bytes += _s_v.capacity()         * sizeof(double);
+    bytes += _chi2_v.capacity()      * sizeof(double);
+    bytes += _t_mean_v.capacity()    * sizeof(double);
+    bytes += _t_dqds_v.capacity()    * sizeof(double);
+    bytes += _dirs_v.capacity()      * sizeof(double);
+    bytes += _cluster_idx_v.capacity() * sizeof(unsigned short);
+    bytes += _michel.capacity()      * sizeof(HitPt);
+    bytes += _michel._electron_hit_idx_v.capacity() * sizeof(size_t);
+    bytes += _michel._photon_clus_v.capacity() * sizeof(std::vector<size_t>);
+    for(auto const& clus : _michel._photon_clus_v)
+      bytes += clus.capacity() * sizeof(size_t);
+    return bytes;
+  }
+
   void MichelCluster::Dump() const
   {
     std::stringstream ss;
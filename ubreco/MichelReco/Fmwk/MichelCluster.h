@@ -89,6 +89,9 @@ public:
     /// Dumps information about this cluster
     void Dump() const;
 
+    /// Heap memory held by the cluster's containers (capacity, in bytes)
+    size_t HeapBytes() const;
+
     //
     // Data attributes
     //
@@ -6,6 +6,9 @@
 #include <sstream>
 #include <iomanip>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 namespace michel {
 
   //-----------------------------------------------------------------
@@ -13,9 +16,11 @@ namespace michel {
     //-----------------------------------------------------------------
     : _d_cutoff           ( 6.0 ) //Used to be 3.6
     , _min_nhits          ( 4   ) //Used to be 25
+    , _hit_index_cell     ( 10. )
     , _alg_merge          ( nullptr )
     , _alg_filter         ( nullptr )
     , _alg_v              ( )
+    , _parallel_clusters  ( false )
   {
     _event_time = 0;
     _event_ctr  = 0;
@@ -55,6 +60,7 @@ namespace michel {
       throw MichelException();
     }
     _all_hit_v = all_hit_v;
+    _hit_index.Build(_all_hit_v, _hit_index_cell);
   }
   
   //-----------------------------------------------------------------
@@ -67,6 +73,7 @@ namespace michel {
       throw MichelException();
     }
     std::swap(_all_hit_v, all_hit_v);
+    _hit_index.Build(_all_hit_v, _hit_index_cell);
   }
   
   //-----------------------------------------------------------------
@@ -89,9 +96,12 @@ namespace michel {
   void MichelRecoManager::AddAlgo(BaseMichelAlgo* algo)
   //-----------------------------------------------------------------
   {
+    algo->SetHitIndex(&_hit_index);
     _alg_v.push_back(algo);
     _alg_time_v.push_back(0.);
     _alg_ctr_v.push_back(0);
+    _alg_drop_v.push_back(0);
+    _alg_alloc_v.push_back(0.);
   }
   
   //-----------------------------------------------------------------
@@ -168,43 +178,40 @@ namespace michel {
     std::vector<MichelCluster> processed_cluster_v;
     processed_cluster_v.reserve(_output_v.size());
 
-    // loop through the various clusters
-    for (auto& cluster : _output_v ) {
-      // start going through algorithms and executing
-      // them consecutively
-      bool keep = true;
-      for (size_t n = 0; n < _alg_v.size() && keep; n++) {
-	if (_verbosity <= msg::kINFO) {
-	  std::stringstream ss;
-	  ss << "running algo : " << _alg_v[n]->Name()
-	     << "(" << n << ")"
-	     << " on MichelCluster ID: " << cluster._id;
-	  Print(msg::kINFO, __FUNCTION__, ss.str());
+    // run the algorithm chain on each cluster. Clusters are independent
+    // (algorithms only read the event hit list), so in parallel mode each
+    // cluster keeps its own profiling counters, summed in cluster order after
+    std::vector<char> keep_v(_output_v.size(), 0);
+    if (_parallel_clusters && _output_v.size() > 1) {
+      const size_t nalgs = _alg_v.size();
+      std::vector<std::vector<double> > time_vv (_output_v.size(), std::vector<double>(nalgs, 0.));
+      std::vector<std::vector<size_t> > ctr_vv  (_output_v.size(), std::vector<size_t>(nalgs, 0));
+      std::vector<std::vector<size_t> > drop_vv (_output_v.size(), std::vector<size_t>(nalgs, 0));
+      std::vector<std::vector<double> > alloc_vv(_output_v.size(), std::vector<double>(nalgs, 0.));
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, _output_v.size(), 1),
+			[&](tbb::blocked_range<size_t> const& range) {
+			  for (size_t i = range.begin(); i != range.end(); ++i)
+			    keep_v[i] = RunAlgoChain(_output_v[i], time_vv[i], ctr_vv[i], drop_vv[i], alloc_vv[i]);
+			});
+      for (size_t i = 0; i < _output_v.size(); ++i) {
+	for (size_t n = 0; n < nalgs; ++n) {
+	  _alg_time_v[n]  += time_vv[i][n];
+	  _alg_ctr_v[n]   += ctr_vv[i][n];
+	  _alg_drop_v[n]  += drop_vv[i][n];
+	  _alg_alloc_v[n] += alloc_vv[i][n];
 	}
-	_watch.Start();
-	MichelCluster before(cluster);
-	keep = _alg_v[n]->ProcessCluster(cluster, _all_hit_v);
-	auto const diff_msg = before.Diff(cluster);
-	if ( !diff_msg.empty() && ( _verbosity <= msg::kDEBUG ) ) {
-	  std::stringstream ss;
-	  ss << "\033[93m Detected a change in MichelCluster (ID=" << cluster._id << ")!\033[00m"
-	     << " by algorithm "
-	     << "\033[95m " << _alg_v[n]->Name() << " (" << n << ") \033[00m" << std::endl
-	     << diff_msg;
-	  Print(msg::kDEBUG, __FUNCTION__, ss.str());
-	}
-	_alg_time_v[n] += _watch.RealTime();
-	_alg_ctr_v[n] += 1;
-	if (!keep && _verbosity <= msg::kINFO) {
-	  std::stringstream ss;
-	  ss << "dropping MichelCluster due to algorithm: "
-	     << _alg_v[n]->Name();
-	  Print(msg::kINFO, __FUNCTION__, ss.str());
-	}
-      }// looping through algorithms
-      
+      }
+    }
+    else {
+      for (size_t i = 0; i < _output_v.size(); ++i)
+	keep_v[i] = RunAlgoChain(_output_v[i], _alg_time_v, _alg_ctr_v, _alg_drop_v, _alg_alloc_v);
+    }
+
+    // loop through the various clusters, in input order
+    for (size_t i = 0; i < _output_v.size(); ++i) {
+      auto& cluster = _output_v[i];
       // If keep is true, move it
-      if (keep) {
+      if (keep_v[i]) {
 	if (_verbosity <= msg::kINFO) {
 	  std::stringstream ss;
 	  ss << " Saving cluster with ID " << cluster._id;
@@ -237,6 +244,59 @@ namespace michel {
     return;
   }// end Process function
   
+  //-----------------------------------------------------------------
+  bool MichelRecoManager::RunAlgoChain(MichelCluster& cluster,
+				       std::vector<double>& time_v,
+				       std::vector<size_t>& ctr_v,
+				       std::vector<size_t>& drop_v,
+				       std::vector<double>& alloc_v) const
+  //-----------------------------------------------------------------
+  {
+    // start going through algorithms and executing
+    // them consecutively
+    TStopwatch watch;
+    bool keep = true;
+    for (size_t n = 0; n < _alg_v.size() && keep; n++) {
+      if (_verbosity <= msg::kINFO) {
+	std::stringstream ss;
+	ss << "running algo : " << _alg_v[n]->Name()
+	   << "(" << n << ")"
+	   << " on MichelCluster ID: " << cluster._id;
+	Print(msg::kINFO, __FUNCTION__, ss.str());
+      }
+      // Keep a copy to report what the algorithm changed only when
+      // that report is going to be printed
+      const bool track_changes = (_verbosity <= msg::kDEBUG);
+      MichelCluster before;
+      if (track_changes) before = cluster;
+      const size_t bytes_before = cluster.HeapBytes();
+      watch.Start();
+      keep = _alg_v[n]->ProcessCluster(cluster, _all_hit_v);
+      time_v[n] += watch.RealTime();
+      ctr_v[n] += 1;
+      alloc_v[n] += (double)cluster.HeapBytes() - (double)bytes_before;
+      if (!keep) drop_v[n] += 1;
+      if (track_changes) {
+	auto const diff_msg = before.Diff(cluster);
+	if ( !diff_msg.empty() ) {
+	  std::stringstream ss;
+	  ss << "\033[93m Detected a change in MichelCluster (ID=" << cluster._id << ")!\033[00m"
+	     << " by algorithm "
+	     << "\033[95m " << _alg_v[n]->Name() << " (" << n << ") \033[00m" << std::endl
+	     << diff_msg;
+	  Print(msg::kDEBUG, __FUNCTION__, ss.str());
+	}
+      }
+      if (!keep && _verbosity <= msg::kINFO) {
+	std::stringstream ss;
+	ss << "dropping MichelCluster due to algorithm: "
+	   << _alg_v[n]->Name();
+	Print(msg::kINFO, __FUNCTION__, ss.str());
+      }
+    }// looping through algorithms
+    return keep;
+  }
+
   //-----------------------------------------------------------------
   void MichelRecoManager::EventReset()
   //-----------------------------------------------------------------
@@ -269,6 +329,10 @@ namespace michel {
       std::cout <<  std::setw(25) << _alg_v[n]->Name() << "\t Algo Time: " 
 		<< std::setw(10) << alg_time * 1.e6  << " [us/cluster]"
 		<< "\t Clusters Scanned: " << _alg_ctr_v[n] << std::endl;
+      double alg_alloc = _alg_alloc_v[n] / ((double)_alg_ctr_v[n]);
+      std::cout <<  std::setw(25) << " " << "\t Heap Change: "
+		<< std::setw(9) << alg_alloc << " [bytes/cluster]"
+		<< "\t Clusters Dropped: " << _alg_drop_v[n] << std::endl;
       if (_alg_v[n]->Name() == "CalcTruncated")
 	_alg_v[n]->EventReset();
       _alg_v[n]->Report();
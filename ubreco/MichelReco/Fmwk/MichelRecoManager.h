@@ -21,6 +21,7 @@
 #include "ubreco/MichelReco/Fmwk/BaseMichelAlgo.h"
 #include "ubreco/MichelReco/Fmwk/MichelAnaBase.h"
 #include "ubreco/MichelReco/Fmwk/ColorPrint.h"
+#include "ubreco/MichelReco/Fmwk/HitIndex2D.h"
 #include <TFile.h>
 #include <TStopwatch.h>
 #include <math.h>
@@ -109,6 +110,12 @@ public:
     /// Setter for setting minimum number of hits to create MichelCluster
     void SetMinNHits(int n)       { _min_nhits = n; }
 
+    /// Cell size of the event hit index [cm]
+    void SetHitIndexCellSize(double d) { _hit_index_cell = d; }
+
+    /// Run the algorithm chain on different clusters concurrently
+    void SetParallelClusters(bool doit) { _parallel_clusters = doit; }
+
     /// Getter for input MichelClusterArray
     MichelClusterArray GetMergedClusters()
     { return _merged_v; }
@@ -131,6 +138,14 @@ public:
 
 protected:
 
+    /// Runs the algorithm chain on one cluster, adding to the per-algorithm
+    /// profiling counters given; returns false if an algorithm dropped it
+    bool RunAlgoChain(MichelCluster& cluster,
+		      std::vector<double>& time_v,
+		      std::vector<size_t>& ctr_v,
+		      std::vector<size_t>& drop_v,
+		      std::vector<double>& alloc_v) const;
+
     // MichelCluster configuration parameters
     ///< MichelCluster's cut-off distance for neighboring cluster
     ///< MAXIMUM distance. Set this to a huge number for very generous ordering
@@ -146,6 +161,10 @@ protected:
     MichelClusterArray _output_v;
     /// "ALL" hit list
     std::vector< ::michel::HitPt > _all_hit_v;
+    /// Spatial index of "ALL" hit list, shared with the algorithms
+    HitIndex2D _hit_index;
+    /// Cell size of _hit_index
+    double _hit_index_cell;
     /// Used hit marker for "ALL" hit list
     std::vector< bool > _used_hit_marker_v;
     //
@@ -159,6 +178,8 @@ protected:
     std::vector< michel::BaseMichelAlgo* > _alg_v;
     /// Analysis to be executed
     std::vector< michel::MichelAnaBase* >  _ana_v;
+    /// Run clusters through _alg_v concurrently
+    bool _parallel_clusters;
 
     //
     // Time profilers
@@ -166,6 +187,8 @@ protected:
     TStopwatch _watch; ///< For profiling
     std::vector<double> _alg_time_v; ///< Overall time for processing
     std::vector<size_t> _alg_ctr_v;  ///< Overall number of clusters processed by algo
+    std::vector<size_t> _alg_drop_v; ///< Number of clusters dropped by algo
+    std::vector<double> _alg_alloc_v;///< Net change in cluster heap memory by algo [bytes]
     double _merge_time; ///< Overall time for processing cluster merging
     size_t _merge_ctr;  ///< number of clusters processed by merging
     TStopwatch _event_watch;
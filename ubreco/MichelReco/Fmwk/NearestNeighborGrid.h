@@ -0,0 +1,148 @@
+/**
+ * \file NearestNeighborGrid.h
+ *
+ * \ingroup MichelCluster
+ *
+ * \brief Uniform 2D grid over a fixed set of points, used to speed up the
+ *        greedy nearest-neighbor hit ordering here and in HitCosmicTag's
+ *        ClassicHitOrderer
+ *
+ */
+
+/** \addtogroup MichelCluster
+
+    @{*/
+#ifndef MICHELCLUSTER_NEARESTNEIGHBORGRID_H
+#define MICHELCLUSTER_NEARESTNEIGHBORGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace michel {
+  /**
+     \class NearestNeighborGrid
+     Buckets points (x,y) into square cells of a given size, and returns the
+     points still in the grid that lie near a position, as a sorted list of
+     point indices. Points are removed as an ordering consumes them.
+     Candidates are a superset of the points within the requested distance, so
+     a caller that scans them in index order with its own distance and
+     tie-break rules gets the same answer as a scan over every point.
+     If the cell size is not a positive finite number, or a coordinate is not
+     finite, every remaining point is a candidate.
+  */
+  class NearestNeighborGrid {
+
+  public:
+
+    NearestNeighborGrid(const std::vector<double>& x,
+			const std::vector<double>& y,
+			double cell_size)
+      : _x(x), _y(y), _cell(cell_size), _alive(x.size(),true), _n_alive(x.size())
+    {
+      _valid = (cell_size > 0 && std::isfinite(cell_size));
+      for(size_t i=0; _valid && i<_x.size(); ++i) {
+	if(!std::isfinite(_x[i]) || !std::isfinite(_y[i]) ||
+	   std::abs(_x[i]/_cell) > kMaxCell || std::abs(_y[i]/_cell) > kMaxCell)
+	  _valid = false;
+      }
+      if(!_valid) return;
+
+      _cell_of.resize(_x.size());
+      for(size_t i=0; i<_x.size(); ++i) {
+	int64_t ix = CellIndex(_x[i]);
+	int64_t iy = CellIndex(_y[i]);
+	if(i==0) { _ix_min = _ix_max = ix; _iy_min = _iy_max = iy; }
+	_ix_min = std::min(_ix_min,ix); _ix_max = std::max(_ix_max,ix);
+	_iy_min = std::min(_iy_min,iy); _iy_max = std::max(_iy_max,iy);
+	_cell_of[i] = Key(ix,iy);
+	_cells[_cell_of[i]].push_back(i);
+      }
+    }
+
+    size_t NRemaining() const { return _n_alive; }
+
+    /// Take a point out of the grid
+    void Remove(size_t i)
+    {
+      if(!_alive[i]) return;
+      _alive[i] = false;
+      --_n_alive;
+      if(!_valid) return;
+      auto& cell = _cells[_cell_of[i]];
+      auto it = std::find(cell.begin(),cell.end(),i);
+      *it = cell.back();
+      cell.pop_back();
+    }
+
+    /// Indices, in increasing order, of the remaining points in the cells
+    /// that overlap the square of half-width r around (x0,y0), including
+    /// one extra ring of cells. Returns true if that is every remaining point.
+    bool Near(double x0, double y0, double r, std::vector<size_t>& candidates) const
+    {
+      candidates.clear();
+
+      bool all = !_valid || !(r < kMaxCell*_cell) ||
+	!std::isfinite(x0) || !std::isfinite(y0) ||
+	std::abs(x0/_cell) > kMaxCell || std::abs(y0/_cell) > kMaxCell;
+
+      int64_t ix_lo=0, ix_hi=0, iy_lo=0, iy_hi=0;
+      if(!all) {
+	ix_lo = std::max(CellIndex(x0-r)-1,_ix_min);
+	ix_hi = std::min(CellIndex(x0+r)+1,_ix_max);
+	iy_lo = std::max(CellIndex(y0-r)-1,_iy_min);
+	iy_hi = std::min(CellIndex(y0+r)+1,_iy_max);
+	if(ix_lo>ix_hi || iy_lo>iy_hi) return false;
+	// looking at more cells than there are points is no faster
+	all = (double)(ix_hi-ix_lo+1)*(double)(iy_hi-iy_lo+1) > (double)_n_alive;
+      }
+
+      if(all) {
+	candidates.reserve(_n_alive);
+	for(size_t i=0; i<_alive.size(); ++i)
+	  if(_alive[i]) candidates.push_back(i);
+	return true;
+      }
+
+      for(int64_t ix=ix_lo; ix<=ix_hi; ++ix) {
+	for(int64_t iy=iy_lo; iy<=iy_hi; ++iy) {
+	  auto it = _cells.find(Key(ix,iy));
+	  if(it==_cells.end()) continue;
+	  candidates.insert(candidates.end(),it->second.begin(),it->second.end());
+	}
+      }
+      std::sort(candidates.begin(),candidates.end());
+
+      return (ix_lo==_ix_min && ix_hi==_ix_max && iy_lo==_iy_min && iy_hi==_iy_max);
+    }
+
+  private:
+
+    // keeps the cell indices of stored points inside 32 bits, so that Key()
+    // is one-to-one; points further out put the grid in scan-all mode
+    static constexpr double kMaxCell = 1.e9;
+
+    int64_t CellIndex(double v) const { return (int64_t)std::floor(v/_cell); }
+
+    // each index keeps its own half of the key
+    static uint64_t Key(int64_t ix, int64_t iy)
+    { return ((uint64_t)(uint32_t)ix << 32) | (uint32_t)iy; }
+
+    const std::vector<double>& _x;
+    const std::vector<double>& _y;
+    double _cell;
+    bool _valid;
+
+    std::vector<bool> _alive;
+    size_t _n_alive;
+
+    std::vector<uint64_t> _cell_of;
+    std::unordered_map<uint64_t, std::vector<size_t> > _cells;
+    int64_t _ix_min=0, _ix_max=0, _iy_min=0, _iy_max=0;
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
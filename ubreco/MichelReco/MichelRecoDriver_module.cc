@@ -109,6 +109,8 @@ MichelRecoDriver::MichelRecoDriver(fhicl::ParameterSet const & p)
 	    << "**********************" << std::endl;
 
   _mgr = new michel::AlgoDefault();
+  _mgr->SetParallelClusters(p.get<bool>("ParallelClusters", false));
+  _mgr->SetHitIndexCellSize(p.get<double>("HitIndexCellSize", 10.));
 
 }
 
@@ -7,6 +7,7 @@
 #include "FlashNeutrinoId_tool.h"
 
 #include "larcore/Geometry/WireReadout.h"
+#include "ubreco/UBFlashFinder/PMTGeoCache.h"
 
 #include <algorithm>
 
@@ -483,27 +484,17 @@ void FlashNeutrinoId::FlashCandidate::GetFlashLocation()
     m_centerY = m_centerZ = 0.;
     m_widthY = m_widthZ = -999.;
     m_totalPE = 0.;
-    float sumy = 0., sumz = 0., sumy2 = 0., sumz2 = 0.;
 
-    art::ServiceHandle<geo::Geometry> geometry;
-    for (unsigned int opdet = 0; opdet < m_peSpectrum.size(); opdet++)
-    {
-        auto const PMTxyz = geometry->OpDetGeoFromOpDet(opdet).GetCenter();
-        // Add up the position, weighting with PEs
-        sumy += m_peSpectrum[opdet] * PMTxyz.Y();
-        sumy2 += m_peSpectrum[opdet] * PMTxyz.Y() * PMTxyz.Y();
-        sumz += m_peSpectrum[opdet] * PMTxyz.Z();
-        sumz2 += m_peSpectrum[opdet] * PMTxyz.Z() * PMTxyz.Z();
-        m_totalPE += m_peSpectrum[opdet];
-    }
-    m_centerY = sumy / m_totalPE;
-    m_centerZ = sumz / m_totalPE;
+    // PE spectrum is indexed by opdet, matching the cached geometry arrays
+    const auto &pmtGeo(pmtana::PMTGeoCache::Get());
+    pmtana::FlashShapeSums<float> sums;
+    sums.Add(m_peSpectrum.data(), pmtGeo.OpDetY(), pmtGeo.OpDetZ(), std::min(m_peSpectrum.size(), pmtGeo.NOpDets()));
+    m_totalPE = sums.totalPE;
+    m_centerY = sums.CenterY();
+    m_centerZ = sums.CenterZ();
     // This is just sqrt(<x^2> - <x>^2)
-    if ((sumy2 * m_totalPE - sumy * sumy) > 0.)
-        m_widthY = std::sqrt(sumy2 * m_totalPE - sumy * sumy) / m_totalPE;
-
-    if ((sumz2 * m_totalPE - sumz * sumz) > 0.)
-        m_widthZ = std::sqrt(sumz2 * m_totalPE - sumz * sumz) / m_totalPE;
+    m_widthY = sums.WidthY(m_widthY);
+    m_widthZ = sums.WidthZ(m_widthZ);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
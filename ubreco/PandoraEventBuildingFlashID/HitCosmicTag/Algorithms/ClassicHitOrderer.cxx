@@ -2,6 +2,7 @@
 #define CLASSICHITORDERER_CXX
 
 #include "ClassicHitOrderer.h"
+#include "ubreco/MichelReco/Fmwk/NearestNeighborGrid.h"
 
 
 namespace cosmictag {
@@ -65,26 +66,53 @@ namespace cosmictag {
     //    std::cout << "BEFORE: " << h.wire << ", " << h.time*4 << std::endl;
     //  }
 
-    _s_hit_v.erase(_s_hit_v.begin() + _start_index);
+    // The remaining hits go in a grid with cells of the allowed hit distance.
+    // The nearest hit is looked for in a growing box around the last ordered
+    // hit, until no hit outside the box can be as close as the best one found.
+    // Candidates come back in hit order, so ties go to the same hit as in a
+    // scan of the whole remaining vector.
+    const std::vector<SimpleHit> hits = _s_hit_v;
+    std::vector<double> time_v(hits.size()), wire_v(hits.size());
+    for (size_t i = 0; i < hits.size(); i++) {
+      time_v[i] = hits[i].time;
+      wire_v[i] = hits[i].wire;
+    }
+    michel::NearestNeighborGrid grid(time_v, wire_v, max_allowed_hit_distance);
+    grid.Remove(_start_index);
+    std::vector<size_t> candidates;
 
     double min_dist = 1e9; 
     int min_index = -1;
 
-    while (_s_hit_v.size() != 0) {
+    while (grid.NRemaining() != 0) {
 
       min_dist = 1e9;
       min_index = -1; 
 
-      for (size_t i = 0; i < _s_hit_v.size(); i++){
+      TVector3 pt1(new_vector.back().time, new_vector.back().wire, 0);
+
+      double search_radius = max_allowed_hit_distance;
+      while (true) {
+
+        bool complete = grid.Near(pt1.X(), pt1.Y(), search_radius, candidates);
+
+        for (auto const& i : candidates) {
 
-        TVector3 pt1(new_vector.back().time, new_vector.back().wire, 0);
-        TVector3 pt2(_s_hit_v.at(i).time,    _s_hit_v.at(i).wire,    0);
-        double dist = (pt1 - pt2).Mag();
+          TVector3 pt2(hits[i].time, hits[i].wire, 0);
+          double dist = (pt1 - pt2).Mag();
 
-        if (dist < min_dist) {
-          min_index = i;
-          min_dist = dist;
+          if (dist < min_dist) {
+            min_index = i;
+            min_dist = dist;
+          }
         }
+
+        // hits outside the box are further than search_radius
+        if (complete || (min_index >= 0 && min_dist < search_radius * (1 - 1e-6))) break;
+
+        min_dist = 1e9;
+        min_index = -1;
+        search_radius *= 2;
       }
 
       if (min_index < 0) {
@@ -95,17 +123,17 @@ namespace cosmictag {
       // Emplace the next hit in the new vector...
       if (min_dist < max_allowed_hit_distance) {
         CT_DEBUG()  << "min_dist: " << min_dist <<std::endl;
-        new_vector.push_back(_s_hit_v.at(min_index));
+        new_vector.push_back(hits.at(min_index));
         _ds_v.push_back(min_dist);
-      } else if (_s_hit_v.at(min_index).wire == new_vector.back().wire && min_dist < 50) {
+      } else if (hits.at(min_index).wire == new_vector.back().wire && min_dist < 50) {
         CT_DEBUG()  << "min_dist: " << min_dist << " => but on same wire, so continue"<< std::endl;
-        new_vector.push_back(_s_hit_v.at(min_index));
+        new_vector.push_back(hits.at(min_index));
         _ds_v.push_back(min_dist);
       } else if (new_vector.size() > 5){
  
         // Calculate previous slope
         auto iter = new_vector.end();
-        auto sh_3 = _s_hit_v.at(min_index);
+        auto sh_3 = hits.at(min_index);
         auto sh_2 = *(--iter);
         auto sh_1 = *(iter-5); // go 5 hits back
         double slope = (sh_2.time - sh_1.time) / (sh_2.wire - sh_1.wire);
@@ -144,15 +172,15 @@ namespace cosmictag {
             min_dist < max_allowed_hit_distance + 50 &&
             progressive_order) {
 
-          new_vector.push_back(_s_hit_v.at(min_index)); 
+          new_vector.push_back(hits.at(min_index)); 
           _ds_v.push_back(min_dist);
 
         } 
 
       }
 
-      // ...and delete it from the old vector
-      _s_hit_v.erase(_s_hit_v.begin() + min_index);
+      // ...and delete it from the remaining hits
+      grid.Remove(min_index);
 
     }
 
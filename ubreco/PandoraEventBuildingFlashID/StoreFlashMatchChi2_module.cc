@@ -45,6 +45,7 @@
 
 #include "larcore/Geometry/WireReadout.h"
 #include "larcore/Geometry/Geometry.h"
+#include "ubreco/UBFlashFinder/PMTGeoCache.h"
 
 #include "TTree.h"
 
@@ -421,27 +422,14 @@ void StoreFlashMatchChi2::produce(art::Event& e)
   // Reset variables
   flash.x = flash.y = flash.z = 0;
   flash.x_err = flash.y_err = flash.z_err = 0;
-  float totalPE = 0.;
-  float sumy = 0., sumz = 0., sumy2 = 0., sumz2 = 0.;
-  
-  for (unsigned int opdet = 0; opdet < PEspectrum.size(); opdet++)
-    {
-      auto const PMTxyz = geometry->OpDetGeoFromOpDet(opdet).GetCenter();
-      // Add up the position, weighting with PEs
-      sumy += PEspectrum[opdet] * PMTxyz.Y();
-      sumy2 += PEspectrum[opdet] * PMTxyz.Y() * PMTxyz.Y();
-      sumz += PEspectrum[opdet] * PMTxyz.Z();
-      sumz2 += PEspectrum[opdet] * PMTxyz.Z() * PMTxyz.Z();
-      totalPE += PEspectrum[opdet];
-    }
-  flash.y = sumy / totalPE;
-  flash.z = sumz / totalPE;
+  const auto& pmtGeo = pmtana::PMTGeoCache::Get();
+  pmtana::FlashShapeSums<float> sums;
+  sums.Add(PEspectrum.data(), pmtGeo.OpDetY(), pmtGeo.OpDetZ(), std::min(PEspectrum.size(), pmtGeo.NOpDets()));
+  flash.y = sums.CenterY();
+  flash.z = sums.CenterZ();
   // This is just sqrt(<x^2> - <x>^2)
-  if ((sumy2 * totalPE - sumy * sumy) > 0.)
-    flash.y_err = std::sqrt(sumy2 * totalPE - sumy * sumy) / totalPE;
-  
-  if ((sumz2 * totalPE - sumz * sumz) > 0.)
-    flash.z_err = std::sqrt(sumz2 * totalPE - sumz * sumz) / totalPE;
+  flash.y_err = sums.WidthY(flash.y_err);
+  flash.z_err = sums.WidthZ(flash.z_err);
   
   // Set the flash properties
   flash.pe_v.resize(nOpDets);
@@ -26,6 +26,9 @@ namespace clusmtool {
     */
     float Float(const std::vector<const cluster::Cluster*> &clusters);
 
+    /// only pairs are scored
+    size_t NumClusters() const { return 2; }
+
     void Report();
     
     void Reset();
@@ -21,13 +21,22 @@ namespace clusmtool {
     */
     float Float(const std::vector<const cluster::Cluster*> &clusters);
 
+    /// only pairs are scored
+    size_t NumClusters() const { return 2; }
+
+    /// pairs with no time overlap are rejected
+    bool RequireTimeOverlap() const { return true; }
+
+    void TimeRange(const ::cluster::Cluster& cluster, double& tmin, double& tmax) const
+    { getMinMaxTime(&cluster,tmin,tmax); }
+
     void Report();
     
     void Reset();
 
   protected:
 
-    void getMinMaxTime(const cluster::Cluster* cluster, double& min, double& max);
+    void getMinMaxTime(const cluster::Cluster* cluster, double& min, double& max) const;
 
     void configure(const fhicl::ParameterSet& pset);
     
@@ -168,20 +177,15 @@ namespace clusmtool {
   }
   
   
-  void CFAlgoIoU::getMinMaxTime(const cluster::Cluster* cluster, double& min, double& max)
+  void CFAlgoIoU::getMinMaxTime(const cluster::Cluster* cluster, double& min, double& max) const
   {
     
-    auto const& hits = cluster->GetHits();
-
+    // hit time range is computed once by the cluster
     min = 9600;
     max = 0;
 
-    for (auto const& hit : hits){
-      
-      if (hit._t > max) max = hit._t;
-      if (hit._t < min) min = hit._t;
-
-    }// fo rall hits
+    if (cluster->_t_max > max) max = cluster->_t_max;
+    if (cluster->_t_min < min) min = cluster->_t_min;
     
     return;
   }
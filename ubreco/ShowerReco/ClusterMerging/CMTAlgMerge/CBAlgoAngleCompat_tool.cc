@@ -37,6 +37,9 @@ namespace clusmtool {
     */
     bool Bool(const ::cluster::Cluster &cluster1,
 	      const ::cluster::Cluster &cluster2);
+
+    /// Bool only reads its configuration
+    bool ConcurrentBool() const { return true; }
     
 
     /// Function to reset the algorithm instance ... maybe implemented via child class
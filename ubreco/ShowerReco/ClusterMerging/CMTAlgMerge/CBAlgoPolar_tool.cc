@@ -22,6 +22,13 @@ namespace clusmtool {
     bool Bool(const ::cluster::Cluster &cluster1,
 	      const ::cluster::Cluster &cluster2);
 
+    /// Bool needs one cluster's span to hold the other's angle, with a gap
+    /// shorter than that cluster: skip pairs where neither holds
+    bool Compatible(const ::cluster::Cluster &cluster1,
+		    const ::cluster::Cluster &cluster2) const;
+
+    /// Bool only reads its configuration, and prints only when verbose
+    bool ConcurrentBool() const { return !_verbose; }
 
     /// Function to reset the algorithm instance ... maybe implemented via child class
     void Reset(){}
@@ -30,7 +37,10 @@ namespace clusmtool {
 
     float _buffer;
     
-    float ClusterDistance(const ::cluster::Cluster& c1, const ::cluster::Cluster& c2);
+    float ClusterDistance(const ::cluster::Cluster& c1, const ::cluster::Cluster& c2) const;
+
+    /// gap along r between the clusters, -1 if it can not be computed
+    float ClusterGap(const ::cluster::Cluster& c1, const ::cluster::Cluster& c2) const;
     
   };
 
@@ -60,7 +70,7 @@ namespace clusmtool {
   //--------------------------------------------------------
   {
 
-    if (cluster1._plane != cluster2._plane)
+    if (_verbose && cluster1._plane != cluster2._plane)
       std::cout << "Different planes!" << std::endl;
 
     auto clusDistance = ClusterDistance(cluster1,cluster2);
@@ -82,7 +92,7 @@ namespace clusmtool {
     }
 
     if (clusDistance < 0) {
-      std::cout << "Error. Distance is  " << clusDistance << std::endl;
+      if (_verbose) { std::cout << "Error. Distance is  " << clusDistance << std::endl; }
       return false;
     }
 
@@ -125,9 +135,43 @@ namespace clusmtool {
     return false;
   }
 
+  //--------------------------------------------------------
+  bool CBAlgoPolar::Compatible(const ::cluster::Cluster &cluster1,
+			       const ::cluster::Cluster &cluster2) const
+  //--------------------------------------------------------
+  {
+    auto clusDistance = ClusterGap(cluster1,cluster2);
+
+    // let Bool report the failure
+    if (clusDistance < 0) return true;
+
+    if ( cluster1._angle_span.inRange(cluster2._angle, _buffer) &&
+	 (clusDistance < cluster1.Length()) )
+      return true;
+
+    if ( cluster2._angle_span.inRange(cluster1._angle, _buffer) &&
+	 (clusDistance < cluster2.Length()) )
+      return true;
+
+    return false;
+  }
+
   // calculate maximum gap between clusters
   float CBAlgoPolar::ClusterDistance(const ::cluster::Cluster& c1,
-				     const ::cluster::Cluster& c2) {
+				     const ::cluster::Cluster& c2) const {
+
+    auto gap = ClusterGap(c1,c2);
+
+    if (_verbose && gap < 0) {
+      std::cout << "C1 [ " << c1._start_pt._r << ", " << c1._end_pt._r << " ]" << std::endl;
+      std::cout << "C2 [ " << c2._start_pt._r << ", " << c2._end_pt._r << " ]" << std::endl;
+    }
+
+    return gap;
+  }
+
+  float CBAlgoPolar::ClusterGap(const ::cluster::Cluster& c1,
+				const ::cluster::Cluster& c2) const {
 
     if ( (c1._start_pt._r >= c2._start_pt._r) && (c1._end_pt._r <= c2._end_pt._r) )
       return 0.;
@@ -145,9 +189,6 @@ namespace clusmtool {
     
     if (c2._start_pt._r > c1._end_pt._r) return c2._start_pt._r - c1._end_pt._r;
 
-    std::cout << "C1 [ " << c1._start_pt._r << ", " << c1._end_pt._r << " ]" << std::endl;
-    std::cout << "C2 [ " << c2._start_pt._r << ", " << c2._end_pt._r << " ]" << std::endl;
-    
     return -1;
   }
 
@@ -67,7 +67,7 @@ bool ClusterMerger::analyze(storage_manager* storage) {
     return true;
   }
 
-  std::vector<std::vector<unsigned short> > merged_indexes;
+  std::vector<std::vector<unsigned int> > merged_indexes;
   bk.PassResult(merged_indexes);
 
   event_hit* ev_hits = nullptr;
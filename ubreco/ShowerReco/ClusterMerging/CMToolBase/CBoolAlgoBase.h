@@ -43,6 +43,22 @@ namespace clusmtool {
       else return true;
     }
 
+    /**
+       Cheap pre-selection run by CMergeManager before Bool: return false for
+       pairs Bool can never accept (e.g. from cluster extents or angle spans)
+       to skip them. Default keeps every pair.
+    */
+    virtual bool Compatible(const ::cluster::Cluster &cluster1,
+			    const ::cluster::Cluster &cluster2) const
+    { return true; }
+
+    /**
+       Whether Bool may be called for different pairs at the same time, i.e.
+       it does not modify the algorithm and its result does not depend on
+       call order. Default false.
+    */
+    virtual bool ConcurrentBool() const { return false; }
+
     /**
        
        Core function: given full event info, return matched index vectors
@@ -41,6 +41,23 @@ namespace clusmtool {
       else return -1;
     }
 
+    /**
+       Number of clusters Float can give a positive score to (0: any).
+       CMatchManager does not build combinations of any other size.
+    */
+    virtual size_t NumClusters() const { return 0; }
+
+    /**
+       Whether Float rejects every combination in which two clusters' time
+       ranges (see TimeRange) do not overlap. If so CMatchManager only builds
+       overlapping combinations.
+    */
+    virtual bool RequireTimeOverlap() const { return false; }
+
+    /// Time range of a cluster, as Float sees it
+    virtual void TimeRange(const ::cluster::Cluster& cluster, double& tmin, double& tmax) const
+    { tmin = cluster._t_min; tmax = cluster._t_max; }
+
   };
 
 }
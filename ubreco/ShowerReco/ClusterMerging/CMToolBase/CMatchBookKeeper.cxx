@@ -2,6 +2,7 @@
 #define RECOTOOL_MATCHBOOKKEEPER_CXX
 
 #include "CMatchBookKeeper.h"
+#include <algorithm>
 
 namespace clusmtool {
 
@@ -18,7 +19,7 @@ namespace clusmtool {
   void CMatchBookKeeper::Match(const std::vector<unsigned int>& matched_indexes,
 			      const float& score)
   {
-    _register.insert(std::make_pair(score,matched_indexes));
+    _register.emplace_back(score,matched_indexes);
   }
 
   
@@ -40,31 +41,60 @@ namespace clusmtool {
     // Rough guess: assume half of registered pairs are good
     result.reserve((unsigned int)(_register.size()/2));
 
+    // Sets are taken from the highest score down, the latest registered
+    // first among equal scores. Once every cluster is used, only empty
+    // sets could still be taken.
     std::vector<bool> used_index;
-    
-    for( auto riter = _register.rbegin();
-	 riter != _register.rend();
-	 ++riter) {
+    size_t nfree = 0;
+    bool has_empty = false;
+    for(auto const& reg : _register) {
+      if(reg.second.empty()) has_empty = true;
+      for(auto const& index : reg.second) {
+	if(index >= used_index.size())
+	  used_index.resize(index+1,true);
+	if(used_index[index]) {
+	  used_index[index] = false;
+	  ++nfree;
+	}
+      }
+    }
 
-      bool valid_set = true;
+    auto lower = [this](size_t a, size_t b) {
+      if(_register[a].first != _register[b].first)
+	return _register[a].first < _register[b].first;
+      return a < b;
+    };
 
-      for(auto const& index : (*riter).second) {
+    std::vector<size_t> heap;
+    heap.reserve(_register.size());
+    for(size_t i=0; i<_register.size(); ++i) heap.push_back(i);
+    std::make_heap(heap.begin(),heap.end(),lower);
 
-	if(index >= used_index.size())
+    while(!heap.empty() && (nfree || has_empty)) {
 
-	  used_index.resize(index+1,false);
+      std::pop_heap(heap.begin(),heap.end(),lower);
+      auto const& indexes = _register[heap.back()].second;
+      heap.pop_back();
 
-	else if(used_index.at(index)) valid_set = false;
+      bool valid_set = true;
+
+      for(auto const& index : indexes) {
+
+	if(used_index[index]) valid_set = false;
 
       }
 
       if(valid_set) {
 
-	result.push_back((*riter).second);
+	result.push_back(indexes);
+
+	for(auto& index : indexes) {
+
+	  if(!used_index[index]) --nfree;
 
-	for(auto& index : (*riter).second)
+	  used_index[index] = true;
 
-	  used_index.at(index) = true;
+	}
 
       }
 
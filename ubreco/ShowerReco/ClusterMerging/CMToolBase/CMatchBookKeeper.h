@@ -16,7 +16,6 @@
 
 #include <iostream>
 #include <vector>
-#include <map>
 #include "CMTException.h"
 
 namespace clusmtool {
@@ -50,7 +49,8 @@ namespace clusmtool {
 
   protected:
 
-    std::multimap<float,std::vector<unsigned int> > _register;
+    /// Registered (score, cluster indexes), in registration order
+    std::vector<std::pair<float,std::vector<unsigned int> > > _register;
 
   };
 }
@@ -2,6 +2,8 @@
 #define RECOTOOL_CMATCHMANAGER_CXX
 
 #include "CMatchManager.h"
+#include <cmath>
+#include <limits>
 
 namespace clusmtool {
 
@@ -57,79 +59,55 @@ namespace clusmtool {
     return res;
   }
 
-  std::vector<std::vector<size_t> > ClusterCombinations(const std::vector<size_t>& seed)
-  {
-  
-    std::vector<size_t> ctr(seed.size(),0);
-    
-    std::vector<std::vector<size_t> > res;
-    
-    while(1) {
-      
-      res.push_back(std::vector<size_t>(seed.size(),0));
-      for(size_t index=0; index<ctr.size(); ++index)
-        
-        (*res.rbegin())[index] = ctr.at(index);
-    
-      for(size_t i=0; i<ctr.size(); ++i) {
-        
-        size_t index = (size_t)(ctr.size()-i-1);
-        
-        ctr.at(index) +=1;
-        
-        if(ctr.at(index) < seed.at(index))
-          
-          break;
-        
-        ctr.at(index) = 0;
-
+  namespace {
+
+  /**
+     Clusters on one plane, by position in the plane's priority-ordered list,
+     that can be combined with clusters whose time ranges span [t_lo,t_hi]:
+     all of them if times are not checked, otherwise those that overlap.
+  */
+  class PlaneTimeIndex {
+
+  public:
+
+    PlaneTimeIndex(const std::vector<double>& tmin_v,
+		   const std::vector<double>& tmax_v,
+		   bool use_time)
+      : _tmin_v(tmin_v), _tmax_v(tmax_v), _use_time(use_time)
+    {
+      for(size_t pos=0; pos<_tmin_v.size(); ++pos) {
+	if(std::isnan(_tmin_v[pos])) _nan_v.push_back(pos);
+	else _sorted_v.emplace_back(_tmin_v[pos],pos);
       }
-
-      bool abort = true;
-      for(auto const& value : ctr)
-        
-        abort = abort && (!(value));
-      
-    if(abort) break;
+      std::sort(_sorted_v.begin(),_sorted_v.end());
     }
-    return res;
-  }
-
-  std::vector<std::vector<std::pair<size_t,size_t> > > PlaneClusterCombinations(const std::vector<size_t>& seed)
-  {
-    // Result container
-    std::vector<std::vector<std::pair<size_t,size_t> > > result;
 
-    // Loop over N-planes: start from max number of planes => down to 2 planes
-    for(size_t i=0; i<seed.size(); ++i) {
-      
-      // If finish making clusters down to 2 palnes, break
-      if(seed.size() < 2+i) break;
+    void Candidates(double t_lo, double t_hi, std::vector<size_t>& pos_v) const
+    {
+      pos_v.clear();
+      if(!_use_time) {
+	for(size_t pos=0; pos<_tmin_v.size(); ++pos) pos_v.push_back(pos);
+	return;
+      }
+      // clusters starting after t_hi can not overlap
+      auto last = std::upper_bound(_sorted_v.begin(),_sorted_v.end(),
+				   std::make_pair(t_hi,std::numeric_limits<size_t>::max()));
+      for(auto iter = _sorted_v.begin(); iter != last; ++iter)
+	if(!(_tmax_v[(*iter).second] < t_lo)) pos_v.push_back((*iter).second);
+      for(auto const& pos : _nan_v)
+	if(!(_tmax_v[pos] < t_lo)) pos_v.push_back(pos);
+      std::sort(pos_v.begin(),pos_v.end());
+    }
 
-      // Compute possible N-plane combinations
-      auto const& plane_comb_v = SimpleCombination(seed.size(),seed.size()-i);
+  private:
 
-      // Loop over possible N-plane combinations
-      for(auto const& plane_comb : plane_comb_v){
+    const std::vector<double>& _tmin_v;
+    const std::vector<double>& _tmax_v;
+    bool _use_time;
+    std::vector<std::pair<double,size_t> > _sorted_v;
+    std::vector<size_t> _nan_v;
+  };
 
-        // Make a seed for cluster combinations
-        std::vector<size_t> cluster_seed_v;
-        cluster_seed_v.reserve(plane_comb.size());
-        for(auto const& index : plane_comb) cluster_seed_v.push_back(seed[index]);
-        
-        // Compute cluster combinations
-        for(auto const& cluster_comb : ClusterCombinations(cluster_seed_v)) {
-          
-          // Store result
-          result.push_back(std::vector<std::pair<size_t,size_t> >());
-          for(size_t i=0; i<cluster_comb.size(); ++i)
-            
-            (*result.rbegin()).push_back(std::make_pair(plane_comb.at(i),cluster_comb.at(i)));
-        }
-      }
-    }
-    return result;
-      
   }
 
   bool CMatchManager::IterationProcess()
@@ -175,32 +153,49 @@ namespace clusmtool {
 
       cluster_array.at( plane_to_index.at(_in_clusters.at((*riter).second)._plane) ).push_back((*riter).second);
 
-    // Find combinations
-    std::vector<size_t> seed;
-    seed.reserve(cluster_array.size());
-    for(auto const& clusters_per_plane : cluster_array)
+    // Time range of each cluster, per plane in cluster_array order
+    bool use_time = _match_algo->RequireTimeOverlap();
+    std::vector<std::vector<double> > tmin_array(cluster_array.size());
+    std::vector<std::vector<double> > tmax_array(cluster_array.size());
+    std::vector<PlaneTimeIndex> time_index_v;
+    time_index_v.reserve(cluster_array.size());
+    for(size_t plane_index=0; plane_index<cluster_array.size(); ++plane_index) {
+      if(use_time) {
+	for(auto const& in_cluster_index : cluster_array[plane_index]) {
+	  double tmin, tmax;
+	  _match_algo->TimeRange(_in_clusters.at(in_cluster_index),tmin,tmax);
+	  tmin_array[plane_index].push_back(tmin);
+	  tmax_array[plane_index].push_back(tmax);
+	}
+      }
+      else {
+	tmin_array[plane_index].resize(cluster_array[plane_index].size(),0.);
+	tmax_array[plane_index].resize(cluster_array[plane_index].size(),0.);
+      }
+      time_index_v.emplace_back(tmin_array[plane_index],tmax_array[plane_index],use_time);
+    }
 
-      seed.push_back(clusters_per_plane.size());
-    
-    auto const& combinations = PlaneClusterCombinations(seed);
+    size_t num_clusters = _match_algo->NumClusters();
 
-    if(_debug_mode <= kPerIteration) 
-      std::cout << "\033[93m checking through " << combinations.size() << " combinations \033[00m" << std::endl;
-    
-    // Loop over combinations and call algorithm
-    for(auto const& comb : combinations) {
+    size_t ncombinations = 0;
+
+    // Score one combination, given as positions in cluster_array per plane
+    auto score_combination = [&](const std::vector<size_t>& plane_comb,
+				 const std::vector<size_t>& pos_comb) {
+
+      ++ncombinations;
 
       std::vector<const cluster::Cluster*> ptr_v;
 
       std::vector<unsigned int> tmp_index_v;
 
-      tmp_index_v.reserve(comb.size());
+      tmp_index_v.reserve(plane_comb.size());
 
-      ptr_v.reserve(comb.size());
+      ptr_v.reserve(plane_comb.size());
 
-      for(auto const& plane_cluster : comb) {
+      for(size_t i=0; i<plane_comb.size(); ++i) {
         
-        auto const& in_cluster_index = cluster_array.at(plane_cluster.first).at(plane_cluster.second);
+        auto const& in_cluster_index = cluster_array.at(plane_comb[i]).at(pos_comb[i]);
 
         tmp_index_v.push_back(in_cluster_index);
 
@@ -229,8 +224,61 @@ namespace clusmtool {
       if(score>0)
         
         _book_keeper.Match(tmp_index_v,score);
-
+    };
+
+    // Loop over N-planes: start from max number of planes => down to 2 planes.
+    // For each set of planes, clusters are combined in the same (lexicographic)
+    // order as a full enumeration, skipping any that can not overlap in time.
+    for(size_t nplanes=cluster_array.size(); nplanes>=2; --nplanes) {
+
+      if(num_clusters && nplanes != num_clusters) continue;
+
+      for(auto const& plane_comb : SimpleCombination(cluster_array.size(),nplanes)) {
+
+	// candidate positions, current choice and running common time range per level
+	std::vector<std::vector<size_t> > cand_v(nplanes);
+	std::vector<size_t> cursor_v(nplanes,0);
+	std::vector<size_t> pos_comb(nplanes,0);
+	std::vector<double> t_lo_v(nplanes+1, -std::numeric_limits<double>::infinity());
+	std::vector<double> t_hi_v(nplanes+1,  std::numeric_limits<double>::infinity());
+
+	time_index_v[plane_comb[0]].Candidates(t_lo_v[0],t_hi_v[0],cand_v[0]);
+
+	size_t level = 0;
+	while(1) {
+
+	  if(cursor_v[level] == cand_v[level].size()) {
+	    if(!level) break;
+	    --level;
+	    ++cursor_v[level];
+	    continue;
+	  }
+
+	  auto const& plane_index = plane_comb[level];
+	  auto const& pos = cand_v[level][cursor_v[level]];
+	  pos_comb[level] = pos;
+
+	  if(level+1 == nplanes) {
+	    score_combination(plane_comb,pos_comb);
+	    ++cursor_v[level];
+	    continue;
+	  }
+
+	  // NaN bounds do not restrict anything
+	  t_lo_v[level+1] = t_lo_v[level];
+	  t_hi_v[level+1] = t_hi_v[level];
+	  if(tmin_array[plane_index][pos] > t_lo_v[level+1]) t_lo_v[level+1] = tmin_array[plane_index][pos];
+	  if(tmax_array[plane_index][pos] < t_hi_v[level+1]) t_hi_v[level+1] = tmax_array[plane_index][pos];
+
+	  ++level;
+	  time_index_v[plane_comb[level]].Candidates(t_lo_v[level],t_hi_v[level],cand_v[level]);
+	  cursor_v[level] = 0;
+	}
+      }
     }
+
+    if(_debug_mode <= kPerIteration) 
+      std::cout << "\033[93m checked " << ncombinations << " combinations \033[00m" << std::endl;
   
     if(_debug_mode <= kPerIteration) {
       if(_match_algo) _match_algo->Report();
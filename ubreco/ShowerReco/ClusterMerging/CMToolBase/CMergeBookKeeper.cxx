@@ -2,281 +2,194 @@
 #define RECOTOOL_CMERGEBOOKKEEPER_CXX
 
 #include "CMergeBookKeeper.h"
+#include <algorithm>
 
 namespace clusmtool {
 
-  CMergeBookKeeper::CMergeBookKeeper(unsigned short nclusters)
+  CMergeBookKeeper::CMergeBookKeeper(unsigned int nclusters)
   { 
     Reset(nclusters);
   }
 
-  void CMergeBookKeeper::Reset(unsigned short nclusters)
+  void CMergeBookKeeper::Reset(unsigned int nclusters)
   {
+    _parent.resize(nclusters);
+    for(size_t i=0; i<nclusters; ++i)
+      _parent[i] = i;
+    _set_size.assign(nclusters,1);
     _prohibit_merge.clear();
-    _prohibit_merge.reserve(nclusters);
-    std::vector<unsigned short>::clear();
-    std::vector<unsigned short>::reserve(nclusters);
-
-    for(size_t i=0; i<nclusters; ++i) {
-      this->push_back(i);
-      _prohibit_merge.push_back(std::vector<bool>(nclusters-i,false));
-    }
+    _prohibit_merge.resize(nclusters);
     _out_cluster_count = nclusters;
-    
   }
 
-  void CMergeBookKeeper::ProhibitMerge(unsigned short index1, unsigned short index2)
+  unsigned int CMergeBookKeeper::Find(unsigned int index) const
   {
-    if(index1 == index2)
+    while(_parent[index] != index) {
+      _parent[index] = _parent[_parent[index]];
+      index = _parent[index];
+    }
+    return index;
+  }
 
-      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
+  void CMergeBookKeeper::CheckIndexes(const char* func,
+				      unsigned int index1, unsigned int index2,
+				      bool distinct) const
+  {
+    if(distinct && index1 == index2)
 
+      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",func,index1));
 
     if( index1 >= this->size() || index2 >= this->size() )
 
       throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
-
-    auto out_index1 = this->at(index1);
-    auto out_index2 = this->at(index2);
-
-    if(out_index1 == out_index2)
-      throw CMTException(Form("Cluster %d and %d already merged!",index1,index2));    
-
-    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
-
-    _prohibit_merge.at(out_index1).at(out_index2-out_index1) = true;
-
   }
 
-  bool CMergeBookKeeper::MergeAllowed(unsigned short index1,
-				 unsigned short index2)
+  void CMergeBookKeeper::ProhibitMerge(unsigned int index1, unsigned int index2)
   {
+    CheckIndexes(__FUNCTION__,index1,index2);
 
-    if(index1 == index2)
+    auto out_index1 = Find(index1);
+    auto out_index2 = Find(index2);
 
-      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
+    if(out_index1 == out_index2)
 
+      throw CMTException(Form("Cluster %d and %d already merged!",index1,index2));    
 
-    if( index1 >= this->size() || index2 >= this->size() )
+    _prohibit_merge[out_index1].insert(out_index2);
+    _prohibit_merge[out_index2].insert(out_index1);
+  }
 
-      throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
+  bool CMergeBookKeeper::MergeAllowed(unsigned int index1,
+				      unsigned int index2)
+  {
+    CheckIndexes(__FUNCTION__,index1,index2);
 
-    auto out_index1 = this->at(index1);
-    auto out_index2 = this->at(index2);
+    auto out_index1 = Find(index1);
+    auto out_index2 = Find(index2);
 
     if(out_index1 == out_index2) return true;
 
-    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
-
-    return !(_prohibit_merge.at(out_index1).at(out_index2-out_index1));
-    
+    return !(_prohibit_merge[out_index1].count(out_index2));
   }
 
-  void CMergeBookKeeper::Merge(unsigned short index1, unsigned short index2)
+  void CMergeBookKeeper::Merge(unsigned int index1, unsigned int index2)
   {
+    CheckIndexes(__FUNCTION__,index1,index2);
 
-    if(index1 == index2)
-
-      throw CMTException(Form("<<%s>> Two input clusters identical (%d)",__FUNCTION__,index1));
-
-
-    if( index1 >= this->size() || index2 >= this->size() )
-
-      throw CMTException(Form("Input cluster index (%d and/or %d) out of range",index1,index2));
-
-    auto out_index1 = this->at(index1);
-    auto out_index2 = this->at(index2);
+    auto out_index1 = Find(index1);
+    auto out_index2 = Find(index2);
 
     if(out_index1 == out_index2) return;
 
-    if(out_index2 < out_index1) std::swap(out_index1,out_index2);
-
-    if(_prohibit_merge.at(out_index1).at(out_index2-out_index1))
+    if(_prohibit_merge[out_index1].count(out_index2))
       
       throw CMTException(Form("Clusters (%d,%d) correspond to output (%d,%d) which is prohibited to merge",
-				   index1,index2,
-				   out_index1,out_index2));
+			      index1,index2,
+			      out_index1,out_index2));
 
     //
-    // Merge cluster indexes
+    // Merge cluster indexes: smaller set goes under the larger one
     //
-    for(auto &v : (*this)) {
-
-      if( v == out_index1 || v == out_index2 )
-	v = out_index1;
-      else if( v > out_index2 )
-	v -= 1;
-    }
+    if(_set_size[out_index1] < _set_size[out_index2]) std::swap(out_index1,out_index2);
+    _parent[out_index2] = out_index1;
+    _set_size[out_index1] += _set_size[out_index2];
 
     //
-    // Merge prohibit rule
+    // Merge prohibit rule: whatever the absorbed set may not merge with,
+    // the merged set may not merge with either
     //
-    // (1) handle index < out_index1
-    for(size_t index=0; index < out_index1; ++index) {
-      
-      size_t tmp_out_index1 = out_index1 - index;
-      size_t tmp_out_index2 = out_index2 - index;
-
-      _prohibit_merge.at(index).at(tmp_out_index1) = ( _prohibit_merge.at(index).at(tmp_out_index1)
-						       ||
-						       _prohibit_merge.at(index).at(tmp_out_index2)
-						       );
-      
-      for(size_t in_index=tmp_out_index2; 
-	  //in_index < _prohibit_merge.at(index).size() - 1;
-	  in_index < (_out_cluster_count - index - 1);
-	  ++in_index) {
-
-	/*
-	if(in_index >= (_out_cluster_count - 1 - index)) 
-
-	  _prohibit_merge.at(index).at(in_index) = false;
-
-	else
-	*/	  
-	_prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index).at(in_index+1);
-      }
-
-      //(*_prohibit_merge.at(index).rbegin()) = false;
-      _prohibit_merge.at(index).at(_out_cluster_count - index - 1) = false;
-
-    }
-
-    // (2) handle index == out_index1
-    for(size_t in_index = 1; 
-	//in_index < _prohibit_merge.at(out_index1).size() - 1; 
-	in_index < (_out_cluster_count - out_index1 - 1);
-	++in_index) {
-      if( (in_index + out_index1) < out_index2 ) {
-	/*
-	std::cout<<Form("Inspecting1 : (%d,%zu) to (%zu,%zu)",
-			out_index1,in_index,
-			(in_index + out_index1),(out_index2 - (in_index+out_index1)))
-		 << std::endl;
-	*/
-	_prohibit_merge.at(out_index1).at(in_index) = ( _prohibit_merge.at(out_index1).at(in_index)
-							||
-							_prohibit_merge.at(in_index + out_index1).at(out_index2 - (in_index+out_index1))
-							);
-      }
-      else {
-	/*
-	std::cout<<Form("Inspecting2 : (%d,%zu) to (%d,%zu) ...",
-			out_index1,in_index+1,
-			out_index2,(in_index+out_index1-out_index2));
-	if(_prohibit_merge.at(out_index1).at(in_index+1)) std::cout<<"T";
-	else std::cout<<"F";
-	std::cout<<",";
-	if(_prohibit_merge.at(out_index2).at(in_index+out_index1-out_index2)) std::cout<<"T";
-	else std::cout<<"F";
-	std::cout<<std::endl;
-	*/
-	_prohibit_merge.at(out_index1).at(in_index) = ( _prohibit_merge.at(out_index1).at(in_index+1)
-							||
-							_prohibit_merge.at(out_index2).at(in_index+1+out_index1-out_index2)
-							);
-	
-      }
-    }
-    //(*_prohibit_merge.at(out_index1).rbegin()) = false;
-    _prohibit_merge.at(out_index1).at(_out_cluster_count - out_index1 - 1) = false;
-
-    // (3) handle out_index1 < index < out_index2
-    for(size_t index = out_index1+1; 
-	index < out_index2;
-	++index){
-      for(size_t in_index = (out_index2 - index);
-	  //in_index < (_prohibit_merge.at(index).size() - 1);
-	  in_index < (_out_cluster_count - index - 1);
-	  ++in_index)
-
-	_prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index).at(in_index+1);
-      
-      //(*_prohibit_merge.at(index).rbegin()) = false;
-      _prohibit_merge.at(index).at(_out_cluster_count - index - 1) = false;
-    }
-    // (4) handle out_index2 <= index
-    for(size_t index = out_index2;
-	//index < (_prohibit_merge.size() - 1);
-	index < (_out_cluster_count - 1);
-	++index) {
-      
-      for(size_t in_index = 0;
-	  in_index < _prohibit_merge.at(index).size();
-	  ++in_index)
-
-	if(in_index < _prohibit_merge.at(index+1).size())
-	  _prohibit_merge.at(index).at(in_index) = _prohibit_merge.at(index+1).at(in_index);
-
-	else
-	  _prohibit_merge.at(index).at(in_index) = false;
-
+    auto& absorbed = _prohibit_merge[out_index2];
+    for(auto const& other : absorbed) {
+      _prohibit_merge[other].erase(out_index2);
+      _prohibit_merge[other].insert(out_index1);
+      _prohibit_merge[out_index1].insert(other);
     }
+    std::unordered_set<unsigned int>().swap(absorbed);
 
     _out_cluster_count -=1;
-
   }
 
   void CMergeBookKeeper::Report() const 
   {
+    std::vector<std::vector<unsigned int> > result;
+    PassResult(result);
+    std::vector<unsigned int> out_index_v(this->size(),0);
+    for(size_t out_index=0; out_index<result.size(); ++out_index)
+      for(auto const& index : result[out_index])
+	out_index_v[index] = out_index;
+
     std::cout<<"Merge Result:"<<std::endl;
-    for(auto const& v : *this)
+    for(auto const& v : out_index_v)
       std::cout<<v<< " ";
     std::cout<<std::endl<<std::endl;
 
     std::cout<<"Prohibit Status:"<<std::endl;
-    for(auto const &bs : _prohibit_merge) {
-      
-      for(auto const &b : bs) {
+    for(size_t out_index=0; out_index<result.size(); ++out_index) {
 
-	if(b) std::cout<<"\033[93mT\033[00m ";
-	else std::cout<<"\033[95mF\033[00m ";
+      auto const& prohibit = _prohibit_merge[Find(result[out_index].front())];
+      std::vector<unsigned int> other_v;
+      for(auto const& other : prohibit)
+	other_v.push_back(out_index_v[other]);
+      std::sort(other_v.begin(),other_v.end());
 
-      }
+      std::cout<<out_index<<" :";
+      for(auto const& other : other_v)
+	std::cout<<" \033[93m"<<other<<"\033[00m";
       std::cout<<std::endl;
     }
     std::cout<<std::endl;
 
   }
 
-  bool CMergeBookKeeper::IsMerged(unsigned short index1, unsigned short index2) const
+  bool CMergeBookKeeper::IsMerged(unsigned int index1, unsigned int index2) const
   { 
     if( index1 >= this->size() || index2 >= this->size() )
       throw CMTException(Form("Invalid cluster index: %d or %d",index1,index2));
 
-    return this->at(index1) == this->at(index2); 
+    return Find(index1) == Find(index2); 
   }
 
   
-  std::vector<unsigned short> CMergeBookKeeper::GetMergedSet(unsigned short index1) const
+  std::vector<unsigned int> CMergeBookKeeper::GetMergedSet(unsigned int index1) const
   {
 
     if( index1 >= this->size() )
       throw CMTException(Form("Invalid cluster index: %d ",index1));
 
-    auto out_index = this->at(index1);
-    std::vector<unsigned short> result;
+    auto out_index = Find(index1);
+    std::vector<unsigned int> result;
+    result.reserve(_set_size[out_index]);
     
     for(size_t i=0; i<this->size(); ++i)
-      if( this->at(i) == out_index ) result.push_back(i);
+      if( Find(i) == out_index ) result.push_back(i);
 
     return result;
   }
 
-  void CMergeBookKeeper::PassResult(std::vector<std::vector<unsigned short> > &result) const
+  void CMergeBookKeeper::PassResult(std::vector<std::vector<unsigned int> > &result) const
   {
 
     result.clear();
-    result.resize(_out_cluster_count, std::vector<unsigned short>());
-
-    for(size_t i=0; i<this->size(); ++i)
-      result.at(this->at(i)).push_back(i);
+    result.reserve(_out_cluster_count);
+
+    // output clusters in order of their smallest input index
+    const unsigned int kNoOutput = this->size();
+    std::vector<unsigned int> out_index_v(this->size(),kNoOutput);
+    for(size_t i=0; i<this->size(); ++i) {
+      auto root = Find(i);
+      if(out_index_v[root] == kNoOutput) {
+	out_index_v[root] = result.size();
+	result.emplace_back();
+	result.back().reserve(_set_size[root]);
+      }
+      result[out_index_v[root]].push_back(i);
+    }
   }
 
   void CMergeBookKeeper::Combine(const CMergeBookKeeper &another)
   {
     // Check length compatibility between this instance's result and "another"
-    std::vector<std::vector<unsigned short> > my_result;
+    std::vector<std::vector<unsigned int> > my_result;
     this->PassResult(my_result);
     if(my_result.size() != another.size()) {
       throw CMTException(Form("Input has an incompatible size (%zu != %zu)",
@@ -287,7 +200,7 @@ namespace clusmtool {
     }
 
     // Check if "another" result is different from input
-    std::vector<std::vector<unsigned short> > another_result;
+    std::vector<std::vector<unsigned int> > another_result;
     another.PassResult(another_result);
     if(another_result.size() >= my_result.size())
       throw CMTException(Form("The input has equal or more number of output clusters (%zu>=%zu)",
@@ -301,7 +214,7 @@ namespace clusmtool {
       if(ares.size()==1) continue;
 
       // Get one of cluster to be used for merging
-      unsigned short target = my_result.at(ares.at(0)).at(0);
+      unsigned int target = my_result.at(ares.at(0)).at(0);
 
       for(auto const &res_index : ares) {
 
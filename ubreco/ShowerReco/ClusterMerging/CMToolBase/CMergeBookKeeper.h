@@ -15,6 +15,7 @@
 #define RECOTOOL_CMERGEBOOKKEEPER_H
 
 #include <iostream>
+#include <unordered_set>
 #include <vector>
 #include <TString.h>
 #include "CMTException.h"
@@ -31,35 +32,45 @@ namespace clusmtool {
      of the cluster which has to be smaller than the previously specified number of clusters.
      CMergeBookKeeper keeps track of which clusters are asked to merge together, and it can be
      asked to return a vector of merged cluster indexes.
+
+     Merged sets are kept with union-find, and prohibited pairs of merged sets as a sparse
+     list per set, so merging and MergeAllowed cost nearly constant time in the number of
+     clusters. Output (merged) clusters are numbered in order of their smallest input index.
   */
-  class CMergeBookKeeper : public std::vector<unsigned short>{
+  class CMergeBookKeeper {
     
   public:
     
     /// Default constructor
-    CMergeBookKeeper(unsigned short nclusters=0);
+    CMergeBookKeeper(unsigned int nclusters=0);
     
     /// Default destructor
     virtual ~CMergeBookKeeper(){};
 
     /// Reset method
-    void Reset(unsigned short nclusters=0);
+    void Reset(unsigned int nclusters=0);
+
+    /// Number of input clusters
+    size_t size() const { return _parent.size(); }
+
+    /// Number of output (merged) clusters
+    size_t NumOutputClusters() const { return _out_cluster_count; }
 
     /// Method to set a pair of clusters to prohibit from merging
-    void ProhibitMerge(unsigned short index1, unsigned short index2);
+    void ProhibitMerge(unsigned int index1, unsigned int index2);
 
     /// Method to inqury if a combination is prohibited to merge
-    bool MergeAllowed(unsigned short index1, unsigned short index2);
+    bool MergeAllowed(unsigned int index1, unsigned int index2);
 
     /// Method to merge 2 clusters via index numbers
-    void Merge(unsigned short index1, unsigned short index2);
+    void Merge(unsigned int index1, unsigned int index2);
 
     /**
        Method to retrieve a vector of cluster indexes which 
        is merged with the input cluster index. All indexes here
        are regarding the original cluster index.
     */
-    std::vector<unsigned short> GetMergedSet(unsigned short index1) const;
+    std::vector<unsigned int> GetMergedSet(unsigned int index1) const;
 
     /**
        Method to ask if a given 2 clusters are already merged.
@@ -67,18 +78,18 @@ namespace clusmtool {
        a merged cluster sets from GetMergedIndexes and check if
        two clusters are merged.
     */
-    bool IsMerged(unsigned short index1, unsigned short index2) const;
+    bool IsMerged(unsigned int index1, unsigned int index2) const;
 
     /**
        A method to get the full result. The return is a vector
        of merged cluster indexes (which is a vector of original cluster indexes).
     */
-    void PassResult(std::vector<std::vector<unsigned short> > &result) const;
+    void PassResult(std::vector<std::vector<unsigned int> > &result) const;
 
 
-    std::vector<std::vector<unsigned short> > GetResult() const
+    std::vector<std::vector<unsigned int> > GetResult() const
     { 
-      std::vector<std::vector<unsigned short> > result; 
+      std::vector<std::vector<unsigned int> > result; 
       PassResult(result);
       return result;
     }
@@ -92,10 +103,25 @@ namespace clusmtool {
 
   protected:
 
+    /// Representative input index of the merged set including index
+    unsigned int Find(unsigned int index) const;
+
+    /// Checks index validity (and, if requested, that the two differ)
+    void CheckIndexes(const char* func,
+		      unsigned int index1, unsigned int index2,
+		      bool distinct=true) const;
+
+    /// Union-find parent of each input cluster (compressed on lookup)
+    mutable std::vector<unsigned int> _parent;
+
+    /// Number of input clusters in each merged set (valid for representatives)
+    std::vector<unsigned int> _set_size;
+
     /**
-       A 2D-map vector that stores pair of clusters for which merging is prohibited
+       Per merged set (by representative), the representatives of the sets
+       it is prohibited to merge with. Kept symmetric.
      */
-    std::vector<std::vector<bool> > _prohibit_merge;
+    std::vector<std::unordered_set<unsigned int> > _prohibit_merge;
 
     /// Number of output clusters
     size_t _out_cluster_count;
@@ -2,6 +2,8 @@
 #define RECOTOOL_CMERGEMANAGER_CXX
 
 #include "CMergeManager.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 namespace clusmtool {
 
@@ -126,8 +128,9 @@ namespace clusmtool {
 
     while (algo_idx < _merge_algo_v.size() ) {
 
+      // the previous output is this iteration's input
       if(!iter_ctr) _tmp_merged_clusters = _in_clusters;
-      else _tmp_merged_clusters = _out_clusters;
+      else _tmp_merged_clusters.swap(_out_clusters);
       _out_clusters.clear();
       
       bk.Reset(_tmp_merged_clusters.size());
@@ -151,14 +154,18 @@ namespace clusmtool {
       // Save output
       bk.PassResult(_tmp_merged_indexes);
       
-      if(bk.size() == _tmp_merged_indexes.size())
-	_out_clusters = _tmp_merged_clusters;
+      // Input clusters are not used past this point (only their count), so
+      // they are moved to the output rather than copied
+      _out_clusters.reserve(_tmp_merged_indexes.size());
+      if(bk.size() == _tmp_merged_indexes.size()) {
+	for(auto& cluster : _tmp_merged_clusters)
+	  _out_clusters.push_back(std::move(cluster));
+      }
       else {
-	_out_clusters.reserve(_tmp_merged_indexes.size());
 	for(auto const& indexes_v : _tmp_merged_indexes) {
 	  
 	  if(indexes_v.size()==1) {
-	    _out_clusters.push_back(_tmp_merged_clusters.at(indexes_v.at(0)));
+	    _out_clusters.push_back(std::move(_tmp_merged_clusters.at(indexes_v.at(0))));
 	    continue;
 	  }
 	  
@@ -169,12 +176,12 @@ namespace clusmtool {
 	  tmp_hits.reserve(tmp_hit_counts);
 	  
 	  for(auto const& index : indexes_v) {
-	    for(auto const& hit : _tmp_merged_clusters.at(index).GetHits())
-	      tmp_hits.push_back(hit);
+	    auto const& hits = _tmp_merged_clusters.at(index).GetHits();
+	    tmp_hits.insert(tmp_hits.end(),hits.begin(),hits.end());
 	  }
 	  _out_clusters.push_back(::cluster::Cluster());
 	  
-	  if((*_out_clusters.rbegin()).SetHits(tmp_hits) < 1) continue;
+	  if((*_out_clusters.rbegin()).SetHits(std::move(tmp_hits)) < 1) continue;
 	}
 	_book_keeper_v.push_back(bk);
       }
@@ -236,72 +243,110 @@ namespace clusmtool {
 
     // which mode? pair-wise:
     if (_merge_algo_v[algo_idx]->PairWiseMode() == true) {
-      
-      // Run over clusters and execute merging algorithms
-      for(auto citer1 = _priority.rbegin();
-	  citer1 != _priority.rend();
-	  ++citer1) {
-	
+
+      auto& algo = *(_merge_algo_v[algo_idx]);
+
+      // Clusters in priority order, and per plane the positions of its
+      // clusters in that order: only pairs on the same plane are compared
+      std::vector<size_t> order_v;
+      order_v.reserve(_priority.size());
+      for(auto citer = _priority.rbegin(); citer != _priority.rend(); ++citer)
+	order_v.push_back((*citer).second);
+
+      std::map<size_t, std::vector<size_t> > plane_order_m;
+      std::vector<size_t> plane_pos_v(order_v.size());
+      for(size_t pos=0; pos<order_v.size(); ++pos) {
+	auto& plane_order = plane_order_m[in_clusters.at(order_v[pos])._plane];
+	plane_pos_v[pos] = plane_order.size();
+	plane_order.push_back(pos);
+      }
+
+      // Candidate pairs, in the order they are inspected
+      std::vector<std::pair<size_t,size_t> > pair_v;
+      for(size_t pos1=0; pos1<order_v.size(); ++pos1) {
+
 	nloop1 += 1;
-	
-	auto citer2 = citer1;
-	
-	UChar_t plane1 = in_clusters.at((*citer1).second)._plane;
-	
-	while(1) {
-	  citer2++;
-	  if(citer2 == _priority.rend()) break;
+	nloop2 += order_v.size() - pos1 - 1;
 
-	  nloop2 += 1;
-	  
-	  // Skip if not on the same plane
-	  UChar_t plane2 = in_clusters.at((*citer2).second)._plane;
-	  if(plane1 != plane2) continue;
+	auto const& index1 = order_v[pos1];
+	auto const& cluster1 = in_clusters.at(index1);
+	auto const& plane_order = plane_order_m[cluster1._plane];
+
+	for(size_t ppos2=plane_pos_v[pos1]+1; ppos2<plane_order.size(); ++ppos2) {
+
+	  auto const& index2 = order_v[plane_order[ppos2]];
 
 	  ndiffpl += 1;
 	  
 	  // Skip if this combination is not meant to be compared
-	  if(!(merge_flag.at((*citer2).second)) && !(merge_flag.at((*citer1).second)) ) continue;
+	  if(!(merge_flag.at(index2)) && !(merge_flag.at(index1)) ) continue;
 
 	  nflag += 1;
+
+	  // Skip if this combination is not allowed to merge. Merges only
+	  // spread prohibitions, so a pair rejected now stays rejected below
+	  if(!(book_keeper.MergeAllowed(index1,index2))) continue;
+
+	  // Skip if the algorithm rules this pair out cheaply
+	  if(!algo.Compatible(cluster1,in_clusters.at(index2))) continue;
+
+	  pair_v.emplace_back(index1,index2);
+	}
+      }
+
+      // Score all candidates up front on several threads, when allowed
+      std::vector<char> merge_v;
+      bool scored = (_parallel_scoring && algo.ConcurrentBool() && _debug_mode > kPerMerging);
+      if(scored) {
+	merge_v.resize(pair_v.size(),0);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0,pair_v.size()),
+			  [&](const tbb::blocked_range<size_t>& range) {
+			    for(size_t i=range.begin(); i<range.end(); ++i)
+			      merge_v[i] = algo.Bool(in_clusters.at(pair_v[i].first),
+						     in_clusters.at(pair_v[i].second));
+			  });
+      }
+
+      for(size_t i=0; i<pair_v.size(); ++i) {
+
+	auto const& index1 = pair_v[i].first;
+	auto const& index2 = pair_v[i].second;
 	  
-	  // Skip if this combination is not allowed to merge
-	  if(!(book_keeper.MergeAllowed((*citer1).second,(*citer2).second))) continue;
+	// Skip if this combination is not allowed to merge
+	if(!(book_keeper.MergeAllowed(index1,index2))) continue;
 
-	  nmerge += 1;
+	nmerge += 1;
 	  
-	  if(_debug_mode <= kPerMerging){
+	if(_debug_mode <= kPerMerging){
 	    
-	    std::cout
-	      << Form("    \033[93mInspecting a pair (%zu, %zu) for merging... \033[00m",(*citer1).second, (*citer2).second)
-	      << std::endl;
-	  }
+	  std::cout
+	    << Form("    \033[93mInspecting a pair (%zu, %zu) for merging... \033[00m",index1, index2)
+	    << std::endl;
+	}
 
-	  niter += 1;
+	niter += 1;
 	  
-	  bool merge = _merge_algo_v[algo_idx]->Bool(in_clusters.at((*citer1).second),in_clusters.at((*citer2).second));
+	bool merge = scored ? (bool)merge_v[i] : algo.Bool(in_clusters.at(index1),in_clusters.at(index2));
 	  
-	  if(_debug_mode <= kPerMerging) {
+	if(_debug_mode <= kPerMerging) {
 	    
-	    if(merge) 
-	      std::cout << "    \033[93mfound to be merged!\033[00m " 
-			<< std::endl
-			<< std::endl;
+	  if(merge) 
+	    std::cout << "    \033[93mfound to be merged!\033[00m " 
+		      << std::endl
+		      << std::endl;
 	    
-	    else 
-	      std::cout << "    \033[93mfound NOT to be merged...\033[00m" 
-			<< std::endl
-			<< std::endl;
+	  else 
+	    std::cout << "    \033[93mfound NOT to be merged...\033[00m" 
+		      << std::endl
+		      << std::endl;
 	    
-	  } // end looping over all sets of algorithms
+	} // end looping over all sets of algorithms
 	  
-	  if(merge)
+	if(merge)
 	    
-	    book_keeper.Merge((*citer1).second,(*citer2).second);
+	  book_keeper.Merge(index1,index2);
 	  
-	} // end looping over all cluster pairs for citer1
-	
-      } // end looping over clusters
+      } // end looping over cluster pairs
 
       if (_debug_mode <= kPerIteration){
 	std::cout << "    \033[093m pair-wise comparisons : \033[00m  "  << niter  << std::endl;
@@ -309,6 +354,7 @@ namespace clusmtool {
 	std::cout << "    \033[093m loop2 iterations      : \033[00m  "  << nloop2 << std::endl;
 	std::cout << "    \033[093m ndiffplane            : \033[00m  "  << ndiffpl << std::endl;
 	std::cout << "    \033[093m nflag                 : \033[00m  "  << nflag << std::endl;
+	std::cout << "    \033[093m ncompatible           : \033[00m  "  << pair_v.size() << std::endl;
 	std::cout << "    \033[093m nmerge                : \033[00m  "  << nmerge << std::endl;
       }
     }// if pair-wise mode
@@ -62,6 +62,9 @@ namespace clusmtool {
       std::cout << "DD \t\t\t and now there are   "  << _merge_algo_v.size() << " algorithms" << std::endl;
     }
 
+    /// Score cluster pairs on several threads, for algorithms that allow it
+    void ParallelScoring(bool doit=true) { _parallel_scoring = doit; }
+
     /// A method to obtain output clusters
     const std::vector<::cluster::Cluster>& GetClusters() const { return _out_clusters; }
 
@@ -122,12 +125,15 @@ namespace clusmtool {
 
     std::vector<CMergeBookKeeper> _book_keeper_v;
 
-    std::vector<std::vector<unsigned short> > _tmp_merged_indexes;
+    std::vector<std::vector<unsigned int> > _tmp_merged_indexes;
 
     std::vector<::cluster::Cluster> _tmp_merged_clusters;
 
     /// Merging algorithm
     std::vector<std::unique_ptr<::clusmtool::CBoolAlgoBase> > _merge_algo_v;
+
+    /// Run Bool on several threads (if the algorithm allows)
+    bool _parallel_scoring = false;
     
 
   };
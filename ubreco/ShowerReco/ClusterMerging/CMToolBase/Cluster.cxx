@@ -4,6 +4,7 @@
 #include "Cluster.h"
 
 #include <cmath>
+#include <limits>
 
 namespace cluster {
 
@@ -11,18 +12,25 @@ namespace cluster {
 
     _sum_charge = 0;
     _plane      = 4;
+    _t_min      =  std::numeric_limits<float>::infinity();
+    _t_max      = -std::numeric_limits<float>::infinity();
 
     _hits.clear();
 
   }
 
   int Cluster::SetHits(const std::vector<cluster::pt>& hits) {
+
+    return SetHits(std::vector<cluster::pt>(hits));
+  }
+
+  int Cluster::SetHits(std::vector<cluster::pt>&& hits) {
     
     Clear();
 
-    _hits = hits;
+    _hits = std::move(hits);
 
-    _plane = hits.at(0)._pl;
+    _plane = _hits.at(0)._pl;
 
     _angle = 0.;
 
@@ -67,6 +75,9 @@ namespace cluster {
       if (angle > angle_max) angle_max = angle;
       if (angle < angle_min) angle_min = angle;
 
+      if (hit._t < _t_min) _t_min = hit._t;
+      if (hit._t > _t_max) _t_max = hit._t;
+
       hit_w_v.push_back( hit._w );
       hit_t_v.push_back( hit._t );
       
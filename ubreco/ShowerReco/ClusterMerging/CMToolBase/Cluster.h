@@ -93,13 +93,17 @@ namespace cluster {
     float  _angle_rms;
     cluster::pt _start_pt;
     cluster::pt _end_pt;
+    float  _t_min; // earliest hit time [cm]
+    float  _t_max; // latest hit time [cm]
 
     ::twodimtools::Linearity _lin;
 
-    const std::vector<cluster::pt> GetHits() const { return _hits; }
+    const std::vector<cluster::pt>& GetHits() const { return _hits; }
     
     int SetHits(const std::vector<cluster::pt>& hits) ;
 
+    int SetHits(std::vector<cluster::pt>&& hits) ;
+
     size_t size() const { return _hits.size(); }
 
     float Length() const { return _end_pt._r - _start_pt._r; }
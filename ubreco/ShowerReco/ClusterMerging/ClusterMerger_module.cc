@@ -93,6 +93,7 @@ ClusterMerger::ClusterMerger(fhicl::ParameterSet const & pset)
   _merge_helper->GetManager().Reset();
   _merge_helper->GetManager().DebugMode(clusmtool::CMManagerBase::kPerIteration);
   _merge_helper->GetManager().MergeTillConverge(false);
+  _merge_helper->GetManager().ParallelScoring(pset.get<bool>("ParallelScoring",false));
 
   //const fhicl::ParameterSet& priorityTool = pset.get<fhicl::ParameterSet>("PriorityTool");
   //_merge_helper->GetManager().AddPriorityAlgo(art::make_tool<clusmtool::CPriorityAlgoBase>(priorityTool));
@@ -166,7 +167,7 @@ void ClusterMerger::produce(art::Event & e)
 
   // Grab output cluster from manager
   auto const& bk = _merge_helper->GetResult();
-  std::vector<std::vector<unsigned short> > merged_indexes;
+  std::vector<std::vector<unsigned int> > merged_indexes;
   bk.PassResult(merged_indexes);
   // merged_indexes is a vector of vectors
   // each entry is the vector of original clsuter indices to be merged
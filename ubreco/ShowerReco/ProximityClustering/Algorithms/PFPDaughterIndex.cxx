@@ -0,0 +1,34 @@
+#ifndef GAMMACATCHER_PFPDAUGHTERINDEX_CXX
+#define GAMMACATCHER_PFPDAUGHTERINDEX_CXX
+
+#include "PFPDaughterIndex.h"
+
+#include <algorithm>
+
+namespace gammacatcher {
+
+  void PFPDaughterIndex::Build(const std::vector<recob::PFParticle>& pfp_v)
+  {
+    _pfp_v = &pfp_v;
+    _self_map.clear();
+    for (size_t p=0; p < pfp_v.size(); p++)
+      _self_map[ pfp_v[p].Self() ].push_back(p);
+  }
+
+  void PFPDaughterIndex::Daughters(const recob::PFParticle& pfp, int pdg,
+				   std::vector<size_t>& idx_v) const
+  {
+    idx_v.clear();
+    if (!_pfp_v) return;
+    for (auto const& daughterID : pfp.Daughters()) {
+      auto self = _self_map.find(daughterID);
+      if (self == _self_map.end()) continue;
+      for (auto const& pp : self->second)
+	if ((*_pfp_v)[pp].PdgCode() == pdg) idx_v.push_back(pp);
+    }
+    std::sort(idx_v.begin(), idx_v.end());
+  }
+
+}
+
+#endif
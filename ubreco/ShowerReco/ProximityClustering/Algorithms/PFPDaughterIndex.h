@@ -0,0 +1,57 @@
+/**
+ * \file PFPDaughterIndex.h
+ *
+ * \ingroup Clusterer
+ * 
+ * \brief Lookup of PFParticle daughters by Self() ID
+ *
+ */
+
+/** \addtogroup Clusterer
+
+    @{*/
+
+#ifndef GAMMACATCHER_PFPDAUGHTERINDEX_H
+#define GAMMACATCHER_PFPDAUGHTERINDEX_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "lardataobj/RecoBase/PFParticle.h"
+
+namespace gammacatcher {
+  /**
+     \class PFPDaughterIndex
+     Maps the Self() ID of each PFParticle of an event to its position in the
+     PFParticle vector, so that daughters are found without scanning every
+     PFParticle. Self() IDs need not be contiguous or unique.
+   */
+  class PFPDaughterIndex {
+  
+  public:
+
+    PFPDaughterIndex() : _pfp_v(nullptr) {}
+
+    /// Index a PFParticle vector, which must stay unchanged while in use
+    void Build(const std::vector<recob::PFParticle>& pfp_v);
+
+    /**
+       Positions in the indexed vector, in increasing order, of the
+       PFParticles with the given PDG code whose Self() is one of
+       pfp.Daughters(). A PFParticle appears once per daughter ID matching
+       it, as in a scan of every (PFParticle, daughter ID) pair.
+    */
+    void Daughters(const recob::PFParticle& pfp, int pdg,
+		   std::vector<size_t>& idx_v) const;
+
+  private:
+
+    const std::vector<recob::PFParticle>* _pfp_v;
+    std::unordered_map<size_t, std::vector<size_t> > _self_map;
+
+  };
+
+}
+#endif
+/** @} */ // end of doxygen group 
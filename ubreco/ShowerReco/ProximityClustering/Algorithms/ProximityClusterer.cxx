@@ -6,6 +6,8 @@
 #include "larcorealg/Geometry/Exceptions.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
 
+#include <algorithm>
+
 namespace gammacatcher {
 
   bool ProximityClusterer::initialize() {
@@ -26,31 +28,24 @@ namespace gammacatcher {
     if (hit_h->size() == 0)
       return false;
 
+    // each hit gets a cluster index; clusters are numbered in order of
+    // creation, and a merged cluster keeps the index of the cluster of hit1
+    clearClusters(hit_h->size());
 
-    // a map to connect hit index wih a cluster index
-    // each hit gets a cluster index
-    // _clusterMap[hit_index] -> cluster_index
-    std::map<size_t, size_t> _clusterMap;
-    // a map to connect the cluster index with the vector of hit indices for that cluster
-    // _clusters[index] -> vector of hit indices for that cluster
-    std::map<size_t,std::vector<size_t> > _clusters;
-
-    // keep track of largest cluster ID created
-    size_t maxClusterID = 0;
+    std::vector<size_t> neighborhits;
 
     for (int pl=0; pl < 3; pl++){
 
       // hit map will only contain hits we want to use for clustering
       MakeHitMap(hit_h,pl);
       
-      // iterator for hit cell map
-      std::map<std::pair<int,int>, std::vector<size_t> >::iterator it;
-      
       // loop through hits in each cell to find matches
-      for (it = _hitMap.begin(); it != _hitMap.end(); it++){
+      for (size_t cell=0; cell+1 < _cellStart.size(); cell++){
 
-	// pair = (i,j) indices of this cell in the _hitMap
-	auto const& pair = it->first;
+	// (i,j) indices of this cell in the hit map
+	auto const& key = _cellHits[_cellStart[cell]].first;
+	int i = (int)((uint32_t)(key >> 32) ^ 0x80000000u);
+	int j = (int)((uint32_t)key ^ 0x80000000u);
 	
 	// wire-space cell index
 	// prepare a hit list of all neighboring cells
@@ -58,16 +53,12 @@ namespace gammacatcher {
 	// |__|__|__|
 	// |__|__|__|
 	// |__|__|__|
-	std::vector<size_t> cellhits = it->second;
+	neighborhits.clear();
+	getNeighboringHits(i,j,neighborhits);
 
-	std::vector<size_t> neighborhits;
-	getNeighboringHits(pair,neighborhits);
+	for (size_t h1=_cellStart[cell]; h1 < _cellStart[cell+1]; h1++){
 
-	for (size_t h1=0; h1 < cellhits.size(); h1++){
-
-	  // has this hit been added to a cluster?
-	  // if so not necessary to look at
-	  auto const& hit1 = cellhits[h1];
+	  auto const& hit1 = _cellHits[h1].second;
 	  // keep track if the hit will ever be matched to another
 	  bool matched = false;
 	  // if not find hits it should be clustered with and add it to the appropriate cluster
@@ -80,160 +71,189 @@ namespace gammacatcher {
 	    // should the hits go in the same cluster?
 	    if (compat){
 	      matched = true;
-	      // if both hits have already been assigned to a cluster then we can merge the cluster indices!
-	      if ( (_clusterMap.find(hit1) != _clusterMap.end()) and
-		   (_clusterMap.find(hit2) != _clusterMap.end()) ){
+	      auto clus1 = hitCluster(hit1);
+	      auto clus2 = hitCluster(hit2);
+	      // if both hits have already been assigned to a cluster then we can merge the clusters!
+	      if ( (clus1 != kNoCluster) and (clus2 != kNoCluster) ){
 		// if in the same cluster -> do nothing
-		// if they are in different clusters:
-		if (_clusterMap[hit1] != _clusterMap[hit2]){
-		  auto idx1 = _clusterMap[hit1];
-		  auto idx2 = _clusterMap[hit2];
-		  // hit indices for 1st cluster:
-		  auto hits1 = _clusters[idx1];
-		  auto hits2 = _clusters[idx2];
-		  // append hits2 to hits1
-		  for (auto h : hits2){
-		    hits1.push_back(h);
-		    // also change the index that the hit goes to (idx1 instead of idx2)
-		    _clusterMap[h] = idx1;
-		  }
-		  _clusters[idx1] = hits1;
-		  // erase cluster @ index2
-		  _clusters.erase(idx2);
-		}// if they are in different clusters
+		if (clus1 != clus2)
+		  mergeClusters(clus1,clus2);
 	      }
 	      // if compatible and the 2nd hit has been added to a cluster
 	      // add hit1 to the same cluster
-	      else if ( (_clusterMap.find(hit2) != _clusterMap.end()) and
-			(_clusterMap.find(hit1) == _clusterMap.end()) ){
-		auto clusIdx = _clusterMap[hit2];
-		_clusterMap[hit1] = clusIdx;
-		_clusters[clusIdx].push_back(hit1);
-	      }
-	      // otherwise, add both to a new cluster
-	      else if ( (_clusterMap.find(hit1) != _clusterMap.end()) and
-			(_clusterMap.find(hit2) == _clusterMap.end()) ){
-		auto clusIdx = _clusterMap[hit1];
-		_clusterMap[hit2] = clusIdx;
-		_clusters[clusIdx].push_back(hit2);
-	      }
-	      // if neither has a cluster yet
+	      else if (clus2 != kNoCluster)
+		addHit(clus2,hit1);
+	      else if (clus1 != kNoCluster)
+		addHit(clus1,hit2);
+	      // if neither has a cluster yet, create a new cluster for this match
 	      else{
-		// create a new cluster for this match
-		_clusterMap[hit1] = maxClusterID;
-		_clusterMap[hit2] = maxClusterID;
-		std::vector<size_t> cl = {hit1,hit2};
-		_clusters[maxClusterID] = cl;
-		maxClusterID += 1;
+		auto clus = newCluster();
+		addHit(clus,hit1);
+		addHit(clus,hit2);
 	      }
 	    }// if the two hits are compatible
 	  }// 2nd loop through hits in the cell
 	  // has this hit been matched? if not we still need to add it as its own cluster
-	  if (matched == false){
-	    _clusterMap[hit1] = maxClusterID;
-	    _clusters[maxClusterID] = {hit1};
-	    maxClusterID += 1;
-	  }
+	  if (matched == false)
+	    addHit(newCluster(),hit1);
 	}// 1st loop through hits in the cell
       }// loop through all cells
 
     }// loop through all planes
 
-    // make a vector for the clusters
-    for (auto it = _clusters.begin(); it != _clusters.end(); it++){
-      auto indices = it->second;
-      // if there are enough indices, make a cluster
-      if (indices.size() >= 1){
-	std::vector<unsigned int> clus;
-	for (auto idx : indices)
-	  clus.push_back(idx);
-	_out_cluster_vector.push_back(clus);
-      }// if there are 2 hits in cluster
+    // make a vector for the clusters, in order of cluster index
+    std::vector<std::pair<size_t,size_t> > id_root_v;
+    for (size_t clus=0; clus < _clusParent.size(); clus++)
+      if (_clusParent[clus] == clus) id_root_v.emplace_back(_clusID[clus],clus);
+    std::sort(id_root_v.begin(),id_root_v.end());
+
+    for (auto const& id_root : id_root_v){
+      std::vector<unsigned int> clus;
+      clus.reserve(_clusSize[id_root.second]);
+      for (size_t node = _clusHead[id_root.second]; node != kNoCluster; node = _nodeNext[node])
+	clus.push_back(_nodeHit[node]);
+      _out_cluster_vector.push_back(clus);
     }
     
     return true;
   }
 
-  // get all hits from neighboring cells
-  void ProximityClusterer::getNeighboringHits(const std::pair<int,int>& pair, std::vector<size_t>& hitIndices){
-   
-    auto const& i       = pair.first;
-    // time-space cell index
-    auto const& j       = pair.second;
+  void ProximityClusterer::clearClusters(size_t nhits){
+
+    _nodeHit.clear();
+    _nodeNext.clear();
+    _nodeClus.clear();
+    _hitNode.assign(nhits,kNoCluster);
+    _clusParent.clear();
+    _clusSize.clear();
+    _clusID.clear();
+    _clusHead.clear();
+    _clusTail.clear();
+    _clusStale.clear();
+  }
 
-    // _________
-    // |__|__|__|
-    // |__|XX|__|
-    // |__|__|__|
-    if (_hitMap.find(std::make_pair(i,j)) != _hitMap.end()){
-      for (auto &h : _hitMap[std::make_pair(i,j)])
-	hitIndices.push_back(h);
-    }
+  size_t ProximityClusterer::newCluster(){
+
+    size_t clus = _clusParent.size();
+    _clusParent.push_back(clus);
+    _clusSize.push_back(0);
+    _clusID.push_back(clus);
+    _clusHead.push_back(kNoCluster);
+    _clusTail.push_back(kNoCluster);
+    if (_clusStale.size() <= clus) _clusStale.resize(clus+1);
+    _clusStale[clus].clear();
+    return clus;
+  }
 
-    // now look at neighboring cells, if they exist
-    // _________
-    // |__|__|__|
-    // |XX|__|__|
-    // |__|__|__|
-    if (_hitMap.find(std::make_pair(i-1,j)) != _hitMap.end()){
-      for (auto &h : _hitMap[std::make_pair(i-1,j)])
-	hitIndices.push_back(h);
-    }
-    // _________
-    // |__|__|__|
-    // |__|__|__|
-    // |__|XX|__|
-    if (_hitMap.find(std::make_pair(i,j-1)) != _hitMap.end()){
-      for (auto &h : _hitMap[std::make_pair(i,j-1)])
-	hitIndices.push_back(h);
-    }
-    // _________
-    // |__|__|__|
-    // |__|__|__|
-    // |XX|__|__|
-    if ( _hitMap.find(std::make_pair(i-1,j-1)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i-1,j-1)])
-	hitIndices.push_back(h);
+  size_t ProximityClusterer::findCluster(size_t clus){
+
+    while (_clusParent[clus] != clus){
+      _clusParent[clus] = _clusParent[_clusParent[clus]];
+      clus = _clusParent[clus];
     }
-    // _________
-    // |__|XX|__|
-    // |__|__|__|
-    // |__|__|__|
-    if ( _hitMap.find(std::make_pair(i,j+1)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i,j+1)])
-	hitIndices.push_back(h);
+    return clus;
+  }
+
+  size_t ProximityClusterer::hitCluster(size_t hit){
+
+    auto const& node = _hitNode[hit];
+    if (node == kNoCluster) return kNoCluster;
+    return findCluster(_nodeClus[node]);
+  }
+
+  void ProximityClusterer::addHit(size_t clus, size_t hit){
+
+    clus = findCluster(clus);
+
+    size_t node = _nodeHit.size();
+    _nodeHit.push_back(hit);
+    _nodeNext.push_back(kNoCluster);
+    _nodeClus.push_back(clus);
+
+    if (_clusTail[clus] == kNoCluster) _clusHead[clus] = node;
+    else _nodeNext[_clusTail[clus]] = node;
+    _clusTail[clus] = node;
+    _clusSize[clus] += 1;
+
+    // a hit already in another cluster (one that found no match as hit1)
+    // moves to this one but stays listed in the other
+    auto const& old_node = _hitNode[hit];
+    if (old_node != kNoCluster)
+      _clusStale[findCluster(_nodeClus[old_node])].push_back(old_node);
+    _hitNode[hit] = node;
+  }
+
+  void ProximityClusterer::mergeClusters(size_t clus1, size_t clus2){
+
+    clus1 = findCluster(clus1);
+    clus2 = findCluster(clus2);
+    if (clus1 == clus2) return;
+
+    // every hit listed in cluster 2 is assigned to the merged cluster, also
+    // hits that have moved on to another cluster since: they move back
+    std::vector<size_t> stale_v;
+    stale_v.swap(_clusStale[clus2]);
+    for (auto const& node : stale_v){
+      auto const& hit = _nodeHit[node];
+      auto cur = _hitNode[hit];
+      if (cur == node) continue;
+      auto cur_clus = findCluster(_nodeClus[cur]);
+      if (cur_clus != clus1 and cur_clus != clus2){
+	_hitNode[hit] = node;
+	_clusStale[cur_clus].push_back(cur);
+      }
+      else
+	_clusStale[clus1].push_back(node);
     }
-    // _________
-    // |__|__|__|
-    // |__|__|XX|
-    // |__|__|__|
-    if ( _hitMap.find(std::make_pair(i+1,j)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i+1,j)])
-	hitIndices.push_back(h);
+
+    // hit list of cluster 2 goes after that of cluster 1
+    if (_clusHead[clus2] != kNoCluster){
+      if (_clusTail[clus1] == kNoCluster) _clusHead[clus1] = _clusHead[clus2];
+      else _nodeNext[_clusTail[clus1]] = _clusHead[clus2];
+      _clusTail[clus1] = _clusTail[clus2];
     }
-    // _________
-    // |__|__|XX|
-    // |__|__|__|
-    // |__|__|__|
-    if ( _hitMap.find(std::make_pair(i+1,j+1)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i+1,j+1)])
-	hitIndices.push_back(h);
+
+    // union by size, the merged cluster keeping cluster 1's index
+    auto id = _clusID[clus1];
+    auto head = _clusHead[clus1];
+    auto tail = _clusTail[clus1];
+    auto size = _clusSize[clus1] + _clusSize[clus2];
+    auto root = clus1, child = clus2;
+    if (_clusSize[clus1] < _clusSize[clus2]) std::swap(root,child);
+    _clusParent[child] = root;
+    _clusID[root]   = id;
+    _clusHead[root] = head;
+    _clusTail[root] = tail;
+    _clusSize[root] = size;
+    if (root != clus1){
+      // keep the pending stale nodes with the root
+      auto& stale = _clusStale[clus1];
+      _clusStale[root].insert(_clusStale[root].end(),stale.begin(),stale.end());
+      stale.clear();
     }
-    // _________
-    // |XX|__|__|
-    // |__|__|__|
-    // |__|__|__|
-    if ( _hitMap.find(std::make_pair(i-1,j+1)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i-1,j+1)])
-	hitIndices.push_back(h);
+    else{
+      auto& stale = _clusStale[clus2];
+      _clusStale[root].insert(_clusStale[root].end(),stale.begin(),stale.end());
+      stale.clear();
     }
+  }
+
+  // get all hits from neighboring cells
+  void ProximityClusterer::getNeighboringHits(int i, int j, std::vector<size_t>& hitIndices) const {
+
+    // self, then the neighboring cells, if they exist
     // _________
-    // |__|__|__|
-    // |__|__|__|
-    // |__|__|XX|
-    if ( _hitMap.find(std::make_pair(i+1,j-1)) != _hitMap.end() ){
-      for (auto &h : _hitMap[std::make_pair(i+1,j-1)])
-	hitIndices.push_back(h);
+    // |_8|_5|_7|
+    // |_2|_1|_6|
+    // |_4|_3|_9|
+    const int di[9] = {0, -1,  0, -1, 0, 1, 1, -1,  1};
+    const int dj[9] = {0,  0, -1, -1, 1, 0, 1,  1, -1};
+
+    for (size_t n=0; n < 9; n++){
+      auto it = _cellIndex.find(cellKey(i+di[n],j+dj[n]));
+      if (it == _cellIndex.end()) continue;
+      for (size_t h=_cellStart[it->second]; h < _cellStart[it->second+1]; h++)
+	hitIndices.push_back(_cellHits[h].second);
     }
   }
 
@@ -293,10 +313,9 @@ namespace gammacatcher {
   
   void ProximityClusterer::MakeHitMap(const art::ValidHandle<std::vector<recob::Hit> >& hitlist, int plane){
     
-    _hitMap.clear();
-    // temporary pair
-    std::pair<int,int> tmpPair;
-
+    _cellHits.clear();
+    _cellStart.clear();
+    _cellIndex.clear();
     
     for (size_t h=0; h < hitlist->size(); h++){
       
@@ -323,18 +342,19 @@ namespace gammacatcher {
       // j : jth bin in time of some width
       int i = int(w/_cellSize);
       int j = int(t/_cellSize);
-      tmpPair = std::make_pair(i,j);
-      // does this entry exist in the map?
-      // if yes -> append to vector
-      // if no create new vector and add to map
-      if (_hitMap.find(tmpPair) == _hitMap.end()){
-	std::vector<size_t> aaa = {h};
-	_hitMap[tmpPair] = aaa;
-      }
-      else
-	_hitMap[tmpPair].push_back(h);
+      _cellHits.emplace_back(cellKey(i,j),h);
     }// for all hits
 
+    // group by cell, hits of a cell in index order
+    std::sort(_cellHits.begin(),_cellHits.end());
+    _cellIndex.reserve(_cellHits.size());
+    for (size_t n=0; n < _cellHits.size(); n++){
+      if (n > 0 and _cellHits[n].first == _cellHits[n-1].first) continue;
+      _cellIndex.emplace(_cellHits[n].first,_cellStart.size());
+      _cellStart.push_back(n);
+    }
+    _cellStart.push_back(_cellHits.size());
+
     return;
   }
 
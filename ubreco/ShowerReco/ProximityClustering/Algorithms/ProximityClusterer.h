@@ -15,7 +15,9 @@
 #ifndef GAMMACATCHER_PROXIMITYCLUSTERER_H
 #define GAMMACATCHER_PROXIMITYCLUSTERER_H
 
-#include <map>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Vertex.h"
@@ -101,17 +103,42 @@ namespace gammacatcher {
     bool HitsCompatible(const recob::Hit& h1, const recob::Hit& h2);
 
     /// Function to get neighboring hits (from self + neighoring cells)
-    void getNeighboringHits(const std::pair<int,int>& pair, std::vector<size_t>& hitIndices);
+    void getNeighboringHits(int i, int j, std::vector<size_t>& hitIndices) const;
 
     /// check if time overlaps
     bool TimeOverlap(const recob::Hit& h1, const recob::Hit& h2, double& dmin) const;
-    
-    /// map connecting coordinate index (i,j) to [h1,h2,h3] (hit index list)
-    std::map<std::pair<int,int>, std::vector<size_t> > _hitMap;
 
-    /// maximum i'th and j'th
-    int _maxI;
-    int _maxJ;
+    /// key of cell (i,j); keys sort like the (i,j) pairs
+    static uint64_t cellKey(int i, int j)
+    { return ((uint64_t)((uint32_t)i ^ 0x80000000u) << 32) | ((uint32_t)j ^ 0x80000000u); }
+
+    /// (cell key, hit index) of the hits of one plane, sorted
+    std::vector<std::pair<uint64_t,size_t> > _cellHits;
+    /// per cell (in key order) its first entry in _cellHits, plus the end
+    std::vector<size_t> _cellStart;
+    /// cell key -> cell number
+    std::unordered_map<uint64_t,size_t> _cellIndex;
+
+    /// Cluster bookkeeping. Each hit assignment is a node in its cluster's
+    /// hit list; clusters merge with union-find, the root holding the list
+    /// and the ID the merged cluster keeps.
+    void   clearClusters(size_t nhits);
+    size_t newCluster();
+    size_t findCluster(size_t clus);
+    /// cluster the hit is currently assigned to, kNoCluster if none
+    size_t hitCluster(size_t hit);
+    /// append hit to cluster and assign it there
+    void   addHit(size_t clus, size_t hit);
+    /// append cluster 2 to cluster 1, assigning its hits to cluster 1
+    void   mergeClusters(size_t clus1, size_t clus2);
+
+    static constexpr size_t kNoCluster = (size_t)(-1);
+
+    std::vector<size_t> _nodeHit, _nodeNext, _nodeClus;
+    std::vector<size_t> _hitNode;
+    std::vector<size_t> _clusParent, _clusSize, _clusID, _clusHead, _clusTail;
+    /// nodes that stopped being their hit's assignment, per cluster root
+    std::vector<std::vector<size_t> > _clusStale;
 
     // has the vertex been loaded?
     bool _vertex;
@@ -34,6 +34,8 @@
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardata/Utilities/AssociationUtil.h"
 
+#include "Algorithms/PFPDaughterIndex.h"
+
 class CosmicFilter;
 
 
@@ -173,6 +175,11 @@ void CosmicFilter::produce(art::Event & e)
   
   _pfpmap.clear();
 
+  // PFParticle Self() -> indices in pfp_h, to look daughters up directly
+  gammacatcher::PFPDaughterIndex pfp_daughter_index;
+  pfp_daughter_index.Build(*pfp_h);
+  std::vector<size_t> delta_v;
+
   // BEGIN : LOOP THROUGH ALL PFParticles
   for (size_t p=0; p < pfp_h->size(); p++) {
 
@@ -185,7 +192,7 @@ void CosmicFilter::produce(art::Event & e)
     if (pfp.PdgCode() != 13) continue;
 
     // grab associated track ID
-    const std::vector<art::Ptr<recob::Track> > pfp_trk_v = pfp_trk_assn_v.at(p);
+    auto const& pfp_trk_v = pfp_trk_assn_v.at(p);
     if (pfp_trk_v.size() != 1) 
       std::cout << "\t\t DD \t\t PFP associated to != 1 track" << std::endl;
     
@@ -195,31 +202,23 @@ void CosmicFilter::produce(art::Event & e)
     // get track key
     auto trkKey = pfp_trk_v.at(0).key();
     _pfpmap[trkKey] = std::vector<art::Ptr<recob::Hit>>{};
-    // get daughters
-    std::vector<size_t> daughters = pfp.Daughters();
+    auto& trk_hit_ptr_v = _pfpmap[trkKey];
 
     // find associated PFParticle daughters which are electron-like (delta-ray)
-    for (size_t pp=0; pp < pfp_h->size(); pp++) {
-
-      auto const& pfp2 = pfp_h->at(pp);
-
-      // search through daughters
-      for (auto const& daughterID : daughters) {
-	if ( (pfp2.Self() == daughterID) && (pfp2.PdgCode() == 11) ) {
-
-	  // grab associated clusters
-	  const std::vector<art::Ptr<recob::Cluster> > pfp_clu_v = pfp_clu_assn_v.at(pp);
-	  // for each cluster, find associated hits
-	  for (size_t c=0; c < pfp_clu_v.size(); c++) {
-	    // grab key and find hits
-	    const std::vector<art::Ptr<recob::Hit> > clu_hit_v = clu_hit_assn_v.at( pfp_clu_v.at(c).key() );
-	    // and add their indices to the pfp map
-	    for (size_t h=0; h < clu_hit_v.size(); h++)
-	      _pfpmap[trkKey].push_back( clu_hit_v.at(h) );
-	  }// for all clusters associated to PFP
-	}// if is daughter
-      }// for all daughters
-    }// second pfparticle loop
+    // one entry per matching (daughter ID, PFParticle) pair, added in PFParticle order
+    pfp_daughter_index.Daughters(pfp, 11, delta_v);
+
+    for (auto const& pp : delta_v) {
+      // grab associated clusters
+      auto const& pfp_clu_v = pfp_clu_assn_v.at(pp);
+      // for each cluster, find associated hits
+      for (size_t c=0; c < pfp_clu_v.size(); c++) {
+	// grab key and find hits
+	auto const& clu_hit_v = clu_hit_assn_v.at( pfp_clu_v.at(c).key() );
+	// and add their indices to the pfp map
+	trk_hit_ptr_v.insert( trk_hit_ptr_v.end(), clu_hit_v.begin(), clu_hit_v.end() );
+      }// for all clusters associated to PFP
+    }// for all delta-ray daughters
   }// for all PFParticles
   // END : PFPARTICLE MAP SCAN TO FIND DELTA-RAYS
 
@@ -259,7 +258,7 @@ void CosmicFilter::produce(art::Event & e)
     // in all other cases, track is cosmic-like
     // grab associated hits and compare to SSNet hits
     // if matched -> tag as one to be removed
-    const std::vector<art::Ptr<recob::Hit> > hit_v = trk_hit_assn_v.at(t);
+    auto const& hit_v = trk_hit_assn_v.at(t);
 
     for (size_t h=0; h < hit_v.size(); h++) {
       art::Ptr<recob::Hit> hit = hit_v.at(h);
@@ -18,6 +18,11 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 
 // larsoft data-products
 #include "larcore/Geometry/WireReadout.h"
@@ -82,14 +87,37 @@ private:
 
   ::cluster::ClusterMaker _clusterMaker;
 
-  // vector of all collection-plane hits for all showers in the event
-  std::vector< art::Ptr<recob::Hit> > _allshr_hit_v;
+  // identity of a collection-plane hit for the duplicate check: wire and peak time
+  struct HitKey_t {
+    unsigned int wire;
+    float        time;
+    bool operator==(const HitKey_t& other) const { return (wire == other.wire) && (time == other.time); }
+  };
+  struct HitKeyHash_t {
+    size_t operator()(const HitKey_t& key) const
+    { return std::hash<unsigned int>()(key.wire) * 1000003u ^ std::hash<float>()(key.time); }
+  };
+
+  // keys of all collection-plane hits for all showers in the event
+  std::unordered_set< HitKey_t, HitKeyHash_t > _allshr_hit_keys;
 
   // map connecting photon cluster index to linearity object
   std::map< size_t, twodimtools::Linearity > _photon_lin_map; 
   // map connecting photon cluster index to poly2d object
   std::map< size_t, twodimtools::Poly2D > _photon_poly_map; 
 
+  // wire/time grid of photon polygon bounding boxes: cell -> photon indices, in increasing order
+  std::unordered_map< uint64_t, std::vector<size_t> > _photon_grid;
+  // photons whose bounding box does not fit in the grid. always candidates
+  std::vector<size_t> _photon_unbinned_v;
+
+  // fill the grid from _photon_poly_map
+  void IndexPhotons();
+
+  // indices, in increasing order, of photons whose polygon bounding box overlaps the shower's
+  // (a requirement of Poly2D::Overlap and Poly2D::Contained)
+  void PhotonCandidates(const twodimtools::Poly2D& shr, std::vector<size_t>& photon_idx_v) const;
+
   twodimtools::Poly2D projectShower(detinfo::DetectorClocksData const& clockData,
                                     const art::Ptr<recob::Cluster> clus);
 
@@ -230,13 +258,15 @@ void PhotonMerge::produce(art::Event & e)
 
   }// for all clusters
 
+  IndexPhotons();
+
   // get full list of all hits associated to all showers on the collection plane
   // these cannot be added to any cluster
-  _allshr_hit_v.clear();
+  _allshr_hit_keys.clear();
   for (size_t s=0; s < shr_h->size(); s++) {
-    std::vector< art::Ptr<recob::Hit> > shr_hit_v = shr_hit_assn_v.at(s);
-    for (auto hitPtr : shr_hit_v) {
-      if (hitPtr->WireID().Plane == 2) { _allshr_hit_v.push_back( hitPtr ); }
+    std::vector< art::Ptr<recob::Hit> > const& shr_hit_v = shr_hit_assn_v.at(s);
+    for (auto const& hitPtr : shr_hit_v) {
+      if (hitPtr->WireID().Plane == 2) { _allshr_hit_keys.insert( HitKey_t{ hitPtr->WireID().Wire, hitPtr->PeakTime() } ); }
     }// for all hits
   }// for all showers
 
@@ -276,11 +306,12 @@ void PhotonMerge::produce(art::Event & e)
       // if no hits associated on this plane -> skip
     if (shr_hit_plv_v[2].size() == 0) continue;
     
-    // loop over photons for this plane
-    for (std::map<size_t,twodimtools::Poly2D>::iterator it = _photon_poly_map.begin(); it != _photon_poly_map.end(); ++it) {
+    // loop over photons for this plane that are close enough to overlap the shower cone
+    std::vector<size_t> photon_idx_v;
+    PhotonCandidates(shrPoly, photon_idx_v);
+    for (auto const& photonIdx : photon_idx_v) {
       
-      auto const& photonPoly = it->second;
-      auto const& photonIdx  = it->first;
+      auto const& photonPoly = _photon_poly_map.at(photonIdx);
       // get linearity
       auto const& photonLin = _photon_lin_map[ photonIdx ];
 
@@ -622,14 +653,7 @@ int PhotonMerge::MergeHits(std::vector< art::Ptr<recob::Hit> >& shrhits, const s
 
   for (auto const& gammahit : gammahits) {
 
-    bool duplicate = false;
-
-    for (auto const& shrhit : _allshr_hit_v) {
-      if ( (shrhit->WireID().Wire == gammahit->WireID().Wire) && (shrhit->PeakTime() == gammahit->PeakTime() ) ) {
-	duplicate = true;
-	break; 
-      }// if duplicate
-    }// for hits in gamma hits
+    bool duplicate = ( _allshr_hit_keys.count( HitKey_t{ gammahit->WireID().Wire, gammahit->PeakTime() } ) > 0 );
     
     if (duplicate == false) {
       nhitsmerged +=1;
@@ -641,6 +665,88 @@ int PhotonMerge::MergeHits(std::vector< art::Ptr<recob::Hit> >& shrhits, const s
   return nhitsmerged;
 }
 
+namespace {
+
+  // size of a photon grid cell [cm]
+  const double kPhotonCell = 20.;
+  // largest number of cells a bounding box may cover before it is left out of the grid
+  const int64_t kMaxPhotonCells = 4096;
+
+  // cell range covered by a bounding box. false if it cannot be gridded
+  bool PhotonCellRange(float wmin, float wmax, float tmin, float tmax,
+		       int64_t& iw0, int64_t& iw1, int64_t& it0, int64_t& it1)
+  {
+    for (double v : { wmin, wmax, tmin, tmax })
+      if ( !std::isfinite(v) || std::abs(v / kPhotonCell) > 1.e9 ) return false;
+    iw0 = (int64_t)std::floor(wmin / kPhotonCell);
+    iw1 = (int64_t)std::floor(wmax / kPhotonCell);
+    it0 = (int64_t)std::floor(tmin / kPhotonCell);
+    it1 = (int64_t)std::floor(tmax / kPhotonCell);
+    return ( (iw1 - iw0 + 1) * (it1 - it0 + 1) <= kMaxPhotonCells );
+  }
+
+  uint64_t PhotonCellKey(int64_t iw, int64_t it)
+  { return ((uint64_t)iw << 32) ^ (uint64_t)(uint32_t)it; }
+
+}
+
+void PhotonMerge::IndexPhotons() {
+
+  _photon_grid.clear();
+  _photon_unbinned_v.clear();
+
+  // map is ordered by photon index, so each cell's list comes out sorted
+  for (auto const& photon : _photon_poly_map) {
+
+    float wmin, wmax, tmin, tmax;
+    photon.second.Bounds(wmin, wmax, tmin, tmax);
+
+    int64_t iw0, iw1, it0, it1;
+    if ( (wmin > wmax) || (tmin > tmax) || !PhotonCellRange(wmin, wmax, tmin, tmax, iw0, iw1, it0, it1) ) {
+      _photon_unbinned_v.push_back(photon.first);
+      continue;
+    }
+
+    for (int64_t iw = iw0; iw <= iw1; iw++)
+      for (int64_t it = it0; it <= it1; it++)
+	_photon_grid[ PhotonCellKey(iw, it) ].push_back(photon.first);
+
+  }// for all photons
+
+  return;
+}
+
+void PhotonMerge::PhotonCandidates(const twodimtools::Poly2D& shr, std::vector<size_t>& photon_idx_v) const {
+
+  photon_idx_v = _photon_unbinned_v;
+
+  float wmin, wmax, tmin, tmax;
+  shr.Bounds(wmin, wmax, tmin, tmax);
+
+  // empty shower polygon: nothing can overlap it
+  if ( (wmin > wmax) || (tmin > tmax) ) return;
+
+  int64_t iw0, iw1, it0, it1;
+  if ( !PhotonCellRange(wmin, wmax, tmin, tmax, iw0, iw1, it0, it1) ) {
+    photon_idx_v.clear();
+    for (auto const& photon : _photon_poly_map) photon_idx_v.push_back(photon.first);
+    return;
+  }
+
+  for (int64_t iw = iw0; iw <= iw1; iw++) {
+    for (int64_t it = it0; it <= it1; it++) {
+      auto cell = _photon_grid.find( PhotonCellKey(iw, it) );
+      if (cell == _photon_grid.end()) continue;
+      photon_idx_v.insert(photon_idx_v.end(), cell->second.begin(), cell->second.end());
+    }
+  }
+
+  std::sort(photon_idx_v.begin(), photon_idx_v.end());
+  photon_idx_v.erase( std::unique(photon_idx_v.begin(), photon_idx_v.end()), photon_idx_v.end() );
+
+  return;
+}
+
 void PhotonMerge::beginJob()
 {
   // Implementation of optional member function here.
@@ -0,0 +1,73 @@
+#ifndef SHOWERRECO_ALGOPROFILE_CXX
+#define SHOWERRECO_ALGOPROFILE_CXX
+
+#include "AlgoProfile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace showerreco {
+
+  namespace {
+    const double kTimeMin       = 1.e-7; ///< lower edge of the first bin [s]
+    const size_t kBinsPerDecade = 20;
+    const size_t kDecades       = 10;
+    const size_t kNBins         = kBinsPerDecade * kDecades + 2;
+  }
+
+  AlgoProfile::AlgoProfile()
+    : _calls(0), _failed(0), _time_sum(0.), _time_max(0.), _heap_sum(0.),
+      _time_hist(kNBins, 0)
+  {}
+
+  void AlgoProfile::Fill(double time, double heap_change, bool failed)
+  {
+    _calls    += 1;
+    _failed   += (failed ? 1 : 0);
+    _time_sum += time;
+    _heap_sum += heap_change;
+    if (time > _time_max) _time_max = time;
+    _time_hist[Bin(time)] += 1;
+  }
+
+  void AlgoProfile::Merge(const AlgoProfile& other)
+  {
+    _calls    += other._calls;
+    _failed   += other._failed;
+    _time_sum += other._time_sum;
+    _heap_sum += other._heap_sum;
+    if (other._time_max > _time_max) _time_max = other._time_max;
+    for (size_t i = 0; i < kNBins; i++)
+      _time_hist[i] += other._time_hist[i];
+  }
+
+  double AlgoProfile::QuantileTime(double q) const
+  {
+    if (!_calls) return 0.;
+    // number of calls that must be at or below the answer
+    double need = q * _calls;
+    size_t sum = 0;
+    for (size_t i = 0; i < kNBins; i++) {
+      sum += _time_hist[i];
+      if (sum >= need && sum > 0)
+	return std::min(BinUpEdge(i), _time_max);
+    }
+    return _time_max;
+  }
+
+  size_t AlgoProfile::Bin(double time) const
+  {
+    if (!(time >= kTimeMin)) return 0;
+    double bin = std::floor(std::log10(time / kTimeMin) * kBinsPerDecade);
+    if (bin >= (double)(kNBins - 2)) return kNBins - 1;
+    return (size_t)bin + 1;
+  }
+
+  double AlgoProfile::BinUpEdge(size_t bin) const
+  {
+    if (bin >= kNBins - 1) return _time_max;
+    return kTimeMin * std::pow(10., (double)bin / kBinsPerDecade);
+  }
+
+}
+
+#endif
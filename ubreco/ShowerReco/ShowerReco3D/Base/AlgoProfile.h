@@ -0,0 +1,76 @@
+/**
+ * \file AlgoProfile.h
+ *
+ * \ingroup ShowerReco3D
+ *
+ * \brief Class def header for a class AlgoProfile
+ *
+ */
+
+/** \addtogroup ShowerReco3D
+
+    @{*/
+#ifndef SHOWERRECO_ALGOPROFILE_H
+#define SHOWERRECO_ALGOPROFILE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace showerreco {
+
+/**
+   \class AlgoProfile
+   Time and memory profile of one shower reconstruction module, filled once
+   per proto-shower. Call times go into a log-binned histogram (20 bins per
+   decade between 0.1 us and 1000 s) so that percentiles can be quoted
+   without keeping every call. Profiles filled by different workers are
+   combined with Merge.
+*/
+class AlgoProfile {
+
+public:
+
+  AlgoProfile();
+
+  /// Record one call: time [s], change in shower heap memory [bytes], and
+  /// whether the module rejected the shower
+  void Fill(double time, double heap_change, bool failed);
+
+  /// Add the calls recorded by another profile
+  void Merge(const AlgoProfile& other);
+
+  size_t Calls()    const { return _calls;  }
+  size_t Failures() const { return _failed; }
+
+  /// Mean time per call [s]
+  double MeanTime() const { return _calls ? _time_sum / _calls : 0.; }
+
+  /// Longest call [s]
+  double MaxTime()  const { return _time_max; }
+
+  /// Time below which a fraction q of the calls fall [s], to bin precision
+  double QuantileTime(double q) const;
+
+  /// Mean change in shower heap memory per call [bytes]
+  double MeanHeapChange() const { return _calls ? _heap_sum / _calls : 0.; }
+
+private:
+
+  size_t Bin(double time) const;
+
+  double BinUpEdge(size_t bin) const;
+
+  size_t _calls;
+  size_t _failed;
+  double _time_sum;
+  double _time_max;
+  double _heap_sum;
+
+  /// underflow, log bins, overflow
+  std::vector<size_t> _time_hist;
+
+};
+}
+
+#endif
+/** @} */ // end of doxygen group
@@ -62,6 +62,14 @@ public:
     virtual void do_reconstruction(const util::GeometryUtilities& geomUtilities,
                                    const ::protoshower::ProtoShower & proto_shower, Shower_t & shower) = 0;
 
+    /**
+     * @brief Whether do_reconstruction may run on several showers at once
+     * @details Return true only if do_reconstruction does not modify the module's
+     * own state, or protects it (e.g. a TTree fill) with a lock.  ShrRecoManager
+     * reconstructs showers in parallel only if every module says so.
+     */
+    virtual bool threadSafe() const { return false; }
+
     /**
      * @brief Verbosity setter function for each Modular Algo
      */
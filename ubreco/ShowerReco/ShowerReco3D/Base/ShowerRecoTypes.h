@@ -123,6 +123,22 @@ struct Shower_t {
     fIndex = kSIZE_MAX;
 
   }
+
+  /// Heap memory held by the vector members [bytes], used for profiling
+  size_t HeapBytes() const {
+    size_t bytes = 0;
+    for (auto const* v : { &fTotalEnergy_v, &fSigmaTotalEnergy_v,
+	  &fTotalMIPEnergy_v, &fSigmaTotalMIPEnergy_v, &fdEdx_v, &fSigmadEdx_v,
+	  &fdQdx_v, &fSigmadQdx_v, &fShoweringLength })
+      bytes += v->capacity() * sizeof(double);
+    bytes += fdEdx_v_v.capacity() * sizeof(std::vector<double>);
+    for (auto const& v : fdEdx_v_v) bytes += v.capacity() * sizeof(double);
+    bytes += fHitdQdx_v.capacity() * sizeof(std::vector<double>);
+    for (auto const& v : fHitdQdx_v) bytes += v.capacity() * sizeof(double);
+    bytes += fPlaneIDs.capacity() * sizeof(::geo::PlaneID);
+    bytes += fPlaneIsBad.capacity() / 8;
+    return bytes;
+  }
 }; // end of shower struct
 
 }
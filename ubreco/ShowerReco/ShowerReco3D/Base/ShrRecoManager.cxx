@@ -2,25 +2,28 @@
 #define SHOWERRECO_SHRRECOMANAGER_CXX
 
 #include "ShrRecoManager.h"
+#include "TStopwatch.h"
 #include <iomanip>
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 namespace showerreco {
   
   ShrRecoManager::ShrRecoManager()
+    : _worker_profile_v([this] { return std::vector<AlgoProfile>(_alg_v.size()); })
   { 
+    _parallel_showers = false;
     _alg_v.clear();
     _ana_v.clear();
     _proto_showers.clear();
-    _alg_time_v.clear();
-    _alg_ctr_v.clear();
+    _alg_profile_v.clear();
 }
   
   void ShrRecoManager::Initialize()
   {
     for (auto & alg : _alg_v) {
       alg->initialize();
-      _alg_time_v.push_back(0.);
-      _alg_ctr_v.push_back(0);
+      _alg_profile_v.push_back(AlgoProfile());
     }
     
     return;
@@ -38,11 +41,26 @@ namespace showerreco {
   {
     
     showers.clear();
-    showers.reserve(_proto_showers.size());
-    
-    // for all pfparticle proto-showers
-    for (auto const& proto_shower : _proto_showers) 
-      showers.push_back(RecoOneShower(gser, proto_shower));
+    showers.resize(_proto_showers.size());
+
+    bool parallel = _parallel_showers && _proto_showers.size() > 1 && !(_debug && _verbose);
+    for (auto const& alg : _alg_v)
+      parallel = parallel && alg->threadSafe();
+
+    // for all pfparticle proto-showers. Showers are independent, so in parallel
+    // mode each thread profiles into its own set, combined at Finalize
+    if (parallel) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, _proto_showers.size(), 1),
+			[&](tbb::blocked_range<size_t> const& range) {
+			  auto& profile_v = _worker_profile_v.local();
+			  for (size_t i = range.begin(); i != range.end(); ++i)
+			    showers[i] = RecoOneShower(gser, _proto_showers[i], profile_v);
+			});
+    }
+    else {
+      for (size_t i = 0; i < _proto_showers.size(); i++)
+	showers[i] = RecoOneShower(gser, _proto_showers[i], _alg_profile_v);
+    }
     
     // Check that the showers reconstructed are the same length as the proto_showers vector
     if (showers.size() != _proto_showers.size()) {
@@ -55,7 +73,16 @@ namespace showerreco {
   ::showerreco::Shower_t ShrRecoManager::RecoOneShower(util::GeometryUtilities const& gser,
 						       const ::protoshower::ProtoShower& proto_shower)
   {
+    return RecoOneShower(gser, proto_shower, _alg_profile_v);
+  }
+
+  ::showerreco::Shower_t ShrRecoManager::RecoOneShower(util::GeometryUtilities const& gser,
+						       const ::protoshower::ProtoShower& proto_shower,
+						       std::vector<AlgoProfile>& profile_v)
+  {
     
+    TStopwatch watch;
+
     // reset product shoer
     Shower_t result;
     Reset(result);
@@ -68,19 +95,20 @@ namespace showerreco {
     // loop through reconstruction modules
     for (size_t n = 0; n < _alg_v.size(); n++) {
       
-      _watch.Start();
+      double heap_before = result.HeapBytes();
+      watch.Start();
 
       try {
         _alg_v[n] -> do_reconstruction(gser, proto_shower, result);
       }// if reco succeeds
       catch (ShowerRecoException const& e) {
 	//catch (std::exception e) {
+	profile_v[n].Fill(watch.RealTime(), result.HeapBytes() - heap_before, true);
 	result.fPassedReconstruction = false;
 	std::cout << e.what() << std::endl;
 	return result;
       }// if reco fails
-      _alg_time_v[n] += _watch.RealTime();
-      _alg_ctr_v[n] += 1;
+      profile_v[n].Fill(watch.RealTime(), result.HeapBytes() - heap_before, false);
       if (_debug && _verbose) {
 	printChanges(localCopy, result, _alg_v[n]->name());
 	localCopy = result;
@@ -443,14 +471,30 @@ void ShrRecoManager::PrintModuleList() {
 void ShrRecoManager::Finalize(TFile* fout)
 {
 
+  for (auto const& profile_v : _worker_profile_v)
+    for (size_t n = 0; n < _alg_v.size(); n++)
+      _alg_profile_v[n].Merge(profile_v[n]);
+  _worker_profile_v.clear();
+
   // loop through algos and evaluate time-performance
   std::cout << std::endl
-            << "=================== Time Report =====================" << std::endl;
+            << "=================== Time Report =====================" << std::endl
+            << std::setw(25) << "Algo"
+            << std::setw(10) << "Calls"
+            << std::setw(10) << "Failed"
+            << std::setw(12) << "Mean [us]"
+            << std::setw(12) << "p99 [us]"
+            << std::setw(12) << "Max [us]"
+            << std::setw(22) << "Heap [bytes/shower]" << std::endl;
   for (size_t n = 0; n < _alg_v.size(); n++) {
-    double alg_time = _alg_time_v[n] / ((double)_alg_ctr_v[n]);
-    std::cout <<  std::setw(25) << _alg_v[n]->name() << "\t Algo Time: "
-              << std::setw(10) << alg_time * 1.e6     << " [us/proto_shower]"
-              << "\t Proto-Showers Scanned: " << _alg_ctr_v[n] << std::endl;
+    auto const& prof = _alg_profile_v[n];
+    std::cout << std::setw(25) << _alg_v[n]->name()
+              << std::setw(10) << prof.Calls()
+              << std::setw(10) << prof.Failures()
+              << std::setw(12) << prof.MeanTime() * 1.e6
+              << std::setw(12) << prof.QuantileTime(0.99) * 1.e6
+              << std::setw(12) << prof.MaxTime() * 1.e6
+              << std::setw(22) << prof.MeanHeapChange() << std::endl;
   }
 
   std::cout << "=====================================================" << std::endl
@@ -19,7 +19,8 @@
 #include "ShowerRecoException.h"
 #include "ShowerRecoModuleBase.h"
 #include "ShowerAnaBase.h"
-#include "TStopwatch.h"
+#include "AlgoProfile.h"
+#include "tbb/enumerable_thread_specific.h"
 namespace util {
   class GeometryUtilities;
 }
@@ -99,6 +100,17 @@ public:
      */
     void SetVerbose(bool b = true) { _verbose = b; }
 
+    /**
+     * @brief Reconstruct the proto-showers of an event in parallel
+     * @details Only used if every module is threadSafe() and debug printout is off.
+     * Each shower is still reconstructed by the modules in order, and the output
+     * is the same as in serial mode. Module debugging trees are filled in the
+     * order showers finish, so their entries may be reordered; in dEdxModule's
+     * tree a plane without a cluster repeats the previous entry's values, which
+     * then depend on thread scheduling too.
+     */
+    void SetParallelShowers(bool b = true) { _parallel_showers = b; }
+
     
     /**
      */
@@ -108,6 +120,7 @@ public:
     
     bool _debug;
     bool _verbose;
+    bool _parallel_showers;
 
     /// Shower reconstruction algorithm
     std::vector< std::unique_ptr<::showerreco::ShowerRecoModuleBase> > _alg_v;
@@ -122,15 +135,22 @@ public:
     std::vector< ::protoshower::ProtoShower > _proto_showers;
     
     void Reset(Shower_t& result);
+
+    /// Run the module chain on one proto-shower, profiling each module into profile_v
+    ::showerreco::Shower_t RecoOneShower(util::GeometryUtilities const& gser,
+					 const ::protoshower::ProtoShower& proto_shower,
+					 std::vector<AlgoProfile>& profile_v);
     
     void printChanges(const Shower_t & localCopy,
 		      const Shower_t result,
 		      std::string moduleName);
     
-    // Time profilers
-    TStopwatch _watch; ///< For profiling
-    std::vector<double> _alg_time_v; ///< Overall time for processing
-    std::vector<size_t> _alg_ctr_v;  ///< Overall number of clusters processed by algo;
+    /// Time and memory profile of each module, over the whole job
+    std::vector<AlgoProfile> _alg_profile_v;
+
+    /// Profiles filled by the workers of parallel Reconstruct calls, one set
+    /// per thread for the whole job; added to _alg_profile_v by Finalize
+    tbb::enumerable_thread_specific<std::vector<AlgoProfile> > _worker_profile_v;
     
 };
 }
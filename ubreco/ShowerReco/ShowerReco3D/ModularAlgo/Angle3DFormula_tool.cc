@@ -34,6 +34,9 @@ namespace showerreco {
     
     void do_reconstruction(const util::GeometryUtilities&,
                            const ::protoshower::ProtoShower &, Shower_t &);
+
+    // verbose printout would interleave between showers
+    bool threadSafe() const { return !_verbose; }
     
   private:
     
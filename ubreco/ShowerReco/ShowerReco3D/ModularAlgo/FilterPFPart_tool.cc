@@ -28,6 +28,8 @@ namespace showerreco {
     
     void do_reconstruction(const util::GeometryUtilities&,
                            const ::protoshower::ProtoShower &, Shower_t &);
+
+    bool threadSafe() const { return true; }
     
     void setMinNHitsAbsolute(int n) { _min_nhits_absolute = n; }
     void setMinNHitsLargest (int n) { _min_nhits_largest  = n; }
@@ -33,6 +33,8 @@ namespace showerreco {
     
     void do_reconstruction(util::GeometryUtilities const&,
                            const ::protoshower::ProtoShower &, Shower_t &);
+
+    bool threadSafe() const { return !_verbose; }
     
   private:
     
@@ -3,6 +3,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 
 #include "ubreco/ShowerReco/ShowerReco3D/Base/ShowerRecoModuleBase.h"
 #include "ubreco/ShowerReco/ShowerReco3D/Base/Calorimetry.h"
@@ -38,6 +39,9 @@ namespace showerreco {
                            const ::protoshower::ProtoShower &, Shower_t &);
     
     void initialize();
+
+    // verbose printout would interleave between showers
+    bool threadSafe() const { return !_verbose; }
     
   private:
 
@@ -47,6 +51,8 @@ namespace showerreco {
     */
 
     //double _recomb, _ADC_to_e, _e_to_MeV;
+    // debugging tree, filled under _tree_mutex
+    std::mutex _tree_mutex;
     TTree* _energy_tree;
     double _e0, _e1, _e2;
     int    _nhit0, _nhit1, _nhit2;
@@ -91,12 +97,9 @@ namespace showerreco {
     //handle to tpc energy calibration provider
     //const lariov::TPCEnergyCalibProvider& energyCalibProvider  = art::ServiceHandle<lariov::TPCEnergyCalibService>()->GetProvider();
 
-    _e0 = 0.;
-    _e1 = 0.;
-    _e2 = 0.;
-    _nhit0 = 0;
-    _nhit1 = 0;
-    _nhit2 = 0;
+    // per-plane values for the debugging tree
+    double e_pl[3]    = {0., 0., 0.};
+    int    nhit_pl[3] = {0, 0, 0};
 
     //if the module does not have 2D cluster info -> fail the reconstruction
     if (!proto_shower.hasCluster2D()){
@@ -143,22 +146,19 @@ namespace showerreco {
       // set the energy for this plane
       resultShower.fTotalEnergy_v[pl] = E;
 
-      if (pl==0) {
-	_nhit0 = hits.size();
-	_e0     = E;
-      }
-      if (pl==1) {
-	_nhit1 = hits.size();
-	_e1     = E;
-      }
-      if (pl==2) {
-	_nhit2 = hits.size();
-	_e2     = E;
+      if (pl < 3) {
+	nhit_pl[pl] = hits.size();
+	e_pl[pl]    = E;
       }
       
     }// for all input clusters
 
-    _energy_tree->Fill();
+    {
+      std::lock_guard<std::mutex> lock(_tree_mutex);
+      _e0 = e_pl[0]; _e1 = e_pl[1]; _e2 = e_pl[2];
+      _nhit0 = nhit_pl[0]; _nhit1 = nhit_pl[1]; _nhit2 = nhit_pl[2];
+      _energy_tree->Fill();
+    }
     
     if (hasPl2)
       resultShower.fTotalEnergy = resultShower.fTotalEnergy_v[2];
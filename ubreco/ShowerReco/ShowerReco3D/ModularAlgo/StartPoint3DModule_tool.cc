@@ -27,6 +27,8 @@ namespace showerreco {
     /// Inherited/overloaded function from ShowerRecoModuleBase
     void do_reconstruction(util::GeometryUtilities const&,
                            const ::protoshower::ProtoShower &, Shower_t &);
+
+    bool threadSafe() const { return true; }
     
   };
 
@@ -26,6 +26,8 @@ namespace showerreco {
     void do_reconstruction(const util::GeometryUtilities&,
                            const ::protoshower::ProtoShower &, Shower_t &);
 
+    bool threadSafe() const { return true; }
+
   };
   
   StartPoint3DfromVtx::StartPoint3DfromVtx(const fhicl::ParameterSet& pset)
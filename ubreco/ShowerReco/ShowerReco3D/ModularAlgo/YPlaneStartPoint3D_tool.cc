@@ -28,6 +28,8 @@ namespace showerreco {
     void do_reconstruction(util::GeometryUtilities const&,
                            const ::protoshower::ProtoShower &, Shower_t &);
 
+    bool threadSafe() const { return true; }
+
   private:
 
     double _wire2cm, _time2cm;
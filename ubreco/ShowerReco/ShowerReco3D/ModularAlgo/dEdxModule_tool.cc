@@ -2,6 +2,7 @@
 #define DEDXMODULE_CXX
 
 #include <iostream>
+#include <mutex>
 #include "ubreco/ShowerReco/ShowerReco3D/Base/ShowerRecoModuleBase.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
 #include "larcore/Geometry/WireReadout.h"
@@ -36,6 +37,9 @@ namespace showerreco {
                            const ::protoshower::ProtoShower &, Shower_t &);
     
     void initialize();
+
+    // verbose printout would interleave between showers
+    bool threadSafe() const { return !_verbose; }
     
   protected:
 
@@ -47,7 +51,10 @@ namespace showerreco {
 			   const int& pl, const lariov::TPCEnergyCalibProvider& energyCalibProvider);
     */
 
-    // debugging tree
+    // debugging tree, filled under _tree_mutex. With parallel showers the
+    // entries come in completion order, and the values a plane without a
+    // cluster carries over from the previous entry depend on scheduling
+    std::mutex _tree_mutex;
     TTree* _dedx_tree;
     double _dedx0, _dedx1, _dedx2;
     std::vector<double> _dedx0_v, _dedx1_v, _dedx2_v;
@@ -131,9 +138,11 @@ namespace showerreco {
     if (_verbose)
       std::cout << "3D shower direction : " << dir3D[0] << ", " << dir3D[1] << ", " << dir3D[2] << std::endl;
 
-    _px = dir3D[0];
-    _py = dir3D[1];
-    _pz = dir3D[2];
+    // per-plane values for the debugging tree
+    bool   seen[3]  = {false, false, false};
+    double pitch_pl[3], dedx_pl[3];
+    int    nhits_pl[3], ntot_pl[3];
+    std::vector<double> dedx_v_pl[3];
 
     // loop through planes
     auto const& channelMap = art::ServiceHandle<geo::WireReadout>()->Get();
@@ -225,26 +234,13 @@ namespace showerreco {
 	  std::cout << "dedx Module : Final dEdx = " << dedx << std::endl;
 	}
 
-      if (pl == 0) {
-	_pitch0 = pitch;
-	_nhits0 = nhits;
-	_dedx0_v = dedx_v;
-	_dedx0 = dedx;
-	_ntot0 = hits.size();
-      }
-      if (pl == 1) {
-	_pitch1 = pitch;
-	_nhits1 = nhits;
-	_dedx1_v = dedx_v;
-	_dedx1 = dedx;
-	_ntot1 = hits.size();
-      }
-      if (pl == 2) {
-	_pitch2 = pitch;
-	_nhits2 = nhits;
-	_dedx2_v = dedx_v;
-	_dedx2 = dedx;
-	_ntot2 = hits.size();
+      if (pl < 3) {
+	seen[pl]      = true;
+	pitch_pl[pl]  = pitch;
+	nhits_pl[pl]  = nhits;
+	dedx_v_pl[pl] = dedx_v;
+	dedx_pl[pl]   = dedx;
+	ntot_pl[pl]   = hits.size();
       }
 
       resultShower.fdEdx_v.at(pl) = dedx;
@@ -255,6 +251,24 @@ namespace showerreco {
       
     }// for all clusters (planes)
 
+    // planes without a cluster keep the values of the previous entry (the
+    // previous shower to finish, in parallel mode)
+    std::lock_guard<std::mutex> lock(_tree_mutex);
+    _px = dir3D[0];
+    _py = dir3D[1];
+    _pz = dir3D[2];
+    if (seen[0]) {
+      _pitch0 = pitch_pl[0]; _nhits0 = nhits_pl[0]; _dedx0_v = std::move(dedx_v_pl[0]);
+      _dedx0  = dedx_pl[0];  _ntot0  = ntot_pl[0];
+    }
+    if (seen[1]) {
+      _pitch1 = pitch_pl[1]; _nhits1 = nhits_pl[1]; _dedx1_v = std::move(dedx_v_pl[1]);
+      _dedx1  = dedx_pl[1];  _ntot1  = ntot_pl[1];
+    }
+    if (seen[2]) {
+      _pitch2 = pitch_pl[2]; _nhits2 = nhits_pl[2]; _dedx2_v = std::move(dedx_v_pl[2]);
+      _dedx2  = dedx_pl[2];  _ntot2  = ntot_pl[2];
+    }
     _dedx_tree->Fill();
     
     return;
@@ -197,6 +197,7 @@ ShrReco3D::ShrReco3D(fhicl::ParameterSet const & p)
   }// for all algorithms to be added
 
   _manager->SetDebug(false);
+  _manager->SetParallelShowers(p.get<bool>("ParallelShowers",false));
 
   //_manager = new ::showerreco::Pi0RecoAlgorithm();
   _psalg = art::make_tool<::protoshower::ProtoShowerAlgBase>(protoshower_pset);
@@ -2,6 +2,8 @@
 #define TWODIM_POLY2D_CXX
 
 #include "Poly2D.h"
+#include <algorithm>
+#include <limits>
 
 #include "larcore/Geometry/WireReadout.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
@@ -14,6 +16,7 @@ namespace twodimtools {
   Poly2D::Poly2D()
   { 
     vertices.clear(); 
+    UpdateBounds();
     // get detector specific properties
     auto const& channelMap = art::ServiceHandle<geo::WireReadout>()->Get();
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService>()->DataForJob();
@@ -27,6 +30,7 @@ namespace twodimtools {
     : Poly2D()
   {
     SelectPolygonHitList(hit_v,vertices,0.95);
+    UpdateBounds();
   }
   
   //------------------------------------------------
@@ -87,6 +91,7 @@ namespace twodimtools {
     if ( !(poly1.PolyOverlap(poly2)) ) {
       std::vector< std::pair<float, float> > nullpoint;
       vertices = nullpoint;
+      UpdateBounds();
       return;
     }
     
@@ -123,6 +128,7 @@ namespace twodimtools {
     }//for all segments in poly1
     
     vertices = IntersectionPoints;
+    UpdateBounds();
     return;
   }
   
@@ -218,10 +224,12 @@ namespace twodimtools {
     
     bool overlap = false;
 
+    // no vertex of poly2 can be inside if the bounding boxes are apart
+    if (!BoundsOverlap(poly2)) return false;
     
     for (size_t j=0; j < poly2.Size(); j++){
       
-      if ( this->PointInside(poly2.Point(j)) == true) {
+      if ( this->PointInside(poly2.vertices[j]) == true) {
 	overlap = true;
 	break;
       }
@@ -284,14 +292,23 @@ namespace twodimtools {
     if ( (this->Contained(poly2)) or (poly2.Contained(*this)) ) {
       return true;
     }
+    if (!BoundsOverlap(poly2)) return false;
     //loop over the two polygons checking wehther
-    //two segments ever intersect
-    for (unsigned int i = 0; i < this->Size(); i++) {
-      for (unsigned int j = 0; j < poly2.Size(); j++) {
-	if (SegmentOverlap( this->Point(i).first, this->Point(i).second,
-			    this->Point(i + 1).first, this->Point(i + 1).second,
-			    poly2.Point(j).first, poly2.Point(j).second,
-			    poly2.Point(j + 1).first, poly2.Point(j + 1).second) ) {
+    //two segments ever intersect. Edges of this polygon
+    //that lie outside poly2's bounding box are skipped
+    const size_t n1 = this->Size();
+    const size_t n2 = poly2.Size();
+    for (size_t i = 0; i < n1; i++) {
+      auto const& A = vertices[i];
+      auto const& B = vertices[(i + 1 < n1) ? i + 1 : 0];
+      if ( std::min(A.first,  B.first)  > poly2._xmax || std::max(A.first,  B.first)  < poly2._xmin ||
+	   std::min(A.second, B.second) > poly2._ymax || std::max(A.second, B.second) < poly2._ymin )
+	continue;
+      for (size_t j = 0; j < n2; j++) {
+	auto const& C = poly2.vertices[j];
+	auto const& D = poly2.vertices[(j + 1 < n2) ? j + 1 : 0];
+	if (SegmentOverlap( A.first, A.second, B.first, B.second,
+			    C.first, C.second, D.first, D.second) ) {
 	  return true;
 	}
       }
@@ -303,13 +320,20 @@ namespace twodimtools {
   bool Poly2D::PointInside(const std::pair<float, float> &point) const
   {
     
+    //a point outside the bounding box is outside the polygon
+    if ( point.first  < _xmin || point.first  > _xmax ||
+	 point.second < _ymin || point.second > _ymax )
+      return false;
+
     //any ray originating at point will cross polygon
     //even number of times if point outside
     //odd number of times if point inside
     int intersections = 0;
-    for (unsigned int i = 0; i < this->Size(); i++) {
-      if ( SegmentOverlap( this->Point(i).first, this->Point(i).second,
-			   this->Point(i + 1).first, this->Point(i + 1).second,
+    const size_t n = this->Size();
+    for (size_t i = 0; i < n; i++) {
+      auto const& A = vertices[i];
+      auto const& B = vertices[(i + 1 < n) ? i + 1 : 0];
+      if ( SegmentOverlap( A.first, A.second, B.first, B.second,
 			   10000.0, 10000.0,
 			   point.first, point.second) )
 	intersections += 1;
@@ -325,10 +349,16 @@ namespace twodimtools {
   bool Poly2D::Contained(const Poly2D &poly2) const
   {
     
+    //poly2 cannot fit if its bounding box does not
+    if ( poly2.Size() &&
+	 ( poly2._xmin < _xmin || poly2._xmax > _xmax ||
+	   poly2._ymin < _ymin || poly2._ymax > _ymax ) )
+      return false;
+
     //loop over poly2 checking wehther
     //points of poly2 all inside poly1
     for (unsigned int i = 0; i < poly2.Size(); i++) {
-      if ( !(this->PointInside( poly2.Point(i)) ) )
+      if ( !(this->PointInside( poly2.vertices[i]) ) )
 	return false;
     }
     
@@ -336,6 +366,27 @@ namespace twodimtools {
     
   }
   
+  //-----------------------------
+  void Poly2D::UpdateBounds()
+  {
+    // an empty polygon gets an empty (inverted) box, which rejects everything
+    _xmin = _ymin =  std::numeric_limits<float>::max();
+    _xmax = _ymax = -std::numeric_limits<float>::max();
+    for (auto const& v : vertices) {
+      _xmin = std::min(_xmin, v.first);
+      _xmax = std::max(_xmax, v.first);
+      _ymin = std::min(_ymin, v.second);
+      _ymax = std::max(_ymax, v.second);
+    }
+  }
+
+  //-----------------------------------------------------------
+  bool Poly2D::BoundsOverlap(const Poly2D &poly2) const
+  {
+    return !( poly2._xmin > _xmax || poly2._xmax < _xmin ||
+	      poly2._ymin > _ymax || poly2._ymax < _ymin );
+  }
+
   //-------------------------------
   void Poly2D::UntanglePolygon()
   {
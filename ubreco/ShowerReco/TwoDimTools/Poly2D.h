@@ -50,7 +50,7 @@ namespace twodimtools {
     /// default destructor
     ~Poly2D(){}
     /// constructor starting from list of edges for polygon
-    Poly2D(const std::vector< std::pair<float,float> > &points) { vertices = points; }
+    Poly2D(const std::vector< std::pair<float,float> > &points) { vertices = points; UpdateBounds(); }
     /// constructor given input list of hits
     Poly2D(const std::vector< art::Ptr<recob::Hit> >& hit_v);
     /// Create Intersection Polygon from 2 polygons
@@ -66,6 +66,9 @@ namespace twodimtools {
     float Area() const;
     /// return polygon perimeter
     float Perimeter() const;
+    /// bounding box of the vertices (inverted, min > max, if the polygon is empty)
+    void Bounds(float& xmin, float& xmax, float& ymin, float& ymax) const
+    { xmin = _xmin; xmax = _xmax; ymin = _ymin; ymax = _ymax; }
     /// boolean: do these polygons overlap?
     bool Overlap(const Poly2D &poly2) const;
     /// boolean: do these polygons overlap?
@@ -77,7 +80,7 @@ namespace twodimtools {
     /// untangle polygon
     void UntanglePolygon();
     /// clear polygon's points
-    void Clear() { vertices.clear(); }
+    void Clear() { vertices.clear(); UpdateBounds(); }
     
     ///Calculate the opening angle at the specified vertex:
     //float InteriorAngle(unsigned int p) const;
@@ -93,6 +96,16 @@ namespace twodimtools {
 
     /// vector listing the polygon edges
     std::vector< std::pair<float,float> > vertices;
+
+    /// bounding box of the vertices, kept in sync with vertices by UpdateBounds.
+    /// Used to reject points and polygons that cannot touch any edge.
+    float _xmin, _xmax, _ymin, _ymax;
+
+    /// recompute the bounding box after vertices change
+    void UpdateBounds();
+
+    /// boolean: could any edge of this polygon cross any edge of poly2?
+    bool BoundsOverlap(const Poly2D &poly2) const;
     
     /// utility function used by PolyOverlap to determine overlap
     bool Overlap(float slope, const Poly2D &poly2, const std::pair<float,float> &origin) const;
@@ -0,0 +1,45 @@
+#ifndef __PMTGEOCACHE_CXX__
+#define __PMTGEOCACHE_CXX__
+
+#include "larcore/Geometry/WireReadout.h"
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+#include "PMTGeoCache.h"
+
+#include <limits>
+
+namespace pmtana {
+
+  PMTGeoCache const& PMTGeoCache::Get() {
+    static const PMTGeoCache cache;
+    return cache;
+  }
+
+  PMTGeoCache::PMTGeoCache() {
+    ::art::ServiceHandle<geo::Geometry> geo;
+    auto const& channelMapAlg = art::ServiceHandle<geo::WireReadout const>()->Get();
+
+    const size_t nopdets = geo->NOpDets();
+    _opdet_y.resize(nopdets);
+    _opdet_z.resize(nopdets);
+    for(size_t opdet=0; opdet<nopdets; ++opdet) {
+      auto const xyz = geo->OpDetGeoFromOpDet(opdet).GetCenter();
+      _opdet_y[opdet] = xyz.Y();
+      _opdet_z[opdet] = xyz.Z();
+    }
+
+    const size_t nopch = channelMapAlg.MaxOpChannel()+1;
+    _opch_y.assign(nopch,std::numeric_limits<double>::quiet_NaN());
+    _opch_z.assign(nopch,std::numeric_limits<double>::quiet_NaN());
+    for(size_t opch=0; opch<nopch; ++opch) {
+      if(!channelMapAlg.IsValidOpChannel(opch)) continue;
+      auto const xyz = channelMapAlg.OpDetGeoFromOpChannel(opch).GetCenter();
+      _opch_y[opch] = xyz.Y();
+      _opch_z[opch] = xyz.Z();
+    }
+  }
+
+}
+#endif
@@ -0,0 +1,107 @@
+#ifndef __PMTGEOCACHE_H__
+#define __PMTGEOCACHE_H__
+
+#include "FlashFinderFMWKInterface.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace pmtana {
+
+  /**
+     PE-weighted position sums of a flash. Contiguous blocks of PMTs are added
+     with Add(); Acc is the accumulation type of the caller (float or double)
+     so that results match the per-PMT loops this replaces.
+  */
+  template <typename Acc>
+  struct FlashShapeSums {
+    Acc totalPE = 0., sumy = 0., sumz = 0., sumy2 = 0., sumz2 = 0.;
+
+    template <typename PE>
+    void Add(PE const* pe, double const* y, double const* z, size_t n)
+    {
+      for(size_t i=0; i<n; ++i) {
+	sumy    += pe[i]*y[i];
+	sumy2   += pe[i]*y[i]*y[i];
+	sumz    += pe[i]*z[i];
+	sumz2   += pe[i]*z[i]*z[i];
+	totalPE += pe[i];
+      }
+    }
+
+    Acc CenterY() const { return sumy/totalPE; }
+    Acc CenterZ() const { return sumz/totalPE; }
+
+    // sqrt(<x^2> - <x>^2), or def when that is not positive
+    Acc WidthY(Acc def) const
+    { return (sumy2*totalPE - sumy*sumy) > 0. ? std::sqrt(sumy2*totalPE - sumy*sumy)/totalPE : def; }
+    Acc WidthZ(Acc def) const
+    { return (sumz2*totalPE - sumz*sumz) > 0. ? std::sqrt(sumz2*totalPE - sumz*sumz)/totalPE : def; }
+  };
+
+  /**
+     PMT centers from the geometry, looked up once per job and kept as plain
+     arrays indexed by optical detector and by optical channel. Channels that
+     are not valid optical channels are stored as NaN.
+  */
+  class PMTGeoCache {
+  public:
+    static PMTGeoCache const& Get();
+
+    size_t NOpDets() const { return _opdet_y.size(); }
+    size_t NOpChannels() const { return _opch_y.size(); }
+
+    double const* OpDetY() const { return _opdet_y.data(); }
+    double const* OpDetZ() const { return _opdet_z.data(); }
+    double const* OpChannelY() const { return _opch_y.data(); }
+    double const* OpChannelZ() const { return _opch_z.data(); }
+
+    // adds channels [first, last) of a per-channel PE vector to sums, with
+    // channels the cache has no position for looked up in the geometry one by one
+    template <typename Acc, typename PE>
+    void AddOpChannels(FlashShapeSums<Acc>& sums, PE const* pe, size_t first, size_t last) const;
+
+  private:
+    PMTGeoCache();
+
+    std::vector<double> _opdet_y, _opdet_z;
+    std::vector<double> _opch_y, _opch_z;
+  };
+
+  /**
+     Shape sums of n_flashes flashes whose PE vectors of n_pmts values are
+     stored back to back in pe, all using the same n_pmts positions. This is
+     one plain Add() per flash: it only saves the per-PMT geometry lookups,
+     and each flash keeps its own PMT summation order.
+  */
+  template <typename Acc, typename PE>
+  void AddFlashes(PE const* pe, size_t n_flashes, size_t n_pmts,
+		  double const* y, double const* z,
+		  FlashShapeSums<Acc>* sums)
+  {
+    for(size_t f=0; f<n_flashes; ++f)
+      sums[f].Add(pe+f*n_pmts, y, z, n_pmts);
+  }
+
+  template <typename Acc, typename PE>
+  void PMTGeoCache::AddOpChannels(FlashShapeSums<Acc>& sums, PE const* pe, size_t first, size_t last) const
+  {
+    size_t opch = first;
+    while(opch<last) {
+      size_t run_end = opch;
+      while(run_end<last && run_end<_opch_y.size() && !std::isnan(_opch_y[run_end])) ++run_end;
+      if(run_end>opch) {
+	sums.Add(pe+opch, &_opch_y[opch], &_opch_z[opch], run_end-opch);
+	opch = run_end;
+	continue;
+      }
+      double xyz[3];
+      OpDetCenterFromOpChannel(opch, xyz);
+      sums.Add(pe+opch, &xyz[1], &xyz[2], 1);
+      ++opch;
+    }
+  }
+
+}
+#endif
@@ -35,6 +35,7 @@
 #include <string>
 #include "FlashFinderManager.h"
 #include "FlashFinderFMWKInterface.h"
+#include "PMTGeoCache.h"
 #include "PECalib.h"
 
 class UBFlashFinder;
@@ -185,38 +186,20 @@ void UBFlashFinder::GetFlashLocation(std::vector<double> pePerOpChannel,
   // Reset variables
   Ycenter = Zcenter = 0.;
   Ywidth  = Zwidth  = -999.;
-  double totalPE = 0.;
-  double sumy = 0., sumz = 0., sumy2 = 0., sumz2 = 0.;
 
-  for (unsigned int opch = 0; opch < pePerOpChannel.size(); opch++) {
+  auto const& pmtGeo = ::pmtana::PMTGeoCache::Get();
+  ::pmtana::FlashShapeSums<double> sums;
 
-    if (opch > 31 && opch < 200){
-      //  std::cout << "Ignoring channel " << opch << " as it's not a real channel" << std::endl;                                                                                             
-      continue;
-    }
-
-    // Get physical detector location for this opChannel
-    double PMTxyz[3];
-    ::pmtana::OpDetCenterFromOpChannel(opch, PMTxyz);
-
-    // Add up the position, weighting with PEs
-    sumy    += pePerOpChannel[opch]*PMTxyz[1];
-    sumy2   += pePerOpChannel[opch]*PMTxyz[1]*PMTxyz[1];
-    sumz    += pePerOpChannel[opch]*PMTxyz[2];
-    sumz2   += pePerOpChannel[opch]*PMTxyz[2]*PMTxyz[2];
+  // channels 0-31 are the PMTs; 32-199 are not real channels and are skipped
+  pmtGeo.AddOpChannels(sums, pePerOpChannel.data(), 0, std::min(pePerOpChannel.size(),(size_t)32));
+  pmtGeo.AddOpChannels(sums, pePerOpChannel.data(), 200, std::max(pePerOpChannel.size(),(size_t)200));
 
-    totalPE += pePerOpChannel[opch];
-  }
-
-  Ycenter = sumy/totalPE;
-  Zcenter = sumz/totalPE;
+  Ycenter = sums.CenterY();
+  Zcenter = sums.CenterZ();
 
   // This is just sqrt(<x^2> - <x>^2)
-  if ( (sumy2*totalPE - sumy*sumy) > 0. ) 
-    Ywidth = std::sqrt(sumy2*totalPE - sumy*sumy)/totalPE;
-  
-  if ( (sumz2*totalPE - sumz*sumz) > 0. ) 
-    Zwidth = std::sqrt(sumz2*totalPE - sumz*sumz)/totalPE;
+  Ywidth = sums.WidthY(Ywidth);
+  Zwidth = sums.WidthZ(Zwidth);
 }
 
 DEFINE_ART_MODULE(UBFlashFinder)
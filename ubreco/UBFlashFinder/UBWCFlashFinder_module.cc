@@ -36,6 +36,7 @@
 #include <memory>
 #include <string>
 #include "FlashFinderFMWKInterface.h" //pmtana
+#include "PMTGeoCache.h"
 //WCOpReco
 #include "Config_Params.h"
 #include "OpWaveform.h"
@@ -528,35 +529,19 @@ void UBWCFlashFinder::GetFlashLocation(std::vector<double> pePerOpChannel,
   // Reset variables
   Ycenter = Zcenter = 0.;
   Ywidth  = Zwidth  = -999.;
-  double totalPE = 0.;
-  double sumy = 0., sumz = 0., sumy2 = 0., sumz2 = 0.;
 
-  for (unsigned int opch = 0; opch < pePerOpChannel.size(); opch++) {
-    if (opch > 31 ){
-      continue;
-    }
+  auto const& pmtGeo = ::pmtana::PMTGeoCache::Get();
+  ::pmtana::FlashShapeSums<double> sums;
 
-    // Get physical detector location for this opChannel
-    double PMTxyz[3];
-    ::pmtana::OpDetCenterFromOpChannel(opch, PMTxyz);
-    // Add up the position, weighting with PEs
-    sumy    += pePerOpChannel[opch]*PMTxyz[1];
-    sumy2   += pePerOpChannel[opch]*PMTxyz[1]*PMTxyz[1];
-    sumz    += pePerOpChannel[opch]*PMTxyz[2];
-    sumz2   += pePerOpChannel[opch]*PMTxyz[2]*PMTxyz[2];
+  // channels 0-31 are the PMTs; later channels are ignored
+  pmtGeo.AddOpChannels(sums, pePerOpChannel.data(), 0, std::min(pePerOpChannel.size(),(size_t)32));
 
-    totalPE += pePerOpChannel[opch];
-  }
-
-  Ycenter = sumy/totalPE;
-  Zcenter = sumz/totalPE;
+  Ycenter = sums.CenterY();
+  Zcenter = sums.CenterZ();
 
   // This is just sqrt(<x^2> - <x>^2)
-  if ( (sumy2*totalPE - sumy*sumy) > 0. ) 
-    Ywidth = std::sqrt(sumy2*totalPE - sumy*sumy)/totalPE;
-  
-  if ( (sumz2*totalPE - sumz*sumz) > 0. ) 
-    Zwidth = std::sqrt(sumz2*totalPE - sumz*sumz)/totalPE;
+  Ywidth = sums.WidthY(Ywidth);
+  Zwidth = sums.WidthZ(Zwidth);
 }
 
 DEFINE_ART_MODULE(UBWCFlashFinder)
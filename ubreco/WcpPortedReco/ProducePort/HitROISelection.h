@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////
+// File:        HitROISelection.h
+//
+// Helpers shared by WCPHybrid and SelectWires to rebuild a wire's ROIs
+// from the tick ranges of the WCP-ported hits on its channel: a flat
+// channel -> hits index, and a selection that copies only the non-zero
+// samples of the wire's own sparse ROIs that fall inside those ranges.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef WCPPORT_HITROISELECTION_H
+#define WCPPORT_HITROISELECTION_H
+
+#include "lardataobj/RecoBase/Wire.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace wcpport {
+
+  typedef std::pair<int,int> TickRange_t; // start, end tick (both included)
+
+  // hit indices of an event grouped by channel, each group in the order of
+  // the hit collection
+  class ChannelHitIndex {
+  public:
+    template <class HitPtrVec>
+    explicit ChannelHitIndex(HitPtrVec const& hits)
+    {
+      size_t n_chan = 0;
+      for(auto const& hit : hits)
+	n_chan = std::max(n_chan,(size_t)hit->Channel()+1);
+
+      fOffset.assign(n_chan+1,0);
+      for(auto const& hit : hits)
+	++fOffset[hit->Channel()+1];
+      for(size_t ch=0; ch<n_chan; ++ch)
+	fOffset[ch+1] += fOffset[ch];
+
+      fHits.resize(hits.size());
+      std::vector<size_t> fill(fOffset.begin(),fOffset.end()-1);
+      for(size_t i_h=0; i_h<hits.size(); ++i_h)
+	fHits[fill[hits[i_h]->Channel()]++] = i_h;
+    }
+
+    size_t NHits(unsigned int channel) const
+    { return channel+1<fOffset.size() ? fOffset[channel+1]-fOffset[channel] : 0; }
+
+    // i-th hit (index into the hit collection) on the channel
+    size_t Hit(unsigned int channel, size_t i) const { return fHits[fOffset[channel]+i]; }
+
+  private:
+    std::vector<size_t> fOffset;
+    std::vector<size_t> fHits;
+  };
+
+  // adds to roi, one range per run, the non-zero samples of wire_roi whose
+  // tick lies in one of the given ranges (clipped to the waveform); ranges
+  // may overlap and come in any order
+  inline void SelectHitROIs(recob::Wire::RegionsOfInterest_t const& wire_roi,
+			    std::vector<TickRange_t> tick_ranges,
+			    recob::Wire::RegionsOfInterest_t& roi)
+  {
+    const int n_ticks = wire_roi.size();
+
+    std::vector<TickRange_t> merged;
+    merged.reserve(tick_ranges.size());
+    for(auto& r : tick_ranges){
+      r.first  = std::max(r.first,0);
+      r.second = std::min(r.second,n_ticks-1);
+    }
+    std::sort(tick_ranges.begin(),tick_ranges.end());
+    for(auto const& r : tick_ranges){
+      if(r.first>r.second) continue;
+      if(!merged.empty() && r.first<=merged.back().second+1)
+	merged.back().second = std::max(merged.back().second,r.second);
+      else
+	merged.push_back(r);
+    }
+
+    auto const& wire_ranges = wire_roi.get_ranges();
+    auto w_it = wire_ranges.begin();
+    for(auto const& m : merged){
+      while(w_it!=wire_ranges.end() && (int)w_it->end_index()<=m.first) ++w_it;
+
+      for(auto it=w_it; it!=wire_ranges.end() && (int)it->begin_index()<=m.second; ++it){
+	const int begin = it->begin_index();
+	const int lo = std::max(m.first,begin);
+	const int hi = std::min(m.second+1,(int)it->end_index());
+	auto const& data = it->data();
+
+	// same zero test as the dense waveform scan (NaN counts as non-zero)
+	int t = lo;
+	while(t<hi){
+	  while(t<hi && data[t-begin]==0.0) ++t;
+	  const int start = t;
+	  while(t<hi && data[t-begin]!=0.0) ++t;
+	  if(t>start)
+	    roi.add_range(start, data.begin()+(start-begin), data.begin()+(t-begin));
+	}
+      }
+    }
+  }
+
+}
+
+#endif
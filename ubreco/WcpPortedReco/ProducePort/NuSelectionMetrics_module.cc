@@ -12,6 +12,7 @@
 #include "ubobj/WcpPort/NuSelectionMatch.h"
 #include "ubobj/WcpPort/NuSelectionTruth.h"
 #include "ubobj/WcpPort/NuSelectionCharge.h"
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
 
 #include "TTree.h"
 #include "TBranch.h"
@@ -42,6 +43,7 @@ private:
   std::string fTreeChargeName;
   bool fMainCluster;
   bool fMC;
+  std::shared_ptr<wcpport::PortedInput> fPort;
 };
 
 nsm::NuSelectionMetrics::NuSelectionMetrics(fhicl::ParameterSet const & p) : EDProducer{p}
@@ -51,6 +53,7 @@ nsm::NuSelectionMetrics::NuSelectionMetrics(fhicl::ParameterSet const & p) : EDP
   fTreeChargeName = p.get<std::string>("TreeChargeName");
   fMainCluster = p.get<bool>("MainCluster");
   fMC = p.get<bool>("MC");
+  fPort = wcpport::PortedInput::Open(fInput);
 
   produces<std::vector<nsm::NuSelectionContainment> >();
   produces<std::vector<nsm::NuSelectionCharge> >();
@@ -67,13 +70,7 @@ void nsm::NuSelectionMetrics::produce(art::Event &e){
   auto outputNsmatchVec = std::make_unique< std::vector<nsm::NuSelectionMatch> >();
   auto outputNstruthVec = std::make_unique< std::vector<nsm::NuSelectionTruth> >();
   
-  std::string path(fInput);
-  std::string file = (path);
-  std::cout<<"INPUT FILE NAME: "<<file<<std::endl;
-  TFile *fin = new TFile(file.c_str());
-  TTree *tin = (TTree*)fin->Get(fTreeEvalName.c_str());
-  
-  int run=-1, subrun=-1, event=-1;
+  TTree *tin = fPort->Tree(fTreeEvalName);
 
   float truth_nuEnergy=-1., truth_energyInside=-1., truth_electronInside=-1.;
   int truth_nuPdg=-1;
@@ -88,9 +85,6 @@ void nsm::NuSelectionMetrics::produce(art::Event &e){
   unsigned int match_type=0;
   bool match_isFC=false, match_isTgm=false, match_notFC_FV=false, match_notFC_SP=false, match_notFC_DC=false;
 
-  tin->SetBranchAddress("run",&run);
-  tin->SetBranchAddress("subrun",&subrun);
-  tin->SetBranchAddress("event",&event);
   tin->SetBranchAddress("flash_found",&flash_found);
   tin->SetBranchAddress("flash_time",&flash_time);
   tin->SetBranchAddress("flash_measPe",&flash_measPe);
@@ -127,60 +121,58 @@ void nsm::NuSelectionMetrics::produce(art::Event &e){
   }
 
   
-  for(int i=0; i<tin->GetEntries(); i++){
-    tin->GetEntry(i);
-    if( run!=(int)e.run() || 
-        subrun!=(int)e.subRun() || 
-	event!=(int)e.id().event() ) continue;
-
-    nsm::NuSelectionContainment nsc;
-    nsc.SetFlashFound( flash_found );
-    nsc.SetFlashTime( flash_time );
-    nsc.SetFlashMeasPe( flash_measPe );
-    nsc.SetFlashPredPe( flash_predPe );
-    nsc.SetMatchFound( match_found );
-    nsc.SetMatchType( match_type );
-    nsc.SetIsFC( match_isFC );
-    nsc.SetIsTGM( match_isTgm );
-    nsc.SetNotFCFV( match_notFC_FV );
-    nsc.SetNotFCSP( match_notFC_SP );
-    nsc.SetNotFCDC( match_notFC_DC );
-    nsc.SetCharge( match_charge );
-    nsc.SetEnergy( match_energy );
-    outputNscontainmentVec->push_back( nsc );
-
-    if(fMC==true){
-      nsm::NuSelectionMatch nsm;
-      nsm.SetCompleteness( match_completeness );
-      nsm.SetCompletenessEnergy( match_completeness_energy );
-      nsm.SetPurity( match_purity );
-      nsm.SetPurityXY( match_purity_xy );
-      nsm.SetPurityXZ( match_purity_xz );
-      outputNsmatchVec->push_back( nsm );
-
-      nsm::NuSelectionTruth nst;
-      nst.SetIsCC( truth_isCC );
-      nst.SetIsEligible( truth_isEligible );
-      nst.SetIsFC( truth_isFC );
-      nst.SetVtxInside( truth_vtxInside );
-      nst.SetNuPdg( truth_nuPdg );
-      nst.SetVtxX( truthVtxX );
-      nst.SetVtxY( truthVtxY );
-      nst.SetVtxZ( truthVtxZ );
-      nst.SetTime( truth_nuTime );
-      nst.SetNuEnergy( truth_nuEnergy );
-      nst.SetEnergyInside( truth_energyInside );
-      nst.SetElectronInside( truth_electronInside );
-      outputNstruthVec->push_back( nst );
+  for(auto const& range : fPort->Entries(fTreeEvalName,e.run(),e.subRun(),e.id().event())){
+    for(Long64_t i=range.first; i<range.second; i++){
+      tin->GetEntry(i);
+
+      nsm::NuSelectionContainment nsc;
+      nsc.SetFlashFound( flash_found );
+      nsc.SetFlashTime( flash_time );
+      nsc.SetFlashMeasPe( flash_measPe );
+      nsc.SetFlashPredPe( flash_predPe );
+      nsc.SetMatchFound( match_found );
+      nsc.SetMatchType( match_type );
+      nsc.SetIsFC( match_isFC );
+      nsc.SetIsTGM( match_isTgm );
+      nsc.SetNotFCFV( match_notFC_FV );
+      nsc.SetNotFCSP( match_notFC_SP );
+      nsc.SetNotFCDC( match_notFC_DC );
+      nsc.SetCharge( match_charge );
+      nsc.SetEnergy( match_energy );
+      outputNscontainmentVec->push_back( nsc );
+
+      if(fMC==true){
+        nsm::NuSelectionMatch nsm;
+        nsm.SetCompleteness( match_completeness );
+        nsm.SetCompletenessEnergy( match_completeness_energy );
+        nsm.SetPurity( match_purity );
+        nsm.SetPurityXY( match_purity_xy );
+        nsm.SetPurityXZ( match_purity_xz );
+        outputNsmatchVec->push_back( nsm );
+
+        nsm::NuSelectionTruth nst;
+        nst.SetIsCC( truth_isCC );
+        nst.SetIsEligible( truth_isEligible );
+        nst.SetIsFC( truth_isFC );
+        nst.SetVtxInside( truth_vtxInside );
+        nst.SetNuPdg( truth_nuPdg );
+        nst.SetVtxX( truthVtxX );
+        nst.SetVtxY( truthVtxY );
+        nst.SetVtxZ( truthVtxZ );
+        nst.SetTime( truth_nuTime );
+        nst.SetNuEnergy( truth_nuEnergy );
+        nst.SetEnergyInside( truth_energyInside );
+        nst.SetElectronInside( truth_electronInside );
+        outputNstruthVec->push_back( nst );
+      }
     }
   }
 
-  TTree *t = (TTree*)fin->Get(fTreeChargeName.c_str());
+  tin->ResetBranchAddresses();
+
+  TTree *t = fPort->Tree(fTreeChargeName);
   int channel, start_tick, main_flag;
   float charge, charge_error;
-  t->SetBranchAddress("run",&run);
-  t->SetBranchAddress("subrun",&subrun);
-  t->SetBranchAddress("event",&event);
   t->SetBranchAddress("channel",&channel);
   t->SetBranchAddress("start_tick",&start_tick);
   t->SetBranchAddress("main_flag",&main_flag);
@@ -188,19 +180,17 @@ void nsm::NuSelectionMetrics::produce(art::Event &e){
   t->SetBranchAddress("charge_error",&charge_error);
 
   float u=0., v=0., y=0.;
-  for(int i=0; i<t->GetEntries(); i++){
-    t->GetEntry(i);
+  for(auto const& range : fPort->Entries(fTreeChargeName,e.run(),e.subRun(),e.id().event())){
+    for(Long64_t i=range.first; i<range.second; i++){
+      t->GetEntry(i);
 
-    if(fMainCluster==true && main_flag!=1) continue;
+      if(fMainCluster==true && main_flag!=1) continue;
 
-    if( run!=(int)e.run() || 
-        subrun!=(int)e.subRun() || 
-	event!=(int)e.id().event() ) continue;
-
-    if(channel<2400){ u += charge; }
-    else if(channel>=2400 && channel<4800){ v += charge; }
-    else{ y += charge; }
+      if(channel<2400){ u += charge; }
+      else if(channel>=2400 && channel<4800){ v += charge; }
+      else{ y += charge; }
 
+    }
   }
 
   NuSelectionCharge nscharge;
@@ -215,8 +205,7 @@ void nsm::NuSelectionMetrics::produce(art::Event &e){
     e.put(std::move(outputNsmatchVec));
     e.put(std::move(outputNstruthVec));
   }
-  fin->Close();
-  delete fin;
+  t->ResetBranchAddresses();
 }
 
 DEFINE_ART_MODULE(nsm::NuSelectionMetrics)
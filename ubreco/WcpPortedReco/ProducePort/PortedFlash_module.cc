@@ -16,6 +16,8 @@
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "larcorealg/Geometry/OpDetGeo.h"
 #include "ubcore/Geometry/UBOpReadoutMap.h"
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
+#include "ubreco/UBFlashFinder/PMTGeoCache.h"
 
 #include "TTree.h"
 #include "TBranch.h"
@@ -44,12 +46,14 @@ private:
 
   std::string fInput;
   std::string fTreeName;
+  std::shared_ptr<wcpport::PortedInput> fPort;
 };
 
 pf::PortedFlash::PortedFlash(fhicl::ParameterSet const & p) : EDProducer{p}
 {
   fInput = p.get<std::string>("PortInput");
   fTreeName = p.get<std::string>("TreeName");
+  fPort = wcpport::PortedInput::Open(fInput);
 
   produces<std::vector<recob::OpFlash> >();
   produces<std::vector<int> >("flashType");
@@ -59,26 +63,27 @@ pf::PortedFlash::PortedFlash(fhicl::ParameterSet const & p) : EDProducer{p}
 
 void pf::PortedFlash::produce(art::Event &e){
 
-  auto const& channelMap = ::art::ServiceHandle<geo::WireReadout const>()->Get();
+  auto const& pmtGeo = pmtana::PMTGeoCache::Get();
+  if(pmtGeo.NOpChannels()<32)
+    throw cet::exception("PortedFlash") << "geometry has fewer than 32 optical channels\n";
+  // the flash sums read channels 0-31 straight from the cache, so a channel
+  // without a position would turn the flash center into NaN
+  for(size_t j=0; j<32; j++){
+    if(std::isnan(pmtGeo.OpChannelY()[j]) || std::isnan(pmtGeo.OpChannelZ()[j]))
+      throw cet::exception("PortedFlash") << "optical channel " << j << " is not a valid channel in this geometry\n";
+  }
 
   auto outputFlashVec = std::make_unique< std::vector<recob::OpFlash> >();
   auto outputIntVec = std::make_unique< std::vector<int> >();
   auto outputDoubleVecA = std::make_unique< std::vector<double> >();
   auto outputDoubleVecB = std::make_unique< std::vector<double> >();
 
-  std::string path(fInput);
-  std::string file = (path);
-  std::cout<<"INPUT FILE NAME: "<<file<<std::endl;
-  TFile *fin = new TFile(file.c_str());
-  TTree *tin = (TTree*)fin->Get(fTreeName.c_str());
+  TTree *tin = fPort->Tree(fTreeName);
   
-  int run=-1, subrun=-1, event=-1, type=-1;
+  int type=-1;
   double totalPE=-1., time=-1., low_time=-1., high_time=-1.;
   std::vector<double> *pe = new std::vector<double>;
   std::vector<double> *pe_err = new std::vector<double>;
-  tin->SetBranchAddress("run",&run);
-  tin->SetBranchAddress("subrun",&subrun);
-  tin->SetBranchAddress("event",&event);
   tin->SetBranchAddress("type",&type);
   tin->SetBranchAddress("totalPE",&totalPE);
   tin->SetBranchAddress("time",&time);
@@ -90,38 +95,30 @@ void pf::PortedFlash::produce(art::Event &e){
   std::cout<<"==========================================="<<std::endl;
   std::cout<<"Run "<<e.run()<<"   Subrun "<< e.subRun()<<"    Event "<<e.id().event()<<std::endl;
 
-  for(int i=0; i<tin->GetEntries(); i++){
-    tin->GetEntry(i);
-    if( run!=(int)e.run() || 
-        subrun!=(int)e.subRun() || 
-	event!=(int)e.id().event() ) continue;
-
-    double Ycenter=0., Zcenter=0., Ywidth=0., Zwidth=0.;
-    double sumy=0., sumz=0., sumy2=0., sumz2=0.;
-    double totalPE=0.;
-
-    std::cout<<pe->size()<<" pe vector size"<<std::endl;
-
-    // may have multiple flashes in beam gate window (pe size > 32)
-    // assuming incidence of 3 flashes in beam gate window is incredibly rare...
-    size_t peSize = pe->size();
-
-    std::vector<double> tempA(32,0.0);
-    for(size_t j=0; j<32; j++){
-      tempA.at(j)=pe->at(j);
-      auto const PMTxyz = channelMap.OpDetGeoFromOpChannel(j).GetCenter();
-      sumy += pe->at(j)*PMTxyz.Y();
-      sumy2 += pe->at(j)*PMTxyz.Y()*PMTxyz.Y();
-      sumz += pe->at(j)*PMTxyz.Z();
-      sumz2 += pe->at(j)*PMTxyz.Z()*PMTxyz.Z();
-      totalPE += pe->at(j);
-    }
-    Ycenter = sumy/totalPE;
-    Zcenter = sumz/totalPE;
-    if( (sumy2*totalPE - sumy*sumy) > 0. ){ Ywidth = std::sqrt(sumy2*totalPE - sumy*sumy) / totalPE; }
-    if( (sumz2*totalPE - sumz*sumz) > 0. ){ Zwidth = std::sqrt(sumz2*totalPE - sumz*sumz) / totalPE; }
+  for(auto const& range : fPort->Entries(fTreeName,e.run(),e.subRun(),e.id().event())){
+    for(Long64_t i=range.first; i<range.second; i++){
+      tin->GetEntry(i);
+
+      std::cout<<pe->size()<<" pe vector size"<<std::endl;
+
+      // may have multiple flashes in beam gate window (pe size > 32)
+      // assuming incidence of 3 flashes in beam gate window is incredibly rare...
+      size_t peSize = pe->size();
+      const size_t nFlashes = peSize>32 ? 2 : 1;
+
+      std::vector<double> tempA(32,0.0), tempB(32,0.0);
+      for(size_t j=0; j<32; j++) tempA.at(j)=pe->at(j);
+      if(nFlashes>1)
+        for(size_t j=32; j<64; j++) tempB.at(j-32)=pe->at(j);
 
-    recob::OpFlash flash(time,
+      // both flashes use the positions of channels 0-31
+      pmtana::FlashShapeSums<double> sums[2];
+      pmtana::AddFlashes(pe->data(), nFlashes, 32, pmtGeo.OpChannelY(), pmtGeo.OpChannelZ(), sums);
+
+      double Ycenter = sums[0].CenterY(), Zcenter = sums[0].CenterZ();
+      double Ywidth = sums[0].WidthY(0.), Zwidth = sums[0].WidthZ(0.);
+
+      recob::OpFlash flash(time,
 			 high_time-low_time,
 			 -1.,
 			 2, 
@@ -134,30 +131,15 @@ void pf::PortedFlash::produce(art::Event &e){
 			 Zcenter,
 			 Zwidth);
 
-    outputFlashVec->emplace_back( flash );
-    outputIntVec->push_back( type );
-    outputDoubleVecA->push_back( low_time );
-    outputDoubleVecB->push_back( high_time );
-
-    if(peSize>32){
-      Ycenter=0.; Zcenter=0.; Ywidth=0.; Zwidth=0.;
-      sumy=0.; sumz=0.; sumy2=0.; sumz2=0.;
-      totalPE=0.;
-      std::vector<double> tempB(32,0.0);
-      for(size_t j=32; j<64; j++){
-	tempB.at(j-32)=pe->at(j);
-        auto const PMTxyz = channelMap.OpDetGeoFromOpChannel(j-32).GetCenter();
-        sumy += pe->at(j)*PMTxyz.Y();
-        sumy2 += pe->at(j)*PMTxyz.Y()*PMTxyz.Y();
-        sumz += pe->at(j)*PMTxyz.Z();
-        sumz2 += pe->at(j)*PMTxyz.Z()*PMTxyz.Z();
-	totalPE += pe->at(j);
-      }
-      Ycenter = sumy/totalPE;
-      Zcenter = sumz/totalPE;
-      if( (sumy2*totalPE - sumy*sumy) > 0. ){ Ywidth = std::sqrt(sumy2*totalPE - sumy*sumy) / totalPE; }
-      if( (sumz2*totalPE - sumz*sumz) > 0. ){ Zwidth = std::sqrt(sumz2*totalPE - sumz*sumz) / totalPE; }
-      recob::OpFlash flash(time,
+      outputFlashVec->emplace_back( flash );
+      outputIntVec->push_back( type );
+      outputDoubleVecA->push_back( low_time );
+      outputDoubleVecB->push_back( high_time );
+
+      if(nFlashes>1){
+        Ycenter = sums[1].CenterY(); Zcenter = sums[1].CenterZ();
+        Ywidth = sums[1].WidthY(0.); Zwidth = sums[1].WidthZ(0.);
+        recob::OpFlash flash(time,
 			   high_time-low_time,
 			   -1.,
 			   2, 
@@ -169,14 +151,17 @@ void pf::PortedFlash::produce(art::Event &e){
 			   Ywidth,
 			   Zcenter,
 			   Zwidth);
-      outputFlashVec->emplace_back( flash );
-      outputIntVec->push_back( type );
-      outputDoubleVecA->push_back( low_time );
-      outputDoubleVecB->push_back( high_time );
+        outputFlashVec->emplace_back( flash );
+        outputIntVec->push_back( type );
+        outputDoubleVecA->push_back( low_time );
+        outputDoubleVecB->push_back( high_time );
+      }
     }
   }
 
-  fin->Close();
+  tin->ResetBranchAddresses();
+  delete pe;
+  delete pe_err;
   std::cout<<" flash vector size: "<<outputFlashVec->size()<<std::endl;
   e.put(std::move(outputFlashVec));
   e.put(std::move(outputIntVec), "flashType");
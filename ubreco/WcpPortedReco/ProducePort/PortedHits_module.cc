@@ -13,6 +13,7 @@
 #include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
 #include "lardata/Utilities/AssociationUtil.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
 
 #include "TTree.h"
 #include "TBranch.h"
@@ -45,6 +46,7 @@ private:
   short fTickOffset;
   float fChargeScaling;
   float fRebin;
+  std::shared_ptr<wcpport::PortedInput> fPort;
 };
 
 ph::PortedHits::PortedHits(fhicl::ParameterSet const & p) : EDProducer{p}
@@ -55,70 +57,58 @@ ph::PortedHits::PortedHits(fhicl::ParameterSet const & p) : EDProducer{p}
   fTickOffset = p.get<short>("TickOffset");
   fChargeScaling = p.get<float>("ChargeScaling");
   fRebin = p.get<float>("Rebin");
+  fPort = wcpport::PortedInput::Open(fInput);
   produces<std::vector<recob::Hit> >();
 }
 
 void ph::PortedHits::produce(art::Event &e){
   std::unique_ptr<std::vector<recob::Hit> >hit_collection(new std::vector<recob::Hit>);
 
-  std::string path(fInput);
-
-  std::string file = (path);
-  std::cout<<"INPUT FILE NAME: "<<file<<std::endl;
-  TFile *fin = new TFile(file.c_str());
-  TTree *tin = (TTree*)fin->Get(fTreeName.c_str());
-  
-  int run, subrun, event;
-  int channel, start_tick, main_flag;
-  float charge, charge_error;
-  tin->SetBranchAddress("run",&run);
-  tin->SetBranchAddress("subrun",&subrun);
-  tin->SetBranchAddress("event",&event);
-  tin->SetBranchAddress("channel",&channel);
-  tin->SetBranchAddress("start_tick",&start_tick);
-  tin->SetBranchAddress("main_flag",&main_flag);
-  tin->SetBranchAddress("charge",&charge);
-  tin->SetBranchAddress("charge_error",&charge_error);
+  // read the columns of this event, then remap all channels at once
+  auto const& entries = fPort->Entries(fTreeName,e.run(),e.subRun(),e.id().event());
+  std::vector<int> channel, start_tick, main_flag;
+  std::vector<float> charge, charge_error;
+  fPort->ReadColumn(fTreeName,"channel",entries,channel);
+  fPort->ReadColumn(fTreeName,"start_tick",entries,start_tick);
+  fPort->ReadColumn(fTreeName,"charge",entries,charge);
+  fPort->ReadColumn(fTreeName,"charge_error",entries,charge_error);
+  if(fMainCluster==true)
+    fPort->ReadColumn(fTreeName,"main_flag",entries,main_flag);
+
+  // WCP channels run 0-2399 (U), 2400-4799 (V), 4800+ (Y)
+  const size_t n_hits = channel.size();
+  std::vector<int> plane(n_hits);
+  for(size_t i=0; i<n_hits; i++){
+    plane[i] = (channel[i]>=2400) + (channel[i]>=4800);
+    channel[i] -= 2400*plane[i];
+  }
 
   //auto const &detClocks = lar::providerFrom<detinfo::DetectorClocksService>();
   auto const& channelMap = art::ServiceHandle<geo::WireReadout const>()->Get();
-  int cryostat_no=0, tpc_no=0, plane_no=0;
-  for(int i=0; i<tin->GetEntries(); i++){
-    tin->GetEntry(i);
-
-    if(fMainCluster==true && main_flag!=1) continue;
-
-    if(run!=(int)e.run() || subrun!=(int)e.subRun() || event!=(int)e.id().event()) continue;
-
-    if(channel<2400){ 
-      plane_no=0; 
-    }
-    else if(channel>=2400 && channel<4800){ 
-      plane_no=1; 
-      channel=channel-2400; 
-    }
-    else{ 
-      plane_no=2; 
-      channel=channel-4800; 
-    }
-    geo::WireID wire(cryostat_no,tpc_no,plane_no,channel);
+  int cryostat_no=0, tpc_no=0;
+  hit_collection->reserve(n_hits);
+  for(size_t i=0; i<n_hits; i++){
+
+    if(fMainCluster==true && main_flag[i]!=1) continue;
+
+    geo::WireID wire(cryostat_no,tpc_no,plane[i],channel[i]);
     raw::ChannelID_t chan = channelMap.PlaneWireToChannel(wire); // removed -1
 
     //raw::TDCtick_t start_tdc = detClocks->TPCTick2TDC(start_tick-fTickOffset);
     //raw::TDCtick_t end_tdc = detClocks->TPCTick2TDC(start_tick+(fRebin-1)-fTickOffset);
 	
     hit_collection->push_back(recob::Hit(chan,
-					 start_tick-fTickOffset,
-					 start_tick+3-fTickOffset,
-					 start_tick+(fRebin/2.)-fTickOffset,
+					 start_tick[i]-fTickOffset,
+					 start_tick[i]+3-fTickOffset,
+					 start_tick[i]+(fRebin/2.)-fTickOffset,
 					 fRebin/2.,
 					 fRebin/2.,
-					 charge*fChargeScaling/fRebin, 
-					 charge_error*fChargeScaling/fRebin,
-					 charge*fChargeScaling,
-					 charge*fChargeScaling,
-					 charge*fChargeScaling,
-					 charge_error*fChargeScaling,
+					 charge[i]*fChargeScaling/fRebin, 
+					 charge_error[i]*fChargeScaling/fRebin,
+					 charge[i]*fChargeScaling,
+					 charge[i]*fChargeScaling,
+					 charge[i]*fChargeScaling,
+					 charge_error[i]*fChargeScaling,
 					 -1, // 1
 					 0,
 					 1,
@@ -127,8 +117,6 @@ void ph::PortedHits::produce(art::Event &e){
                                          channelMap.SignalType(chan),
 					 wire));
   }
-  
-  fin->Close();
 
   std::cout<<" [threshold] hit collection size: "<<hit_collection->size()<<std::endl;
   e.put(std::move(hit_collection));
@@ -0,0 +1,143 @@
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+
+#include <iostream>
+
+std::shared_ptr<wcpport::PortedInput> wcpport::PortedInput::Open(std::string const& path)
+{
+  // weak references, so the file closes once no module holds it anymore
+  static std::mutex registry_mutex;
+  static std::map<std::string, std::weak_ptr<PortedInput>> registry;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto port = registry[path].lock();
+  if(!port){
+    port = std::shared_ptr<PortedInput>(new PortedInput(path));
+    registry[path] = port;
+  }
+  return port;
+}
+
+wcpport::PortedInput::PortedInput(std::string const& path)
+  : fPath(path)
+{
+  // do not leave the port file as the current directory
+  TDirectory::TContext ctx;
+  std::cout<<"INPUT FILE NAME: "<<fPath<<std::endl;
+  fFile.reset(TFile::Open(fPath.c_str(),"READ"));
+  if(!fFile || fFile->IsZombie())
+    throw cet::exception("PortedInput") << "could not open port file " << fPath << "\n";
+}
+
+wcpport::PortedInput::~PortedInput()
+{
+  if(fFile) fFile->Close();
+}
+
+TTree* wcpport::PortedInput::Tree(std::string const& name, bool required)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto it = fTrees.find(name);
+  if(it==fTrees.end()){
+    TTree* tree = nullptr;
+    fFile->GetObject(name.c_str(),tree);
+    it = fTrees.emplace(name,tree).first;
+  }
+  if(!it->second && required)
+    throw cet::exception("PortedInput") << "no tree " << name << " in port file " << fPath << "\n";
+  return it->second;
+}
+
+TBranch* wcpport::PortedInput::Branch(TTree* tree, std::string const& name)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto tree_it = fBranches.find(tree);
+  if(tree_it==fBranches.end()){
+    tree_it = fBranches.emplace(tree,std::unordered_map<std::string, TBranch*>()).first;
+    TObjArray* branches = tree->GetListOfBranches();
+    for(int i_b=0; i_b<branches->GetEntriesFast(); ++i_b){
+      TBranch* branch = static_cast<TBranch*>(branches->UncheckedAt(i_b));
+      tree_it->second.emplace(branch->GetName(),branch);
+    }
+  }
+
+  auto it = tree_it->second.find(name);
+  if(it!=tree_it->second.end()) return it->second;
+
+  // sub-branches and aliases go through the full search, once
+  TBranch* branch = tree->GetBranch(name.c_str());
+  tree_it->second.emplace(name,branch);
+  return branch;
+}
+
+wcpport::EntryRanges_t const&
+wcpport::PortedInput::Entries(std::string const& name, int run, int subrun, int event)
+{
+  static const EntryRanges_t no_entries;
+
+  TTree* tree = Tree(name);
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  auto idx_it = fIndices.find(name);
+  if(idx_it==fIndices.end()){
+    idx_it = fIndices.emplace(name,EventIndex_t()).first;
+    BuildIndex(tree,idx_it->second);
+  }
+
+  auto it = idx_it->second.find(EventKey_t(run,subrun,event));
+  if(it==idx_it->second.end()) return no_entries;
+  return it->second;
+}
+
+Long64_t wcpport::PortedInput::Count(EntryRanges_t const& ranges)
+{
+  Long64_t n=0;
+  for(auto const& r : ranges) n += r.second-r.first;
+  return n;
+}
+
+void wcpport::PortedInput::BuildIndex(TTree* tree, EventIndex_t& index) const
+{
+  int key[3] = {-1,-1,-1};
+  const char* key_names[3] = {"run","subrun","event"};
+  TBranch* key_branches[3] = {nullptr,nullptr,nullptr};
+
+  for(size_t i_k=0; i_k<3; ++i_k){
+    TLeaf* leaf = tree->GetLeaf(key_names[i_k]);
+    if(!leaf || std::string(leaf->GetTypeName())!="Int_t")
+      throw cet::exception("PortedInput") << "tree " << tree->GetName() << " in " << fPath
+					  << " has no int branch " << key_names[i_k] << "\n";
+    key_branches[i_k] = tree->GetBranch(key_names[i_k]);
+    key_branches[i_k]->SetAddress(&key[i_k]);
+  }
+
+  // port trees are written event by event, so an event is normally one
+  // contiguous range; anything else just gets more ranges
+  EntryRanges_t* last_ranges = nullptr;
+  EventKey_t last_key(-1,-1,-1);
+  const Long64_t n_entries = tree->GetEntries();
+  for(Long64_t i=0; i<n_entries; ++i){
+    for(size_t i_k=0; i_k<3; ++i_k)
+      key_branches[i_k]->GetEntry(i,1); // also when disabled by SetBranchStatus
+
+    EventKey_t this_key(key[0],key[1],key[2]);
+    if(!last_ranges || this_key!=last_key){
+      last_ranges = &index[this_key];
+      last_key = this_key;
+    }
+    if(!last_ranges->empty() && last_ranges->back().second==i)
+      ++last_ranges->back().second;
+    else
+      last_ranges->emplace_back(i,i+1);
+  }
+
+  // the modules set their own addresses before reading
+  tree->ResetBranchAddresses();
+
+  std::cout<<"PortedInput: indexed "<<n_entries<<" entries of "<<tree->GetName()
+	   <<" into "<<index.size()<<" events"<<std::endl;
+}
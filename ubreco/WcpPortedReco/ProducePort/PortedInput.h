@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////
+// File:        PortedInput.h
+//
+// Job-wide access to the Wire-Cell port files read by the Ported*
+// producers. Each file is opened once, the first time a module asks for
+// it, and stays open until the last module holding it is destroyed.
+// For every tree that is read, a (run, subrun, event) -> entry ranges
+// index is built on first use from the run/subrun/event branches only,
+// so a module reads just the entries of the current event instead of
+// scanning the whole tree. ReadColumn then pulls single branches over
+// those ranges into contiguous arrays, leaving the other branches unread.
+// Branch lookups by name are also cached per tree, for modules that set
+// hundreds of branch addresses on the same trees; the cache lives as long
+// as the file is held, so it only pays across events for files that stay
+// open, and within one event for the rest.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef WCPPORT_PORTEDINPUT_H
+#define WCPPORT_PORTEDINPUT_H
+
+#include "cetlib_except/exception.h"
+
+#include "RtypesCore.h"
+#include "TBranch.h"
+#include "TClass.h"
+#include "TDataType.h"
+#include "TTree.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class TFile;
+
+namespace wcpport {
+
+  typedef std::tuple<int,int,int> EventKey_t;                 // run, subrun, event
+  typedef std::pair<Long64_t,Long64_t> EntryRange_t;          // [first, last)
+  typedef std::vector<EntryRange_t> EntryRanges_t;
+
+  class PortedInput {
+  public:
+    // shared handle to the port file at path, opening it if no other
+    // module currently holds it; throws if the file cannot be opened
+    static std::shared_ptr<PortedInput> Open(std::string const& path);
+
+    ~PortedInput();
+    PortedInput(PortedInput const&) = delete;
+    PortedInput& operator=(PortedInput const&) = delete;
+
+    std::string const& Path() const { return fPath; }
+    TFile* File() const { return fFile.get(); }
+
+    // the named tree; throws if it is not in the file, unless required is
+    // false, in which case nullptr is returned
+    TTree* Tree(std::string const& name, bool required=true);
+
+    // branch of a tree from this file by name, nullptr if there is none;
+    // the first call for a tree maps all of its top-level branches
+    TBranch* Branch(TTree* tree, std::string const& name);
+
+    // points the named branch of a tree from this file, found with Branch,
+    // at addr; throws if there is no such branch or it does not hold T, which
+    // is a basic type, an array of one, or a pointer to a class
+    template <typename T>
+    void SetBranchAddress(TTree* tree, std::string const& name, T* addr);
+
+    // entries of the named tree that belong to (run, subrun, event), as
+    // ranges in file order; empty if the event is not in the tree
+    EntryRanges_t const& Entries(std::string const& name, int run, int subrun, int event);
+
+    // total number of entries those ranges cover
+    static Long64_t Count(EntryRanges_t const& ranges);
+
+    // one branch of the named tree over the given ranges, in entry order;
+    // the branch must hold a single value of type T per entry
+    template <typename T>
+    void ReadColumn(std::string const& tree_name, std::string const& branch_name,
+		    EntryRanges_t const& ranges, std::vector<T>& column);
+
+  private:
+    explicit PortedInput(std::string const& path);
+
+    typedef std::map<EventKey_t, EntryRanges_t> EventIndex_t;
+
+    void BuildIndex(TTree* tree, EventIndex_t& index) const;
+
+    // same type check as TTree::SetBranchAddress
+    template <typename T>
+    static bool HoldsType(TBranch* branch);
+
+    std::string                         fPath;
+    std::unique_ptr<TFile>              fFile;
+    std::map<std::string, TTree*>       fTrees;
+    std::map<std::string, EventIndex_t> fIndices;
+    std::map<TTree*, std::unordered_map<std::string, TBranch*>> fBranches;
+    std::mutex                          fMutex;
+  };
+
+
+  template <typename T>
+  bool PortedInput::HoldsType(TBranch* branch)
+  {
+    typedef std::remove_all_extents_t<T> element_t;
+    TClass* expected_class = nullptr;
+    EDataType expected_type = kOther_t;
+    if(!branch || branch->GetExpectedType(expected_class,expected_type)!=0) return false;
+    if(std::is_pointer<element_t>::value)
+      return expected_class && expected_class==TClass::GetClass(typeid(std::remove_pointer_t<element_t>));
+    return !expected_class && expected_type==TDataType::GetType(typeid(element_t));
+  }
+
+
+  template <typename T>
+  void PortedInput::SetBranchAddress(TTree* tree, std::string const& name, T* addr)
+  {
+    TBranch* branch = Branch(tree,name);
+    if(!HoldsType<T>(branch))
+      throw cet::exception("PortedInput") << "branch " << name << " of tree " << tree->GetName()
+					  << " in " << fPath << " is missing or not of the requested type\n";
+    branch->SetAddress(addr);
+  }
+
+
+  template <typename T>
+  void PortedInput::ReadColumn(std::string const& tree_name, std::string const& branch_name,
+			       EntryRanges_t const& ranges, std::vector<T>& column)
+  {
+    TTree* tree = Tree(tree_name);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    TBranch* branch = tree->GetBranch(branch_name.c_str());
+    if(!HoldsType<T>(branch))
+      throw cet::exception("PortedInput") << "branch " << branch_name << " of tree " << tree_name
+					  << " in " << fPath << " is missing or not of the requested type\n";
+
+    column.resize(Count(ranges));
+    T value{};
+    branch->SetAddress(&value);
+    size_t i_c = 0;
+    for(auto const& range : ranges)
+      for(Long64_t i=range.first; i<range.second; ++i){
+	branch->GetEntry(i);
+	column[i_c++] = value;
+      }
+    branch->ResetAddress();
+  }
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "lardata/Utilities/AssociationUtil.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
 
 #include "TTree.h"
 #include "TBranch.h"
@@ -41,6 +42,7 @@ private:
   bool fMainCluster;
   std::string fSpacePointLabel;
   short fTickOffset;
+  std::shared_ptr<wcpport::PortedInput> fPort;
 };
 
 psp::PortedSpacePoints::PortedSpacePoints(fhicl::ParameterSet const & p) : EDProducer{p}
@@ -50,6 +52,7 @@ psp::PortedSpacePoints::PortedSpacePoints(fhicl::ParameterSet const & p) : EDPro
   fMainCluster = p.get<bool>("MainCluster");
   fSpacePointLabel = p.get<std::string>("SpacePointLabel");
   fTickOffset = p.get<short>("TickOffset");
+  fPort = wcpport::PortedInput::Open(fInput);
 
   produces<std::vector<recob::SpacePoint> >();
 }
@@ -58,51 +61,29 @@ void psp::PortedSpacePoints::produce(art::Event &e){
 
   auto outputSpacePointVec = std::make_unique< std::vector<recob::SpacePoint> >();
 
-  std::string path(fInput);
-  std::string file = (path);
-  std::cout<<"INPUT FILE NAME: "<<file<<std::endl;
-  TFile *fin = new TFile(file.c_str());
-  TTree *tin = (TTree*)fin->Get(fTreeName.c_str());
- 
-  int run=-1, subrun=-1, event=-1, /*cluster_id=-1,*/ main_flag=-1, time_slice=-1, ch_u=-1, ch_v=-1, ch_w=-1;
-  double x=-1., y=-1., z=-1., q=-1., nq=-1;
-  tin->SetBranchAddress("run",&run);
-  tin->SetBranchAddress("subrun",&subrun);
-  tin->SetBranchAddress("event",&event);
-  //tin->SetBranchAddress("cluster_id",&cluster_id);
-  tin->SetBranchAddress("main_flag",&main_flag);
-  tin->SetBranchAddress("time_slice",&time_slice);
-  tin->SetBranchAddress("ch_u",&ch_u);
-  tin->SetBranchAddress("ch_v",&ch_v);
-  tin->SetBranchAddress("ch_w",&ch_w);
-  tin->SetBranchAddress("x",&x);
-  tin->SetBranchAddress("y",&y);
-  tin->SetBranchAddress("z",&z);
-  tin->SetBranchAddress("q",&q);
-  tin->SetBranchAddress("nq",&nq);
-
-  for(int i=0; i<tin->GetEntries(); i++){
-    tin->GetEntry(i);
-
-    if(fMainCluster==true && main_flag!=1) continue;
-
-    if( run!=(int)e.run() || 
-        subrun!=(int)e.subRun() || 
-	event!=(int)e.id().event() ) continue;
-
-    int id = -1;
-    double xyz[3] = {0., 0., 0.};
-    double xyz_err[6] = {0., 0., 0., 0., 0., 0.};
-    double chisq = 0.;
-
-    xyz[0]=x; // x alignment not confirmed
-    xyz[1]=y;
-    xyz[2]=z;
-    recob::SpacePoint sp(xyz, xyz_err, chisq, id);
-    outputSpacePointVec->emplace_back(sp);
+  // only the columns that go into the output are read
+  auto const& entries = fPort->Entries(fTreeName,e.run(),e.subRun(),e.id().event());
+  std::vector<double> x, y, z;
+  std::vector<int> main_flag;
+  fPort->ReadColumn(fTreeName,"x",entries,x);
+  fPort->ReadColumn(fTreeName,"y",entries,y);
+  fPort->ReadColumn(fTreeName,"z",entries,z);
+  if(fMainCluster==true)
+    fPort->ReadColumn(fTreeName,"main_flag",entries,main_flag);
+
+  int id = -1;
+  double xyz_err[6] = {0., 0., 0., 0., 0., 0.};
+  double chisq = 0.;
+
+  outputSpacePointVec->reserve(x.size());
+  for(size_t i=0; i<x.size(); i++){
+
+    if(fMainCluster==true && main_flag[i]!=1) continue;
+
+    double xyz[3] = {x[i], y[i], z[i]}; // x alignment not confirmed
+    outputSpacePointVec->emplace_back(xyz, xyz_err, chisq, id);
   }
 
-  fin->Close();
   std::cout<<" space point vector size: "<<outputSpacePointVec->size()<<std::endl;
   e.put(std::move(outputSpacePointVec));
 }
@@ -17,6 +17,7 @@
 #include "lardata/Utilities/AssociationUtil.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "ubreco/WcpPortedReco/ProducePort/HitROISelection.h"
 
 #include <memory>
 
@@ -83,54 +84,30 @@ void SelectWires::produce(art::Event& e)
   lar_pandora::WireVector wire_vec;
   art::fill_ptr_vector(wire_vec, wire_handle);
 
-  std::map<int,std::vector<std::pair<int,int> > > hit_map;
-  std::pair<int,int> hit_roi;
-
-  for(size_t i_h=0; i_h<hit_vec.size(); ++i_h)
-    {
-      art::Ptr<recob::Hit> hit = hit_vec.at(i_h);
-      hit_roi = std::make_pair( (int)hit->StartTick(), (int)hit->EndTick() );
-      hit_map[ (int)hit->Channel() ].emplace_back( hit_roi );
-    }
+  // (WCP-ported) hits of each channel
+  wcpport::ChannelHitIndex chan_hits(hit_vec);
+  std::vector<wcpport::TickRange_t> hit_ranges;
 
   for(size_t i_w=0; i_w<wire_vec.size(); ++i_w)
     {
       art::Ptr<recob::Wire> wire = wire_vec.at(i_w);
       auto wire_channel = wire->Channel();
-      std::vector<float> wf = wire->Signal();
-      recob::Wire::RegionsOfInterest_t roi( (int)wf.size() );
-      bool found = false;
+      auto const& wire_roi = wire->SignalROI();
+      const int wf_size = wire_roi.size();
+      recob::Wire::RegionsOfInterest_t roi( wf_size );
 
-      for(auto const& m : hit_map)
-	{
-	  if( m.first != (int)wire_channel) continue;
-	  found = true;
+      const size_t n_hits = chan_hits.NHits(wire_channel);
+      bool found = (n_hits>0);
 
-	  for(auto & e : m.second)
+      if(found)
+	{
+	  hit_ranges.clear();
+	  for(size_t i=0; i<n_hits; ++i)
 	    {
-	      std::vector<float> wf_temp(wf.size(), 0.);
-	      for(int a=e.first; a<=e.second; a++)
-		{
-		  wf_temp[a] = wf[a];
-		}
-	      
-	      auto first = wf_temp.begin();
-	      auto done = wf_temp.end();
-	      auto beg = first;
-	      while(true)
-		{
-		  beg = std::find_if(beg, done, [](float v){ return v!=0.0; } );
-		  if(beg==done)
-		    {
-		      break;
-		    }
-		  auto end = std::find_if(beg, done, [](float v){ return v==0.0;} );
-		  
-		  std::vector<float> c(beg, end);
-		  roi.add_range(beg-first, c.begin(), c.end());
-		  beg=end;
-		}
+	      auto const& hit = hit_vec[chan_hits.Hit(wire_channel,i)];
+	      hit_ranges.emplace_back( (int)hit->StartTick(), (int)hit->EndTick() );
 	    }
+	  wcpport::SelectHitROIs(wire_roi, hit_ranges, roi);
 	}
 
       if(found==true)
@@ -138,8 +115,8 @@ void SelectWires::produce(art::Event& e)
           outputWireVec->emplace_back(recob::Wire(roi,wire_channel,channelMap.View(wire_channel)));
 
 	  raw::RawDigit::ADCvector_t outadc;
-	  outadc.resize((int)wf.size(), 1);
-	  outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,(int)wf.size(),outadc,raw::kNone));
+	  outadc.resize(wf_size, 1);
+	  outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,wf_size,outadc,raw::kNone));
 	  const size_t outind = outputWireVec->size();
 	  auto const rawptr = rawPtr(outind-1);
 	  auto const sigptr = wirePtr(outind-1);
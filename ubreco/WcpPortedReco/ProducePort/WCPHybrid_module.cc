@@ -17,6 +17,7 @@
 #include "lardata/Utilities/AssociationUtil.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "ubreco/WcpPortedReco/ProducePort/HitROISelection.h"
 
 #include "TF1.h"
 #include "TH1.h"
@@ -93,70 +94,41 @@ void WCPHybrid::produce(art::Event& e)
   lar_pandora::WireVector wire_vec;
   art::fill_ptr_vector(wire_vec, wire_handle);
 
-  std::map<int,std::vector<std::pair<int,int> > > hit_map;
-  std::pair<int,int> hit_roi;
-
-  for(size_t i_h=0; i_h<hit_vec.size(); ++i_h)
-    {
-      art::Ptr<recob::Hit> hit = hit_vec.at(i_h);
-      hit_roi = std::make_pair( (int)hit->StartTick(), (int)hit->EndTick() );
-      hit_map[ (int)hit->Channel() ].emplace_back( hit_roi );
-    }
+  // (WCP-ported) hits of each channel
+  wcpport::ChannelHitIndex chan_hits(hit_vec);
+  std::vector<wcpport::TickRange_t> hit_ranges;
 
   for(size_t i_w=0; i_w<wire_vec.size(); ++i_w) // loop over all 8256 wires
     {
       art::Ptr<recob::Wire> wire = wire_vec.at(i_w);
       auto wire_channel = wire->Channel();
-      std::vector<float> wf = wire->Signal();
-      recob::Wire::RegionsOfInterest_t roi( (int)wf.size() );
-      //recob::Wire::RegionsOfInterest_t unbinnedROI( (int)wf.size() );
+      auto const& wire_roi = wire->SignalROI();
+      const int wf_size = wire_roi.size();
+      recob::Wire::RegionsOfInterest_t roi( wf_size );
+      //recob::Wire::RegionsOfInterest_t unbinnedROI( wf_size );
 
-      bool found = false;
+      const size_t n_hits = chan_hits.NHits(wire_channel);
+      bool found = (n_hits>0);
       bool dead = false;
 
-      for(auto const& m : hit_map) // loop over (WCP-ported) hit channel-tick pairs
+      if(found)
 	{
-	  if( m.first != (int)wire_channel) {
-	    continue;
-	  }
-	  found=true;
-
 	  double totalsignal=0;
-	  for(int i=0; i<(int)wf.size(); i++){
-	    totalsignal+=wf.at(i);
-	  }
+	  for(auto const& range : wire_roi.get_ranges())
+	    for(float v : range.data())
+	      totalsignal+=v;
 
 	  if(totalsignal==0.0){
 	    dead=true;
 	  }
 
-	  for(auto & e : m.second) // loop over pairs of ticks of for a given <hit channel-time tick> pair
+	  hit_ranges.clear();
+	  for(size_t i=0; i<n_hits; ++i) // pairs of ticks of the hits on this channel
 	    {
-	      std::vector<float> wf_temp(wf.size(), 0.);
-	      for(int a=e.first; a<=e.second; a++) // e.first = start tick, e.second = end tick
-		{
-		  if(a<0 || a>(int)wf.size()-1) continue;
-		  wf_temp[a] = wf[a];
-		}
-
-	      auto first = wf_temp.begin();
-	      auto done = wf_temp.end();
-	      auto beg = first;
-
-	      while(true)
-		{
-		  beg = std::find_if(beg, done, [](float v){ return v!=0.0; } ); // find the first "non-zero" element's iterator 
-		  if(beg==done) // if there's no element that satisfies the condition "element non-zero", then quit
-		    {
-		      break;
-		    }
-		  auto end = std::find_if(beg, done, [](float v){ return v==0.0;} ); // find the first "zero" element "after" beg iterator found above
-		  
-		  std::vector<float> c(beg, end);
-		  roi.add_range(beg-first, c.begin(), c.end()); //(offset:where to add the elements, first, last)
-		  beg=end;
-		}
+	      auto const& hit = hit_vec[chan_hits.Hit(wire_channel,i)];
+	      hit_ranges.emplace_back( (int)hit->StartTick(), (int)hit->EndTick() );
 	    }
+	  wcpport::SelectHitROIs(wire_roi, hit_ranges, roi);
 	}
 
       if(found==true && dead==false) // live channels
@@ -164,8 +136,8 @@ void WCPHybrid::produce(art::Event& e)
             outputWireVec->emplace_back(recob::Wire(roi,wire_channel,channelMap.View(wire_channel)));
 	    
 	    raw::RawDigit::ADCvector_t outadc;
-	    outadc.resize((int)wf.size(), 1);
-	    outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,(int)wf.size(),outadc,raw::kNone));
+	    outadc.resize(wf_size, 1);
+	    outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,wf_size,outadc,raw::kNone));
 	    const size_t outind = outputWireVec->size();
 	    auto const rawptr = rawPtr(outind-1);
 	    auto const sigptr = wirePtr(outind-1);
@@ -175,24 +147,22 @@ void WCPHybrid::produce(art::Event& e)
 	{
 	  if(fChargeSupplement){
 
-	    for(size_t i_h=0; i_h<hit_vec.size(); ++i_h)
+	    for(size_t i_h=0; i_h<n_hits; ++i_h)
 	      {
-		art::Ptr<recob::Hit> hit = hit_vec.at(i_h);
-		if((int)hit->Channel()==(int)wire_channel){
-		  for(int i=(int)hit->StartTick(); i<(int)hit->EndTick()+1; ++i){
-		    roi.set_at(i, hit->PeakAmplitude());
-		  }
+		art::Ptr<recob::Hit> const& hit = hit_vec[chan_hits.Hit(wire_channel,i_h)];
+		for(int i=(int)hit->StartTick(); i<(int)hit->EndTick()+1; ++i){
+		  roi.set_at(i, hit->PeakAmplitude());
 		}
 	      }
 	  }
 	  if(fUnbin==true) // unbinned WCP hit
-            outputWireVec->emplace_back(recob::Wire(unbinROI(roi,(int)wf.size()),wire_channel,channelMap.View(wire_channel)));
+            outputWireVec->emplace_back(recob::Wire(unbinROI(roi,wf_size),wire_channel,channelMap.View(wire_channel)));
 	  else if(fUnbin==false) // raw WCP hit
             outputWireVec->emplace_back(recob::Wire(roi,wire_channel,channelMap.View(wire_channel)));
 
 	  raw::RawDigit::ADCvector_t outadc;
-	  outadc.resize((int)wf.size(), 1);
-	  outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,(int)wf.size(),outadc,raw::kNone));
+	  outadc.resize(wf_size, 1);
+	  outputRawdigitVec->emplace_back(raw::RawDigit(wire_channel,wf_size,outadc,raw::kNone));
 	  const size_t outind = outputWireVec->size();
 	  auto const rawptr = rawPtr(outind-1);
 	  auto const sigptr = wirePtr(outind-1);
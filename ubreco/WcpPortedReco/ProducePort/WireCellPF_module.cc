@@ -19,6 +19,7 @@
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "ubobj/WcpPort/NuSelectionBDT.h"
 #include "ubobj/WcpPort/NuSelectionKINE.h"
+#include "ubreco/WcpPortedReco/ProducePort/PortedInput.h"
 
 #include <memory>
 #include <string>
@@ -70,6 +71,28 @@ private:
   bool f_PFport;
   bool f_BDTport;
   bool f_KINEport;
+
+  std::string fInput_file;   // merged multi-event input; per-event files if empty
+  std::shared_ptr<wcpport::PortedInput> fMergedInput; // kept open for the whole job
+
+  // the merged input, opened on first use, or this event's own file, which
+  // is released after produce(); a per-event file is never read again, so
+  // keeping it open would not save anything
+  std::shared_ptr<wcpport::PortedInput> GetInput(std::string const& path);
+
+  // entries of a tree belonging to this event: the whole tree for a
+  // per-event file, the indexed entries for a merged one
+  wcpport::EntryRanges_t EventEntries(wcpport::PortedInput& port, std::string const& tree_name, TTree* tree, art::Event const& e) const;
+  // first of those entries, -1 if there is none
+  Long64_t EventEntry(wcpport::PortedInput& port, std::string const& tree_name, TTree* tree, art::Event const& e) const;
+
+  // sets a branch address through the file's cached branch map; throws if
+  // the branch is missing or does not hold T
+  template <typename T>
+  void SetBranchAddress(wcpport::PortedInput& port, TTree* tree, std::string const& name, T* addr)
+  {
+    port.SetBranchAddress(tree,name,addr);
+  }
 };
 
 
@@ -86,6 +109,7 @@ nsm::WireCellPF::WireCellPF(fhicl::ParameterSet const& p)
   , f_PFport	  (p.get<bool>("PFport", true))
   , f_BDTport	  (p.get<bool>("BDTport", true))
   , f_KINEport	  (p.get<bool>("KINEport", true))
+  , fInput_file   (p.get<std::string>("PFInput_file", ""))
 {
   // Call appropriate produces<>() functions here.
   // Call appropriate consumes<>() for any products to be retrieved by this module.
@@ -102,18 +126,27 @@ void nsm::WireCellPF::produce(art::Event& e)
 {
   // Implementation of required member function here.
   bool badinput = false;
-  TFile* fin = nullptr;
-  std::string event_runinfo = std::to_string((int)e.run())+"_"+std::to_string((int)e.subRun())+"_"+std::to_string((int)e.event());
-  fInput = fInput_prefix+"_"+event_runinfo+".root";
-  mf::LogInfo("WireCellPF") <<"INPUT FILE NAME: "<< fInput <<"\n";
-  std::ifstream fcheck(fInput.c_str());
-  if(!fcheck.good()) {
-	mf::LogInfo("WireCellPF") <<"INPUT FILE NOT FOUND!"<<std::endl;
-	badinput = true;
+  std::shared_ptr<wcpport::PortedInput> port;
+  if(!fInput_file.empty()){
+	fInput = fInput_file;
   }
   else{
-	fin = new TFile(fInput.c_str());
-	if(fin->IsZombie()){
+	std::string event_runinfo = std::to_string((int)e.run())+"_"+std::to_string((int)e.subRun())+"_"+std::to_string((int)e.event());
+	fInput = fInput_prefix+"_"+event_runinfo+".root";
+  }
+  mf::LogInfo("WireCellPF") <<"INPUT FILE NAME: "<< fInput <<"\n";
+  if(fInput_file.empty()){
+	std::ifstream fcheck(fInput.c_str());
+	if(!fcheck.good()) {
+	  mf::LogInfo("WireCellPF") <<"INPUT FILE NOT FOUND!"<<std::endl;
+	  badinput = true;
+	}
+  }
+  if(!badinput){
+	try{
+	  port = GetInput(fInput);
+	}
+	catch(cet::exception const&){
 	  mf::LogError("WireCellPF") <<"INPUT FILE CANNOT OPEN: "<< fInput <<"\n";
 	  badinput = true;
 	}
@@ -133,19 +166,24 @@ if(f_PFport){
   // 5th bit: long muon
   // 6th bit: nue CC
   Int_t neutrino_type = 0;
-  TTree *tree2 = (TTree*)fin->Get(fInput_tree2.c_str());
+  TTree *tree2 = port->Tree(fInput_tree2,false);
   if(tree2) {
   tree2->SetBranchStatus("*", 0);
   tree2->SetBranchStatus("neutrino_type", 1);
-  tree2->SetBranchAddress("neutrino_type",&neutrino_type);
-    for(int i=0; i<tree2->GetEntries(); i++){
+  SetBranchAddress(*port,tree2,"neutrino_type",&neutrino_type);
+    bool found = false;
+    for(auto const& range : EventEntries(*port,fInput_tree2,tree2,e)){
+      for(Long64_t i=range.first; i<range.second && !found; i++){
 	tree2->GetEntry(i);
-	if(neutrino_type>1) break; // this should be the in-beam flash match
+	found = (neutrino_type>1); // this should be the in-beam flash match
+      }
     }
+    tree2->ResetBranchAddresses();
   }
 
-  TTree *tree = (TTree*)fin->Get(fInput_tree.c_str());
-  if(tree) {
+  TTree *tree = port->Tree(fInput_tree,false);
+  Long64_t entry = tree ? EventEntry(*port,fInput_tree,tree,e) : -1;
+  if(entry>=0) {
   /// Wire-Cell Particle Flow
   int mc_Ntrack;  // number of tracks in MC
   int mc_id[MAX_TRACKS];  // track id; size == mc_Ntrack
@@ -160,19 +198,20 @@ if(f_PFport){
   std::vector<std::vector<int> > *mc_daughters = new std::vector<std::vector<int>>;  // daughters id of this track; vector
   //std::cout<<"Check point 0.1: "<<std::endl;
 
-  tree->SetBranchAddress("mc_Ntrack"       , &mc_Ntrack);
-  tree->SetBranchAddress("mc_id"           , &mc_id);
-  tree->SetBranchAddress("mc_pdg"          , &mc_pdg);
-  tree->SetBranchAddress("mc_process"      , &mc_process);
-  tree->SetBranchAddress("mc_mother"       , &mc_mother);
-  tree->SetBranchAddress("mc_included"     , &mc_included);
-  tree->SetBranchAddress("mc_daughters"    , &mc_daughters);
-  tree->SetBranchAddress("mc_startXYZT"    , &mc_startXYZT);     // unit: cm
-  tree->SetBranchAddress("mc_endXYZT"      , &mc_endXYZT);       // unit: cm
-  tree->SetBranchAddress("mc_startMomentum", &mc_startMomentum); // unit: GeV
-  tree->SetBranchAddress("mc_endMomentum"  , &mc_endMomentum);   // unit: GeV
+  SetBranchAddress(*port,tree,"mc_Ntrack"       , &mc_Ntrack);
+  SetBranchAddress(*port,tree,"mc_id"           , &mc_id);
+  SetBranchAddress(*port,tree,"mc_pdg"          , &mc_pdg);
+  SetBranchAddress(*port,tree,"mc_process"      , &mc_process);
+  SetBranchAddress(*port,tree,"mc_mother"       , &mc_mother);
+  SetBranchAddress(*port,tree,"mc_included"     , &mc_included);
+  SetBranchAddress(*port,tree,"mc_daughters"    , &mc_daughters);
+  SetBranchAddress(*port,tree,"mc_startXYZT"    , &mc_startXYZT);     // unit: cm
+  SetBranchAddress(*port,tree,"mc_endXYZT"      , &mc_endXYZT);       // unit: cm
+  SetBranchAddress(*port,tree,"mc_startMomentum", &mc_startMomentum); // unit: GeV
+  SetBranchAddress(*port,tree,"mc_endMomentum"  , &mc_endMomentum);   // unit: GeV
   //std::cout<<"Check point 0.2: "<<std::endl;
-  tree->GetEntry(0); // one file one event (entry)
+  tree->GetEntry(entry); // one file one event (entry)
+  tree->ResetBranchAddresses();
   //std::cout<<"Check point 0.3: "<<std::endl;
 
   for(int i=0; i<mc_Ntrack; i++){
@@ -203,7 +242,7 @@ if(f_PFport){
 
   }
   else {
-    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree <<" not found in file " << fInput <<"\n";
+    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree <<" not found (or has no entry for this event) in file " << fInput <<"\n";
   }
 
   e.put(std::move(outputPF));
@@ -219,8 +258,9 @@ if(f_BDTport){
   else{
   nsm::NuSelectionBDT nsmbdt;
 
-  TTree *tree3 = (TTree*)fin->Get(fInput_tree3.c_str());
-  if(tree3){
+  TTree *tree3 = port->Tree(fInput_tree3,false);
+  Long64_t entry3 = tree3 ? EventEntry(*port,fInput_tree3,tree3,e) : -1;
+  if(entry3>=0){
 
   /// define variables and set branch address
 
@@ -249,30 +289,30 @@ if(f_BDTport){
   std::vector<int> *shw_sp_br4_showers = new std::vector<int>;
   float shw_sp_shw_vtx_dis;
   float shw_sp_max_shw_dis;
-  tree3->SetBranchAddress("shw_sp_num_mip_tracks",&shw_sp_num_mip_tracks);
-  tree3->SetBranchAddress("shw_sp_num_muons",&shw_sp_num_muons);
-  tree3->SetBranchAddress("shw_sp_num_pions",&shw_sp_num_pions);
-  tree3->SetBranchAddress("shw_sp_num_protons",&shw_sp_num_protons);
-  tree3->SetBranchAddress("shw_sp_proton_length_1",&shw_sp_proton_length_1);
-  tree3->SetBranchAddress("shw_sp_proton_dqdx_1",&shw_sp_proton_dqdx_1);
-  tree3->SetBranchAddress("shw_sp_proton_energy_1",&shw_sp_proton_energy_1);
-  tree3->SetBranchAddress("shw_sp_proton_length_2",&shw_sp_proton_length_2);
-  tree3->SetBranchAddress("shw_sp_proton_dqdx_2",&shw_sp_proton_dqdx_2);
-  tree3->SetBranchAddress("shw_sp_proton_energy_2",&shw_sp_proton_energy_2);
-  tree3->SetBranchAddress("shw_sp_n_good_showers",&shw_sp_n_good_showers);
-  tree3->SetBranchAddress("shw_sp_n_20mev_showers",&shw_sp_n_20mev_showers);
-  tree3->SetBranchAddress("shw_sp_n_br1_showers",&shw_sp_n_br1_showers);
-  tree3->SetBranchAddress("shw_sp_n_br2_showers",&shw_sp_n_br2_showers);
-  tree3->SetBranchAddress("shw_sp_n_br3_showers",&shw_sp_n_br3_showers);
-  tree3->SetBranchAddress("shw_sp_n_br4_showers",&shw_sp_n_br4_showers);
-  tree3->SetBranchAddress("shw_sp_n_20br1_showers",&shw_sp_n_20br1_showers);
-  tree3->SetBranchAddress("shw_sp_20mev_showers",&shw_sp_20mev_showers);
-  tree3->SetBranchAddress("shw_sp_br1_showers",&shw_sp_br1_showers);
-  tree3->SetBranchAddress("shw_sp_br2_showers",&shw_sp_br2_showers);
-  tree3->SetBranchAddress("shw_sp_br3_showers",&shw_sp_br3_showers);
-  tree3->SetBranchAddress("shw_sp_br4_showers",&shw_sp_br4_showers);
-  tree3->SetBranchAddress("shw_sp_shw_vtx_dis",&shw_sp_shw_vtx_dis);
-  tree3->SetBranchAddress("shw_sp_max_shw_dis",&shw_sp_max_shw_dis);
+  SetBranchAddress(*port,tree3,"shw_sp_num_mip_tracks",&shw_sp_num_mip_tracks);
+  SetBranchAddress(*port,tree3,"shw_sp_num_muons",&shw_sp_num_muons);
+  SetBranchAddress(*port,tree3,"shw_sp_num_pions",&shw_sp_num_pions);
+  SetBranchAddress(*port,tree3,"shw_sp_num_protons",&shw_sp_num_protons);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_length_1",&shw_sp_proton_length_1);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_dqdx_1",&shw_sp_proton_dqdx_1);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_energy_1",&shw_sp_proton_energy_1);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_length_2",&shw_sp_proton_length_2);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_dqdx_2",&shw_sp_proton_dqdx_2);
+  SetBranchAddress(*port,tree3,"shw_sp_proton_energy_2",&shw_sp_proton_energy_2);
+  SetBranchAddress(*port,tree3,"shw_sp_n_good_showers",&shw_sp_n_good_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_20mev_showers",&shw_sp_n_20mev_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_br1_showers",&shw_sp_n_br1_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_br2_showers",&shw_sp_n_br2_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_br3_showers",&shw_sp_n_br3_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_br4_showers",&shw_sp_n_br4_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_n_20br1_showers",&shw_sp_n_20br1_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_20mev_showers",&shw_sp_20mev_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_showers",&shw_sp_br1_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_showers",&shw_sp_br2_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_showers",&shw_sp_br3_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_showers",&shw_sp_br4_showers);
+  SetBranchAddress(*port,tree3,"shw_sp_shw_vtx_dis",&shw_sp_shw_vtx_dis);
+  SetBranchAddress(*port,tree3,"shw_sp_max_shw_dis",&shw_sp_max_shw_dis);
 
   float shw_sp_filled;
   float shw_sp_flag;
@@ -301,33 +341,33 @@ if(f_BDTport){
   float shw_sp_n_stem_size;
   float shw_sp_flag_stem_trajectory;
   float shw_sp_min_dis;
-  tree3->SetBranchAddress("shw_sp_filled",&shw_sp_filled);
-  tree3->SetBranchAddress("shw_sp_flag",&shw_sp_flag);
-  tree3->SetBranchAddress("shw_sp_energy",&shw_sp_energy);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_0",&shw_sp_vec_dQ_dx_0);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_1",&shw_sp_vec_dQ_dx_1);
-  tree3->SetBranchAddress("shw_sp_max_dQ_dx_sample",&shw_sp_max_dQ_dx_sample);
-  tree3->SetBranchAddress("shw_sp_n_below_threshold",&shw_sp_n_below_threshold);
-  tree3->SetBranchAddress("shw_sp_n_below_zero",&shw_sp_n_below_zero);
-  tree3->SetBranchAddress("shw_sp_n_lowest",&shw_sp_n_lowest);
-  tree3->SetBranchAddress("shw_sp_n_highest",&shw_sp_n_highest);
-  tree3->SetBranchAddress("shw_sp_lowest_dQ_dx",&shw_sp_lowest_dQ_dx);
-  tree3->SetBranchAddress("shw_sp_highest_dQ_dx",&shw_sp_highest_dQ_dx);
-  tree3->SetBranchAddress("shw_sp_medium_dQ_dx",&shw_sp_medium_dQ_dx);
-  tree3->SetBranchAddress("shw_sp_stem_length",&shw_sp_stem_length);
-  tree3->SetBranchAddress("shw_sp_length_main",&shw_sp_length_main);
-  tree3->SetBranchAddress("shw_sp_length_total",&shw_sp_length_total);
-  tree3->SetBranchAddress("shw_sp_angle_beam",&shw_sp_angle_beam);
-  tree3->SetBranchAddress("shw_sp_iso_angle",&shw_sp_iso_angle);
-  tree3->SetBranchAddress("shw_sp_n_vertex",&shw_sp_n_vertex);
-  tree3->SetBranchAddress("shw_sp_n_good_tracks",&shw_sp_n_good_tracks);
-  tree3->SetBranchAddress("shw_sp_E_indirect_max_energy",&shw_sp_E_indirect_max_energy);
-  tree3->SetBranchAddress("shw_sp_flag_all_above",&shw_sp_flag_all_above);
-  tree3->SetBranchAddress("shw_sp_min_dQ_dx_5",&shw_sp_min_dQ_dx_5);
-  tree3->SetBranchAddress("shw_sp_n_other_vertex",&shw_sp_n_other_vertex);
-  tree3->SetBranchAddress("shw_sp_n_stem_size",&shw_sp_n_stem_size);
-  tree3->SetBranchAddress("shw_sp_flag_stem_trajectory",&shw_sp_flag_stem_trajectory);
-  tree3->SetBranchAddress("shw_sp_min_dis",&shw_sp_min_dis);
+  SetBranchAddress(*port,tree3,"shw_sp_filled",&shw_sp_filled);
+  SetBranchAddress(*port,tree3,"shw_sp_flag",&shw_sp_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_energy",&shw_sp_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_0",&shw_sp_vec_dQ_dx_0);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_1",&shw_sp_vec_dQ_dx_1);
+  SetBranchAddress(*port,tree3,"shw_sp_max_dQ_dx_sample",&shw_sp_max_dQ_dx_sample);
+  SetBranchAddress(*port,tree3,"shw_sp_n_below_threshold",&shw_sp_n_below_threshold);
+  SetBranchAddress(*port,tree3,"shw_sp_n_below_zero",&shw_sp_n_below_zero);
+  SetBranchAddress(*port,tree3,"shw_sp_n_lowest",&shw_sp_n_lowest);
+  SetBranchAddress(*port,tree3,"shw_sp_n_highest",&shw_sp_n_highest);
+  SetBranchAddress(*port,tree3,"shw_sp_lowest_dQ_dx",&shw_sp_lowest_dQ_dx);
+  SetBranchAddress(*port,tree3,"shw_sp_highest_dQ_dx",&shw_sp_highest_dQ_dx);
+  SetBranchAddress(*port,tree3,"shw_sp_medium_dQ_dx",&shw_sp_medium_dQ_dx);
+  SetBranchAddress(*port,tree3,"shw_sp_stem_length",&shw_sp_stem_length);
+  SetBranchAddress(*port,tree3,"shw_sp_length_main",&shw_sp_length_main);
+  SetBranchAddress(*port,tree3,"shw_sp_length_total",&shw_sp_length_total);
+  SetBranchAddress(*port,tree3,"shw_sp_angle_beam",&shw_sp_angle_beam);
+  SetBranchAddress(*port,tree3,"shw_sp_iso_angle",&shw_sp_iso_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_n_vertex",&shw_sp_n_vertex);
+  SetBranchAddress(*port,tree3,"shw_sp_n_good_tracks",&shw_sp_n_good_tracks);
+  SetBranchAddress(*port,tree3,"shw_sp_E_indirect_max_energy",&shw_sp_E_indirect_max_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_flag_all_above",&shw_sp_flag_all_above);
+  SetBranchAddress(*port,tree3,"shw_sp_min_dQ_dx_5",&shw_sp_min_dQ_dx_5);
+  SetBranchAddress(*port,tree3,"shw_sp_n_other_vertex",&shw_sp_n_other_vertex);
+  SetBranchAddress(*port,tree3,"shw_sp_n_stem_size",&shw_sp_n_stem_size);
+  SetBranchAddress(*port,tree3,"shw_sp_flag_stem_trajectory",&shw_sp_flag_stem_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_min_dis",&shw_sp_min_dis);
 
   float shw_sp_vec_median_dedx;
   float shw_sp_vec_mean_dedx;
@@ -349,26 +389,26 @@ if(f_BDTport){
   float shw_sp_vec_dQ_dx_17;
   float shw_sp_vec_dQ_dx_18;
   float shw_sp_vec_dQ_dx_19;
-  tree3->SetBranchAddress("shw_sp_vec_median_dedx",&shw_sp_vec_median_dedx);
-  tree3->SetBranchAddress("shw_sp_vec_mean_dedx",&shw_sp_vec_mean_dedx);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_2",&shw_sp_vec_dQ_dx_2);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_3",&shw_sp_vec_dQ_dx_3);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_4",&shw_sp_vec_dQ_dx_4);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_5",&shw_sp_vec_dQ_dx_5);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_6",&shw_sp_vec_dQ_dx_6);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_7",&shw_sp_vec_dQ_dx_7);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_8",&shw_sp_vec_dQ_dx_8);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_9",&shw_sp_vec_dQ_dx_9);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_10",&shw_sp_vec_dQ_dx_10);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_11",&shw_sp_vec_dQ_dx_11);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_12",&shw_sp_vec_dQ_dx_12);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_13",&shw_sp_vec_dQ_dx_13);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_14",&shw_sp_vec_dQ_dx_14);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_15",&shw_sp_vec_dQ_dx_15);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_16",&shw_sp_vec_dQ_dx_16);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_17",&shw_sp_vec_dQ_dx_17);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_18",&shw_sp_vec_dQ_dx_18);
-  tree3->SetBranchAddress("shw_sp_vec_dQ_dx_19",&shw_sp_vec_dQ_dx_19);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_median_dedx",&shw_sp_vec_median_dedx);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_mean_dedx",&shw_sp_vec_mean_dedx);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_2",&shw_sp_vec_dQ_dx_2);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_3",&shw_sp_vec_dQ_dx_3);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_4",&shw_sp_vec_dQ_dx_4);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_5",&shw_sp_vec_dQ_dx_5);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_6",&shw_sp_vec_dQ_dx_6);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_7",&shw_sp_vec_dQ_dx_7);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_8",&shw_sp_vec_dQ_dx_8);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_9",&shw_sp_vec_dQ_dx_9);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_10",&shw_sp_vec_dQ_dx_10);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_11",&shw_sp_vec_dQ_dx_11);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_12",&shw_sp_vec_dQ_dx_12);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_13",&shw_sp_vec_dQ_dx_13);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_14",&shw_sp_vec_dQ_dx_14);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_15",&shw_sp_vec_dQ_dx_15);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_16",&shw_sp_vec_dQ_dx_16);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_17",&shw_sp_vec_dQ_dx_17);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_18",&shw_sp_vec_dQ_dx_18);
+  SetBranchAddress(*port,tree3,"shw_sp_vec_dQ_dx_19",&shw_sp_vec_dQ_dx_19);
 
   float shw_sp_pio_filled;
   float shw_sp_pio_flag;
@@ -385,21 +425,21 @@ if(f_BDTport){
   std::vector<float> *shw_sp_pio_2_v_dis2 = new std::vector<float>;
   std::vector<float> *shw_sp_pio_2_v_angle2 = new std::vector<float>;
   std::vector<float> *shw_sp_pio_2_v_acc_length = new std::vector<float>;
-  tree3->SetBranchAddress("shw_sp_pio_filled",&shw_sp_pio_filled);
-  tree3->SetBranchAddress("shw_sp_pio_flag",&shw_sp_pio_flag);
-  tree3->SetBranchAddress("shw_sp_pio_mip_id",&shw_sp_pio_mip_id);
-  tree3->SetBranchAddress("shw_sp_pio_flag_pio",&shw_sp_pio_flag_pio);
-  tree3->SetBranchAddress("shw_sp_pio_1_flag",&shw_sp_pio_1_flag);
-  tree3->SetBranchAddress("shw_sp_pio_1_mass",&shw_sp_pio_1_mass);
-  tree3->SetBranchAddress("shw_sp_pio_1_pio_type",&shw_sp_pio_1_pio_type);
-  tree3->SetBranchAddress("shw_sp_pio_1_energy_1",&shw_sp_pio_1_energy_1);
-  tree3->SetBranchAddress("shw_sp_pio_1_energy_2",&shw_sp_pio_1_energy_2);
-  tree3->SetBranchAddress("shw_sp_pio_1_dis_1",&shw_sp_pio_1_dis_1);
-  tree3->SetBranchAddress("shw_sp_pio_1_dis_2",&shw_sp_pio_1_dis_2);
-  tree3->SetBranchAddress("shw_sp_pio_2_v_flag",&shw_sp_pio_2_v_flag);
-  tree3->SetBranchAddress("shw_sp_pio_2_v_dis2",&shw_sp_pio_2_v_dis2);
-  tree3->SetBranchAddress("shw_sp_pio_2_v_angle2",&shw_sp_pio_2_v_angle2);
-  tree3->SetBranchAddress("shw_sp_pio_2_v_acc_length",&shw_sp_pio_2_v_acc_length);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_filled",&shw_sp_pio_filled);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_flag",&shw_sp_pio_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_mip_id",&shw_sp_pio_mip_id);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_flag_pio",&shw_sp_pio_flag_pio);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_flag",&shw_sp_pio_1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_mass",&shw_sp_pio_1_mass);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_pio_type",&shw_sp_pio_1_pio_type);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_energy_1",&shw_sp_pio_1_energy_1);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_energy_2",&shw_sp_pio_1_energy_2);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_dis_1",&shw_sp_pio_1_dis_1);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_1_dis_2",&shw_sp_pio_1_dis_2);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_2_v_flag",&shw_sp_pio_2_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_2_v_dis2",&shw_sp_pio_2_v_dis2);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_2_v_angle2",&shw_sp_pio_2_v_angle2);
+  SetBranchAddress(*port,tree3,"shw_sp_pio_2_v_acc_length",&shw_sp_pio_2_v_acc_length);
 
   float shw_sp_lem_flag;
   float shw_sp_lem_shower_total_length;
@@ -409,14 +449,14 @@ if(f_BDTport){
   float shw_sp_lem_e_dQdx;
   float shw_sp_lem_shower_num_segs;
   float shw_sp_lem_shower_num_main_segs;
-  tree3->SetBranchAddress("shw_sp_lem_flag",&shw_sp_lem_flag);
-  tree3->SetBranchAddress("shw_sp_lem_shower_total_length",&shw_sp_lem_shower_total_length);
-  tree3->SetBranchAddress("shw_sp_lem_shower_main_length",&shw_sp_lem_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_lem_n_3seg",&shw_sp_lem_n_3seg);
-  tree3->SetBranchAddress("shw_sp_lem_e_charge",&shw_sp_lem_e_charge);
-  tree3->SetBranchAddress("shw_sp_lem_e_dQdx",&shw_sp_lem_e_dQdx);
-  tree3->SetBranchAddress("shw_sp_lem_shower_num_segs",&shw_sp_lem_shower_num_segs);
-  tree3->SetBranchAddress("shw_sp_lem_shower_num_main_segs",&shw_sp_lem_shower_num_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_flag",&shw_sp_lem_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_shower_total_length",&shw_sp_lem_shower_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_shower_main_length",&shw_sp_lem_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_n_3seg",&shw_sp_lem_n_3seg);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_e_charge",&shw_sp_lem_e_charge);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_e_dQdx",&shw_sp_lem_e_dQdx);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_shower_num_segs",&shw_sp_lem_shower_num_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_lem_shower_num_main_segs",&shw_sp_lem_shower_num_main_segs);
 
   float shw_sp_br_filled;
   float shw_sp_br1_flag;
@@ -446,34 +486,34 @@ if(f_BDTport){
   float shw_sp_br1_3_flag_sg_trajectory;
   float shw_sp_br1_3_n_shower_main_segs;
   float shw_sp_br1_3_sg_length;
-  tree3->SetBranchAddress("shw_sp_br_filled",&shw_sp_br_filled);
-  tree3->SetBranchAddress("shw_sp_br1_flag",&shw_sp_br1_flag);
-  tree3->SetBranchAddress("shw_sp_br1_1_flag",&shw_sp_br1_1_flag);
-  tree3->SetBranchAddress("shw_sp_br1_1_shower_type",&shw_sp_br1_1_shower_type);
-  tree3->SetBranchAddress("shw_sp_br1_1_vtx_n_segs",&shw_sp_br1_1_vtx_n_segs);
-  tree3->SetBranchAddress("shw_sp_br1_1_energy",&shw_sp_br1_1_energy);
-  tree3->SetBranchAddress("shw_sp_br1_1_n_segs",&shw_sp_br1_1_n_segs);
-  tree3->SetBranchAddress("shw_sp_br1_1_flag_sg_topology",&shw_sp_br1_1_flag_sg_topology);
-  tree3->SetBranchAddress("shw_sp_br1_1_flag_sg_trajectory",&shw_sp_br1_1_flag_sg_trajectory);
-  tree3->SetBranchAddress("shw_sp_br1_1_sg_length",&shw_sp_br1_1_sg_length);
-  tree3->SetBranchAddress("shw_sp_br1_2_flag",&shw_sp_br1_2_flag);
-  tree3->SetBranchAddress("shw_sp_br1_2_energy",&shw_sp_br1_2_energy);
-  tree3->SetBranchAddress("shw_sp_br1_2_n_connected",&shw_sp_br1_2_n_connected);
-  tree3->SetBranchAddress("shw_sp_br1_2_max_length",&shw_sp_br1_2_max_length);
-  tree3->SetBranchAddress("shw_sp_br1_2_n_connected_1",&shw_sp_br1_2_n_connected_1);
-  tree3->SetBranchAddress("shw_sp_br1_2_vtx_n_segs",&shw_sp_br1_2_vtx_n_segs);
-  tree3->SetBranchAddress("shw_sp_br1_2_n_shower_segs",&shw_sp_br1_2_n_shower_segs);
-  tree3->SetBranchAddress("shw_sp_br1_2_max_length_ratio",&shw_sp_br1_2_max_length_ratio);
-  tree3->SetBranchAddress("shw_sp_br1_2_shower_length",&shw_sp_br1_2_shower_length);
-  tree3->SetBranchAddress("shw_sp_br1_3_flag",&shw_sp_br1_3_flag);
-  tree3->SetBranchAddress("shw_sp_br1_3_energy",&shw_sp_br1_3_energy);
-  tree3->SetBranchAddress("shw_sp_br1_3_n_connected_p",&shw_sp_br1_3_n_connected_p);
-  tree3->SetBranchAddress("shw_sp_br1_3_max_length_p",&shw_sp_br1_3_max_length_p);
-  tree3->SetBranchAddress("shw_sp_br1_3_n_shower_segs",&shw_sp_br1_3_n_shower_segs);
-  tree3->SetBranchAddress("shw_sp_br1_3_flag_sg_topology",&shw_sp_br1_3_flag_sg_topology);
-  tree3->SetBranchAddress("shw_sp_br1_3_flag_sg_trajectory",&shw_sp_br1_3_flag_sg_trajectory);
-  tree3->SetBranchAddress("shw_sp_br1_3_n_shower_main_segs",&shw_sp_br1_3_n_shower_main_segs);
-  tree3->SetBranchAddress("shw_sp_br1_3_sg_length",&shw_sp_br1_3_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br_filled",&shw_sp_br_filled);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_flag",&shw_sp_br1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_flag",&shw_sp_br1_1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_shower_type",&shw_sp_br1_1_shower_type);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_vtx_n_segs",&shw_sp_br1_1_vtx_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_energy",&shw_sp_br1_1_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_n_segs",&shw_sp_br1_1_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_flag_sg_topology",&shw_sp_br1_1_flag_sg_topology);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_flag_sg_trajectory",&shw_sp_br1_1_flag_sg_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_1_sg_length",&shw_sp_br1_1_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_flag",&shw_sp_br1_2_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_energy",&shw_sp_br1_2_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_n_connected",&shw_sp_br1_2_n_connected);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_max_length",&shw_sp_br1_2_max_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_n_connected_1",&shw_sp_br1_2_n_connected_1);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_vtx_n_segs",&shw_sp_br1_2_vtx_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_n_shower_segs",&shw_sp_br1_2_n_shower_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_max_length_ratio",&shw_sp_br1_2_max_length_ratio);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_2_shower_length",&shw_sp_br1_2_shower_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_flag",&shw_sp_br1_3_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_energy",&shw_sp_br1_3_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_n_connected_p",&shw_sp_br1_3_n_connected_p);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_max_length_p",&shw_sp_br1_3_max_length_p);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_n_shower_segs",&shw_sp_br1_3_n_shower_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_flag_sg_topology",&shw_sp_br1_3_flag_sg_topology);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_flag_sg_trajectory",&shw_sp_br1_3_flag_sg_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_n_shower_main_segs",&shw_sp_br1_3_n_shower_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br1_3_sg_length",&shw_sp_br1_3_sg_length);
 
 
   float shw_sp_br2_flag;
@@ -488,18 +528,18 @@ if(f_BDTport){
   float shw_sp_br2_max_angle;
   float shw_sp_br2_sg_length;
   float shw_sp_br2_flag_sg_trajectory;
-  tree3->SetBranchAddress("shw_sp_br2_flag",&shw_sp_br2_flag);
-  tree3->SetBranchAddress("shw_sp_br2_flag_single_shower",&shw_sp_br2_flag_single_shower);
-  tree3->SetBranchAddress("shw_sp_br2_num_valid_tracks",&shw_sp_br2_num_valid_tracks);
-  tree3->SetBranchAddress("shw_sp_br2_energy",&shw_sp_br2_energy);
-  tree3->SetBranchAddress("shw_sp_br2_angle1",&shw_sp_br2_angle1);
-  tree3->SetBranchAddress("shw_sp_br2_angle2",&shw_sp_br2_angle2);
-  tree3->SetBranchAddress("shw_sp_br2_angle",&shw_sp_br2_angle);
-  tree3->SetBranchAddress("shw_sp_br2_angle3",&shw_sp_br2_angle3);
-  tree3->SetBranchAddress("shw_sp_br2_n_shower_main_segs",&shw_sp_br2_n_shower_main_segs);
-  tree3->SetBranchAddress("shw_sp_br2_max_angle",&shw_sp_br2_max_angle);
-  tree3->SetBranchAddress("shw_sp_br2_sg_length",&shw_sp_br2_sg_length);
-  tree3->SetBranchAddress("shw_sp_br2_flag_sg_trajectory",&shw_sp_br2_flag_sg_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_flag",&shw_sp_br2_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_flag_single_shower",&shw_sp_br2_flag_single_shower);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_num_valid_tracks",&shw_sp_br2_num_valid_tracks);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_energy",&shw_sp_br2_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_angle1",&shw_sp_br2_angle1);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_angle2",&shw_sp_br2_angle2);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_angle",&shw_sp_br2_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_angle3",&shw_sp_br2_angle3);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_n_shower_main_segs",&shw_sp_br2_n_shower_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_max_angle",&shw_sp_br2_max_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_sg_length",&shw_sp_br2_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br2_flag_sg_trajectory",&shw_sp_br2_flag_sg_trajectory);
 
 
   float shw_sp_br3_flag;
@@ -560,64 +600,64 @@ if(f_BDTport){
   float shw_sp_br3_8_n_main_segs;
   float shw_sp_br3_8_shower_main_length;
   float shw_sp_br3_8_shower_length;
-  tree3->SetBranchAddress("shw_sp_br3_flag",&shw_sp_br3_flag);
-  tree3->SetBranchAddress("shw_sp_br3_1_flag",&shw_sp_br3_1_flag);
-  tree3->SetBranchAddress("shw_sp_br3_1_energy",&shw_sp_br3_1_energy);
-  tree3->SetBranchAddress("shw_sp_br3_1_n_shower_segments",&shw_sp_br3_1_n_shower_segments);
-  tree3->SetBranchAddress("shw_sp_br3_1_sg_flag_trajectory",&shw_sp_br3_1_sg_flag_trajectory);
-  tree3->SetBranchAddress("shw_sp_br3_1_sg_direct_length",&shw_sp_br3_1_sg_direct_length);
-  tree3->SetBranchAddress("shw_sp_br3_1_sg_length",&shw_sp_br3_1_sg_length);
-  tree3->SetBranchAddress("shw_sp_br3_1_total_main_length",&shw_sp_br3_1_total_main_length);
-  tree3->SetBranchAddress("shw_sp_br3_1_total_length",&shw_sp_br3_1_total_length);
-  tree3->SetBranchAddress("shw_sp_br3_1_iso_angle",&shw_sp_br3_1_iso_angle);
-  tree3->SetBranchAddress("shw_sp_br3_1_sg_flag_topology",&shw_sp_br3_1_sg_flag_topology);
-  tree3->SetBranchAddress("shw_sp_br3_2_flag",&shw_sp_br3_2_flag);
-  tree3->SetBranchAddress("shw_sp_br3_2_n_ele",&shw_sp_br3_2_n_ele);
-  tree3->SetBranchAddress("shw_sp_br3_2_n_other",&shw_sp_br3_2_n_other);
-  tree3->SetBranchAddress("shw_sp_br3_2_energy",&shw_sp_br3_2_energy);
-  tree3->SetBranchAddress("shw_sp_br3_2_total_main_length",&shw_sp_br3_2_total_main_length);
-  tree3->SetBranchAddress("shw_sp_br3_2_total_length",&shw_sp_br3_2_total_length);
-  tree3->SetBranchAddress("shw_sp_br3_2_other_fid",&shw_sp_br3_2_other_fid);
-  tree3->SetBranchAddress("shw_sp_br3_3_v_flag",&shw_sp_br3_3_v_flag);
-  tree3->SetBranchAddress("shw_sp_br3_3_v_energy",&shw_sp_br3_3_v_energy);
-  tree3->SetBranchAddress("shw_sp_br3_3_v_angle",&shw_sp_br3_3_v_angle);
-  tree3->SetBranchAddress("shw_sp_br3_3_v_dir_length",&shw_sp_br3_3_v_dir_length);
-  tree3->SetBranchAddress("shw_sp_br3_3_v_length",&shw_sp_br3_3_v_length);
-  tree3->SetBranchAddress("shw_sp_br3_4_flag", &shw_sp_br3_4_flag);
-  tree3->SetBranchAddress("shw_sp_br3_4_acc_length", &shw_sp_br3_4_acc_length);
-  tree3->SetBranchAddress("shw_sp_br3_4_total_length", &shw_sp_br3_4_total_length);
-  tree3->SetBranchAddress("shw_sp_br3_4_energy", &shw_sp_br3_4_energy);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_flag", &shw_sp_br3_5_v_flag);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_dir_length", &shw_sp_br3_5_v_dir_length);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_total_length", &shw_sp_br3_5_v_total_length);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_flag_avoid_muon_check", &shw_sp_br3_5_v_flag_avoid_muon_check);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_n_seg", &shw_sp_br3_5_v_n_seg);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_angle", &shw_sp_br3_5_v_angle);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_sg_length", &shw_sp_br3_5_v_sg_length);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_energy", &shw_sp_br3_5_v_energy);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_n_main_segs", &shw_sp_br3_5_v_n_main_segs);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_n_segs", &shw_sp_br3_5_v_n_segs);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_shower_main_length", &shw_sp_br3_5_v_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_br3_5_v_shower_total_length", &shw_sp_br3_5_v_shower_total_length);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_flag",&shw_sp_br3_6_v_flag);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_angle",&shw_sp_br3_6_v_angle);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_angle1",&shw_sp_br3_6_v_angle1);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_flag_shower_trajectory",&shw_sp_br3_6_v_flag_shower_trajectory);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_direct_length",&shw_sp_br3_6_v_direct_length);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_length",&shw_sp_br3_6_v_length);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_n_other_vtx_segs",&shw_sp_br3_6_v_n_other_vtx_segs);
-  tree3->SetBranchAddress("shw_sp_br3_6_v_energy",&shw_sp_br3_6_v_energy);
-  tree3->SetBranchAddress("shw_sp_br3_7_flag",&shw_sp_br3_7_flag);
-  tree3->SetBranchAddress("shw_sp_br3_7_energy",&shw_sp_br3_7_energy);
-  tree3->SetBranchAddress("shw_sp_br3_7_min_angle",&shw_sp_br3_7_min_angle);
-  tree3->SetBranchAddress("shw_sp_br3_7_sg_length",&shw_sp_br3_7_sg_length);
-  tree3->SetBranchAddress("shw_sp_br3_7_main_length",&shw_sp_br3_7_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_br3_8_flag",&shw_sp_br3_8_flag);
-  tree3->SetBranchAddress("shw_sp_br3_8_max_dQ_dx",&shw_sp_br3_8_max_dQ_dx);
-  tree3->SetBranchAddress("shw_sp_br3_8_energy",&shw_sp_br3_8_energy);
-  tree3->SetBranchAddress("shw_sp_br3_8_n_main_segs",&shw_sp_br3_8_n_main_segs);
-  tree3->SetBranchAddress("shw_sp_br3_8_shower_main_length",&shw_sp_br3_8_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_br3_8_shower_length",&shw_sp_br3_8_shower_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_flag",&shw_sp_br3_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_flag",&shw_sp_br3_1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_energy",&shw_sp_br3_1_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_n_shower_segments",&shw_sp_br3_1_n_shower_segments);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_sg_flag_trajectory",&shw_sp_br3_1_sg_flag_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_sg_direct_length",&shw_sp_br3_1_sg_direct_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_sg_length",&shw_sp_br3_1_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_total_main_length",&shw_sp_br3_1_total_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_total_length",&shw_sp_br3_1_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_iso_angle",&shw_sp_br3_1_iso_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_1_sg_flag_topology",&shw_sp_br3_1_sg_flag_topology);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_flag",&shw_sp_br3_2_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_n_ele",&shw_sp_br3_2_n_ele);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_n_other",&shw_sp_br3_2_n_other);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_energy",&shw_sp_br3_2_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_total_main_length",&shw_sp_br3_2_total_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_total_length",&shw_sp_br3_2_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_2_other_fid",&shw_sp_br3_2_other_fid);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_3_v_flag",&shw_sp_br3_3_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_3_v_energy",&shw_sp_br3_3_v_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_3_v_angle",&shw_sp_br3_3_v_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_3_v_dir_length",&shw_sp_br3_3_v_dir_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_3_v_length",&shw_sp_br3_3_v_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_4_flag", &shw_sp_br3_4_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_4_acc_length", &shw_sp_br3_4_acc_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_4_total_length", &shw_sp_br3_4_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_4_energy", &shw_sp_br3_4_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_flag", &shw_sp_br3_5_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_dir_length", &shw_sp_br3_5_v_dir_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_total_length", &shw_sp_br3_5_v_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_flag_avoid_muon_check", &shw_sp_br3_5_v_flag_avoid_muon_check);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_n_seg", &shw_sp_br3_5_v_n_seg);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_angle", &shw_sp_br3_5_v_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_sg_length", &shw_sp_br3_5_v_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_energy", &shw_sp_br3_5_v_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_n_main_segs", &shw_sp_br3_5_v_n_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_n_segs", &shw_sp_br3_5_v_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_shower_main_length", &shw_sp_br3_5_v_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_5_v_shower_total_length", &shw_sp_br3_5_v_shower_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_flag",&shw_sp_br3_6_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_angle",&shw_sp_br3_6_v_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_angle1",&shw_sp_br3_6_v_angle1);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_flag_shower_trajectory",&shw_sp_br3_6_v_flag_shower_trajectory);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_direct_length",&shw_sp_br3_6_v_direct_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_length",&shw_sp_br3_6_v_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_n_other_vtx_segs",&shw_sp_br3_6_v_n_other_vtx_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_6_v_energy",&shw_sp_br3_6_v_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_7_flag",&shw_sp_br3_7_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_7_energy",&shw_sp_br3_7_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_7_min_angle",&shw_sp_br3_7_min_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_7_sg_length",&shw_sp_br3_7_sg_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_7_main_length",&shw_sp_br3_7_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_flag",&shw_sp_br3_8_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_max_dQ_dx",&shw_sp_br3_8_max_dQ_dx);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_energy",&shw_sp_br3_8_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_n_main_segs",&shw_sp_br3_8_n_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_shower_main_length",&shw_sp_br3_8_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br3_8_shower_length",&shw_sp_br3_8_shower_length);
 
 
   float shw_sp_br4_flag;
@@ -642,28 +682,28 @@ if(f_BDTport){
   float shw_sp_br4_2_iso_angle;
   float shw_sp_br4_2_iso_angle1;
   float shw_sp_br4_2_angle;
-  tree3->SetBranchAddress("shw_sp_br4_flag", &shw_sp_br4_flag);
-  tree3->SetBranchAddress("shw_sp_br4_1_flag", &shw_sp_br4_1_flag);
-  tree3->SetBranchAddress("shw_sp_br4_1_shower_main_length", &shw_sp_br4_1_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_br4_1_shower_total_length", &shw_sp_br4_1_shower_total_length);
-  tree3->SetBranchAddress("shw_sp_br4_1_min_dis", &shw_sp_br4_1_min_dis);
-  tree3->SetBranchAddress("shw_sp_br4_1_energy", &shw_sp_br4_1_energy);
-  tree3->SetBranchAddress("shw_sp_br4_1_flag_avoid_muon_check", &shw_sp_br4_1_flag_avoid_muon_check);
-  tree3->SetBranchAddress("shw_sp_br4_1_n_vtx_segs", &shw_sp_br4_1_n_vtx_segs);
-  tree3->SetBranchAddress("shw_sp_br4_1_n_main_segs", &shw_sp_br4_1_n_main_segs);
-  tree3->SetBranchAddress("shw_sp_br4_2_flag", &shw_sp_br4_2_flag);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio_45", &shw_sp_br4_2_ratio_45);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio_35", &shw_sp_br4_2_ratio_35);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio_25", &shw_sp_br4_2_ratio_25);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio_15", &shw_sp_br4_2_ratio_15);
-  tree3->SetBranchAddress("shw_sp_br4_2_energy",   &shw_sp_br4_2_energy);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio1_45", &shw_sp_br4_2_ratio1_45);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio1_35", &shw_sp_br4_2_ratio1_35);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio1_25", &shw_sp_br4_2_ratio1_25);
-  tree3->SetBranchAddress("shw_sp_br4_2_ratio1_15", &shw_sp_br4_2_ratio1_15);
-  tree3->SetBranchAddress("shw_sp_br4_2_iso_angle", &shw_sp_br4_2_iso_angle);
-  tree3->SetBranchAddress("shw_sp_br4_2_iso_angle1", &shw_sp_br4_2_iso_angle1);
-  tree3->SetBranchAddress("shw_sp_br4_2_angle", &shw_sp_br4_2_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_flag", &shw_sp_br4_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_flag", &shw_sp_br4_1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_shower_main_length", &shw_sp_br4_1_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_shower_total_length", &shw_sp_br4_1_shower_total_length);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_min_dis", &shw_sp_br4_1_min_dis);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_energy", &shw_sp_br4_1_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_flag_avoid_muon_check", &shw_sp_br4_1_flag_avoid_muon_check);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_n_vtx_segs", &shw_sp_br4_1_n_vtx_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_1_n_main_segs", &shw_sp_br4_1_n_main_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_flag", &shw_sp_br4_2_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio_45", &shw_sp_br4_2_ratio_45);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio_35", &shw_sp_br4_2_ratio_35);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio_25", &shw_sp_br4_2_ratio_25);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio_15", &shw_sp_br4_2_ratio_15);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_energy",   &shw_sp_br4_2_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio1_45", &shw_sp_br4_2_ratio1_45);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio1_35", &shw_sp_br4_2_ratio1_35);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio1_25", &shw_sp_br4_2_ratio1_25);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_ratio1_15", &shw_sp_br4_2_ratio1_15);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_iso_angle", &shw_sp_br4_2_iso_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_iso_angle1", &shw_sp_br4_2_iso_angle1);
+  SetBranchAddress(*port,tree3,"shw_sp_br4_2_angle", &shw_sp_br4_2_angle);
 
   float shw_sp_hol_flag;
   float shw_sp_hol_1_flag;
@@ -677,18 +717,18 @@ if(f_BDTport){
   float shw_sp_hol_2_medium_dQ_dx;
   float shw_sp_hol_2_ncount;
   float shw_sp_hol_2_energy;
-  tree3->SetBranchAddress("shw_sp_hol_flag", &shw_sp_hol_flag);
-  tree3->SetBranchAddress("shw_sp_hol_1_flag", &shw_sp_hol_1_flag);
-  tree3->SetBranchAddress("shw_sp_hol_1_n_valid_tracks", &shw_sp_hol_1_n_valid_tracks);
-  tree3->SetBranchAddress("shw_sp_hol_1_min_angle", &shw_sp_hol_1_min_angle);
-  tree3->SetBranchAddress("shw_sp_hol_1_energy", &shw_sp_hol_1_energy);
-  tree3->SetBranchAddress("shw_sp_hol_1_flag_all_shower", &shw_sp_hol_1_flag_all_shower);
-  tree3->SetBranchAddress("shw_sp_hol_1_min_length", &shw_sp_hol_1_min_length);
-  tree3->SetBranchAddress("shw_sp_hol_2_flag", &shw_sp_hol_2_flag);
-  tree3->SetBranchAddress("shw_sp_hol_2_min_angle", &shw_sp_hol_2_min_angle);
-  tree3->SetBranchAddress("shw_sp_hol_2_medium_dQ_dx", &shw_sp_hol_2_medium_dQ_dx);
-  tree3->SetBranchAddress("shw_sp_hol_2_ncount", &shw_sp_hol_2_ncount);
-  tree3->SetBranchAddress("shw_sp_hol_2_energy", &shw_sp_hol_2_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_flag", &shw_sp_hol_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_flag", &shw_sp_hol_1_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_n_valid_tracks", &shw_sp_hol_1_n_valid_tracks);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_min_angle", &shw_sp_hol_1_min_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_energy", &shw_sp_hol_1_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_flag_all_shower", &shw_sp_hol_1_flag_all_shower);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_1_min_length", &shw_sp_hol_1_min_length);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_2_flag", &shw_sp_hol_2_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_2_min_angle", &shw_sp_hol_2_min_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_2_medium_dQ_dx", &shw_sp_hol_2_medium_dQ_dx);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_2_ncount", &shw_sp_hol_2_ncount);
+  SetBranchAddress(*port,tree3,"shw_sp_hol_2_energy", &shw_sp_hol_2_energy);
 
 
   float shw_sp_lol_flag;
@@ -714,29 +754,29 @@ if(f_BDTport){
   float shw_sp_lol_3_shower_main_length;
   float shw_sp_lol_3_n_out;
   float shw_sp_lol_3_n_sum;
-  tree3->SetBranchAddress("shw_sp_lol_flag",&shw_sp_lol_flag);
-  tree3->SetBranchAddress("shw_sp_lol_1_v_flag",&shw_sp_lol_1_v_flag);
-  tree3->SetBranchAddress("shw_sp_lol_1_v_energy",&shw_sp_lol_1_v_energy);
-  tree3->SetBranchAddress("shw_sp_lol_1_v_vtx_n_segs",&shw_sp_lol_1_v_vtx_n_segs);
-  tree3->SetBranchAddress("shw_sp_lol_1_v_nseg",&shw_sp_lol_1_v_nseg);
-  tree3->SetBranchAddress("shw_sp_lol_1_v_angle",&shw_sp_lol_1_v_angle);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_flag",&shw_sp_lol_2_v_flag);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_length",&shw_sp_lol_2_v_length);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_angle",&shw_sp_lol_2_v_angle);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_type",&shw_sp_lol_2_v_type);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_vtx_n_segs",&shw_sp_lol_2_v_vtx_n_segs);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_energy",&shw_sp_lol_2_v_energy);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_shower_main_length",&shw_sp_lol_2_v_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_lol_2_v_flag_dir_weak",&shw_sp_lol_2_v_flag_dir_weak);
-  tree3->SetBranchAddress("shw_sp_lol_3_flag",&shw_sp_lol_3_flag);
-  tree3->SetBranchAddress("shw_sp_lol_3_angle_beam",&shw_sp_lol_3_angle_beam);
-  tree3->SetBranchAddress("shw_sp_lol_3_n_valid_tracks",&shw_sp_lol_3_n_valid_tracks);
-  tree3->SetBranchAddress("shw_sp_lol_3_min_angle",&shw_sp_lol_3_min_angle);
-  tree3->SetBranchAddress("shw_sp_lol_3_vtx_n_segs",&shw_sp_lol_3_vtx_n_segs);
-  tree3->SetBranchAddress("shw_sp_lol_3_energy",&shw_sp_lol_3_energy);
-  tree3->SetBranchAddress("shw_sp_lol_3_shower_main_length",&shw_sp_lol_3_shower_main_length);
-  tree3->SetBranchAddress("shw_sp_lol_3_n_out",&shw_sp_lol_3_n_out);
-  tree3->SetBranchAddress("shw_sp_lol_3_n_sum",&shw_sp_lol_3_n_sum);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_flag",&shw_sp_lol_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_1_v_flag",&shw_sp_lol_1_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_1_v_energy",&shw_sp_lol_1_v_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_1_v_vtx_n_segs",&shw_sp_lol_1_v_vtx_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_1_v_nseg",&shw_sp_lol_1_v_nseg);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_1_v_angle",&shw_sp_lol_1_v_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_flag",&shw_sp_lol_2_v_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_length",&shw_sp_lol_2_v_length);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_angle",&shw_sp_lol_2_v_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_type",&shw_sp_lol_2_v_type);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_vtx_n_segs",&shw_sp_lol_2_v_vtx_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_energy",&shw_sp_lol_2_v_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_shower_main_length",&shw_sp_lol_2_v_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_2_v_flag_dir_weak",&shw_sp_lol_2_v_flag_dir_weak);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_flag",&shw_sp_lol_3_flag);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_angle_beam",&shw_sp_lol_3_angle_beam);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_n_valid_tracks",&shw_sp_lol_3_n_valid_tracks);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_min_angle",&shw_sp_lol_3_min_angle);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_vtx_n_segs",&shw_sp_lol_3_vtx_n_segs);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_energy",&shw_sp_lol_3_energy);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_shower_main_length",&shw_sp_lol_3_shower_main_length);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_n_out",&shw_sp_lol_3_n_out);
+  SetBranchAddress(*port,tree3,"shw_sp_lol_3_n_sum",&shw_sp_lol_3_n_sum);
 
 
 
@@ -749,15 +789,15 @@ if(f_BDTport){
 	  float cosmic_n_direct_showers;
 	  float cosmic_n_indirect_showers;
 	  float cosmic_n_main_showers;
-	  tree3->SetBranchAddress("cosmic_filled",&cosmic_filled);
-	  tree3->SetBranchAddress("cosmic_flag",&cosmic_flag);
-	  tree3->SetBranchAddress("cosmic_energy_main_showers",&cosmic_energy_main_showers);
-	  tree3->SetBranchAddress("cosmic_energy_indirect_showers",&cosmic_energy_indirect_showers);
-	  tree3->SetBranchAddress("cosmic_energy_direct_showers",&cosmic_energy_direct_showers);
-	  tree3->SetBranchAddress("cosmic_n_direct_showers",&cosmic_n_direct_showers);
-	  tree3->SetBranchAddress("cosmic_n_indirect_showers",&cosmic_n_indirect_showers);
-	  tree3->SetBranchAddress("cosmic_n_solid_tracks",&cosmic_n_solid_tracks);
-	  tree3->SetBranchAddress("cosmic_n_main_showers",&cosmic_n_main_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_filled",&cosmic_filled);
+	  SetBranchAddress(*port,tree3,"cosmic_flag",&cosmic_flag);
+	  SetBranchAddress(*port,tree3,"cosmic_energy_main_showers",&cosmic_energy_main_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_energy_indirect_showers",&cosmic_energy_indirect_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_energy_direct_showers",&cosmic_energy_direct_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_n_direct_showers",&cosmic_n_direct_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_n_indirect_showers",&cosmic_n_indirect_showers);
+	  SetBranchAddress(*port,tree3,"cosmic_n_solid_tracks",&cosmic_n_solid_tracks);
+	  SetBranchAddress(*port,tree3,"cosmic_n_main_showers",&cosmic_n_main_showers);
 
 
 	  float gap_filled;
@@ -771,17 +811,17 @@ if(f_BDTport){
 	  float gap_energy;
 	  float gap_num_valid_tracks;
 	  float gap_flag_single_shower;
-	  tree3->SetBranchAddress("gap_flag",&gap_flag);
-	  tree3->SetBranchAddress("gap_flag_prolong_u",&gap_flag_prolong_u);
-	  tree3->SetBranchAddress("gap_flag_prolong_v",&gap_flag_prolong_v);
-	  tree3->SetBranchAddress("gap_flag_prolong_w",&gap_flag_prolong_w);
-	  tree3->SetBranchAddress("gap_flag_parallel",&gap_flag_parallel);
-	  tree3->SetBranchAddress("gap_n_points",&gap_n_points);
-	  tree3->SetBranchAddress("gap_n_bad",&gap_n_bad);
-	  tree3->SetBranchAddress("gap_energy",&gap_energy);
-	  tree3->SetBranchAddress("gap_num_valid_tracks",&gap_num_valid_tracks);
-	  tree3->SetBranchAddress("gap_flag_single_shower",&gap_flag_single_shower);
-	  tree3->SetBranchAddress("gap_filled",&gap_filled);
+	  SetBranchAddress(*port,tree3,"gap_flag",&gap_flag);
+	  SetBranchAddress(*port,tree3,"gap_flag_prolong_u",&gap_flag_prolong_u);
+	  SetBranchAddress(*port,tree3,"gap_flag_prolong_v",&gap_flag_prolong_v);
+	  SetBranchAddress(*port,tree3,"gap_flag_prolong_w",&gap_flag_prolong_w);
+	  SetBranchAddress(*port,tree3,"gap_flag_parallel",&gap_flag_parallel);
+	  SetBranchAddress(*port,tree3,"gap_n_points",&gap_n_points);
+	  SetBranchAddress(*port,tree3,"gap_n_bad",&gap_n_bad);
+	  SetBranchAddress(*port,tree3,"gap_energy",&gap_energy);
+	  SetBranchAddress(*port,tree3,"gap_num_valid_tracks",&gap_num_valid_tracks);
+	  SetBranchAddress(*port,tree3,"gap_flag_single_shower",&gap_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"gap_filled",&gap_filled);
 
 
 	  float mip_quality_filled;
@@ -796,18 +836,18 @@ if(f_BDTport){
 	  float mip_quality_acc_length;
 	  float mip_quality_shortest_angle;
 	  float mip_quality_flag_proton;
-	  tree3->SetBranchAddress("mip_quality_filled",&mip_quality_filled);
-	  tree3->SetBranchAddress("mip_quality_flag",&mip_quality_flag);
-	  tree3->SetBranchAddress("mip_quality_energy",&mip_quality_energy);
-	  tree3->SetBranchAddress("mip_quality_overlap",&mip_quality_overlap);
-	  tree3->SetBranchAddress("mip_quality_n_showers",&mip_quality_n_showers);
-	  tree3->SetBranchAddress("mip_quality_n_tracks",&mip_quality_n_tracks);
-	  tree3->SetBranchAddress("mip_quality_flag_inside_pi0",&mip_quality_flag_inside_pi0);
-	  tree3->SetBranchAddress("mip_quality_n_pi0_showers",&mip_quality_n_pi0_showers);
-	  tree3->SetBranchAddress("mip_quality_shortest_length",&mip_quality_shortest_length);
-	  tree3->SetBranchAddress("mip_quality_acc_length",&mip_quality_acc_length);
-	  tree3->SetBranchAddress("mip_quality_shortest_angle",&mip_quality_shortest_angle);
-	  tree3->SetBranchAddress("mip_quality_flag_proton",&mip_quality_flag_proton);
+	  SetBranchAddress(*port,tree3,"mip_quality_filled",&mip_quality_filled);
+	  SetBranchAddress(*port,tree3,"mip_quality_flag",&mip_quality_flag);
+	  SetBranchAddress(*port,tree3,"mip_quality_energy",&mip_quality_energy);
+	  SetBranchAddress(*port,tree3,"mip_quality_overlap",&mip_quality_overlap);
+	  SetBranchAddress(*port,tree3,"mip_quality_n_showers",&mip_quality_n_showers);
+	  SetBranchAddress(*port,tree3,"mip_quality_n_tracks",&mip_quality_n_tracks);
+	  SetBranchAddress(*port,tree3,"mip_quality_flag_inside_pi0",&mip_quality_flag_inside_pi0);
+	  SetBranchAddress(*port,tree3,"mip_quality_n_pi0_showers",&mip_quality_n_pi0_showers);
+	  SetBranchAddress(*port,tree3,"mip_quality_shortest_length",&mip_quality_shortest_length);
+	  SetBranchAddress(*port,tree3,"mip_quality_acc_length",&mip_quality_acc_length);
+	  SetBranchAddress(*port,tree3,"mip_quality_shortest_angle",&mip_quality_shortest_angle);
+	  SetBranchAddress(*port,tree3,"mip_quality_flag_proton",&mip_quality_flag_proton);
 
 
 	  float mip_filled;
@@ -842,38 +882,38 @@ if(f_BDTport){
     float mip_n_stem_size;
     float mip_flag_stem_trajectory;
     float mip_min_dis;
-	  tree3->SetBranchAddress("mip_filled",&mip_filled);
-	  tree3->SetBranchAddress("mip_flag",&mip_flag);
-	  tree3->SetBranchAddress("mip_energy",&mip_energy);
-	  tree3->SetBranchAddress("mip_n_end_reduction",&mip_n_end_reduction);
-	  tree3->SetBranchAddress("mip_n_first_mip",&mip_n_first_mip);
-	  tree3->SetBranchAddress("mip_n_first_non_mip",&mip_n_first_non_mip);
-	  tree3->SetBranchAddress("mip_n_first_non_mip_1",&mip_n_first_non_mip_1);
-	  tree3->SetBranchAddress("mip_n_first_non_mip_2",&mip_n_first_non_mip_2);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_0",&mip_vec_dQ_dx_0);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_1",&mip_vec_dQ_dx_1);
-	  tree3->SetBranchAddress("mip_max_dQ_dx_sample",&mip_max_dQ_dx_sample);
-	  tree3->SetBranchAddress("mip_n_below_threshold",&mip_n_below_threshold);
-	  tree3->SetBranchAddress("mip_n_below_zero",&mip_n_below_zero);
-	  tree3->SetBranchAddress("mip_n_lowest",&mip_n_lowest);
-	  tree3->SetBranchAddress("mip_n_highest",&mip_n_highest);
-	  tree3->SetBranchAddress("mip_lowest_dQ_dx",&mip_lowest_dQ_dx);
-	  tree3->SetBranchAddress("mip_highest_dQ_dx",&mip_highest_dQ_dx);
-	  tree3->SetBranchAddress("mip_medium_dQ_dx",&mip_medium_dQ_dx);
-	  tree3->SetBranchAddress("mip_stem_length",&mip_stem_length);
-	  tree3->SetBranchAddress("mip_length_main",&mip_length_main);
-	  tree3->SetBranchAddress("mip_length_total",&mip_length_total);
-	  tree3->SetBranchAddress("mip_angle_beam",&mip_angle_beam);
-	  tree3->SetBranchAddress("mip_iso_angle",&mip_iso_angle);
-	  tree3->SetBranchAddress("mip_n_vertex",&mip_n_vertex);
-	  tree3->SetBranchAddress("mip_n_good_tracks",&mip_n_good_tracks);
-	  tree3->SetBranchAddress("mip_E_indirect_max_energy",&mip_E_indirect_max_energy);
-	  tree3->SetBranchAddress("mip_flag_all_above",&mip_flag_all_above);
-	  tree3->SetBranchAddress("mip_min_dQ_dx_5",&mip_min_dQ_dx_5);
-	  tree3->SetBranchAddress("mip_n_other_vertex",&mip_n_other_vertex);
-	  tree3->SetBranchAddress("mip_n_stem_size",&mip_n_stem_size);
-	  tree3->SetBranchAddress("mip_flag_stem_trajectory",&mip_flag_stem_trajectory);
-	  tree3->SetBranchAddress("mip_min_dis",&mip_min_dis);
+	  SetBranchAddress(*port,tree3,"mip_filled",&mip_filled);
+	  SetBranchAddress(*port,tree3,"mip_flag",&mip_flag);
+	  SetBranchAddress(*port,tree3,"mip_energy",&mip_energy);
+	  SetBranchAddress(*port,tree3,"mip_n_end_reduction",&mip_n_end_reduction);
+	  SetBranchAddress(*port,tree3,"mip_n_first_mip",&mip_n_first_mip);
+	  SetBranchAddress(*port,tree3,"mip_n_first_non_mip",&mip_n_first_non_mip);
+	  SetBranchAddress(*port,tree3,"mip_n_first_non_mip_1",&mip_n_first_non_mip_1);
+	  SetBranchAddress(*port,tree3,"mip_n_first_non_mip_2",&mip_n_first_non_mip_2);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_0",&mip_vec_dQ_dx_0);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_1",&mip_vec_dQ_dx_1);
+	  SetBranchAddress(*port,tree3,"mip_max_dQ_dx_sample",&mip_max_dQ_dx_sample);
+	  SetBranchAddress(*port,tree3,"mip_n_below_threshold",&mip_n_below_threshold);
+	  SetBranchAddress(*port,tree3,"mip_n_below_zero",&mip_n_below_zero);
+	  SetBranchAddress(*port,tree3,"mip_n_lowest",&mip_n_lowest);
+	  SetBranchAddress(*port,tree3,"mip_n_highest",&mip_n_highest);
+	  SetBranchAddress(*port,tree3,"mip_lowest_dQ_dx",&mip_lowest_dQ_dx);
+	  SetBranchAddress(*port,tree3,"mip_highest_dQ_dx",&mip_highest_dQ_dx);
+	  SetBranchAddress(*port,tree3,"mip_medium_dQ_dx",&mip_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"mip_stem_length",&mip_stem_length);
+	  SetBranchAddress(*port,tree3,"mip_length_main",&mip_length_main);
+	  SetBranchAddress(*port,tree3,"mip_length_total",&mip_length_total);
+	  SetBranchAddress(*port,tree3,"mip_angle_beam",&mip_angle_beam);
+	  SetBranchAddress(*port,tree3,"mip_iso_angle",&mip_iso_angle);
+	  SetBranchAddress(*port,tree3,"mip_n_vertex",&mip_n_vertex);
+	  SetBranchAddress(*port,tree3,"mip_n_good_tracks",&mip_n_good_tracks);
+	  SetBranchAddress(*port,tree3,"mip_E_indirect_max_energy",&mip_E_indirect_max_energy);
+	  SetBranchAddress(*port,tree3,"mip_flag_all_above",&mip_flag_all_above);
+	  SetBranchAddress(*port,tree3,"mip_min_dQ_dx_5",&mip_min_dQ_dx_5);
+	  SetBranchAddress(*port,tree3,"mip_n_other_vertex",&mip_n_other_vertex);
+	  SetBranchAddress(*port,tree3,"mip_n_stem_size",&mip_n_stem_size);
+	  SetBranchAddress(*port,tree3,"mip_flag_stem_trajectory",&mip_flag_stem_trajectory);
+	  SetBranchAddress(*port,tree3,"mip_min_dis",&mip_min_dis);
 
 
 	  float mip_vec_dQ_dx_2;
@@ -894,24 +934,24 @@ if(f_BDTport){
 	  float mip_vec_dQ_dx_17;
 	  float mip_vec_dQ_dx_18;
 	  float mip_vec_dQ_dx_19;
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_2",&mip_vec_dQ_dx_2);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_3",&mip_vec_dQ_dx_3);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_4",&mip_vec_dQ_dx_4);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_5",&mip_vec_dQ_dx_5);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_6",&mip_vec_dQ_dx_6);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_7",&mip_vec_dQ_dx_7);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_8",&mip_vec_dQ_dx_8);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_9",&mip_vec_dQ_dx_9);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_10",&mip_vec_dQ_dx_10);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_11",&mip_vec_dQ_dx_11);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_12",&mip_vec_dQ_dx_12);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_13",&mip_vec_dQ_dx_13);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_14",&mip_vec_dQ_dx_14);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_15",&mip_vec_dQ_dx_15);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_16",&mip_vec_dQ_dx_16);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_17",&mip_vec_dQ_dx_17);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_18",&mip_vec_dQ_dx_18);
-	  tree3->SetBranchAddress("mip_vec_dQ_dx_19",&mip_vec_dQ_dx_19);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_2",&mip_vec_dQ_dx_2);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_3",&mip_vec_dQ_dx_3);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_4",&mip_vec_dQ_dx_4);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_5",&mip_vec_dQ_dx_5);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_6",&mip_vec_dQ_dx_6);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_7",&mip_vec_dQ_dx_7);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_8",&mip_vec_dQ_dx_8);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_9",&mip_vec_dQ_dx_9);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_10",&mip_vec_dQ_dx_10);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_11",&mip_vec_dQ_dx_11);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_12",&mip_vec_dQ_dx_12);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_13",&mip_vec_dQ_dx_13);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_14",&mip_vec_dQ_dx_14);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_15",&mip_vec_dQ_dx_15);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_16",&mip_vec_dQ_dx_16);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_17",&mip_vec_dQ_dx_17);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_18",&mip_vec_dQ_dx_18);
+	  SetBranchAddress(*port,tree3,"mip_vec_dQ_dx_19",&mip_vec_dQ_dx_19);
 
 
 	  float pio_filled;
@@ -929,21 +969,21 @@ if(f_BDTport){
 	  std::vector<float> *pio_2_v_dis2 = new std::vector<float>;
 	  std::vector<float> *pio_2_v_angle2 = new std::vector<float>;
 	  std::vector<float> *pio_2_v_acc_length = new std::vector<float>;
-	  tree3->SetBranchAddress("pio_filled",&pio_filled);
-	  tree3->SetBranchAddress("pio_flag",&pio_flag);
-	  tree3->SetBranchAddress("pio_mip_id",&pio_mip_id);
-	  tree3->SetBranchAddress("pio_flag_pio",&pio_flag_pio);
-	  tree3->SetBranchAddress("pio_1_flag",&pio_1_flag);
-	  tree3->SetBranchAddress("pio_1_mass",&pio_1_mass);
-	  tree3->SetBranchAddress("pio_1_pio_type",&pio_1_pio_type);
-	  tree3->SetBranchAddress("pio_1_energy_1",&pio_1_energy_1);
-	  tree3->SetBranchAddress("pio_1_energy_2",&pio_1_energy_2);
-	  tree3->SetBranchAddress("pio_1_dis_1",&pio_1_dis_1);
-	  tree3->SetBranchAddress("pio_1_dis_2",&pio_1_dis_2);
-	  tree3->SetBranchAddress("pio_2_v_flag",&pio_2_v_flag);
-	  tree3->SetBranchAddress("pio_2_v_dis2",&pio_2_v_dis2);
-	  tree3->SetBranchAddress("pio_2_v_angle2",&pio_2_v_angle2);
-	  tree3->SetBranchAddress("pio_2_v_acc_length",&pio_2_v_acc_length);
+	  SetBranchAddress(*port,tree3,"pio_filled",&pio_filled);
+	  SetBranchAddress(*port,tree3,"pio_flag",&pio_flag);
+	  SetBranchAddress(*port,tree3,"pio_mip_id",&pio_mip_id);
+	  SetBranchAddress(*port,tree3,"pio_flag_pio",&pio_flag_pio);
+	  SetBranchAddress(*port,tree3,"pio_1_flag",&pio_1_flag);
+	  SetBranchAddress(*port,tree3,"pio_1_mass",&pio_1_mass);
+	  SetBranchAddress(*port,tree3,"pio_1_pio_type",&pio_1_pio_type);
+	  SetBranchAddress(*port,tree3,"pio_1_energy_1",&pio_1_energy_1);
+	  SetBranchAddress(*port,tree3,"pio_1_energy_2",&pio_1_energy_2);
+	  SetBranchAddress(*port,tree3,"pio_1_dis_1",&pio_1_dis_1);
+	  SetBranchAddress(*port,tree3,"pio_1_dis_2",&pio_1_dis_2);
+	  SetBranchAddress(*port,tree3,"pio_2_v_flag",&pio_2_v_flag);
+	  SetBranchAddress(*port,tree3,"pio_2_v_dis2",&pio_2_v_dis2);
+	  SetBranchAddress(*port,tree3,"pio_2_v_angle2",&pio_2_v_angle2);
+	  SetBranchAddress(*port,tree3,"pio_2_v_acc_length",&pio_2_v_acc_length);
 
 
 	  float sig_flag;
@@ -958,18 +998,18 @@ if(f_BDTport){
 	  std::vector<float> *sig_2_v_flag_single_shower= new std::vector<float>;
 	  std::vector<float> *sig_2_v_medium_dQ_dx= new std::vector<float>;
 	  std::vector<float> *sig_2_v_start_dQ_dx= new std::vector<float>;
-	  tree3->SetBranchAddress("sig_flag",&sig_flag);
-	  tree3->SetBranchAddress("sig_1_v_flag",&sig_1_v_flag);
-	  tree3->SetBranchAddress("sig_1_v_angle",&sig_1_v_angle);
-	  tree3->SetBranchAddress("sig_1_v_flag_single_shower",&sig_1_v_flag_single_shower);
-	  tree3->SetBranchAddress("sig_1_v_energy",&sig_1_v_energy);
-	  tree3->SetBranchAddress("sig_1_v_energy_1",&sig_1_v_energy_1);
-	  tree3->SetBranchAddress("sig_2_v_flag",&sig_2_v_flag);
-	  tree3->SetBranchAddress("sig_2_v_energy",&sig_2_v_energy);
-	  tree3->SetBranchAddress("sig_2_v_shower_angle",&sig_2_v_shower_angle);
-	  tree3->SetBranchAddress("sig_2_v_flag_single_shower",&sig_2_v_flag_single_shower);
-	  tree3->SetBranchAddress("sig_2_v_medium_dQ_dx",&sig_2_v_medium_dQ_dx);
-	  tree3->SetBranchAddress("sig_2_v_start_dQ_dx",&sig_2_v_start_dQ_dx);
+	  SetBranchAddress(*port,tree3,"sig_flag",&sig_flag);
+	  SetBranchAddress(*port,tree3,"sig_1_v_flag",&sig_1_v_flag);
+	  SetBranchAddress(*port,tree3,"sig_1_v_angle",&sig_1_v_angle);
+	  SetBranchAddress(*port,tree3,"sig_1_v_flag_single_shower",&sig_1_v_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"sig_1_v_energy",&sig_1_v_energy);
+	  SetBranchAddress(*port,tree3,"sig_1_v_energy_1",&sig_1_v_energy_1);
+	  SetBranchAddress(*port,tree3,"sig_2_v_flag",&sig_2_v_flag);
+	  SetBranchAddress(*port,tree3,"sig_2_v_energy",&sig_2_v_energy);
+	  SetBranchAddress(*port,tree3,"sig_2_v_shower_angle",&sig_2_v_shower_angle);
+	  SetBranchAddress(*port,tree3,"sig_2_v_flag_single_shower",&sig_2_v_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"sig_2_v_medium_dQ_dx",&sig_2_v_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"sig_2_v_start_dQ_dx",&sig_2_v_start_dQ_dx);
 
 
 	  float mgo_flag;
@@ -982,16 +1022,16 @@ if(f_BDTport){
 	  float mgo_total_other_energy;
 	  float mgo_n_total_showers;
 	  float mgo_total_other_energy_1;
-	  tree3->SetBranchAddress("mgo_flag",&mgo_flag);
-	  tree3->SetBranchAddress("mgo_energy",&mgo_energy);
-	  tree3->SetBranchAddress("mgo_max_energy",&mgo_max_energy);
-	  tree3->SetBranchAddress("mgo_total_energy",&mgo_total_energy);
-	  tree3->SetBranchAddress("mgo_n_showers",&mgo_n_showers);
-	  tree3->SetBranchAddress("mgo_max_energy_1",&mgo_max_energy_1);
-	  tree3->SetBranchAddress("mgo_max_energy_2",&mgo_max_energy_2);
-	  tree3->SetBranchAddress("mgo_total_other_energy",&mgo_total_other_energy);
-	  tree3->SetBranchAddress("mgo_n_total_showers",&mgo_n_total_showers);
-	  tree3->SetBranchAddress("mgo_total_other_energy_1",&mgo_total_other_energy_1);
+	  SetBranchAddress(*port,tree3,"mgo_flag",&mgo_flag);
+	  SetBranchAddress(*port,tree3,"mgo_energy",&mgo_energy);
+	  SetBranchAddress(*port,tree3,"mgo_max_energy",&mgo_max_energy);
+	  SetBranchAddress(*port,tree3,"mgo_total_energy",&mgo_total_energy);
+	  SetBranchAddress(*port,tree3,"mgo_n_showers",&mgo_n_showers);
+	  SetBranchAddress(*port,tree3,"mgo_max_energy_1",&mgo_max_energy_1);
+	  SetBranchAddress(*port,tree3,"mgo_max_energy_2",&mgo_max_energy_2);
+	  SetBranchAddress(*port,tree3,"mgo_total_other_energy",&mgo_total_other_energy);
+	  SetBranchAddress(*port,tree3,"mgo_n_total_showers",&mgo_n_total_showers);
+	  SetBranchAddress(*port,tree3,"mgo_total_other_energy_1",&mgo_total_other_energy_1);
 
 
 	  float mgt_flag;
@@ -1006,18 +1046,18 @@ if(f_BDTport){
 	  float mgt_e_direct_total_energy;
 	  float mgt_flag_indirect_max_pio;
 	  float mgt_e_indirect_total_energy;
-	  tree3->SetBranchAddress("mgt_flag",&mgt_flag);
-	  tree3->SetBranchAddress("mgt_flag_single_shower",&mgt_flag_single_shower);
-	  tree3->SetBranchAddress("mgt_max_energy",&mgt_max_energy);
-	  tree3->SetBranchAddress("mgt_energy",&mgt_energy);
-	  tree3->SetBranchAddress("mgt_total_other_energy",&mgt_total_other_energy);
-	  tree3->SetBranchAddress("mgt_max_energy_1",&mgt_max_energy_1);
-	  tree3->SetBranchAddress("mgt_e_indirect_max_energy",&mgt_e_indirect_max_energy);
-	  tree3->SetBranchAddress("mgt_e_direct_max_energy",&mgt_e_direct_max_energy);
-	  tree3->SetBranchAddress("mgt_n_direct_showers",&mgt_n_direct_showers);
-	  tree3->SetBranchAddress("mgt_e_direct_total_energy",&mgt_e_direct_total_energy);
-	  tree3->SetBranchAddress("mgt_flag_indirect_max_pio",&mgt_flag_indirect_max_pio);
-	  tree3->SetBranchAddress("mgt_e_indirect_total_energy",&mgt_e_indirect_total_energy);
+	  SetBranchAddress(*port,tree3,"mgt_flag",&mgt_flag);
+	  SetBranchAddress(*port,tree3,"mgt_flag_single_shower",&mgt_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"mgt_max_energy",&mgt_max_energy);
+	  SetBranchAddress(*port,tree3,"mgt_energy",&mgt_energy);
+	  SetBranchAddress(*port,tree3,"mgt_total_other_energy",&mgt_total_other_energy);
+	  SetBranchAddress(*port,tree3,"mgt_max_energy_1",&mgt_max_energy_1);
+	  SetBranchAddress(*port,tree3,"mgt_e_indirect_max_energy",&mgt_e_indirect_max_energy);
+	  SetBranchAddress(*port,tree3,"mgt_e_direct_max_energy",&mgt_e_direct_max_energy);
+	  SetBranchAddress(*port,tree3,"mgt_n_direct_showers",&mgt_n_direct_showers);
+	  SetBranchAddress(*port,tree3,"mgt_e_direct_total_energy",&mgt_e_direct_total_energy);
+	  SetBranchAddress(*port,tree3,"mgt_flag_indirect_max_pio",&mgt_flag_indirect_max_pio);
+	  SetBranchAddress(*port,tree3,"mgt_e_indirect_total_energy",&mgt_e_indirect_total_energy);
 
 
 	  float stw_flag;
@@ -1043,29 +1083,29 @@ if(f_BDTport){
 	  std::vector<float> *stw_4_v_angle = new std::vector<float>;
 	  std::vector<float> *stw_4_v_dis = new std::vector<float>;
 	  std::vector<float> *stw_4_v_energy = new std::vector<float>;
-	  tree3->SetBranchAddress("stw_flag", &stw_flag);
-	  tree3->SetBranchAddress("stw_1_flag",&stw_1_flag);
-	  tree3->SetBranchAddress("stw_1_energy",&stw_1_energy);
-	  tree3->SetBranchAddress("stw_1_dis",&stw_1_dis);
-	  tree3->SetBranchAddress("stw_1_dQ_dx",&stw_1_dQ_dx);
-	  tree3->SetBranchAddress("stw_1_flag_single_shower",&stw_1_flag_single_shower);
-	  tree3->SetBranchAddress("stw_1_n_pi0",&stw_1_n_pi0);
-	  tree3->SetBranchAddress("stw_1_num_valid_tracks",&stw_1_num_valid_tracks);
-	  tree3->SetBranchAddress("stw_2_v_flag", &stw_2_v_flag);
-	  tree3->SetBranchAddress("stw_2_v_medium_dQ_dx", &stw_2_v_medium_dQ_dx);
-	  tree3->SetBranchAddress("stw_2_v_energy", &stw_2_v_energy);
-	  tree3->SetBranchAddress("stw_2_v_angle", &stw_2_v_angle);
-	  tree3->SetBranchAddress("stw_2_v_dir_length", &stw_2_v_dir_length);
-	  tree3->SetBranchAddress("stw_2_v_max_dQ_dx", &stw_2_v_max_dQ_dx);
-	  tree3->SetBranchAddress("stw_3_v_flag",&stw_3_v_flag);
-	  tree3->SetBranchAddress("stw_3_v_angle",&stw_3_v_angle);
-	  tree3->SetBranchAddress("stw_3_v_dir_length",&stw_3_v_dir_length);
-	  tree3->SetBranchAddress("stw_3_v_energy",&stw_3_v_energy);
-	  tree3->SetBranchAddress("stw_3_v_medium_dQ_dx",&stw_3_v_medium_dQ_dx);
-	  tree3->SetBranchAddress("stw_4_v_flag",&stw_4_v_flag);
-	  tree3->SetBranchAddress("stw_4_v_angle",&stw_4_v_angle);
-	  tree3->SetBranchAddress("stw_4_v_dis",&stw_4_v_dis);
-	  tree3->SetBranchAddress("stw_4_v_energy",&stw_4_v_energy);
+	  SetBranchAddress(*port,tree3,"stw_flag", &stw_flag);
+	  SetBranchAddress(*port,tree3,"stw_1_flag",&stw_1_flag);
+	  SetBranchAddress(*port,tree3,"stw_1_energy",&stw_1_energy);
+	  SetBranchAddress(*port,tree3,"stw_1_dis",&stw_1_dis);
+	  SetBranchAddress(*port,tree3,"stw_1_dQ_dx",&stw_1_dQ_dx);
+	  SetBranchAddress(*port,tree3,"stw_1_flag_single_shower",&stw_1_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"stw_1_n_pi0",&stw_1_n_pi0);
+	  SetBranchAddress(*port,tree3,"stw_1_num_valid_tracks",&stw_1_num_valid_tracks);
+	  SetBranchAddress(*port,tree3,"stw_2_v_flag", &stw_2_v_flag);
+	  SetBranchAddress(*port,tree3,"stw_2_v_medium_dQ_dx", &stw_2_v_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"stw_2_v_energy", &stw_2_v_energy);
+	  SetBranchAddress(*port,tree3,"stw_2_v_angle", &stw_2_v_angle);
+	  SetBranchAddress(*port,tree3,"stw_2_v_dir_length", &stw_2_v_dir_length);
+	  SetBranchAddress(*port,tree3,"stw_2_v_max_dQ_dx", &stw_2_v_max_dQ_dx);
+	  SetBranchAddress(*port,tree3,"stw_3_v_flag",&stw_3_v_flag);
+	  SetBranchAddress(*port,tree3,"stw_3_v_angle",&stw_3_v_angle);
+	  SetBranchAddress(*port,tree3,"stw_3_v_dir_length",&stw_3_v_dir_length);
+	  SetBranchAddress(*port,tree3,"stw_3_v_energy",&stw_3_v_energy);
+	  SetBranchAddress(*port,tree3,"stw_3_v_medium_dQ_dx",&stw_3_v_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"stw_4_v_flag",&stw_4_v_flag);
+	  SetBranchAddress(*port,tree3,"stw_4_v_angle",&stw_4_v_angle);
+	  SetBranchAddress(*port,tree3,"stw_4_v_dis",&stw_4_v_dis);
+	  SetBranchAddress(*port,tree3,"stw_4_v_energy",&stw_4_v_energy);
 
 
 	  float spt_flag;
@@ -1082,20 +1122,20 @@ if(f_BDTport){
 	  float spt_num_valid_tracks;
 	  float spt_n_vtx_segs;
 	  float spt_max_length;
-	  tree3->SetBranchAddress("spt_flag", &spt_flag);
-	  tree3->SetBranchAddress("spt_flag_single_shower", &spt_flag_single_shower);
-	  tree3->SetBranchAddress("spt_energy", &spt_energy);
-	  tree3->SetBranchAddress("spt_shower_main_length", &spt_shower_main_length);
-	  tree3->SetBranchAddress("spt_shower_total_length", &spt_shower_total_length);
-	  tree3->SetBranchAddress("spt_angle_beam", &spt_angle_beam);
-	  tree3->SetBranchAddress("spt_angle_vertical", &spt_angle_vertical);
-	  tree3->SetBranchAddress("spt_max_dQ_dx", &spt_max_dQ_dx);
-	  tree3->SetBranchAddress("spt_angle_beam_1", &spt_angle_beam_1);
-	  tree3->SetBranchAddress("spt_angle_drift", &spt_angle_drift);
-	  tree3->SetBranchAddress("spt_angle_drift_1", &spt_angle_drift_1);
-	  tree3->SetBranchAddress("spt_num_valid_tracks", &spt_num_valid_tracks);
-	  tree3->SetBranchAddress("spt_n_vtx_segs", &spt_n_vtx_segs);
-	  tree3->SetBranchAddress("spt_max_length", &spt_max_length);
+	  SetBranchAddress(*port,tree3,"spt_flag", &spt_flag);
+	  SetBranchAddress(*port,tree3,"spt_flag_single_shower", &spt_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"spt_energy", &spt_energy);
+	  SetBranchAddress(*port,tree3,"spt_shower_main_length", &spt_shower_main_length);
+	  SetBranchAddress(*port,tree3,"spt_shower_total_length", &spt_shower_total_length);
+	  SetBranchAddress(*port,tree3,"spt_angle_beam", &spt_angle_beam);
+	  SetBranchAddress(*port,tree3,"spt_angle_vertical", &spt_angle_vertical);
+	  SetBranchAddress(*port,tree3,"spt_max_dQ_dx", &spt_max_dQ_dx);
+	  SetBranchAddress(*port,tree3,"spt_angle_beam_1", &spt_angle_beam_1);
+	  SetBranchAddress(*port,tree3,"spt_angle_drift", &spt_angle_drift);
+	  SetBranchAddress(*port,tree3,"spt_angle_drift_1", &spt_angle_drift_1);
+	  SetBranchAddress(*port,tree3,"spt_num_valid_tracks", &spt_num_valid_tracks);
+	  SetBranchAddress(*port,tree3,"spt_n_vtx_segs", &spt_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"spt_max_length", &spt_max_length);
 
 
 	  float stem_len_flag;
@@ -1104,12 +1144,12 @@ if(f_BDTport){
 	  float stem_len_flag_avoid_muon_check;
 	  float stem_len_num_daughters;
 	  float stem_len_daughter_length;
-	  tree3->SetBranchAddress("stem_len_flag", &stem_len_flag);
-	  tree3->SetBranchAddress("stem_len_energy", &stem_len_energy);
-	  tree3->SetBranchAddress("stem_len_length", &stem_len_length);
-	  tree3->SetBranchAddress("stem_len_flag_avoid_muon_check", &stem_len_flag_avoid_muon_check);
-	  tree3->SetBranchAddress("stem_len_num_daughters", &stem_len_num_daughters);
-	  tree3->SetBranchAddress("stem_len_daughter_length", &stem_len_daughter_length);
+	  SetBranchAddress(*port,tree3,"stem_len_flag", &stem_len_flag);
+	  SetBranchAddress(*port,tree3,"stem_len_energy", &stem_len_energy);
+	  SetBranchAddress(*port,tree3,"stem_len_length", &stem_len_length);
+	  SetBranchAddress(*port,tree3,"stem_len_flag_avoid_muon_check", &stem_len_flag_avoid_muon_check);
+	  SetBranchAddress(*port,tree3,"stem_len_num_daughters", &stem_len_num_daughters);
+	  SetBranchAddress(*port,tree3,"stem_len_daughter_length", &stem_len_daughter_length);
 
 
 	  float lem_flag;
@@ -1120,14 +1160,14 @@ if(f_BDTport){
 	  float lem_e_dQdx;
 	  float lem_shower_num_segs;
 	  float lem_shower_num_main_segs;
-	  tree3->SetBranchAddress("lem_flag",&lem_flag);
-	  tree3->SetBranchAddress("lem_shower_total_length",&lem_shower_total_length);
-	  tree3->SetBranchAddress("lem_shower_main_length",&lem_shower_main_length);
-	  tree3->SetBranchAddress("lem_n_3seg",&lem_n_3seg);
-	  tree3->SetBranchAddress("lem_e_charge",&lem_e_charge);
-	  tree3->SetBranchAddress("lem_e_dQdx",&lem_e_dQdx);
-	  tree3->SetBranchAddress("lem_shower_num_segs",&lem_shower_num_segs);
-	  tree3->SetBranchAddress("lem_shower_num_main_segs",&lem_shower_num_main_segs);
+	  SetBranchAddress(*port,tree3,"lem_flag",&lem_flag);
+	  SetBranchAddress(*port,tree3,"lem_shower_total_length",&lem_shower_total_length);
+	  SetBranchAddress(*port,tree3,"lem_shower_main_length",&lem_shower_main_length);
+	  SetBranchAddress(*port,tree3,"lem_n_3seg",&lem_n_3seg);
+	  SetBranchAddress(*port,tree3,"lem_e_charge",&lem_e_charge);
+	  SetBranchAddress(*port,tree3,"lem_e_dQdx",&lem_e_dQdx);
+	  SetBranchAddress(*port,tree3,"lem_shower_num_segs",&lem_shower_num_segs);
+	  SetBranchAddress(*port,tree3,"lem_shower_num_main_segs",&lem_shower_num_main_segs);
 
 
 	  float brm_flag;
@@ -1141,17 +1181,17 @@ if(f_BDTport){
 	  float brm_acc_direct_length;
 	  float brm_n_shower_main_segs;
 	  float brm_n_mu_main;
-	  tree3->SetBranchAddress("brm_flag",&brm_flag);
-	  tree3->SetBranchAddress("brm_n_mu_segs",&brm_n_mu_segs);
-	  tree3->SetBranchAddress("brm_Ep",&brm_Ep);
-	  tree3->SetBranchAddress("brm_energy",&brm_energy);
-	  tree3->SetBranchAddress("brm_acc_length",&brm_acc_length);
-	  tree3->SetBranchAddress("brm_shower_total_length",&brm_shower_total_length);
-	  tree3->SetBranchAddress("brm_connected_length",&brm_connected_length);
-	  tree3->SetBranchAddress("brm_n_size",&brm_n_size);
-	  tree3->SetBranchAddress("brm_acc_direct_length",&brm_acc_direct_length);
-	  tree3->SetBranchAddress("brm_n_shower_main_segs",&brm_n_shower_main_segs);
-	  tree3->SetBranchAddress("brm_n_mu_main",&brm_n_mu_main);
+	  SetBranchAddress(*port,tree3,"brm_flag",&brm_flag);
+	  SetBranchAddress(*port,tree3,"brm_n_mu_segs",&brm_n_mu_segs);
+	  SetBranchAddress(*port,tree3,"brm_Ep",&brm_Ep);
+	  SetBranchAddress(*port,tree3,"brm_energy",&brm_energy);
+	  SetBranchAddress(*port,tree3,"brm_acc_length",&brm_acc_length);
+	  SetBranchAddress(*port,tree3,"brm_shower_total_length",&brm_shower_total_length);
+	  SetBranchAddress(*port,tree3,"brm_connected_length",&brm_connected_length);
+	  SetBranchAddress(*port,tree3,"brm_n_size",&brm_n_size);
+	  SetBranchAddress(*port,tree3,"brm_acc_direct_length",&brm_acc_direct_length);
+	  SetBranchAddress(*port,tree3,"brm_n_shower_main_segs",&brm_n_shower_main_segs);
+	  SetBranchAddress(*port,tree3,"brm_n_mu_main",&brm_n_mu_main);
 
 
 	  float cme_flag;
@@ -1160,12 +1200,12 @@ if(f_BDTport){
 	  float cme_mu_length;
 	  float cme_length;
 	  float cme_angle_beam;
-	  tree3->SetBranchAddress("cme_flag",&cme_flag);
-	  tree3->SetBranchAddress("cme_mu_energy",&cme_mu_energy);
-	  tree3->SetBranchAddress("cme_energy",&cme_energy);
-	  tree3->SetBranchAddress("cme_mu_length",&cme_mu_length);
-	  tree3->SetBranchAddress("cme_length",&cme_length);
-	  tree3->SetBranchAddress("cme_angle_beam",&cme_angle_beam);
+	  SetBranchAddress(*port,tree3,"cme_flag",&cme_flag);
+	  SetBranchAddress(*port,tree3,"cme_mu_energy",&cme_mu_energy);
+	  SetBranchAddress(*port,tree3,"cme_energy",&cme_energy);
+	  SetBranchAddress(*port,tree3,"cme_mu_length",&cme_mu_length);
+	  SetBranchAddress(*port,tree3,"cme_length",&cme_length);
+	  SetBranchAddress(*port,tree3,"cme_angle_beam",&cme_angle_beam);
 
 
 	  float anc_flag;
@@ -1179,17 +1219,17 @@ if(f_BDTport){
 	  float anc_shower_main_length;
 	  float anc_shower_total_length;
 	  float anc_flag_main_outside;
-	  tree3->SetBranchAddress("anc_flag",&anc_flag);
-	  tree3->SetBranchAddress("anc_energy",&anc_energy);
-	  tree3->SetBranchAddress("anc_angle",&anc_angle);
-	  tree3->SetBranchAddress("anc_max_angle",&anc_max_angle);
-	  tree3->SetBranchAddress("anc_max_length",&anc_max_length);
-	  tree3->SetBranchAddress("anc_acc_forward_length",&anc_acc_forward_length);
-	  tree3->SetBranchAddress("anc_acc_backward_length",&anc_acc_backward_length);
-	  tree3->SetBranchAddress("anc_acc_forward_length1",&anc_acc_forward_length1);
-	  tree3->SetBranchAddress("anc_shower_main_length",&anc_shower_main_length);
-	  tree3->SetBranchAddress("anc_shower_total_length",&anc_shower_total_length);
-	  tree3->SetBranchAddress("anc_flag_main_outside",&anc_flag_main_outside);
+	  SetBranchAddress(*port,tree3,"anc_flag",&anc_flag);
+	  SetBranchAddress(*port,tree3,"anc_energy",&anc_energy);
+	  SetBranchAddress(*port,tree3,"anc_angle",&anc_angle);
+	  SetBranchAddress(*port,tree3,"anc_max_angle",&anc_max_angle);
+	  SetBranchAddress(*port,tree3,"anc_max_length",&anc_max_length);
+	  SetBranchAddress(*port,tree3,"anc_acc_forward_length",&anc_acc_forward_length);
+	  SetBranchAddress(*port,tree3,"anc_acc_backward_length",&anc_acc_backward_length);
+	  SetBranchAddress(*port,tree3,"anc_acc_forward_length1",&anc_acc_forward_length1);
+	  SetBranchAddress(*port,tree3,"anc_shower_main_length",&anc_shower_main_length);
+	  SetBranchAddress(*port,tree3,"anc_shower_total_length",&anc_shower_total_length);
+	  SetBranchAddress(*port,tree3,"anc_flag_main_outside",&anc_flag_main_outside);
 
 
 	  float stem_dir_filled;
@@ -1201,15 +1241,15 @@ if(f_BDTport){
 	  float stem_dir_angle2;
 	  float stem_dir_angle3;
 	  float stem_dir_ratio;
-	  tree3->SetBranchAddress("stem_dir_filled",&stem_dir_filled);
-	  tree3->SetBranchAddress("stem_dir_flag",&stem_dir_flag);
-	  tree3->SetBranchAddress("stem_dir_flag_single_shower",&stem_dir_flag_single_shower);
-	  tree3->SetBranchAddress("stem_dir_angle",&stem_dir_angle);
-	  tree3->SetBranchAddress("stem_dir_energy",&stem_dir_energy);
-	  tree3->SetBranchAddress("stem_dir_angle1",&stem_dir_angle1);
-	  tree3->SetBranchAddress("stem_dir_angle2",&stem_dir_angle2);
-	  tree3->SetBranchAddress("stem_dir_angle3",&stem_dir_angle3);
-	  tree3->SetBranchAddress("stem_dir_ratio",&stem_dir_ratio);
+	  SetBranchAddress(*port,tree3,"stem_dir_filled",&stem_dir_filled);
+	  SetBranchAddress(*port,tree3,"stem_dir_flag",&stem_dir_flag);
+	  SetBranchAddress(*port,tree3,"stem_dir_flag_single_shower",&stem_dir_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"stem_dir_angle",&stem_dir_angle);
+	  SetBranchAddress(*port,tree3,"stem_dir_energy",&stem_dir_energy);
+	  SetBranchAddress(*port,tree3,"stem_dir_angle1",&stem_dir_angle1);
+	  SetBranchAddress(*port,tree3,"stem_dir_angle2",&stem_dir_angle2);
+	  SetBranchAddress(*port,tree3,"stem_dir_angle3",&stem_dir_angle3);
+	  SetBranchAddress(*port,tree3,"stem_dir_ratio",&stem_dir_ratio);
 
 
 	  float vis_flag;
@@ -1236,30 +1276,30 @@ if(f_BDTport){
 	  float vis_2_sg_length;
 	  float vis_2_max_angle;
 	  float vis_2_max_weak_track;
-	  tree3->SetBranchAddress("vis_flag",&vis_flag);
-	  tree3->SetBranchAddress("vis_1_filled",&vis_1_filled);
-	  tree3->SetBranchAddress("vis_1_flag",&vis_1_flag);
-	  tree3->SetBranchAddress("vis_1_n_vtx_segs",&vis_1_n_vtx_segs);
-	  tree3->SetBranchAddress("vis_1_energy",&vis_1_energy);
-	  tree3->SetBranchAddress("vis_1_num_good_tracks",&vis_1_num_good_tracks);
-	  tree3->SetBranchAddress("vis_1_max_angle",&vis_1_max_angle);
-	  tree3->SetBranchAddress("vis_1_max_shower_angle",&vis_1_max_shower_angle);
-	  tree3->SetBranchAddress("vis_1_tmp_length1",&vis_1_tmp_length1);
-	  tree3->SetBranchAddress("vis_1_tmp_length2",&vis_1_tmp_length2);
-	  tree3->SetBranchAddress("vis_1_particle_type",&vis_1_particle_type);
-	  tree3->SetBranchAddress("vis_2_filled",&vis_2_filled);
-	  tree3->SetBranchAddress("vis_2_flag",&vis_2_flag);
-	  tree3->SetBranchAddress("vis_2_n_vtx_segs",&vis_2_n_vtx_segs);
-	  tree3->SetBranchAddress("vis_2_min_angle",&vis_2_min_angle);
-	  tree3->SetBranchAddress("vis_2_min_weak_track",&vis_2_min_weak_track);
-	  tree3->SetBranchAddress("vis_2_angle_beam",&vis_2_angle_beam);
-	  tree3->SetBranchAddress("vis_2_min_angle1",&vis_2_min_angle1);
-	  tree3->SetBranchAddress("vis_2_iso_angle1",&vis_2_iso_angle1);
-	  tree3->SetBranchAddress("vis_2_min_medium_dQ_dx",&vis_2_min_medium_dQ_dx);
-	  tree3->SetBranchAddress("vis_2_min_length",&vis_2_min_length);
-	  tree3->SetBranchAddress("vis_2_sg_length",&vis_2_sg_length);
-	  tree3->SetBranchAddress("vis_2_max_angle",&vis_2_max_angle);
-	  tree3->SetBranchAddress("vis_2_max_weak_track",&vis_2_max_weak_track);
+	  SetBranchAddress(*port,tree3,"vis_flag",&vis_flag);
+	  SetBranchAddress(*port,tree3,"vis_1_filled",&vis_1_filled);
+	  SetBranchAddress(*port,tree3,"vis_1_flag",&vis_1_flag);
+	  SetBranchAddress(*port,tree3,"vis_1_n_vtx_segs",&vis_1_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"vis_1_energy",&vis_1_energy);
+	  SetBranchAddress(*port,tree3,"vis_1_num_good_tracks",&vis_1_num_good_tracks);
+	  SetBranchAddress(*port,tree3,"vis_1_max_angle",&vis_1_max_angle);
+	  SetBranchAddress(*port,tree3,"vis_1_max_shower_angle",&vis_1_max_shower_angle);
+	  SetBranchAddress(*port,tree3,"vis_1_tmp_length1",&vis_1_tmp_length1);
+	  SetBranchAddress(*port,tree3,"vis_1_tmp_length2",&vis_1_tmp_length2);
+	  SetBranchAddress(*port,tree3,"vis_1_particle_type",&vis_1_particle_type);
+	  SetBranchAddress(*port,tree3,"vis_2_filled",&vis_2_filled);
+	  SetBranchAddress(*port,tree3,"vis_2_flag",&vis_2_flag);
+	  SetBranchAddress(*port,tree3,"vis_2_n_vtx_segs",&vis_2_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"vis_2_min_angle",&vis_2_min_angle);
+	  SetBranchAddress(*port,tree3,"vis_2_min_weak_track",&vis_2_min_weak_track);
+	  SetBranchAddress(*port,tree3,"vis_2_angle_beam",&vis_2_angle_beam);
+	  SetBranchAddress(*port,tree3,"vis_2_min_angle1",&vis_2_min_angle1);
+	  SetBranchAddress(*port,tree3,"vis_2_iso_angle1",&vis_2_iso_angle1);
+	  SetBranchAddress(*port,tree3,"vis_2_min_medium_dQ_dx",&vis_2_min_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"vis_2_min_length",&vis_2_min_length);
+	  SetBranchAddress(*port,tree3,"vis_2_sg_length",&vis_2_sg_length);
+	  SetBranchAddress(*port,tree3,"vis_2_max_angle",&vis_2_max_angle);
+	  SetBranchAddress(*port,tree3,"vis_2_max_weak_track",&vis_2_max_weak_track);
 
 
 	  float br_filled;
@@ -1290,34 +1330,34 @@ if(f_BDTport){
 	  float br1_3_flag_sg_trajectory;
 	  float br1_3_n_shower_main_segs;
 	  float br1_3_sg_length;
-	  tree3->SetBranchAddress("br_filled",&br_filled);
-	  tree3->SetBranchAddress("br1_flag",&br1_flag);
-	  tree3->SetBranchAddress("br1_1_flag",&br1_1_flag);
-	  tree3->SetBranchAddress("br1_1_shower_type",&br1_1_shower_type);
-	  tree3->SetBranchAddress("br1_1_vtx_n_segs",&br1_1_vtx_n_segs);
-	  tree3->SetBranchAddress("br1_1_energy",&br1_1_energy);
-	  tree3->SetBranchAddress("br1_1_n_segs",&br1_1_n_segs);
-	  tree3->SetBranchAddress("br1_1_flag_sg_topology",&br1_1_flag_sg_topology);
-	  tree3->SetBranchAddress("br1_1_flag_sg_trajectory",&br1_1_flag_sg_trajectory);
-	  tree3->SetBranchAddress("br1_1_sg_length",&br1_1_sg_length);
-	  tree3->SetBranchAddress("br1_2_flag",&br1_2_flag);
-	  tree3->SetBranchAddress("br1_2_energy",&br1_2_energy);
-	  tree3->SetBranchAddress("br1_2_n_connected",&br1_2_n_connected);
-	  tree3->SetBranchAddress("br1_2_max_length",&br1_2_max_length);
-	  tree3->SetBranchAddress("br1_2_n_connected_1",&br1_2_n_connected_1);
-	  tree3->SetBranchAddress("br1_2_vtx_n_segs",&br1_2_vtx_n_segs);
-	  tree3->SetBranchAddress("br1_2_n_shower_segs",&br1_2_n_shower_segs);
-	  tree3->SetBranchAddress("br1_2_max_length_ratio",&br1_2_max_length_ratio);
-	  tree3->SetBranchAddress("br1_2_shower_length",&br1_2_shower_length);
-	  tree3->SetBranchAddress("br1_3_flag",&br1_3_flag);
-	  tree3->SetBranchAddress("br1_3_energy",&br1_3_energy);
-	  tree3->SetBranchAddress("br1_3_n_connected_p",&br1_3_n_connected_p);
-	  tree3->SetBranchAddress("br1_3_max_length_p",&br1_3_max_length_p);
-	  tree3->SetBranchAddress("br1_3_n_shower_segs",&br1_3_n_shower_segs);
-	  tree3->SetBranchAddress("br1_3_flag_sg_topology",&br1_3_flag_sg_topology);
-	  tree3->SetBranchAddress("br1_3_flag_sg_trajectory",&br1_3_flag_sg_trajectory);
-	  tree3->SetBranchAddress("br1_3_n_shower_main_segs",&br1_3_n_shower_main_segs);
-	  tree3->SetBranchAddress("br1_3_sg_length",&br1_3_sg_length);
+	  SetBranchAddress(*port,tree3,"br_filled",&br_filled);
+	  SetBranchAddress(*port,tree3,"br1_flag",&br1_flag);
+	  SetBranchAddress(*port,tree3,"br1_1_flag",&br1_1_flag);
+	  SetBranchAddress(*port,tree3,"br1_1_shower_type",&br1_1_shower_type);
+	  SetBranchAddress(*port,tree3,"br1_1_vtx_n_segs",&br1_1_vtx_n_segs);
+	  SetBranchAddress(*port,tree3,"br1_1_energy",&br1_1_energy);
+	  SetBranchAddress(*port,tree3,"br1_1_n_segs",&br1_1_n_segs);
+	  SetBranchAddress(*port,tree3,"br1_1_flag_sg_topology",&br1_1_flag_sg_topology);
+	  SetBranchAddress(*port,tree3,"br1_1_flag_sg_trajectory",&br1_1_flag_sg_trajectory);
+	  SetBranchAddress(*port,tree3,"br1_1_sg_length",&br1_1_sg_length);
+	  SetBranchAddress(*port,tree3,"br1_2_flag",&br1_2_flag);
+	  SetBranchAddress(*port,tree3,"br1_2_energy",&br1_2_energy);
+	  SetBranchAddress(*port,tree3,"br1_2_n_connected",&br1_2_n_connected);
+	  SetBranchAddress(*port,tree3,"br1_2_max_length",&br1_2_max_length);
+	  SetBranchAddress(*port,tree3,"br1_2_n_connected_1",&br1_2_n_connected_1);
+	  SetBranchAddress(*port,tree3,"br1_2_vtx_n_segs",&br1_2_vtx_n_segs);
+	  SetBranchAddress(*port,tree3,"br1_2_n_shower_segs",&br1_2_n_shower_segs);
+	  SetBranchAddress(*port,tree3,"br1_2_max_length_ratio",&br1_2_max_length_ratio);
+	  SetBranchAddress(*port,tree3,"br1_2_shower_length",&br1_2_shower_length);
+	  SetBranchAddress(*port,tree3,"br1_3_flag",&br1_3_flag);
+	  SetBranchAddress(*port,tree3,"br1_3_energy",&br1_3_energy);
+	  SetBranchAddress(*port,tree3,"br1_3_n_connected_p",&br1_3_n_connected_p);
+	  SetBranchAddress(*port,tree3,"br1_3_max_length_p",&br1_3_max_length_p);
+	  SetBranchAddress(*port,tree3,"br1_3_n_shower_segs",&br1_3_n_shower_segs);
+	  SetBranchAddress(*port,tree3,"br1_3_flag_sg_topology",&br1_3_flag_sg_topology);
+	  SetBranchAddress(*port,tree3,"br1_3_flag_sg_trajectory",&br1_3_flag_sg_trajectory);
+	  SetBranchAddress(*port,tree3,"br1_3_n_shower_main_segs",&br1_3_n_shower_main_segs);
+	  SetBranchAddress(*port,tree3,"br1_3_sg_length",&br1_3_sg_length);
 
 
 	  float br2_flag;
@@ -1332,18 +1372,18 @@ if(f_BDTport){
 	  float br2_max_angle;
 	  float br2_sg_length;
 	  float br2_flag_sg_trajectory;
-	  tree3->SetBranchAddress("br2_flag",&br2_flag);
-	  tree3->SetBranchAddress("br2_flag_single_shower",&br2_flag_single_shower);
-	  tree3->SetBranchAddress("br2_num_valid_tracks",&br2_num_valid_tracks);
-	  tree3->SetBranchAddress("br2_energy",&br2_energy);
-	  tree3->SetBranchAddress("br2_angle1",&br2_angle1);
-	  tree3->SetBranchAddress("br2_angle2",&br2_angle2);
-	  tree3->SetBranchAddress("br2_angle",&br2_angle);
-	  tree3->SetBranchAddress("br2_angle3",&br2_angle3);
-	  tree3->SetBranchAddress("br2_n_shower_main_segs",&br2_n_shower_main_segs);
-	  tree3->SetBranchAddress("br2_max_angle",&br2_max_angle);
-	  tree3->SetBranchAddress("br2_sg_length",&br2_sg_length);
-	  tree3->SetBranchAddress("br2_flag_sg_trajectory",&br2_flag_sg_trajectory);
+	  SetBranchAddress(*port,tree3,"br2_flag",&br2_flag);
+	  SetBranchAddress(*port,tree3,"br2_flag_single_shower",&br2_flag_single_shower);
+	  SetBranchAddress(*port,tree3,"br2_num_valid_tracks",&br2_num_valid_tracks);
+	  SetBranchAddress(*port,tree3,"br2_energy",&br2_energy);
+	  SetBranchAddress(*port,tree3,"br2_angle1",&br2_angle1);
+	  SetBranchAddress(*port,tree3,"br2_angle2",&br2_angle2);
+	  SetBranchAddress(*port,tree3,"br2_angle",&br2_angle);
+	  SetBranchAddress(*port,tree3,"br2_angle3",&br2_angle3);
+	  SetBranchAddress(*port,tree3,"br2_n_shower_main_segs",&br2_n_shower_main_segs);
+	  SetBranchAddress(*port,tree3,"br2_max_angle",&br2_max_angle);
+	  SetBranchAddress(*port,tree3,"br2_sg_length",&br2_sg_length);
+	  SetBranchAddress(*port,tree3,"br2_flag_sg_trajectory",&br2_flag_sg_trajectory);
 
 
 	  float br3_flag;
@@ -1404,64 +1444,64 @@ if(f_BDTport){
 	  float br3_8_n_main_segs;
 	  float br3_8_shower_main_length;
 	  float br3_8_shower_length;
-	  tree3->SetBranchAddress("br3_flag",&br3_flag);
-	  tree3->SetBranchAddress("br3_1_flag",&br3_1_flag);
-	  tree3->SetBranchAddress("br3_1_energy",&br3_1_energy);
-	  tree3->SetBranchAddress("br3_1_n_shower_segments",&br3_1_n_shower_segments);
-	  tree3->SetBranchAddress("br3_1_sg_flag_trajectory",&br3_1_sg_flag_trajectory);
-	  tree3->SetBranchAddress("br3_1_sg_direct_length",&br3_1_sg_direct_length);
-	  tree3->SetBranchAddress("br3_1_sg_length",&br3_1_sg_length);
-	  tree3->SetBranchAddress("br3_1_total_main_length",&br3_1_total_main_length);
-	  tree3->SetBranchAddress("br3_1_total_length",&br3_1_total_length);
-	  tree3->SetBranchAddress("br3_1_iso_angle",&br3_1_iso_angle);
-	  tree3->SetBranchAddress("br3_1_sg_flag_topology",&br3_1_sg_flag_topology);
-	  tree3->SetBranchAddress("br3_2_flag",&br3_2_flag);
-	  tree3->SetBranchAddress("br3_2_n_ele",&br3_2_n_ele);
-	  tree3->SetBranchAddress("br3_2_n_other",&br3_2_n_other);
-	  tree3->SetBranchAddress("br3_2_energy",&br3_2_energy);
-	  tree3->SetBranchAddress("br3_2_total_main_length",&br3_2_total_main_length);
-	  tree3->SetBranchAddress("br3_2_total_length",&br3_2_total_length);
-	  tree3->SetBranchAddress("br3_2_other_fid",&br3_2_other_fid);
-	  tree3->SetBranchAddress("br3_3_v_flag",&br3_3_v_flag);
-	  tree3->SetBranchAddress("br3_3_v_energy",&br3_3_v_energy);
-	  tree3->SetBranchAddress("br3_3_v_angle",&br3_3_v_angle);
-	  tree3->SetBranchAddress("br3_3_v_dir_length",&br3_3_v_dir_length);
-	  tree3->SetBranchAddress("br3_3_v_length",&br3_3_v_length);
-	  tree3->SetBranchAddress("br3_4_flag", &br3_4_flag);
-	  tree3->SetBranchAddress("br3_4_acc_length", &br3_4_acc_length);
-	  tree3->SetBranchAddress("br3_4_total_length", &br3_4_total_length);
-	  tree3->SetBranchAddress("br3_4_energy", &br3_4_energy);
-	  tree3->SetBranchAddress("br3_5_v_flag", &br3_5_v_flag);
-	  tree3->SetBranchAddress("br3_5_v_dir_length", &br3_5_v_dir_length);
-	  tree3->SetBranchAddress("br3_5_v_total_length", &br3_5_v_total_length);
-	  tree3->SetBranchAddress("br3_5_v_flag_avoid_muon_check", &br3_5_v_flag_avoid_muon_check);
-	  tree3->SetBranchAddress("br3_5_v_n_seg", &br3_5_v_n_seg);
-	  tree3->SetBranchAddress("br3_5_v_angle", &br3_5_v_angle);
-	  tree3->SetBranchAddress("br3_5_v_sg_length", &br3_5_v_sg_length);
-	  tree3->SetBranchAddress("br3_5_v_energy", &br3_5_v_energy);
-	  tree3->SetBranchAddress("br3_5_v_n_main_segs", &br3_5_v_n_main_segs);
-	  tree3->SetBranchAddress("br3_5_v_n_segs", &br3_5_v_n_segs);
-	  tree3->SetBranchAddress("br3_5_v_shower_main_length", &br3_5_v_shower_main_length);
-	  tree3->SetBranchAddress("br3_5_v_shower_total_length", &br3_5_v_shower_total_length);
-	  tree3->SetBranchAddress("br3_6_v_flag",&br3_6_v_flag);
-	  tree3->SetBranchAddress("br3_6_v_angle",&br3_6_v_angle);
-	  tree3->SetBranchAddress("br3_6_v_angle1",&br3_6_v_angle1);
-	  tree3->SetBranchAddress("br3_6_v_flag_shower_trajectory",&br3_6_v_flag_shower_trajectory);
-	  tree3->SetBranchAddress("br3_6_v_direct_length",&br3_6_v_direct_length);
-	  tree3->SetBranchAddress("br3_6_v_length",&br3_6_v_length);
-	  tree3->SetBranchAddress("br3_6_v_n_other_vtx_segs",&br3_6_v_n_other_vtx_segs);
-	  tree3->SetBranchAddress("br3_6_v_energy",&br3_6_v_energy);
-	  tree3->SetBranchAddress("br3_7_flag",&br3_7_flag);
-	  tree3->SetBranchAddress("br3_7_energy",&br3_7_energy);
-	  tree3->SetBranchAddress("br3_7_min_angle",&br3_7_min_angle);
-	  tree3->SetBranchAddress("br3_7_sg_length",&br3_7_sg_length);
-	  tree3->SetBranchAddress("br3_7_main_length",&br3_7_shower_main_length);
-	  tree3->SetBranchAddress("br3_8_flag",&br3_8_flag);
-	  tree3->SetBranchAddress("br3_8_max_dQ_dx",&br3_8_max_dQ_dx);
-	  tree3->SetBranchAddress("br3_8_energy",&br3_8_energy);
-	  tree3->SetBranchAddress("br3_8_n_main_segs",&br3_8_n_main_segs);
-	  tree3->SetBranchAddress("br3_8_shower_main_length",&br3_8_shower_main_length);
-	  tree3->SetBranchAddress("br3_8_shower_length",&br3_8_shower_length);
+	  SetBranchAddress(*port,tree3,"br3_flag",&br3_flag);
+	  SetBranchAddress(*port,tree3,"br3_1_flag",&br3_1_flag);
+	  SetBranchAddress(*port,tree3,"br3_1_energy",&br3_1_energy);
+	  SetBranchAddress(*port,tree3,"br3_1_n_shower_segments",&br3_1_n_shower_segments);
+	  SetBranchAddress(*port,tree3,"br3_1_sg_flag_trajectory",&br3_1_sg_flag_trajectory);
+	  SetBranchAddress(*port,tree3,"br3_1_sg_direct_length",&br3_1_sg_direct_length);
+	  SetBranchAddress(*port,tree3,"br3_1_sg_length",&br3_1_sg_length);
+	  SetBranchAddress(*port,tree3,"br3_1_total_main_length",&br3_1_total_main_length);
+	  SetBranchAddress(*port,tree3,"br3_1_total_length",&br3_1_total_length);
+	  SetBranchAddress(*port,tree3,"br3_1_iso_angle",&br3_1_iso_angle);
+	  SetBranchAddress(*port,tree3,"br3_1_sg_flag_topology",&br3_1_sg_flag_topology);
+	  SetBranchAddress(*port,tree3,"br3_2_flag",&br3_2_flag);
+	  SetBranchAddress(*port,tree3,"br3_2_n_ele",&br3_2_n_ele);
+	  SetBranchAddress(*port,tree3,"br3_2_n_other",&br3_2_n_other);
+	  SetBranchAddress(*port,tree3,"br3_2_energy",&br3_2_energy);
+	  SetBranchAddress(*port,tree3,"br3_2_total_main_length",&br3_2_total_main_length);
+	  SetBranchAddress(*port,tree3,"br3_2_total_length",&br3_2_total_length);
+	  SetBranchAddress(*port,tree3,"br3_2_other_fid",&br3_2_other_fid);
+	  SetBranchAddress(*port,tree3,"br3_3_v_flag",&br3_3_v_flag);
+	  SetBranchAddress(*port,tree3,"br3_3_v_energy",&br3_3_v_energy);
+	  SetBranchAddress(*port,tree3,"br3_3_v_angle",&br3_3_v_angle);
+	  SetBranchAddress(*port,tree3,"br3_3_v_dir_length",&br3_3_v_dir_length);
+	  SetBranchAddress(*port,tree3,"br3_3_v_length",&br3_3_v_length);
+	  SetBranchAddress(*port,tree3,"br3_4_flag", &br3_4_flag);
+	  SetBranchAddress(*port,tree3,"br3_4_acc_length", &br3_4_acc_length);
+	  SetBranchAddress(*port,tree3,"br3_4_total_length", &br3_4_total_length);
+	  SetBranchAddress(*port,tree3,"br3_4_energy", &br3_4_energy);
+	  SetBranchAddress(*port,tree3,"br3_5_v_flag", &br3_5_v_flag);
+	  SetBranchAddress(*port,tree3,"br3_5_v_dir_length", &br3_5_v_dir_length);
+	  SetBranchAddress(*port,tree3,"br3_5_v_total_length", &br3_5_v_total_length);
+	  SetBranchAddress(*port,tree3,"br3_5_v_flag_avoid_muon_check", &br3_5_v_flag_avoid_muon_check);
+	  SetBranchAddress(*port,tree3,"br3_5_v_n_seg", &br3_5_v_n_seg);
+	  SetBranchAddress(*port,tree3,"br3_5_v_angle", &br3_5_v_angle);
+	  SetBranchAddress(*port,tree3,"br3_5_v_sg_length", &br3_5_v_sg_length);
+	  SetBranchAddress(*port,tree3,"br3_5_v_energy", &br3_5_v_energy);
+	  SetBranchAddress(*port,tree3,"br3_5_v_n_main_segs", &br3_5_v_n_main_segs);
+	  SetBranchAddress(*port,tree3,"br3_5_v_n_segs", &br3_5_v_n_segs);
+	  SetBranchAddress(*port,tree3,"br3_5_v_shower_main_length", &br3_5_v_shower_main_length);
+	  SetBranchAddress(*port,tree3,"br3_5_v_shower_total_length", &br3_5_v_shower_total_length);
+	  SetBranchAddress(*port,tree3,"br3_6_v_flag",&br3_6_v_flag);
+	  SetBranchAddress(*port,tree3,"br3_6_v_angle",&br3_6_v_angle);
+	  SetBranchAddress(*port,tree3,"br3_6_v_angle1",&br3_6_v_angle1);
+	  SetBranchAddress(*port,tree3,"br3_6_v_flag_shower_trajectory",&br3_6_v_flag_shower_trajectory);
+	  SetBranchAddress(*port,tree3,"br3_6_v_direct_length",&br3_6_v_direct_length);
+	  SetBranchAddress(*port,tree3,"br3_6_v_length",&br3_6_v_length);
+	  SetBranchAddress(*port,tree3,"br3_6_v_n_other_vtx_segs",&br3_6_v_n_other_vtx_segs);
+	  SetBranchAddress(*port,tree3,"br3_6_v_energy",&br3_6_v_energy);
+	  SetBranchAddress(*port,tree3,"br3_7_flag",&br3_7_flag);
+	  SetBranchAddress(*port,tree3,"br3_7_energy",&br3_7_energy);
+	  SetBranchAddress(*port,tree3,"br3_7_min_angle",&br3_7_min_angle);
+	  SetBranchAddress(*port,tree3,"br3_7_sg_length",&br3_7_sg_length);
+	  SetBranchAddress(*port,tree3,"br3_7_main_length",&br3_7_shower_main_length);
+	  SetBranchAddress(*port,tree3,"br3_8_flag",&br3_8_flag);
+	  SetBranchAddress(*port,tree3,"br3_8_max_dQ_dx",&br3_8_max_dQ_dx);
+	  SetBranchAddress(*port,tree3,"br3_8_energy",&br3_8_energy);
+	  SetBranchAddress(*port,tree3,"br3_8_n_main_segs",&br3_8_n_main_segs);
+	  SetBranchAddress(*port,tree3,"br3_8_shower_main_length",&br3_8_shower_main_length);
+	  SetBranchAddress(*port,tree3,"br3_8_shower_length",&br3_8_shower_length);
 
 
 	  float br4_flag;
@@ -1486,28 +1526,28 @@ if(f_BDTport){
 	  float br4_2_iso_angle;
 	  float br4_2_iso_angle1;
 	  float br4_2_angle;
-	  tree3->SetBranchAddress("br4_flag", &br4_flag);
-	  tree3->SetBranchAddress("br4_1_flag", &br4_1_flag);
-	  tree3->SetBranchAddress("br4_1_shower_main_length", &br4_1_shower_main_length);
-	  tree3->SetBranchAddress("br4_1_shower_total_length", &br4_1_shower_total_length);
-	  tree3->SetBranchAddress("br4_1_min_dis", &br4_1_min_dis);
-	  tree3->SetBranchAddress("br4_1_energy", &br4_1_energy);
-	  tree3->SetBranchAddress("br4_1_flag_avoid_muon_check", &br4_1_flag_avoid_muon_check);
-	  tree3->SetBranchAddress("br4_1_n_vtx_segs", &br4_1_n_vtx_segs);
-	  tree3->SetBranchAddress("br4_1_n_main_segs", &br4_1_n_main_segs);
-	  tree3->SetBranchAddress("br4_2_flag", &br4_2_flag);
-	  tree3->SetBranchAddress("br4_2_ratio_45", &br4_2_ratio_45);
-	  tree3->SetBranchAddress("br4_2_ratio_35", &br4_2_ratio_35);
-	  tree3->SetBranchAddress("br4_2_ratio_25", &br4_2_ratio_25);
-	  tree3->SetBranchAddress("br4_2_ratio_15", &br4_2_ratio_15);
-	  tree3->SetBranchAddress("br4_2_energy",   &br4_2_energy);
-	  tree3->SetBranchAddress("br4_2_ratio1_45", &br4_2_ratio1_45);
-	  tree3->SetBranchAddress("br4_2_ratio1_35", &br4_2_ratio1_35);
-	  tree3->SetBranchAddress("br4_2_ratio1_25", &br4_2_ratio1_25);
-	  tree3->SetBranchAddress("br4_2_ratio1_15", &br4_2_ratio1_15);
-	  tree3->SetBranchAddress("br4_2_iso_angle", &br4_2_iso_angle);
-	  tree3->SetBranchAddress("br4_2_iso_angle1", &br4_2_iso_angle1);
-	  tree3->SetBranchAddress("br4_2_angle", &br4_2_angle);
+	  SetBranchAddress(*port,tree3,"br4_flag", &br4_flag);
+	  SetBranchAddress(*port,tree3,"br4_1_flag", &br4_1_flag);
+	  SetBranchAddress(*port,tree3,"br4_1_shower_main_length", &br4_1_shower_main_length);
+	  SetBranchAddress(*port,tree3,"br4_1_shower_total_length", &br4_1_shower_total_length);
+	  SetBranchAddress(*port,tree3,"br4_1_min_dis", &br4_1_min_dis);
+	  SetBranchAddress(*port,tree3,"br4_1_energy", &br4_1_energy);
+	  SetBranchAddress(*port,tree3,"br4_1_flag_avoid_muon_check", &br4_1_flag_avoid_muon_check);
+	  SetBranchAddress(*port,tree3,"br4_1_n_vtx_segs", &br4_1_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"br4_1_n_main_segs", &br4_1_n_main_segs);
+	  SetBranchAddress(*port,tree3,"br4_2_flag", &br4_2_flag);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio_45", &br4_2_ratio_45);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio_35", &br4_2_ratio_35);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio_25", &br4_2_ratio_25);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio_15", &br4_2_ratio_15);
+	  SetBranchAddress(*port,tree3,"br4_2_energy",   &br4_2_energy);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio1_45", &br4_2_ratio1_45);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio1_35", &br4_2_ratio1_35);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio1_25", &br4_2_ratio1_25);
+	  SetBranchAddress(*port,tree3,"br4_2_ratio1_15", &br4_2_ratio1_15);
+	  SetBranchAddress(*port,tree3,"br4_2_iso_angle", &br4_2_iso_angle);
+	  SetBranchAddress(*port,tree3,"br4_2_iso_angle1", &br4_2_iso_angle1);
+	  SetBranchAddress(*port,tree3,"br4_2_angle", &br4_2_angle);
 
 
 	  float tro_flag;
@@ -1553,49 +1593,49 @@ if(f_BDTport){
 	  std::vector<float> *tro_5_v_min_count= new std::vector<float>;
 	  std::vector<float> *tro_5_v_max_count= new std::vector<float>;
 	  std::vector<float> *tro_5_v_energy = new std::vector<float>;
-	  tree3->SetBranchAddress("tro_flag",&tro_flag);
-	  tree3->SetBranchAddress("tro_1_v_flag",&tro_1_v_flag);
-	  tree3->SetBranchAddress("tro_1_v_particle_type",&tro_1_v_particle_type);
-	  tree3->SetBranchAddress("tro_1_v_flag_dir_weak",&tro_1_v_flag_dir_weak);
-	  tree3->SetBranchAddress("tro_1_v_min_dis",&tro_1_v_min_dis);
-	  tree3->SetBranchAddress("tro_1_v_sg1_length",&tro_1_v_sg1_length);
-	  tree3->SetBranchAddress("tro_1_v_shower_main_length",&tro_1_v_shower_main_length);
-	  tree3->SetBranchAddress("tro_1_v_max_n_vtx_segs",&tro_1_v_max_n_vtx_segs);
-	  tree3->SetBranchAddress("tro_1_v_tmp_length",&tro_1_v_tmp_length);
-	  tree3->SetBranchAddress("tro_1_v_medium_dQ_dx",&tro_1_v_medium_dQ_dx);
-	  tree3->SetBranchAddress("tro_1_v_dQ_dx_cut",&tro_1_v_dQ_dx_cut);
-	  tree3->SetBranchAddress("tro_1_v_flag_shower_topology",&tro_1_v_flag_shower_topology);
-	  tree3->SetBranchAddress("tro_2_v_flag",&tro_2_v_flag);
-	  tree3->SetBranchAddress("tro_2_v_energy",&tro_2_v_energy);
-	  tree3->SetBranchAddress("tro_2_v_stem_length",&tro_2_v_stem_length);
-	  tree3->SetBranchAddress("tro_2_v_iso_angle",&tro_2_v_iso_angle);
-	  tree3->SetBranchAddress("tro_2_v_max_length",&tro_2_v_max_length);
-	  tree3->SetBranchAddress("tro_2_v_angle",&tro_2_v_angle);
-	  tree3->SetBranchAddress("tro_3_flag",&tro_3_flag);
-	  tree3->SetBranchAddress("tro_3_stem_length",&tro_3_stem_length);
-	  tree3->SetBranchAddress("tro_3_n_muon_segs",&tro_3_n_muon_segs);
-	  tree3->SetBranchAddress("tro_3_energy",&tro_3_energy);
-	  tree3->SetBranchAddress("tro_4_v_flag",&tro_4_v_flag);
-	  tree3->SetBranchAddress("tro_4_v_dir2_mag",&tro_4_v_dir2_mag);
-	  tree3->SetBranchAddress("tro_4_v_angle",&tro_4_v_angle);
-	  tree3->SetBranchAddress("tro_4_v_angle1",&tro_4_v_angle1);
-	  tree3->SetBranchAddress("tro_4_v_angle2",&tro_4_v_angle2);
-	  tree3->SetBranchAddress("tro_4_v_length",&tro_4_v_length);
-	  tree3->SetBranchAddress("tro_4_v_length1",&tro_4_v_length1);
-	  tree3->SetBranchAddress("tro_4_v_medium_dQ_dx",&tro_4_v_medium_dQ_dx);
-	  tree3->SetBranchAddress("tro_4_v_end_dQ_dx",&tro_4_v_end_dQ_dx);
-	  tree3->SetBranchAddress("tro_4_v_energy",&tro_4_v_energy);
-	  tree3->SetBranchAddress("tro_4_v_shower_main_length",&tro_4_v_shower_main_length);
-	  tree3->SetBranchAddress("tro_4_v_flag_shower_trajectory",&tro_4_v_flag_shower_trajectory);
-	  tree3->SetBranchAddress("tro_5_v_flag",&tro_5_v_flag);
-	  tree3->SetBranchAddress("tro_5_v_max_angle",&tro_5_v_max_angle);
-	  tree3->SetBranchAddress("tro_5_v_min_angle",&tro_5_v_min_angle);
-	  tree3->SetBranchAddress("tro_5_v_max_length",&tro_5_v_max_length);
-	  tree3->SetBranchAddress("tro_5_v_iso_angle",&tro_5_v_iso_angle);
-	  tree3->SetBranchAddress("tro_5_v_n_vtx_segs",&tro_5_v_n_vtx_segs);
-	  tree3->SetBranchAddress("tro_5_v_min_count",&tro_5_v_min_count);
-	  tree3->SetBranchAddress("tro_5_v_max_count",&tro_5_v_max_count);
-	  tree3->SetBranchAddress("tro_5_v_energy",&tro_5_v_energy);
+	  SetBranchAddress(*port,tree3,"tro_flag",&tro_flag);
+	  SetBranchAddress(*port,tree3,"tro_1_v_flag",&tro_1_v_flag);
+	  SetBranchAddress(*port,tree3,"tro_1_v_particle_type",&tro_1_v_particle_type);
+	  SetBranchAddress(*port,tree3,"tro_1_v_flag_dir_weak",&tro_1_v_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"tro_1_v_min_dis",&tro_1_v_min_dis);
+	  SetBranchAddress(*port,tree3,"tro_1_v_sg1_length",&tro_1_v_sg1_length);
+	  SetBranchAddress(*port,tree3,"tro_1_v_shower_main_length",&tro_1_v_shower_main_length);
+	  SetBranchAddress(*port,tree3,"tro_1_v_max_n_vtx_segs",&tro_1_v_max_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"tro_1_v_tmp_length",&tro_1_v_tmp_length);
+	  SetBranchAddress(*port,tree3,"tro_1_v_medium_dQ_dx",&tro_1_v_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"tro_1_v_dQ_dx_cut",&tro_1_v_dQ_dx_cut);
+	  SetBranchAddress(*port,tree3,"tro_1_v_flag_shower_topology",&tro_1_v_flag_shower_topology);
+	  SetBranchAddress(*port,tree3,"tro_2_v_flag",&tro_2_v_flag);
+	  SetBranchAddress(*port,tree3,"tro_2_v_energy",&tro_2_v_energy);
+	  SetBranchAddress(*port,tree3,"tro_2_v_stem_length",&tro_2_v_stem_length);
+	  SetBranchAddress(*port,tree3,"tro_2_v_iso_angle",&tro_2_v_iso_angle);
+	  SetBranchAddress(*port,tree3,"tro_2_v_max_length",&tro_2_v_max_length);
+	  SetBranchAddress(*port,tree3,"tro_2_v_angle",&tro_2_v_angle);
+	  SetBranchAddress(*port,tree3,"tro_3_flag",&tro_3_flag);
+	  SetBranchAddress(*port,tree3,"tro_3_stem_length",&tro_3_stem_length);
+	  SetBranchAddress(*port,tree3,"tro_3_n_muon_segs",&tro_3_n_muon_segs);
+	  SetBranchAddress(*port,tree3,"tro_3_energy",&tro_3_energy);
+	  SetBranchAddress(*port,tree3,"tro_4_v_flag",&tro_4_v_flag);
+	  SetBranchAddress(*port,tree3,"tro_4_v_dir2_mag",&tro_4_v_dir2_mag);
+	  SetBranchAddress(*port,tree3,"tro_4_v_angle",&tro_4_v_angle);
+	  SetBranchAddress(*port,tree3,"tro_4_v_angle1",&tro_4_v_angle1);
+	  SetBranchAddress(*port,tree3,"tro_4_v_angle2",&tro_4_v_angle2);
+	  SetBranchAddress(*port,tree3,"tro_4_v_length",&tro_4_v_length);
+	  SetBranchAddress(*port,tree3,"tro_4_v_length1",&tro_4_v_length1);
+	  SetBranchAddress(*port,tree3,"tro_4_v_medium_dQ_dx",&tro_4_v_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"tro_4_v_end_dQ_dx",&tro_4_v_end_dQ_dx);
+	  SetBranchAddress(*port,tree3,"tro_4_v_energy",&tro_4_v_energy);
+	  SetBranchAddress(*port,tree3,"tro_4_v_shower_main_length",&tro_4_v_shower_main_length);
+	  SetBranchAddress(*port,tree3,"tro_4_v_flag_shower_trajectory",&tro_4_v_flag_shower_trajectory);
+	  SetBranchAddress(*port,tree3,"tro_5_v_flag",&tro_5_v_flag);
+	  SetBranchAddress(*port,tree3,"tro_5_v_max_angle",&tro_5_v_max_angle);
+	  SetBranchAddress(*port,tree3,"tro_5_v_min_angle",&tro_5_v_min_angle);
+	  SetBranchAddress(*port,tree3,"tro_5_v_max_length",&tro_5_v_max_length);
+	  SetBranchAddress(*port,tree3,"tro_5_v_iso_angle",&tro_5_v_iso_angle);
+	  SetBranchAddress(*port,tree3,"tro_5_v_n_vtx_segs",&tro_5_v_n_vtx_segs);
+	  SetBranchAddress(*port,tree3,"tro_5_v_min_count",&tro_5_v_min_count);
+	  SetBranchAddress(*port,tree3,"tro_5_v_max_count",&tro_5_v_max_count);
+	  SetBranchAddress(*port,tree3,"tro_5_v_energy",&tro_5_v_energy);
 
 
 	  float hol_flag;
@@ -1610,18 +1650,18 @@ if(f_BDTport){
 	  float hol_2_medium_dQ_dx;
 	  float hol_2_ncount;
 	  float hol_2_energy;
-	  tree3->SetBranchAddress("hol_flag", &hol_flag);
-	  tree3->SetBranchAddress("hol_1_flag", &hol_1_flag);
-	  tree3->SetBranchAddress("hol_1_n_valid_tracks", &hol_1_n_valid_tracks);
-	  tree3->SetBranchAddress("hol_1_min_angle", &hol_1_min_angle);
-	  tree3->SetBranchAddress("hol_1_energy", &hol_1_energy);
-	  tree3->SetBranchAddress("hol_1_flag_all_shower", &hol_1_flag_all_shower);
-	  tree3->SetBranchAddress("hol_1_min_length", &hol_1_min_length);
-	  tree3->SetBranchAddress("hol_2_flag", &hol_2_flag);
-	  tree3->SetBranchAddress("hol_2_min_angle", &hol_2_min_angle);
-	  tree3->SetBranchAddress("hol_2_medium_dQ_dx", &hol_2_medium_dQ_dx);
-	  tree3->SetBranchAddress("hol_2_ncount", &hol_2_ncount);
-	  tree3->SetBranchAddress("hol_2_energy", &hol_2_energy);
+	  SetBranchAddress(*port,tree3,"hol_flag", &hol_flag);
+	  SetBranchAddress(*port,tree3,"hol_1_flag", &hol_1_flag);
+	  SetBranchAddress(*port,tree3,"hol_1_n_valid_tracks", &hol_1_n_valid_tracks);
+	  SetBranchAddress(*port,tree3,"hol_1_min_angle", &hol_1_min_angle);
+	  SetBranchAddress(*port,tree3,"hol_1_energy", &hol_1_energy);
+	  SetBranchAddress(*port,tree3,"hol_1_flag_all_shower", &hol_1_flag_all_shower);
+	  SetBranchAddress(*port,tree3,"hol_1_min_length", &hol_1_min_length);
+	  SetBranchAddress(*port,tree3,"hol_2_flag", &hol_2_flag);
+	  SetBranchAddress(*port,tree3,"hol_2_min_angle", &hol_2_min_angle);
+	  SetBranchAddress(*port,tree3,"hol_2_medium_dQ_dx", &hol_2_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"hol_2_ncount", &hol_2_ncount);
+	  SetBranchAddress(*port,tree3,"hol_2_energy", &hol_2_energy);
 
 
 	  float lol_flag;
@@ -1647,29 +1687,29 @@ if(f_BDTport){
 	  float lol_3_shower_main_length;
 	  float lol_3_n_out;
 	  float lol_3_n_sum;
-	  tree3->SetBranchAddress("lol_flag",&lol_flag);
-	  tree3->SetBranchAddress("lol_1_v_flag",&lol_1_v_flag);
-	  tree3->SetBranchAddress("lol_1_v_energy",&lol_1_v_energy);
-	  tree3->SetBranchAddress("lol_1_v_vtx_n_segs",&lol_1_v_vtx_n_segs);
-	  tree3->SetBranchAddress("lol_1_v_nseg",&lol_1_v_nseg);
-	  tree3->SetBranchAddress("lol_1_v_angle",&lol_1_v_angle);
-	  tree3->SetBranchAddress("lol_2_v_flag",&lol_2_v_flag);
-	  tree3->SetBranchAddress("lol_2_v_length",&lol_2_v_length);
-	  tree3->SetBranchAddress("lol_2_v_angle",&lol_2_v_angle);
-	  tree3->SetBranchAddress("lol_2_v_type",&lol_2_v_type);
-	  tree3->SetBranchAddress("lol_2_v_vtx_n_segs",&lol_2_v_vtx_n_segs);
-	  tree3->SetBranchAddress("lol_2_v_energy",&lol_2_v_energy);
-	  tree3->SetBranchAddress("lol_2_v_shower_main_length",&lol_2_v_shower_main_length);
-	  tree3->SetBranchAddress("lol_2_v_flag_dir_weak",&lol_2_v_flag_dir_weak);
-	  tree3->SetBranchAddress("lol_3_flag",&lol_3_flag);
-	  tree3->SetBranchAddress("lol_3_angle_beam",&lol_3_angle_beam);
-	  tree3->SetBranchAddress("lol_3_n_valid_tracks",&lol_3_n_valid_tracks);
-	  tree3->SetBranchAddress("lol_3_min_angle",&lol_3_min_angle);
-	  tree3->SetBranchAddress("lol_3_vtx_n_segs",&lol_3_vtx_n_segs);
-	  tree3->SetBranchAddress("lol_3_energy",&lol_3_energy);
-	  tree3->SetBranchAddress("lol_3_shower_main_length",&lol_3_shower_main_length);
-	  tree3->SetBranchAddress("lol_3_n_out",&lol_3_n_out);
-	  tree3->SetBranchAddress("lol_3_n_sum",&lol_3_n_sum);
+	  SetBranchAddress(*port,tree3,"lol_flag",&lol_flag);
+	  SetBranchAddress(*port,tree3,"lol_1_v_flag",&lol_1_v_flag);
+	  SetBranchAddress(*port,tree3,"lol_1_v_energy",&lol_1_v_energy);
+	  SetBranchAddress(*port,tree3,"lol_1_v_vtx_n_segs",&lol_1_v_vtx_n_segs);
+	  SetBranchAddress(*port,tree3,"lol_1_v_nseg",&lol_1_v_nseg);
+	  SetBranchAddress(*port,tree3,"lol_1_v_angle",&lol_1_v_angle);
+	  SetBranchAddress(*port,tree3,"lol_2_v_flag",&lol_2_v_flag);
+	  SetBranchAddress(*port,tree3,"lol_2_v_length",&lol_2_v_length);
+	  SetBranchAddress(*port,tree3,"lol_2_v_angle",&lol_2_v_angle);
+	  SetBranchAddress(*port,tree3,"lol_2_v_type",&lol_2_v_type);
+	  SetBranchAddress(*port,tree3,"lol_2_v_vtx_n_segs",&lol_2_v_vtx_n_segs);
+	  SetBranchAddress(*port,tree3,"lol_2_v_energy",&lol_2_v_energy);
+	  SetBranchAddress(*port,tree3,"lol_2_v_shower_main_length",&lol_2_v_shower_main_length);
+	  SetBranchAddress(*port,tree3,"lol_2_v_flag_dir_weak",&lol_2_v_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"lol_3_flag",&lol_3_flag);
+	  SetBranchAddress(*port,tree3,"lol_3_angle_beam",&lol_3_angle_beam);
+	  SetBranchAddress(*port,tree3,"lol_3_n_valid_tracks",&lol_3_n_valid_tracks);
+	  SetBranchAddress(*port,tree3,"lol_3_min_angle",&lol_3_min_angle);
+	  SetBranchAddress(*port,tree3,"lol_3_vtx_n_segs",&lol_3_vtx_n_segs);
+	  SetBranchAddress(*port,tree3,"lol_3_energy",&lol_3_energy);
+	  SetBranchAddress(*port,tree3,"lol_3_shower_main_length",&lol_3_shower_main_length);
+	  SetBranchAddress(*port,tree3,"lol_3_n_out",&lol_3_n_out);
+	  SetBranchAddress(*port,tree3,"lol_3_n_sum",&lol_3_n_sum);
 
 	  float cosmict_flag_1; // fiducial volume vertex
 	  float cosmict_flag_2;  // single muon
@@ -1736,71 +1776,71 @@ if(f_BDTport){
 	  std::vector<float> *cosmict_10_flag_dir_weak= new std::vector<float>;
 	  std::vector<float> *cosmict_10_angle_beam= new std::vector<float>;
 	  std::vector<float> *cosmict_10_length = new std::vector<float>;
-	  tree3->SetBranchAddress("cosmict_flag_1",&cosmict_flag_1);
-	  tree3->SetBranchAddress("cosmict_flag_2",&cosmict_flag_2);
-	  tree3->SetBranchAddress("cosmict_flag_3",&cosmict_flag_3);
-	  tree3->SetBranchAddress("cosmict_flag_4",&cosmict_flag_4);
-	  tree3->SetBranchAddress("cosmict_flag_5",&cosmict_flag_5);
-	  tree3->SetBranchAddress("cosmict_flag_6",&cosmict_flag_6);
-	  tree3->SetBranchAddress("cosmict_flag_7",&cosmict_flag_7);
-	  tree3->SetBranchAddress("cosmict_flag_8",&cosmict_flag_8);
-	  tree3->SetBranchAddress("cosmict_flag_9",&cosmict_flag_9);
-	  tree3->SetBranchAddress("cosmict_flag_10",&cosmict_flag_10);
-	  tree3->SetBranchAddress("cosmict_flag",&cosmict_flag);
-	  tree3->SetBranchAddress("cosmict_2_filled",&cosmict_2_filled);
-	  tree3->SetBranchAddress("cosmict_2_particle_type",&cosmict_2_particle_type);
-	  tree3->SetBranchAddress("cosmict_2_n_muon_tracks",&cosmict_2_n_muon_tracks);
-	  tree3->SetBranchAddress("cosmict_2_total_shower_length",&cosmict_2_total_shower_length);
-	  tree3->SetBranchAddress("cosmict_2_flag_inside",&cosmict_2_flag_inside);
-	  tree3->SetBranchAddress("cosmict_2_angle_beam",&cosmict_2_angle_beam);
-	  tree3->SetBranchAddress("cosmict_2_flag_dir_weak",&cosmict_2_flag_dir_weak);
-	  tree3->SetBranchAddress("cosmict_2_dQ_dx_end",&cosmict_2_dQ_dx_end);
-	  tree3->SetBranchAddress("cosmict_2_dQ_dx_front",&cosmict_2_dQ_dx_front);
-	  tree3->SetBranchAddress("cosmict_2_theta",&cosmict_2_theta);
-	  tree3->SetBranchAddress("cosmict_2_phi",&cosmict_2_phi);
-	  tree3->SetBranchAddress("cosmict_2_valid_tracks",&cosmict_2_valid_tracks);
-	  tree3->SetBranchAddress("cosmict_3_filled",&cosmict_3_filled);
-	  tree3->SetBranchAddress("cosmict_3_flag_inside",&cosmict_3_flag_inside);
-	  tree3->SetBranchAddress("cosmict_3_angle_beam",&cosmict_3_angle_beam);
-	  tree3->SetBranchAddress("cosmict_3_flag_dir_weak",&cosmict_3_flag_dir_weak);
-	  tree3->SetBranchAddress("cosmict_3_dQ_dx_end",&cosmict_3_dQ_dx_end);
-	  tree3->SetBranchAddress("cosmict_3_dQ_dx_front",&cosmict_3_dQ_dx_front);
-	  tree3->SetBranchAddress("cosmict_3_theta",&cosmict_3_theta);
-	  tree3->SetBranchAddress("cosmict_3_phi",&cosmict_3_phi);
-	  tree3->SetBranchAddress("cosmict_3_valid_tracks",&cosmict_3_valid_tracks);
-	  tree3->SetBranchAddress("cosmict_4_filled",&cosmict_4_filled);
-	  tree3->SetBranchAddress("cosmict_4_flag_inside",&cosmict_4_flag_inside);
-	  tree3->SetBranchAddress("cosmict_4_angle_beam",&cosmict_4_angle_beam);
-	  tree3->SetBranchAddress("cosmict_4_connected_showers",&cosmict_4_connected_showers);
-	  tree3->SetBranchAddress("cosmict_5_filled",&cosmict_5_filled);
-	  tree3->SetBranchAddress("cosmict_5_flag_inside",&cosmict_5_flag_inside);
-	  tree3->SetBranchAddress("cosmict_5_angle_beam",&cosmict_5_angle_beam);
-	  tree3->SetBranchAddress("cosmict_5_connected_showers",&cosmict_5_connected_showers);
-	  tree3->SetBranchAddress("cosmict_6_filled",&cosmict_6_filled);
-	  tree3->SetBranchAddress("cosmict_6_flag_dir_weak",&cosmict_6_flag_dir_weak);
-	  tree3->SetBranchAddress("cosmict_6_flag_inside",&cosmict_6_flag_inside);
-	  tree3->SetBranchAddress("cosmict_6_angle",&cosmict_6_angle);
-	  tree3->SetBranchAddress("cosmict_7_filled",&cosmict_7_filled);
-	  tree3->SetBranchAddress("cosmict_7_flag_sec",&cosmict_7_flag_sec);
-	  tree3->SetBranchAddress("cosmict_7_n_muon_tracks",&cosmict_7_n_muon_tracks);
-	  tree3->SetBranchAddress("cosmict_7_total_shower_length",&cosmict_7_total_shower_length);
-	  tree3->SetBranchAddress("cosmict_7_flag_inside",&cosmict_7_flag_inside);
-	  tree3->SetBranchAddress("cosmict_7_angle_beam",&cosmict_7_angle_beam);
-	  tree3->SetBranchAddress("cosmict_7_flag_dir_weak",&cosmict_7_flag_dir_weak);
-	  tree3->SetBranchAddress("cosmict_7_dQ_dx_end",&cosmict_7_dQ_dx_end);
-	  tree3->SetBranchAddress("cosmict_7_dQ_dx_front",&cosmict_7_dQ_dx_front);
-	  tree3->SetBranchAddress("cosmict_7_theta",&cosmict_7_theta);
-	  tree3->SetBranchAddress("cosmict_7_phi",&cosmict_7_phi);
-	  tree3->SetBranchAddress("cosmict_8_filled",&cosmict_8_filled);
-	  tree3->SetBranchAddress("cosmict_8_flag_out",&cosmict_8_flag_out);
-	  tree3->SetBranchAddress("cosmict_8_muon_length",&cosmict_8_muon_length);
-	  tree3->SetBranchAddress("cosmict_8_acc_length",&cosmict_8_acc_length);
-	  tree3->SetBranchAddress("cosmict_10_flag_inside",&cosmict_10_flag_inside);
-	  tree3->SetBranchAddress("cosmict_10_vtx_z",&cosmict_10_vtx_z);
-	  tree3->SetBranchAddress("cosmict_10_flag_shower",&cosmict_10_flag_shower);
-	  tree3->SetBranchAddress("cosmict_10_flag_dir_weak",&cosmict_10_flag_dir_weak);
-	  tree3->SetBranchAddress("cosmict_10_angle_beam",&cosmict_10_angle_beam);
-	  tree3->SetBranchAddress("cosmict_10_length",&cosmict_10_length);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_1",&cosmict_flag_1);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_2",&cosmict_flag_2);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_3",&cosmict_flag_3);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_4",&cosmict_flag_4);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_5",&cosmict_flag_5);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_6",&cosmict_flag_6);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_7",&cosmict_flag_7);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_8",&cosmict_flag_8);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_9",&cosmict_flag_9);
+	  SetBranchAddress(*port,tree3,"cosmict_flag_10",&cosmict_flag_10);
+	  SetBranchAddress(*port,tree3,"cosmict_flag",&cosmict_flag);
+	  SetBranchAddress(*port,tree3,"cosmict_2_filled",&cosmict_2_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_2_particle_type",&cosmict_2_particle_type);
+	  SetBranchAddress(*port,tree3,"cosmict_2_n_muon_tracks",&cosmict_2_n_muon_tracks);
+	  SetBranchAddress(*port,tree3,"cosmict_2_total_shower_length",&cosmict_2_total_shower_length);
+	  SetBranchAddress(*port,tree3,"cosmict_2_flag_inside",&cosmict_2_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_2_angle_beam",&cosmict_2_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_2_flag_dir_weak",&cosmict_2_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"cosmict_2_dQ_dx_end",&cosmict_2_dQ_dx_end);
+	  SetBranchAddress(*port,tree3,"cosmict_2_dQ_dx_front",&cosmict_2_dQ_dx_front);
+	  SetBranchAddress(*port,tree3,"cosmict_2_theta",&cosmict_2_theta);
+	  SetBranchAddress(*port,tree3,"cosmict_2_phi",&cosmict_2_phi);
+	  SetBranchAddress(*port,tree3,"cosmict_2_valid_tracks",&cosmict_2_valid_tracks);
+	  SetBranchAddress(*port,tree3,"cosmict_3_filled",&cosmict_3_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_3_flag_inside",&cosmict_3_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_3_angle_beam",&cosmict_3_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_3_flag_dir_weak",&cosmict_3_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"cosmict_3_dQ_dx_end",&cosmict_3_dQ_dx_end);
+	  SetBranchAddress(*port,tree3,"cosmict_3_dQ_dx_front",&cosmict_3_dQ_dx_front);
+	  SetBranchAddress(*port,tree3,"cosmict_3_theta",&cosmict_3_theta);
+	  SetBranchAddress(*port,tree3,"cosmict_3_phi",&cosmict_3_phi);
+	  SetBranchAddress(*port,tree3,"cosmict_3_valid_tracks",&cosmict_3_valid_tracks);
+	  SetBranchAddress(*port,tree3,"cosmict_4_filled",&cosmict_4_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_4_flag_inside",&cosmict_4_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_4_angle_beam",&cosmict_4_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_4_connected_showers",&cosmict_4_connected_showers);
+	  SetBranchAddress(*port,tree3,"cosmict_5_filled",&cosmict_5_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_5_flag_inside",&cosmict_5_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_5_angle_beam",&cosmict_5_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_5_connected_showers",&cosmict_5_connected_showers);
+	  SetBranchAddress(*port,tree3,"cosmict_6_filled",&cosmict_6_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_6_flag_dir_weak",&cosmict_6_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"cosmict_6_flag_inside",&cosmict_6_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_6_angle",&cosmict_6_angle);
+	  SetBranchAddress(*port,tree3,"cosmict_7_filled",&cosmict_7_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_7_flag_sec",&cosmict_7_flag_sec);
+	  SetBranchAddress(*port,tree3,"cosmict_7_n_muon_tracks",&cosmict_7_n_muon_tracks);
+	  SetBranchAddress(*port,tree3,"cosmict_7_total_shower_length",&cosmict_7_total_shower_length);
+	  SetBranchAddress(*port,tree3,"cosmict_7_flag_inside",&cosmict_7_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_7_angle_beam",&cosmict_7_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_7_flag_dir_weak",&cosmict_7_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"cosmict_7_dQ_dx_end",&cosmict_7_dQ_dx_end);
+	  SetBranchAddress(*port,tree3,"cosmict_7_dQ_dx_front",&cosmict_7_dQ_dx_front);
+	  SetBranchAddress(*port,tree3,"cosmict_7_theta",&cosmict_7_theta);
+	  SetBranchAddress(*port,tree3,"cosmict_7_phi",&cosmict_7_phi);
+	  SetBranchAddress(*port,tree3,"cosmict_8_filled",&cosmict_8_filled);
+	  SetBranchAddress(*port,tree3,"cosmict_8_flag_out",&cosmict_8_flag_out);
+	  SetBranchAddress(*port,tree3,"cosmict_8_muon_length",&cosmict_8_muon_length);
+	  SetBranchAddress(*port,tree3,"cosmict_8_acc_length",&cosmict_8_acc_length);
+	  SetBranchAddress(*port,tree3,"cosmict_10_flag_inside",&cosmict_10_flag_inside);
+	  SetBranchAddress(*port,tree3,"cosmict_10_vtx_z",&cosmict_10_vtx_z);
+	  SetBranchAddress(*port,tree3,"cosmict_10_flag_shower",&cosmict_10_flag_shower);
+	  SetBranchAddress(*port,tree3,"cosmict_10_flag_dir_weak",&cosmict_10_flag_dir_weak);
+	  SetBranchAddress(*port,tree3,"cosmict_10_angle_beam",&cosmict_10_angle_beam);
+	  SetBranchAddress(*port,tree3,"cosmict_10_length",&cosmict_10_length);
 
 	  // numu tagger
 	  float numu_cc_flag;
@@ -1825,28 +1865,28 @@ if(f_BDTport){
 	  float numu_cc_3_max_muon_length;
 	  float numu_cc_3_n_daughter_tracks;
 	  float numu_cc_3_n_daughter_all;
-	  tree3->SetBranchAddress("numu_cc_flag",&numu_cc_flag);
-	  tree3->SetBranchAddress("numu_cc_flag_1",&numu_cc_flag_1);
-	  tree3->SetBranchAddress("numu_cc_1_particle_type",&numu_cc_1_particle_type);
-	  tree3->SetBranchAddress("numu_cc_1_length",&numu_cc_1_length);
-	  tree3->SetBranchAddress("numu_cc_1_medium_dQ_dx",&numu_cc_1_medium_dQ_dx);
-	  tree3->SetBranchAddress("numu_cc_1_dQ_dx_cut",&numu_cc_1_dQ_dx_cut);
-	  tree3->SetBranchAddress("numu_cc_1_direct_length",&numu_cc_1_direct_length);
-	  tree3->SetBranchAddress("numu_cc_1_n_daughter_tracks",&numu_cc_1_n_daughter_tracks);
-	  tree3->SetBranchAddress("numu_cc_1_n_daughter_all",&numu_cc_1_n_daughter_all);
-	  tree3->SetBranchAddress("numu_cc_flag_2",&numu_cc_flag_2);
-	  tree3->SetBranchAddress("numu_cc_2_length",&numu_cc_2_length);
-	  tree3->SetBranchAddress("numu_cc_2_total_length",&numu_cc_2_total_length);
-	  tree3->SetBranchAddress("numu_cc_2_n_daughter_tracks",&numu_cc_2_n_daughter_tracks);
-	  tree3->SetBranchAddress("numu_cc_2_n_daughter_all",&numu_cc_2_n_daughter_all);
-	  tree3->SetBranchAddress("numu_cc_flag_3",&numu_cc_flag_3);
-	  tree3->SetBranchAddress("numu_cc_3_particle_type",&numu_cc_3_particle_type);
-	  tree3->SetBranchAddress("numu_cc_3_max_length",&numu_cc_3_max_length);
-	  tree3->SetBranchAddress("numu_cc_3_track_length",&numu_cc_3_acc_track_length);
-	  tree3->SetBranchAddress("numu_cc_3_max_length_all",&numu_cc_3_max_length_all);
-	  tree3->SetBranchAddress("numu_cc_3_max_muon_length",&numu_cc_3_max_muon_length);
-	  tree3->SetBranchAddress("numu_cc_3_n_daughter_tracks",&numu_cc_3_n_daughter_tracks);
-	  tree3->SetBranchAddress("numu_cc_3_n_daughter_all",&numu_cc_3_n_daughter_all);
+	  SetBranchAddress(*port,tree3,"numu_cc_flag",&numu_cc_flag);
+	  SetBranchAddress(*port,tree3,"numu_cc_flag_1",&numu_cc_flag_1);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_particle_type",&numu_cc_1_particle_type);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_length",&numu_cc_1_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_medium_dQ_dx",&numu_cc_1_medium_dQ_dx);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_dQ_dx_cut",&numu_cc_1_dQ_dx_cut);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_direct_length",&numu_cc_1_direct_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_n_daughter_tracks",&numu_cc_1_n_daughter_tracks);
+	  SetBranchAddress(*port,tree3,"numu_cc_1_n_daughter_all",&numu_cc_1_n_daughter_all);
+	  SetBranchAddress(*port,tree3,"numu_cc_flag_2",&numu_cc_flag_2);
+	  SetBranchAddress(*port,tree3,"numu_cc_2_length",&numu_cc_2_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_2_total_length",&numu_cc_2_total_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_2_n_daughter_tracks",&numu_cc_2_n_daughter_tracks);
+	  SetBranchAddress(*port,tree3,"numu_cc_2_n_daughter_all",&numu_cc_2_n_daughter_all);
+	  SetBranchAddress(*port,tree3,"numu_cc_flag_3",&numu_cc_flag_3);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_particle_type",&numu_cc_3_particle_type);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_max_length",&numu_cc_3_max_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_track_length",&numu_cc_3_acc_track_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_max_length_all",&numu_cc_3_max_length_all);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_max_muon_length",&numu_cc_3_max_muon_length);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_n_daughter_tracks",&numu_cc_3_n_daughter_tracks);
+	  SetBranchAddress(*port,tree3,"numu_cc_3_n_daughter_all",&numu_cc_3_n_daughter_all);
 
 	  // BDT scores
 	  float cosmict_2_4_score;
@@ -1896,53 +1936,54 @@ if(f_BDTport){
 	  float tro_4_score;
 	  float tro_5_score;
 	  float nue_score;
-	  tree3->SetBranchAddress("cosmict_2_4_score",&cosmict_2_4_score);
-	  tree3->SetBranchAddress("cosmict_3_5_score",&cosmict_3_5_score);
-	  tree3->SetBranchAddress("cosmict_6_score",&cosmict_6_score);
-	  tree3->SetBranchAddress("cosmict_7_score",&cosmict_7_score);
-	  tree3->SetBranchAddress("cosmict_8_score",&cosmict_8_score);
-	  tree3->SetBranchAddress("cosmict_10_score",&cosmict_10_score);
-	  tree3->SetBranchAddress("numu_1_score",&numu_1_score);
-	  tree3->SetBranchAddress("numu_2_score",&numu_2_score);
-	  tree3->SetBranchAddress("numu_3_score",&numu_3_score);
-	  tree3->SetBranchAddress("cosmict_score",&cosmict_score);
-	  tree3->SetBranchAddress("numu_score",&numu_score);
-	  tree3->SetBranchAddress("mipid_score",&mipid_score);
-	  tree3->SetBranchAddress("gap_score",&gap_score);
-	  tree3->SetBranchAddress("hol_lol_score",&hol_lol_score);
-	  tree3->SetBranchAddress("cme_anc_score",&cme_anc_score);
-	  tree3->SetBranchAddress("mgo_mgt_score",&mgo_mgt_score);
-	  tree3->SetBranchAddress("br1_score",&br1_score);
-	  tree3->SetBranchAddress("br3_score",&br3_score);
-	  tree3->SetBranchAddress("br3_3_score",&br3_3_score);
-	  tree3->SetBranchAddress("br3_5_score",&br3_5_score);
-	  tree3->SetBranchAddress("br3_6_score",&br3_6_score);
-	  tree3->SetBranchAddress("stemdir_br2_score",&stemdir_br2_score);
-	  tree3->SetBranchAddress("trimuon_score",&trimuon_score);
-	  tree3->SetBranchAddress("br4_tro_score",&br4_tro_score);
-	  tree3->SetBranchAddress("mipquality_score",&mipquality_score);
-	  tree3->SetBranchAddress("pio_1_score",&pio_1_score);
-	  tree3->SetBranchAddress("pio_2_score",&pio_2_score);
-	  tree3->SetBranchAddress("stw_spt_score",&stw_spt_score);
-	  tree3->SetBranchAddress("vis_1_score",&vis_1_score);
-	  tree3->SetBranchAddress("vis_2_score",&vis_2_score);
-	  tree3->SetBranchAddress("stw_2_score",&stw_2_score);
-	  tree3->SetBranchAddress("stw_3_score",&stw_3_score);
-	  tree3->SetBranchAddress("stw_4_score",&stw_4_score);
-	  tree3->SetBranchAddress("sig_1_score",&sig_1_score);
-	  tree3->SetBranchAddress("sig_2_score",&sig_2_score);
-	  tree3->SetBranchAddress("lol_1_score",&lol_1_score);
-	  tree3->SetBranchAddress("lol_2_score",&lol_2_score);
-	  tree3->SetBranchAddress("tro_1_score",&tro_1_score);
-	  tree3->SetBranchAddress("tro_2_score",&tro_2_score);
-	  tree3->SetBranchAddress("tro_4_score",&tro_4_score);
-	  tree3->SetBranchAddress("tro_5_score",&tro_5_score);
-	  tree3->SetBranchAddress("nue_score",&nue_score);
+	  SetBranchAddress(*port,tree3,"cosmict_2_4_score",&cosmict_2_4_score);
+	  SetBranchAddress(*port,tree3,"cosmict_3_5_score",&cosmict_3_5_score);
+	  SetBranchAddress(*port,tree3,"cosmict_6_score",&cosmict_6_score);
+	  SetBranchAddress(*port,tree3,"cosmict_7_score",&cosmict_7_score);
+	  SetBranchAddress(*port,tree3,"cosmict_8_score",&cosmict_8_score);
+	  SetBranchAddress(*port,tree3,"cosmict_10_score",&cosmict_10_score);
+	  SetBranchAddress(*port,tree3,"numu_1_score",&numu_1_score);
+	  SetBranchAddress(*port,tree3,"numu_2_score",&numu_2_score);
+	  SetBranchAddress(*port,tree3,"numu_3_score",&numu_3_score);
+	  SetBranchAddress(*port,tree3,"cosmict_score",&cosmict_score);
+	  SetBranchAddress(*port,tree3,"numu_score",&numu_score);
+	  SetBranchAddress(*port,tree3,"mipid_score",&mipid_score);
+	  SetBranchAddress(*port,tree3,"gap_score",&gap_score);
+	  SetBranchAddress(*port,tree3,"hol_lol_score",&hol_lol_score);
+	  SetBranchAddress(*port,tree3,"cme_anc_score",&cme_anc_score);
+	  SetBranchAddress(*port,tree3,"mgo_mgt_score",&mgo_mgt_score);
+	  SetBranchAddress(*port,tree3,"br1_score",&br1_score);
+	  SetBranchAddress(*port,tree3,"br3_score",&br3_score);
+	  SetBranchAddress(*port,tree3,"br3_3_score",&br3_3_score);
+	  SetBranchAddress(*port,tree3,"br3_5_score",&br3_5_score);
+	  SetBranchAddress(*port,tree3,"br3_6_score",&br3_6_score);
+	  SetBranchAddress(*port,tree3,"stemdir_br2_score",&stemdir_br2_score);
+	  SetBranchAddress(*port,tree3,"trimuon_score",&trimuon_score);
+	  SetBranchAddress(*port,tree3,"br4_tro_score",&br4_tro_score);
+	  SetBranchAddress(*port,tree3,"mipquality_score",&mipquality_score);
+	  SetBranchAddress(*port,tree3,"pio_1_score",&pio_1_score);
+	  SetBranchAddress(*port,tree3,"pio_2_score",&pio_2_score);
+	  SetBranchAddress(*port,tree3,"stw_spt_score",&stw_spt_score);
+	  SetBranchAddress(*port,tree3,"vis_1_score",&vis_1_score);
+	  SetBranchAddress(*port,tree3,"vis_2_score",&vis_2_score);
+	  SetBranchAddress(*port,tree3,"stw_2_score",&stw_2_score);
+	  SetBranchAddress(*port,tree3,"stw_3_score",&stw_3_score);
+	  SetBranchAddress(*port,tree3,"stw_4_score",&stw_4_score);
+	  SetBranchAddress(*port,tree3,"sig_1_score",&sig_1_score);
+	  SetBranchAddress(*port,tree3,"sig_2_score",&sig_2_score);
+	  SetBranchAddress(*port,tree3,"lol_1_score",&lol_1_score);
+	  SetBranchAddress(*port,tree3,"lol_2_score",&lol_2_score);
+	  SetBranchAddress(*port,tree3,"tro_1_score",&tro_1_score);
+	  SetBranchAddress(*port,tree3,"tro_2_score",&tro_2_score);
+	  SetBranchAddress(*port,tree3,"tro_4_score",&tro_4_score);
+	  SetBranchAddress(*port,tree3,"tro_5_score",&tro_5_score);
+	  SetBranchAddress(*port,tree3,"nue_score",&nue_score);
 
 
 
   /// Read and assign values
-  tree3->GetEntry(0); // rare case: multiple in-beam matched activity
+  tree3->GetEntry(entry3); // rare case: multiple in-beam matched activity
+  tree3->ResetBranchAddresses();
 
   nsm::NuSelectionBDT::SPID _SPID_init = {
           shw_sp_num_mip_tracks,
@@ -2902,7 +2943,7 @@ if(f_BDTport){
 
   }
   else {
-    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree3 <<" not found in file " << fInput <<"\n";
+    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree3 <<" not found (or has no entry for this event) in file " << fInput <<"\n";
   }
 
   e.put(std::move(outputBDTvars));
@@ -2919,8 +2960,9 @@ if(f_KINEport){
   else{
   nsm::NuSelectionKINE nsmkine;
 
-  TTree *tree4 = (TTree*)fin->Get(fInput_tree4.c_str());
-  if(tree4){
+  TTree *tree4 = port->Tree(fInput_tree4,false);
+  Long64_t entry4 = tree4 ? EventEntry(*port,fInput_tree4,tree4,e) : -1;
+  if(entry4>=0){
 
 	  float kine_reco_Enu; // kinetic energy  + additional energy ...
 	  float kine_reco_add_energy;  // mass, binding energy ...
@@ -2941,27 +2983,28 @@ if(f_KINEport){
 	  float kine_pio_dis_2;
 	  float kine_pio_angle;
 
-	  tree4->SetBranchAddress("kine_reco_Enu", &kine_reco_Enu); // kinetic energy  + additional energy ...
-	  tree4->SetBranchAddress("kine_reco_add_energy", &kine_reco_add_energy);  // mass, binding energy ...
-	  tree4->SetBranchAddress("kine_energy_particle", &kine_energy_particle);  // energy of each particle
-	  tree4->SetBranchAddress("kine_energy_info", &kine_energy_info); // what kind of energy reconstruction?
-	  tree4->SetBranchAddress("kine_particle_type", &kine_particle_type);
-	  tree4->SetBranchAddress("kine_energy_included", &kine_energy_included); // included in the neutrino energy calculation?
-	  tree4->SetBranchAddress("kine_pio_mass", &kine_pio_mass); // mass
-	  tree4->SetBranchAddress("kine_pio_flag", &kine_pio_flag); // 0 not filled, 1, with vertex: CCpio, 2 without vertex: NCpi0
-	  tree4->SetBranchAddress("kine_pio_vtx_dis", &kine_pio_vtx_dis);
-	  tree4->SetBranchAddress("kine_pio_energy_1", &kine_pio_energy_1);
-	  tree4->SetBranchAddress("kine_pio_theta_1", &kine_pio_theta_1);
-	  tree4->SetBranchAddress("kine_pio_phi_1", &kine_pio_phi_1);
-	  tree4->SetBranchAddress("kine_pio_dis_1", &kine_pio_dis_1);
-	  tree4->SetBranchAddress("kine_pio_energy_2", &kine_pio_energy_2);
-	  tree4->SetBranchAddress("kine_pio_theta_2", &kine_pio_theta_2);
-	  tree4->SetBranchAddress("kine_pio_phi_2", &kine_pio_phi_2);
-	  tree4->SetBranchAddress("kine_pio_dis_2", &kine_pio_dis_2);
-	  tree4->SetBranchAddress("kine_pio_angle", &kine_pio_angle);
+	  SetBranchAddress(*port,tree4,"kine_reco_Enu", &kine_reco_Enu); // kinetic energy  + additional energy ...
+	  SetBranchAddress(*port,tree4,"kine_reco_add_energy", &kine_reco_add_energy);  // mass, binding energy ...
+	  SetBranchAddress(*port,tree4,"kine_energy_particle", &kine_energy_particle);  // energy of each particle
+	  SetBranchAddress(*port,tree4,"kine_energy_info", &kine_energy_info); // what kind of energy reconstruction?
+	  SetBranchAddress(*port,tree4,"kine_particle_type", &kine_particle_type);
+	  SetBranchAddress(*port,tree4,"kine_energy_included", &kine_energy_included); // included in the neutrino energy calculation?
+	  SetBranchAddress(*port,tree4,"kine_pio_mass", &kine_pio_mass); // mass
+	  SetBranchAddress(*port,tree4,"kine_pio_flag", &kine_pio_flag); // 0 not filled, 1, with vertex: CCpio, 2 without vertex: NCpi0
+	  SetBranchAddress(*port,tree4,"kine_pio_vtx_dis", &kine_pio_vtx_dis);
+	  SetBranchAddress(*port,tree4,"kine_pio_energy_1", &kine_pio_energy_1);
+	  SetBranchAddress(*port,tree4,"kine_pio_theta_1", &kine_pio_theta_1);
+	  SetBranchAddress(*port,tree4,"kine_pio_phi_1", &kine_pio_phi_1);
+	  SetBranchAddress(*port,tree4,"kine_pio_dis_1", &kine_pio_dis_1);
+	  SetBranchAddress(*port,tree4,"kine_pio_energy_2", &kine_pio_energy_2);
+	  SetBranchAddress(*port,tree4,"kine_pio_theta_2", &kine_pio_theta_2);
+	  SetBranchAddress(*port,tree4,"kine_pio_phi_2", &kine_pio_phi_2);
+	  SetBranchAddress(*port,tree4,"kine_pio_dis_2", &kine_pio_dis_2);
+	  SetBranchAddress(*port,tree4,"kine_pio_angle", &kine_pio_angle);
 
 	  //read and port
-  	  tree4->GetEntry(0);
+  	  tree4->GetEntry(entry4);
+	  tree4->ResetBranchAddresses();
 	  nsm::NuSelectionKINE::KineInfo _KineInfo_init = {
 		  kine_reco_Enu,
 		  kine_reco_add_energy,
@@ -2988,7 +3031,7 @@ if(f_KINEport){
 
   }
   else{
-    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree4 <<" not found in file " << fInput <<"\n";
+    mf::LogError("WireCellPF") <<"TTree "<< fInput_tree4 <<" not found (or has no entry for this event) in file " << fInput <<"\n";
   }
 
   e.put(std::move(outputKINEvars));
@@ -2997,11 +3040,31 @@ if(f_KINEport){
 }
 
 
-  if(fin) fin->Close();
   return;
 
 }
 
+std::shared_ptr<wcpport::PortedInput> nsm::WireCellPF::GetInput(std::string const& path)
+{
+  if(path!=fInput_file) return wcpport::PortedInput::Open(path);
+  if(!fMergedInput) fMergedInput = wcpport::PortedInput::Open(path);
+  return fMergedInput;
+}
+
+wcpport::EntryRanges_t nsm::WireCellPF::EventEntries(wcpport::PortedInput& port, std::string const& tree_name, TTree* tree, art::Event const& e) const
+{
+  if(fInput_file.empty())
+    return wcpport::EntryRanges_t(1,wcpport::EntryRange_t(0,tree->GetEntries()));
+  return port.Entries(tree_name,e.run(),e.subRun(),e.event());
+}
+
+Long64_t nsm::WireCellPF::EventEntry(wcpport::PortedInput& port, std::string const& tree_name, TTree* tree, art::Event const& e) const
+{
+  if(fInput_file.empty()) return 0;
+  auto const& ranges = port.Entries(tree_name,e.run(),e.subRun(),e.event());
+  return ranges.empty() ? -1 : ranges.front().first;
+}
+
 void nsm::WireCellPF::beginJob()
 {
   // Implementation of optional member function here.